@@ -0,0 +1,117 @@
+/**
+ * @file benchmarks/benchmark.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Заголовочный файл для объявлений наборов замеров производительности.
+ */
+
+#ifndef BENCHMARKS_BENCHMARK_HPP_
+#define BENCHMARKS_BENCHMARK_HPP_
+
+#include <cstddef>
+
+/* Сюда нужно добавить объявления наборов замеров. */
+
+/**
+ * @brief Замеры построения R-дерева и запросов к нему.
+ *
+ * @param size Число прямоугольников и запросов.
+ */
+void BenchmarkRTree(size_t size);
+
+/**
+ * @brief Замеры построения k-d дерева и поиска ближайших соседей.
+ *
+ * @param size Число точек и запросов.
+ */
+void BenchmarkKdTree(size_t size);
+
+/**
+ * @brief Замеры построения триангуляции Делоне.
+ *
+ * @param size Наибольшее число точек.
+ */
+void BenchmarkDelaunay(size_t size);
+
+/**
+ * @brief Замеры триангуляции многоугольника.
+ *
+ * @param size Наибольшее число вершин.
+ */
+void BenchmarkTriangulatePolygon(size_t size);
+
+/**
+ * @brief Замеры поиска ближайшей пары и ближайших соседей.
+ *
+ * @param size Число точек.
+ */
+void BenchmarkClosestPair(size_t size);
+
+/**
+ * @brief Замеры суммы Минковского выпуклых многоугольников.
+ *
+ * @param size Суммарное число вершин слагаемых.
+ */
+void BenchmarkMinkowskiSum(size_t size);
+
+/**
+ * @brief Замеры пересечения выпуклых многоугольников.
+ *
+ * @param size Число пар многоугольников.
+ */
+void BenchmarkConvexIntersection(size_t size);
+
+/**
+ * @brief Замеры запросов положения точки относительно выпуклой оболочки.
+ *
+ * @param size Число точек запроса.
+ */
+void BenchmarkConvexLocator(size_t size);
+
+/**
+ * @brief Замеры упрощения ломаных.
+ *
+ * @param size Число вершин ломаной.
+ */
+void BenchmarkSimplifyPolyline(size_t size);
+
+/**
+ * @brief Замеры поиска пар пересекающихся прямоугольников.
+ *
+ * @param size Число прямоугольников.
+ */
+void BenchmarkRectangleIntersections(size_t size);
+
+/**
+ * @brief Замеры поиска максимальной глубины покрытия прямоугольниками.
+ *
+ * @param size Число прямоугольников.
+ */
+void BenchmarkCoverageDepth(size_t size);
+
+/**
+ * @brief Замеры поиска компонент связности объединения прямоугольников.
+ *
+ * @param size Число прямоугольников.
+ */
+void BenchmarkRectangleComponents(size_t size);
+
+/**
+ * @brief Замеры пропускной способности пула рабочих потоков сервера
+ * в зависимости от числа потоков.
+ *
+ * @param size Общее число точек во всех запросах.
+ */
+void BenchmarkThreadPool(size_t size);
+
+/**
+ * @brief Замеры хэширования, добавления и параллельного поиска в кэше
+ * результатов сервера.
+ *
+ * @param size Общий размер всех запросов в байтах.
+ */
+void BenchmarkResultCache(size_t size);
+
+/* Конец вставки. */
+
+#endif  // BENCHMARKS_BENCHMARK_HPP_
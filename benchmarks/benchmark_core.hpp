@@ -0,0 +1,71 @@
+/**
+ * @file benchmarks/benchmark_core.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Вспомогательные средства для измерения производительности.
+ */
+
+#ifndef BENCHMARKS_BENCHMARK_CORE_HPP_
+#define BENCHMARKS_BENCHMARK_CORE_HPP_
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Набор замеров производительности.
+ *
+ * Каждый замер выводится строкой вида
+ * "<набор>/<замер>: <время> s, <число операций в секунду> op/s".
+ */
+class BenchmarkSuite {
+ public:
+  explicit BenchmarkSuite(const std::string& benchmarkSuiteName) :
+    benchmarkSuiteName(benchmarkSuiteName) {
+    std::cerr << "Starting benchmark suite " << benchmarkSuiteName << "..."
+              << std::endl;
+  }
+
+  ~BenchmarkSuite() {
+    std::cerr << "Benchmark suite " << benchmarkSuiteName << " finished."
+              << std::endl << std::endl;
+  }
+
+  /**
+   * @brief Выполнить замер.
+   *
+   * @tparam Function Тип функции.
+   *
+   * @param name Название замера.
+   * @param operations Число операций, выполняемых функцией.
+   * @param function Функция, время работы которой измеряется.
+   * @return Время работы в секундах.
+   */
+  template<typename Function>
+  double Run(const std::string& name, size_t operations, Function function) {
+    auto start = std::chrono::steady_clock::now();
+
+    function();
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << benchmarkSuiteName << "/" << name << ": "
+              << std::fixed << std::setprecision(3) << seconds << " s";
+
+    if (seconds > 0)
+      std::cout << ", " << std::setprecision(0) << operations / seconds
+                << " op/s";
+
+    std::cout << std::endl;
+
+    return seconds;
+  }
+
+ private:
+  //! Название набора замеров.
+  std::string benchmarkSuiteName;
+};
+
+#endif  // BENCHMARKS_BENCHMARK_CORE_HPP_
@@ -0,0 +1,50 @@
+/**
+ * @file benchmarks/closest_pair_benchmark.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Замеры поиска ближайшей пары точек и ближайших соседей.
+ */
+
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+#include <closest_pair.hpp>
+#include "benchmark.hpp"
+#include "benchmark_core.hpp"
+
+using geometry::AllNearestNeighbours;
+using geometry::ClosestPair;
+using geometry::Point;
+
+void BenchmarkClosestPair(size_t size) {
+  BenchmarkSuite suite("BenchmarkClosestPair");
+  std::mt19937 gen(2022);
+  std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+  std::vector<Point<double>> points;
+  size_t found = 0;
+
+  points.reserve(size);
+
+  for (size_t i = 0; i < size; i++)
+    points.push_back(Point<double>(coordinate(gen), coordinate(gen)));
+
+  suite.Run("ClosestPairSingleThread", size, [&]() {
+    found += ClosestPair(points, 1).first;
+  });
+
+  suite.Run("ClosestPair", size, [&]() {
+    found += ClosestPair(points).first;
+  });
+
+  suite.Run("AllNearestNeighboursSingleThread", size, [&]() {
+    found += AllNearestNeighbours(points, 1)[0];
+  });
+
+  suite.Run("AllNearestNeighbours", size, [&]() {
+    found += AllNearestNeighbours(points)[0];
+  });
+
+  // Результат выводится, чтобы компилятор не удалил вычисления.
+  std::cerr << "Checksum " << found << "." << std::endl;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file benchmarks/convex_intersection_benchmark.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Замеры пересечения выпуклых многоугольников.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <clip_polygon.hpp>
+#include <convex_intersection.hpp>
+#include "benchmark.hpp"
+#include "benchmark_core.hpp"
+
+using geometry::ConvexIntersection;
+using geometry::ConvexPolygonsIntersect;
+using geometry::ConvexSeparationShape;
+using geometry::Point;
+using geometry::Polygon;
+using geometry::SutherlandHodgman;
+
+void BenchmarkConvexIntersection(size_t size) {
+  using ConvexPolygon = Polygon<double, std::vector<Point<double>>>;
+
+  BenchmarkSuite suite("BenchmarkConvexIntersection");
+  std::mt19937 gen(2022);
+  std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+  std::uniform_real_distribution<double> angle(0.0, 2 * std::acos(-1.0));
+  const size_t vertices = 32;
+  size_t found = 0;
+
+  // Вершины на окружности в порядке возрастания угла образуют выпуклый
+  // многоугольник.
+  auto randomPolygon = [&]() {
+    std::vector<double> angles(vertices);
+    double x = coordinate(gen), y = coordinate(gen);
+    std::vector<Point<double>> points;
+
+    for (double& value : angles)
+      value = angle(gen);
+
+    std::sort(angles.begin(), angles.end());
+
+    for (double value : angles)
+      points.push_back(Point<double>(x + 20 * std::cos(value),
+                                     y + 20 * std::sin(value)));
+
+    return ConvexPolygon(points);
+  };
+
+  std::vector<ConvexPolygon> first, second;
+
+  for (size_t i = 0; i < size; i++) {
+    first.push_back(randomPolygon());
+    second.push_back(randomPolygon());
+  }
+
+  suite.Run("SutherlandHodgman", size, [&]() {
+    for (size_t i = 0; i < size; i++)
+      found += SutherlandHodgman(first[i], second[i], 0.0).Size();
+  });
+
+  suite.Run("ORourke", size, [&]() {
+    for (size_t i = 0; i < size; i++)
+      found += ConvexIntersection(first[i], second[i], 0.0).Size();
+  });
+
+  suite.Run("Test", size, [&]() {
+    for (size_t i = 0; i < size; i++)
+      found += ConvexPolygonsIntersect(first[i], second[i]);
+  });
+
+  std::vector<ConvexSeparationShape<double>> shapes;
+
+  shapes.reserve(size);
+
+  for (const ConvexPolygon& polygon : second)
+    shapes.emplace_back(polygon);
+
+  ConvexSeparationShape<double> shape(first[0]);
+
+  suite.Run("TestPrepared", size, [&]() {
+    for (size_t i = 0; i < size; i++)
+      found += shape.Intersects(shapes[i]);
+  });
+
+  // Результат выводится, чтобы компилятор не удалил вычисления.
+  std::cerr << "Checksum " << found << "." << std::endl;
+}
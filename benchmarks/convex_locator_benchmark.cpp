@@ -0,0 +1,70 @@
+/**
+ * @file benchmarks/convex_locator_benchmark.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Замеры запросов положения точки относительно выпуклой оболочки.
+ */
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <convex_intersection.hpp>
+#include <convex_locator.hpp>
+#include "benchmark.hpp"
+#include "benchmark_core.hpp"
+
+using geometry::ConvexLocator;
+using geometry::Point;
+using geometry::Polygon;
+
+void BenchmarkConvexLocator(size_t size) {
+  BenchmarkSuite suite("BenchmarkConvexLocator");
+  std::mt19937 gen(2022);
+  std::uniform_real_distribution<double> coordinate(-1.5, 1.5);
+  std::uniform_real_distribution<double> angle(0.0, 2 * std::acos(-1.0));
+  const size_t vertices = 1024;
+  size_t found = 0;
+
+  // Правильный многоугольник, вписанный в единичную окружность.
+  std::vector<Point<double>> hull;
+
+  for (size_t i = 0; i < vertices; i++) {
+    double value = 2 * std::acos(-1.0) * i / vertices;
+
+    hull.push_back(Point<double>(std::cos(value), std::sin(value)));
+  }
+
+  Polygon<double, std::vector<Point<double>>> polygon(hull);
+  std::vector<Point<double>> queries;
+
+  queries.reserve(size);
+
+  for (size_t i = 0; i < size; i++)
+    queries.push_back(Point<double>(coordinate(gen), coordinate(gen)));
+
+  ConvexLocator<double> locator(polygon);
+
+  suite.Run("Linear", size / 16, [&]() {
+    for (size_t i = 0; i < size / 16; i++)
+      found += geometry::detail::LocateInConvex(queries[i], hull, 0.0) >= 0;
+  });
+
+  suite.Run("Single", size, [&]() {
+    for (const Point<double>& query : queries)
+      found += locator.Contains(query);
+  });
+
+  suite.Run("BatchSingleThread", size, [&]() {
+    for (int value : locator.Locate(queries, 1))
+      found += value >= 0;
+  });
+
+  suite.Run("Batch", size, [&]() {
+    for (int value : locator.Locate(queries))
+      found += value >= 0;
+  });
+
+  // Результат выводится, чтобы компилятор не удалил вычисления.
+  std::cerr << "Checksum " << found << "." << std::endl;
+}
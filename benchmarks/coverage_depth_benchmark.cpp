@@ -0,0 +1,49 @@
+/**
+ * @file benchmarks/coverage_depth_benchmark.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Замеры поиска максимальной глубины покрытия прямоугольниками.
+ */
+
+#include <iostream>
+#include <random>
+#include <vector>
+#include <coverage_depth.hpp>
+#include "benchmark.hpp"
+#include "benchmark_core.hpp"
+
+using geometry::MaxCoverageDepth;
+using geometry::Point;
+using geometry::Rectangle;
+
+void BenchmarkCoverageDepth(size_t size) {
+  BenchmarkSuite suite("BenchmarkCoverageDepth");
+  std::mt19937 gen(2022);
+  std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+  std::uniform_real_distribution<double> length(0.0, 3.0);
+  double checksum = 0.0;
+
+  std::vector<Rectangle<double>> rectangles;
+
+  rectangles.reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    double x = coordinate(gen), y = coordinate(gen);
+
+    rectangles.emplace_back(Point<double>(x, y),
+                            Point<double>(x + length(gen), y + length(gen)),
+                            static_cast<int>(i));
+  }
+
+  suite.Run("Depth", size, [&]() {
+    checksum += MaxCoverageDepth(rectangles.data(), size).depth;
+  });
+
+  suite.Run("Histogram", size, [&]() {
+    checksum += MaxCoverageDepth(rectangles.data(), size,
+                                 true).histogram.size();
+  });
+
+  // Результат выводится, чтобы компилятор не удалил вычисления.
+  std::cerr << "Checksum " << checksum << "." << std::endl;
+}
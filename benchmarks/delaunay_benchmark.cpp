@@ -0,0 +1,71 @@
+/**
+ * @file benchmarks/delaunay_benchmark.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Замеры построения триангуляции Делоне.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <delaunay.hpp>
+#include "benchmark.hpp"
+#include "benchmark_core.hpp"
+
+using geometry::DelaunayTriangulation;
+using geometry::Point;
+
+void BenchmarkDelaunay(size_t size) {
+  BenchmarkSuite suite("BenchmarkDelaunay");
+  std::mt19937 gen(2022);
+  std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+  std::vector<Point<double>> points;
+
+  points.reserve(size);
+
+  for (size_t i = 0; i < size; i++)
+    points.push_back(Point<double>(coordinate(gen), coordinate(gen)));
+
+  size_t found = 0;
+
+  // Время, делённое на n log n, должно оставаться примерно постоянным.
+  for (size_t count = std::max<size_t>(size / 8, 2); count <= size;
+       count *= 2) {
+    std::vector<Point<double>> prefix(points.begin(), points.begin() + count);
+    std::string name = "Build" + std::to_string(count);
+    double seconds = suite.Run(name, count, [&]() {
+      found += DelaunayTriangulation<double>(prefix).Size();
+    });
+
+    double perOperation = 1e9 * seconds / (count * std::log2(count));
+
+    std::cout << "BenchmarkDelaunay/" << name << ": " << std::setprecision(2)
+              << perOperation << " ns / (n log n)" << std::endl;
+  }
+
+  std::vector<Point<double>> grid;
+
+  // Точки целочисленной решётки: много коллинеарных и лежащих на одной
+  // окружности точек, знак предикатов вычисляется точно.
+  for (size_t i = 0; i * i < size; i++) {
+    for (size_t j = 0; j * j < size; j++)
+      grid.push_back(Point<double>(i, j));
+  }
+
+  suite.Run("BuildGrid", grid.size(), [&]() {
+    found += DelaunayTriangulation<double>(grid).Size();
+  });
+
+  DelaunayTriangulation<double> triangulation(points);
+
+  suite.Run("Voronoi", size, [&]() {
+    found += triangulation.Voronoi().edges.size();
+  });
+
+  // Результат выводится, чтобы компилятор не удалил вычисления.
+  std::cerr << "Checksum " << found << "." << std::endl;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file benchmarks/kd_tree_benchmark.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Замеры построения k-d дерева и поиска ближайших соседей.
+ */
+
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+#include <kd_tree.hpp>
+#include <parallel.hpp>
+#include "benchmark.hpp"
+#include "benchmark_core.hpp"
+
+using geometry::KdTree;
+using geometry::ParallelFor;
+using geometry::Point;
+
+void BenchmarkKdTree(size_t size) {
+  BenchmarkSuite suite("BenchmarkKdTree");
+  std::mt19937 gen(2022);
+  std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+  std::vector<Point<double>> points, queries;
+
+  points.reserve(size);
+  queries.reserve(size);
+
+  for (size_t i = 0; i < size; i++)
+    points.push_back(Point<double>(coordinate(gen), coordinate(gen)));
+
+  for (size_t i = 0; i < size; i++)
+    queries.push_back(Point<double>(coordinate(gen), coordinate(gen)));
+
+  suite.Run("BuildSingleThread", size, [&]() {
+    KdTree<double> tree(points, 1);
+  });
+
+  std::unique_ptr<KdTree<double>> tree;
+
+  suite.Run("Build", size, [&]() {
+    tree = std::make_unique<KdTree<double>>(points);
+  });
+
+  size_t found = 0;
+
+  suite.Run("Nearest1", size, [&]() {
+    for (const Point<double>& query : queries)
+      found += tree->Nearest(query, 1)[0];
+  });
+
+  suite.Run("Nearest10", size, [&]() {
+    for (const Point<double>& query : queries)
+      found += tree->Nearest(query, 10).size();
+  });
+
+  suite.Run("Nearest10Approximate", size, [&]() {
+    for (const Point<double>& query : queries)
+      found += tree->Nearest(query, 10, 0.5).size();
+  });
+
+  suite.Run("Radius", size, [&]() {
+    std::vector<size_t> result;
+
+    for (const Point<double>& query : queries) {
+      result.clear();
+      tree->Radius(query, 1.0, std::back_inserter(result));
+      found += result.size();
+    }
+  });
+
+  std::vector<std::vector<size_t>> results(size);
+
+  suite.Run("Nearest10Batch", size, [&]() {
+    ParallelFor(size, [&](size_t i) {
+      results[i] = tree->Nearest(queries[i], 10);
+    });
+  });
+
+  // Результат выводится, чтобы компилятор не удалил запросы.
+  std::cerr << "Checksum " << found << "." << std::endl;
+}
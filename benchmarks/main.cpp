@@ -0,0 +1,43 @@
+/**
+ * @file benchmarks/main.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл с функией main() для замеров производительности. Замеры вызывают
+ * алгоритмы напрямую, без HTTP сервера.
+ */
+
+#include <cstdio>
+#include "benchmark.hpp"
+
+int main(int argc, char* argv[]) {
+  // Размер данных по-умолчанию.
+  size_t size = 1000000;
+
+  if (argc >= 2) {
+    // Меняем размер данных, если предоставлен соответствующий аргумент
+    // командной строки.
+    if (std::sscanf(argv[1], "%zu", &size) != 1)
+      return -1;
+  }
+
+  /* Сюда нужно вставить вызов набора замеров для алгоритма. */
+
+  BenchmarkRTree(size);
+  BenchmarkKdTree(size);
+  BenchmarkDelaunay(size);
+  BenchmarkTriangulatePolygon(size);
+  BenchmarkClosestPair(size);
+  BenchmarkMinkowskiSum(size);
+  BenchmarkConvexIntersection(size);
+  BenchmarkConvexLocator(size);
+  BenchmarkSimplifyPolyline(size);
+  BenchmarkRectangleIntersections(size);
+  BenchmarkCoverageDepth(size);
+  BenchmarkRectangleComponents(size);
+  BenchmarkThreadPool(size);
+  BenchmarkResultCache(size);
+
+  /* Конец вставки. */
+
+  return 0;
+}
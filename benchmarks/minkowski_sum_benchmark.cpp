@@ -0,0 +1,76 @@
+/**
+ * @file benchmarks/minkowski_sum_benchmark.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Замеры суммы Минковского выпуклых многоугольников.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <minkowski_sum.hpp>
+#include "benchmark.hpp"
+#include "benchmark_core.hpp"
+
+using geometry::MinkowskiSum;
+using geometry::Point;
+using geometry::Polygon;
+
+void BenchmarkMinkowskiSum(size_t size) {
+  BenchmarkSuite suite("BenchmarkMinkowskiSum");
+  std::mt19937 gen(2022);
+  std::uniform_real_distribution<double> angle(0.0, 2 * std::acos(-1.0));
+  size_t found = 0;
+
+  // Вершины на окружности в порядке возрастания угла образуют выпуклый
+  // многоугольник.
+  auto randomPolygon = [&](size_t count, double radius) {
+    std::vector<double> angles(count);
+
+    for (double& value : angles)
+      value = angle(gen);
+
+    std::sort(angles.begin(), angles.end());
+
+    std::vector<Point<double>> vertices;
+
+    vertices.reserve(count);
+
+    for (double value : angles) {
+      vertices.push_back(Point<double>(radius * std::cos(value),
+                                       radius * std::sin(value)));
+    }
+
+    return Polygon<double, std::vector<Point<double>>>(vertices);
+  };
+
+  auto first = randomPolygon(size / 2, 1.0);
+  auto second = randomPolygon(size / 2, 2.0);
+
+  suite.Run("Pair", size, [&]() {
+    found += MinkowskiSum(first, second).Size();
+  });
+
+  // Один многоугольник складывается со многими маленькими.
+  const size_t small = 16;
+  auto polygon = randomPolygon(small, 1.0);
+  std::vector<Polygon<double, std::vector<Point<double>>>> others;
+
+  others.reserve(size / small);
+
+  for (size_t i = 0; i < size / small; i++)
+    others.push_back(randomPolygon(small, 0.5));
+
+  suite.Run("BatchSingleThread", size / small, [&]() {
+    found += MinkowskiSum(polygon, others, 1).size();
+  });
+
+  suite.Run("Batch", size / small, [&]() {
+    found += MinkowskiSum(polygon, others).size();
+  });
+
+  // Результат выводится, чтобы компилятор не удалил вычисления.
+  std::cerr << "Checksum " << found << "." << std::endl;
+}
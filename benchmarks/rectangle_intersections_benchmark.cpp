@@ -0,0 +1,49 @@
+/**
+ * @file benchmarks/rectangle_intersections_benchmark.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Замеры поиска пар пересекающихся прямоугольников.
+ */
+
+#include <iostream>
+#include <random>
+#include <vector>
+#include <rectangle_intersections.hpp>
+#include "benchmark.hpp"
+#include "benchmark_core.hpp"
+
+using geometry::CountRectangleIntersections;
+using geometry::Point;
+using geometry::Rectangle;
+using geometry::RectangleIntersections;
+
+void BenchmarkRectangleIntersections(size_t size) {
+  BenchmarkSuite suite("BenchmarkRectangleIntersections");
+  std::mt19937 gen(2022);
+  std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+  std::uniform_real_distribution<double> length(0.0, 3.0);
+  size_t found = 0;
+
+  std::vector<Rectangle<double>> rectangles;
+
+  rectangles.reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    double x = coordinate(gen), y = coordinate(gen);
+
+    rectangles.emplace_back(Point<double>(x, y),
+                            Point<double>(x + length(gen), y + length(gen)),
+                            static_cast<int>(i));
+  }
+
+  suite.Run("Pairs", size, [&]() {
+    found += RectangleIntersections(rectangles.data(), size).size();
+  });
+
+  suite.Run("Count", size, [&]() {
+    found += CountRectangleIntersections(rectangles.data(), size);
+  });
+
+  // Результат выводится, чтобы компилятор не удалил вычисления.
+  std::cerr << "Checksum " << found << "." << std::endl;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file benchmarks/result_cache_benchmark.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Замеры кэша результатов запросов сервера.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <parallel.hpp>
+#include <result_cache.hpp>
+#include <thread_pool.hpp>
+#include "benchmark.hpp"
+#include "benchmark_core.hpp"
+
+using geometry::DefaultThreadCount;
+using geometry::ResultCache;
+using geometry::ThreadPool;
+
+void BenchmarkResultCache(size_t size) {
+  BenchmarkSuite suite("BenchmarkResultCache");
+  std::mt19937 gen(2022);
+  std::uniform_int_distribution<int> digit('0', '9');
+  const size_t requests = 256;
+  std::atomic<size_t> found(0);
+
+  // Запросы размером около size / requests байт, как у панелей, которые
+  // раз за разом отправляют одни и те же данные.
+  size_t length = std::max<size_t>(size / requests, 16);
+  std::vector<std::string> inputs(requests);
+
+  for (std::string& input : inputs) {
+    for (size_t i = 0; i < length; i++)
+      input.push_back(static_cast<char>(digit(gen)));
+  }
+
+  suite.Run("Hash", requests, [&]() {
+    for (const std::string& input : inputs)
+      found += ResultCache::Hash("/GrahamScan", input) & 1;
+  });
+
+  // Ответы занимают столько же, сколько запросы, и все помещаются в кэш.
+  ResultCache cache(4 * requests * (length + ResultCache::kEntryOverhead));
+
+  suite.Run("Insert", requests, [&]() {
+    for (const std::string& input : inputs)
+      cache.Insert("/GrahamScan", input, input);
+  });
+
+  std::vector<size_t> workers = { 1, 2, 4, 8, DefaultThreadCount() };
+
+  std::sort(workers.begin(), workers.end());
+  workers.erase(std::unique(workers.begin(), workers.end()), workers.end());
+
+  // Каждый поток многократно ищет все запросы: обращения к разным частям
+  // кэша не блокируют друг друга.
+  const size_t rounds = 64;
+
+  for (size_t threads : workers) {
+    suite.Run("Hits" + std::to_string(threads), threads * rounds * requests,
+              [&]() {
+      ThreadPool pool(threads);
+
+      for (size_t t = 0; t < threads; t++) {
+        pool.Enqueue([&]() {
+          for (size_t round = 0; round < rounds; round++) {
+            for (const std::string& input : inputs)
+              found += cache.Find("/GrahamScan", input) != nullptr;
+          }
+        });
+      }
+
+      pool.Shutdown();
+    });
+  }
+
+  // Результат выводится, чтобы компилятор не удалил вычисления.
+  std::cerr << "Checksum " << found << ", hits " << cache.Hits()
+            << ", misses " << cache.Misses() << "." << std::endl;
+}
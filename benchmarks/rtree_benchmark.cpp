@@ -0,0 +1,78 @@
+/**
+ * @file benchmarks/rtree_benchmark.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Замеры построения R-дерева и запросов к нему.
+ */
+
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+#include <rtree.hpp>
+#include "benchmark.hpp"
+#include "benchmark_core.hpp"
+
+using geometry::Point;
+using geometry::Rectangle;
+using geometry::RTree;
+
+void BenchmarkRTree(size_t size) {
+  BenchmarkSuite suite("BenchmarkRTree");
+  std::mt19937 gen(2022);
+  std::uniform_real_distribution<double> coordinate(0.0, 1000.0);
+  std::uniform_real_distribution<double> extent(0.0, 1.0);
+  std::vector<Rectangle<double>> rectangles;
+
+  rectangles.reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    double x = coordinate(gen), y = coordinate(gen);
+
+    rectangles.push_back(Rectangle<double>(
+        Point<double>(x, y), Point<double>(x + extent(gen), y + extent(gen)),
+        static_cast<int>(i)));
+  }
+
+  std::vector<Point<double>> points;
+
+  points.reserve(size);
+
+  for (size_t i = 0; i < size; i++)
+    points.push_back(Point<double>(coordinate(gen), coordinate(gen)));
+
+  std::unique_ptr<RTree<double>> tree;
+
+  suite.Run("Build", size, [&]() {
+    tree = std::make_unique<RTree<double>>(rectangles);
+  });
+
+  size_t found = 0;
+  std::vector<size_t> result;
+
+  suite.Run("Window", size, [&]() {
+    for (const Point<double>& point : points) {
+      result.clear();
+      tree->Window(Rectangle<double>(point, point + Point<double>(2.0, 2.0)),
+                   std::back_inserter(result));
+      found += result.size();
+    }
+  });
+
+  suite.Run("Stab", size, [&]() {
+    for (const Point<double>& point : points) {
+      result.clear();
+      tree->Stab(point, std::back_inserter(result));
+      found += result.size();
+    }
+  });
+
+  suite.Run("Nearest10", size, [&]() {
+    for (const Point<double>& point : points)
+      found += tree->Nearest(point, 10).size();
+  });
+
+  // Результат выводится, чтобы компилятор не удалил запросы.
+  std::cerr << "Reported " << found << " rectangles." << std::endl;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file benchmarks/simplify_polyline_benchmark.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Замеры упрощения ломаных.
+ */
+
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <vector>
+#include <simplify_polyline.hpp>
+#include "benchmark.hpp"
+#include "benchmark_core.hpp"
+
+using geometry::DouglasPeucker;
+using geometry::Point;
+using geometry::PolylineSimplifier;
+using geometry::SimplifyMethod;
+using geometry::Visvalingam;
+
+void BenchmarkSimplifyPolyline(size_t size) {
+  BenchmarkSuite suite("BenchmarkSimplifyPolyline");
+  std::mt19937 gen(2022);
+  std::normal_distribution<double> step(0.0, 1.0);
+  const size_t window = 1 << 16;
+  size_t found = 0;
+
+  // Случайное блуждание похоже на трек GPS.
+  std::vector<Point<double>> points;
+  double x = 0, y = 0;
+
+  points.reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    x += step(gen);
+    y += step(gen);
+    points.push_back(Point<double>(x, y));
+  }
+
+  suite.Run("DouglasPeucker", size, [&]() {
+    found += DouglasPeucker(points.data(), points.size(), 5.0).size();
+  });
+
+  suite.Run("Visvalingam", size, [&]() {
+    found += Visvalingam(points.data(), points.size(), 25.0).size();
+  });
+
+  auto stream = [&](SimplifyMethod method, double tolerance) {
+    PolylineSimplifier<double> simplifier(method, tolerance, window);
+    std::vector<Point<double>> result;
+    auto inserter = std::back_inserter(result);
+
+    for (const Point<double>& point : points)
+      inserter = simplifier.Push(point, inserter);
+
+    simplifier.Finish(inserter);
+
+    return result.size();
+  };
+
+  suite.Run("DouglasPeuckerStreaming", size, [&]() {
+    found += stream(SimplifyMethod::DouglasPeucker, 5.0);
+  });
+
+  suite.Run("VisvalingamStreaming", size, [&]() {
+    found += stream(SimplifyMethod::Visvalingam, 25.0);
+  });
+
+  // Результат выводится, чтобы компилятор не удалил вычисления.
+  std::cerr << "Checksum " << found << "." << std::endl;
+}
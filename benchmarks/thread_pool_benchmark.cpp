@@ -0,0 +1,68 @@
+/**
+ * @file benchmarks/thread_pool_benchmark.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Замеры пропускной способности пула рабочих потоков сервера.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+#include <graham_scan.hpp>
+#include <parallel.hpp>
+#include <thread_pool.hpp>
+#include "benchmark.hpp"
+#include "benchmark_core.hpp"
+
+using geometry::DefaultThreadCount;
+using geometry::GrahamScan;
+using geometry::Point;
+using geometry::ThreadPool;
+
+void BenchmarkThreadPool(size_t size) {
+  BenchmarkSuite suite("BenchmarkThreadPool");
+  std::mt19937 gen(2022);
+  std::uniform_real_distribution<double> coordinate(-1000.0, 1000.0);
+  const size_t tasks = 256;
+  std::atomic<size_t> found(0);
+
+  // Смесь запросов, как на сервере: каждый шестнадцатый запрос строит
+  // оболочку большого набора точек, остальные --- маленьких. Всего
+  // обрабатывается около size точек.
+  std::vector<std::list<Point<double>>> requests(tasks);
+  size_t large = std::max<size_t>(size / 32, 1);
+  size_t small = std::max<size_t>(size / 512, 3);
+
+  for (size_t i = 0; i < tasks; i++) {
+    size_t count = i % 16 == 0 ? large : small;
+
+    for (size_t j = 0; j < count; j++)
+      requests[i].push_back(Point<double>(coordinate(gen), coordinate(gen)));
+  }
+
+  std::vector<size_t> workers = { 1, 2, 4, 8, DefaultThreadCount() };
+
+  std::sort(workers.begin(), workers.end());
+  workers.erase(std::unique(workers.begin(), workers.end()), workers.end());
+
+  for (size_t threads : workers) {
+    suite.Run("Workers" + std::to_string(threads), tasks, [&]() {
+      ThreadPool pool(threads);
+
+      for (const std::list<Point<double>>& request : requests) {
+        pool.Enqueue([&request, &found]() {
+          found += GrahamScan<double>(request, request.size()).Size();
+        });
+      }
+
+      pool.Shutdown();
+    });
+  }
+
+  // Результат выводится, чтобы компилятор не удалил вычисления.
+  std::cerr << "Checksum " << found << "." << std::endl;
+}
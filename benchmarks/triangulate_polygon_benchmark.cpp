@@ -0,0 +1,52 @@
+/**
+ * @file benchmarks/triangulate_polygon_benchmark.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Замеры триангуляции многоугольника.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <triangulate_polygon.hpp>
+#include "benchmark.hpp"
+#include "benchmark_core.hpp"
+
+using geometry::Point;
+using geometry::TriangulatePolygon;
+
+void BenchmarkTriangulatePolygon(size_t size) {
+  BenchmarkSuite suite("BenchmarkTriangulatePolygon");
+  std::mt19937 gen(2022);
+  std::uniform_real_distribution<double> jitter(0.0, 0.9);
+  std::uniform_real_distribution<double> radius(0.1, 1.0);
+  const double pi = std::acos(-1.0);
+  size_t found = 0;
+
+  // Звёздный многоугольник со случайными радиусами: около трети вершин
+  // являются вершинами разбиения или слияния.
+  for (size_t count = std::max<size_t>(size / 8, 3); count <= size;
+       count *= 2) {
+    std::vector<Point<double>> polygon;
+
+    polygon.reserve(count);
+
+    for (size_t i = 0; i < count; i++) {
+      double angle = 2 * pi * (i + jitter(gen)) / count;
+      double r = radius(gen);
+
+      polygon.push_back(Point<double>(r * std::cos(angle),
+                                      r * std::sin(angle)));
+    }
+
+    suite.Run("Star" + std::to_string(count), count, [&]() {
+      found += TriangulatePolygon<double>(polygon).size();
+    });
+  }
+
+  // Результат выводится, чтобы компилятор не удалил вычисления.
+  std::cerr << "Checksum " << found << "." << std::endl;
+}
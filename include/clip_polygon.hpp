@@ -0,0 +1,881 @@
+/**
+ * @file include/clip_polygon.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Отсечение многоугольников окном: потоковый алгоритм Сазерленда-Ходжмана
+ * для выпуклых окон и алгоритм Вейлера-Азертона для произвольных окон.
+ */
+
+#ifndef INCLUDE_CLIP_POLYGON_HPP_
+#define INCLUDE_CLIP_POLYGON_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <common.hpp>
+#include <point.hpp>
+#include <edge.hpp>
+#include <polygon.hpp>
+
+namespace geometry {
+
+/**
+ * @brief Вычислить удвоенную ориентированную площадь многоугольника.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Container Тип контейнера вершин.
+ *
+ * @param vertices Вершины многоугольника.
+ * @return Удвоенная площадь. Она положительна, если вершины перечислены
+ * против часовой стрелки, и отрицательна в противном случае.
+ */
+template<typename T, typename Container>
+long double SignedDoubleArea(const Container& vertices) {
+  long double area = 0;
+
+  if (vertices.empty())
+    return area;
+
+  auto previous = std::prev(vertices.end());
+
+  for (auto it = vertices.begin(); it != vertices.end(); previous = it++) {
+    area += static_cast<long double>(previous->X()) * it->Y() -
+            static_cast<long double>(it->X()) * previous->Y();
+  }
+
+  return area;
+}
+
+/**
+ * @brief Найти точку пересечения отрезка с прямой.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param segment Отрезок.
+ * @param line Ребро, задающее прямую.
+ * @param precision Абсолютная точность вычислений.
+ * @return Точка пересечения.
+ *
+ * Предполагается, что отрезок и прямая не параллельны. Для целочисленных
+ * типов точка пересечения вычисляется в long double и округляется.
+ */
+template<typename T>
+Point<T> LineIntersection(const Edge<T>& segment, const Edge<T>& line,
+                          T precision) {
+  if constexpr (std::is_integral_v<T>) {
+    long double dx = static_cast<long double>(segment.Destination().X()) -
+                     segment.Origin().X();
+    long double dy = static_cast<long double>(segment.Destination().Y()) -
+                     segment.Origin().Y();
+    long double ex = static_cast<long double>(line.Destination().X()) -
+                     line.Origin().X();
+    long double ey = static_cast<long double>(line.Destination().Y()) -
+                     line.Origin().Y();
+    long double denominator = ey * dx - ex * dy;
+    long double numerator =
+        ey * (static_cast<long double>(segment.Origin().X()) -
+              line.Origin().X()) -
+        ex * (static_cast<long double>(segment.Origin().Y()) -
+              line.Origin().Y());
+    long double t = -numerator / denominator;
+
+    return Point<T>(
+        static_cast<T>(std::llround(segment.Origin().X() + t * dx)),
+        static_cast<T>(std::llround(segment.Origin().Y() + t * dy)));
+  } else {
+    T t = T();
+
+    segment.Intersect(line, &t, precision);
+
+    return segment.Value(t);
+  }
+}
+
+/**
+ * @brief Потоковый отсекатель Сазерленда-Ходжмана.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam OutputIterator Тип итератора, в который записываются вершины
+ * результата.
+ *
+ * Окно отсечения должно быть выпуклым многоугольником. Каждое ребро окна
+ * образует отдельную стадию конвейера: стадия хранит только первую
+ * и предыдущую вершины, поэтому вершины отсекаемого многоугольника
+ * обрабатываются за один проход, а дополнительная память пропорциональна
+ * числу рёбер окна и не зависит от размера многоугольника.
+ *
+ * Вершины подаются функцией Push(), функция Finish() замыкает многоугольник
+ * и подготавливает отсекатель к обработке следующего многоугольника.
+ * Результат имеет ту же ориентацию, что и исходный многоугольник.
+ */
+template<typename T, typename OutputIterator>
+class SutherlandHodgmanClipper {
+ private:
+  /**
+   * @brief Состояние стадии конвейера.
+   */
+  struct Stage {
+    //! Ребро окна.
+    Edge<T> edge;
+    //! Первая вершина, полученная стадией.
+    Point<T> first;
+    //! Предыдущая вершина, полученная стадией.
+    Point<T> last;
+    //! Получала ли стадия вершины.
+    bool started;
+  };
+
+  //! Стадии конвейера.
+  std::vector<Stage> stages;
+  //! Положение внутренних точек относительно рёбер окна.
+  Position inside;
+  //! Абсолютная точность вычислений.
+  T precision;
+  //! Итератор, в который записываются вершины результата.
+  OutputIterator output;
+
+ public:
+  /**
+   * @brief Создать отсекатель.
+   *
+   * @tparam Container Тип контейнера вершин окна.
+   *
+   * @param window Выпуклое окно отсечения.
+   * @param precision Абсолютная точность вычислений.
+   * @param output Итератор, в который записываются вершины результата.
+   *
+   * Окно может быть ориентировано как по часовой, так и против часовой
+   * стрелки.
+   */
+  template<typename Container>
+  SutherlandHodgmanClipper(const Polygon<T, Container>& window,
+                           T precision,
+                           OutputIterator output) :
+      stages(),
+      inside(Position::Right),
+      precision(precision),
+      output(output) {
+    const Container& vertices = window.Vertices();
+
+    if (SignedDoubleArea<T>(vertices) > 0)
+      inside = Position::Left;
+
+    for (auto it = vertices.begin(); it != vertices.end(); ++it) {
+      auto next = std::next(it) == vertices.end() ? vertices.begin() :
+                                                     std::next(it);
+
+      stages.push_back(Stage{Edge<T>(*it, *next), Point<T>(), Point<T>(),
+                             false});
+    }
+  }
+
+  /**
+   * @brief Добавить очередную вершину отсекаемого многоугольника.
+   *
+   * @param point Вершина.
+   */
+  void Push(const Point<T>& point) {
+    Process(0, point);
+  }
+
+  /**
+   * @brief Замкнуть отсекаемый многоугольник.
+   *
+   * Функция обрабатывает замыкающие рёбра всех стадий по порядку
+   * и сбрасывает состояние отсекателя.
+   */
+  void Finish() {
+    for (size_t i = 0; i < stages.size(); i++) {
+      if (stages[i].started)
+        Clip(i, stages[i].first, true);
+
+      stages[i].started = false;
+    }
+  }
+
+  /**
+   * @brief Получить итератор, в который записываются вершины результата.
+   * @return Итератор вывода.
+   */
+  OutputIterator Output() const { return output; }
+
+ private:
+  /**
+   * @brief Передать вершину на стадию конвейера.
+   *
+   * @param index Номер стадии.
+   * @param point Вершина.
+   */
+  void Process(size_t index, const Point<T>& point) {
+    if (index == stages.size()) {
+      *output++ = point;
+      return;
+    }
+
+    Stage& stage = stages[index];
+
+    if (!stage.started) {
+      stage.first = point;
+      stage.last = point;
+      stage.started = true;
+
+      if (IsInside(stage, point))
+        Process(index + 1, point);
+
+      return;
+    }
+
+    Clip(index, point, false);
+  }
+
+  /**
+   * @brief Отсечь ребро от предыдущей вершины стадии до заданной точки.
+   *
+   * @param index Номер стадии.
+   * @param point Конец ребра.
+   * @param closing Является ли ребро замыкающим. Первая вершина стадии
+   * уже передана дальше при получении, поэтому повторно она не передаётся.
+   */
+  void Clip(size_t index, const Point<T>& point, bool closing) {
+    Stage& stage = stages[index];
+    Point<T> last = stage.last;
+    bool lastInside = IsInside(stage, last);
+    bool pointInside = IsInside(stage, point);
+
+    stage.last = point;
+
+    if (lastInside != pointInside) {
+      Process(index + 1,
+              LineIntersection(Edge<T>(last, point), stage.edge, precision));
+    }
+
+    if (pointInside && !closing)
+      Process(index + 1, point);
+  }
+
+  /**
+   * @brief Проверить, лежит ли точка во внутренней полуплоскости ребра.
+   *
+   * @param stage Стадия конвейера.
+   * @param point Точка.
+   * @return Булево значение.
+   */
+  bool IsInside(const Stage& stage, const Point<T>& point) const {
+    Position position = point.Classify(stage.edge, precision);
+
+    return position != Position::Left && position != Position::Right ?
+           true : position == inside;
+  }
+};
+
+/**
+ * @brief Отсечь многоугольник выпуклым окном.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Container Тип контейнера вершин.
+ *
+ * @param subject Отсекаемый многоугольник.
+ * @param window Выпуклое окно отсечения.
+ * @param precision Абсолютная точность вычислений.
+ * @return Часть многоугольника, лежащая внутри окна.
+ *
+ * Функция реализует алгоритм Сазерленда-Ходжмана. Время работы
+ * \f$ O(nm) \f$, где \f$ n \f$ и \f$ m \f$ --- число вершин многоугольника
+ * и окна.
+ */
+template<typename T, typename Container>
+Polygon<T, Container> SutherlandHodgman(const Polygon<T, Container>& subject,
+                                        const Polygon<T, Container>& window,
+                                        T precision) {
+  Container result;
+  SutherlandHodgmanClipper clipper(window, precision,
+                                   std::back_inserter(result));
+
+  for (const Point<T>& point : subject.Vertices())
+    clipper.Push(point);
+
+  clipper.Finish();
+
+  return Polygon<T, Container>(result);
+}
+
+/**
+ * @brief Проверить, является ли многоугольник выпуклым.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Container Тип контейнера вершин.
+ *
+ * @param polygon Многоугольник.
+ * @param precision Абсолютная точность вычислений.
+ * @return Булево значение.
+ *
+ * Многоугольник выпуклый, если у него нет рёбер нулевой длины, все
+ * повороты на вершинах имеют один знак (вершины на одной прямой
+ * допускаются, если граница не разворачивается назад) и направление
+ * рёбер делает ровно один оборот. Последнее условие отличает выпуклый
+ * многоугольник от самопересекающейся звезды: при монотонном вращении
+ * знак проекции ребра на ось абсцисс меняется дважды за каждый оборот.
+ */
+template<typename T, typename Container>
+bool IsConvex(const Polygon<T, Container>& polygon, T precision) {
+  const Container& vertices = polygon.Vertices();
+
+  if (vertices.size() < 3)
+    return false;
+
+  Position turn = Position::Between;
+  int firstSign = 0, lastSign = 0;
+  size_t signChanges = 0;
+  auto a = std::prev(vertices.end(), 2);
+  auto b = std::prev(vertices.end());
+
+  for (auto c = vertices.begin(); c != vertices.end(); a = b, b = c++) {
+    if (Point<T>::IsEqual(*b, *c, precision))
+      return false;
+
+    Position position = c->Classify(*a, *b, precision);
+
+    if (position == Position::Left || position == Position::Right) {
+      if (turn == Position::Between)
+        turn = position;
+      else if (turn != position)
+        return false;
+    } else if (position != Position::Beyond) {
+      return false;
+    }
+
+    int sign = (c->X() > b->X()) - (c->X() < b->X());
+
+    if (sign == 0)
+      continue;
+
+    if (firstSign == 0)
+      firstSign = sign;
+    else if (sign != lastSign)
+      signChanges++;
+
+    lastSign = sign;
+  }
+
+  if (lastSign != firstSign)
+    signChanges++;
+
+  return turn != Position::Between && signChanges == 2;
+}
+
+/**
+ * @brief Проверить, лежит ли точка внутри многоугольника.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Container Тип контейнера вершин.
+ *
+ * @param point Точка.
+ * @param vertices Вершины многоугольника.
+ * @return Булево значение.
+ *
+ * Используется правило чётности числа пересечений горизонтального луча
+ * с границей многоугольника.
+ */
+template<typename T, typename Container>
+bool IsInsidePolygon(const Point<T>& point, const Container& vertices) {
+  bool result = false;
+
+  if (vertices.empty())
+    return result;
+
+  auto previous = std::prev(vertices.end());
+
+  for (auto it = vertices.begin(); it != vertices.end(); previous = it++) {
+    if ((it->Y() > point.Y()) != (previous->Y() > point.Y())) {
+      long double dx = static_cast<long double>(previous->X()) - it->X();
+      long double dy = static_cast<long double>(previous->Y()) - it->Y();
+      long double x = it->X() + dx *
+          (static_cast<long double>(point.Y()) - it->Y()) / dy;
+
+      if (point.X() < x)
+        result = !result;
+    }
+  }
+
+  return result;
+}
+
+namespace detail {
+
+/**
+ * @brief Ключ сортировки точки пересечения на ребре.
+ *
+ * Параметр точки на ребре при сдвиге отсекаемого многоугольника
+ * на вектор \f$ (\varepsilon, \varepsilon^2) \f$ равен
+ * \f$ t_0 + t_1 \varepsilon + t_2 \varepsilon^2 \f$. Ключ хранит
+ * коэффициенты \f$ (t_0, t_1, t_2) \f$, поэтому лексикографическое
+ * сравнение ключей упорядочивает и точки, совпадающие без сдвига.
+ */
+using CrossingKey = std::array<long double, 3>;
+
+/**
+ * @brief Определить, с какой стороны прямой лежит сдвинутая точка.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param origin Начало ребра, задающего прямую.
+ * @param destination Конец ребра, задающего прямую.
+ * @param point Точка.
+ * @param shift Направление сдвига точки: 1 для сдвига на вектор
+ * \f$ (\varepsilon, \varepsilon^2) \f$ и -1 для сдвига на противоположный.
+ * @return 1, если точка слева от прямой, -1, если справа, и 0, если
+ * ребро имеет нулевую длину.
+ *
+ * Сдвиг бесконечно мал, поэтому он учитывается, только если точка лежит
+ * на прямой. Для ребра ненулевой длины результат никогда не равен нулю.
+ */
+template<typename T>
+int ShiftedSide(const Point<T>& origin, const Point<T>& destination,
+                const Point<T>& point, int shift) {
+  long double ux = static_cast<long double>(destination.X()) - origin.X();
+  long double uy = static_cast<long double>(destination.Y()) - origin.Y();
+  long double cross = ux * (static_cast<long double>(point.Y()) -
+                            origin.Y()) -
+                      uy * (static_cast<long double>(point.X()) -
+                            origin.X());
+
+  // Векторное произведение ребра и сдвига равно ux * eps^2 - uy * eps.
+  if (cross == 0 && uy != 0)
+    cross = -shift * uy;
+  else if (cross == 0)
+    cross = shift * ux;
+
+  return (cross > 0) - (cross < 0);
+}
+
+/**
+ * @brief Найти пересечение сдвинутого ребра многоугольника с ребром окна.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param subject Ребро отсекаемого многоугольника или ломаной. Оно
+ * сдвигается на вектор \f$ (\varepsilon, \varepsilon^2) \f$.
+ * @param window Ребро окна.
+ * @param subjectKey Ключ точки пересечения на ребре многоугольника.
+ * @param windowKey Ключ точки пересечения на ребре окна.
+ * @return Функция возвращает true, если рёбра пересекаются.
+ *
+ * После сдвига вершины одного многоугольника не лежат на прямых,
+ * содержащих рёбра другого, поэтому пересечение всегда трансверсально:
+ * касания, общие вершины и перекрывающиеся рёбра разрешаются
+ * однозначно и согласованно для всех рёбер.
+ */
+template<typename T>
+bool ShiftedCross(const Edge<T>& subject, const Edge<T>& window,
+                  CrossingKey* subjectKey, CrossingKey* windowKey) {
+  const Point<T>& a = subject.Origin();
+  const Point<T>& b = subject.Destination();
+  const Point<T>& c = window.Origin();
+  const Point<T>& d = window.Destination();
+
+  if (ShiftedSide(c, d, a, 1) == ShiftedSide(c, d, b, 1) ||
+      ShiftedSide(a, b, c, -1) == ShiftedSide(a, b, d, -1))
+    return false;
+
+  long double ux = static_cast<long double>(b.X()) - a.X();
+  long double uy = static_cast<long double>(b.Y()) - a.Y();
+  long double wx = static_cast<long double>(d.X()) - c.X();
+  long double wy = static_cast<long double>(d.Y()) - c.Y();
+  long double cx = static_cast<long double>(c.X()) - a.X();
+  long double cy = static_cast<long double>(c.Y()) - a.Y();
+  long double denominator = wx * uy - wy * ux;
+
+  *subjectKey = CrossingKey{ (wx * cy - wy * cx) / denominator,
+                             wy / denominator, -wx / denominator };
+  *windowKey = CrossingKey{ (ux * cy - uy * cx) / denominator,
+                            uy / denominator, -ux / denominator };
+
+  return true;
+}
+
+/**
+ * @brief Проверить, является ли вершина возвратом по прямой.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param a Предыдущая вершина.
+ * @param b Вершина.
+ * @param c Следующая вершина.
+ * @return Булево значение.
+ */
+template<typename T>
+bool IsSpike(const Point<T>& a, const Point<T>& b, const Point<T>& c) {
+  long double ux = static_cast<long double>(b.X()) - a.X();
+  long double uy = static_cast<long double>(b.Y()) - a.Y();
+  long double vx = static_cast<long double>(c.X()) - b.X();
+  long double vy = static_cast<long double>(c.Y()) - b.Y();
+
+  return ux * vy - uy * vx == 0 && ux * vx + uy * vy < 0;
+}
+
+/**
+ * @brief Удалить вырожденные вершины многоугольника.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param vertices Вершины многоугольника.
+ * @param precision Абсолютная точность вычислений.
+ *
+ * Удаляются повторяющиеся подряд вершины и вершины, в которых граница
+ * возвращается назад по той же прямой. Такие вершины появляются, когда
+ * точки, различные после сдвига, совпадают без него.
+ */
+template<typename T>
+void RemoveDegenerateVertices(std::vector<Point<T>>* vertices, T precision) {
+  std::vector<Point<T>> result;
+
+  for (const Point<T>& point : *vertices) {
+    while (result.size() >= 2 &&
+           IsSpike(result[result.size() - 2], result.back(), point))
+      result.pop_back();
+
+    if (result.empty() ||
+        !Point<T>::IsEqual(result.back(), point, precision))
+      result.push_back(point);
+  }
+
+  size_t first = 0;
+  bool changed = true;
+
+  while (changed && result.size() - first >= 3) {
+    changed = false;
+
+    if (Point<T>::IsEqual(result.back(), result[first], precision) ||
+        IsSpike(result[result.size() - 2], result.back(), result[first])) {
+      result.pop_back();
+      changed = true;
+    } else if (IsSpike(result.back(), result[first], result[first + 1])) {
+      first++;
+      changed = true;
+    }
+  }
+
+  vertices->assign(result.begin() + first, result.end());
+}
+
+/**
+ * @brief Вершина списка в алгоритме Вейлера-Азертона.
+ *
+ * @tparam T Тип данных координат.
+ */
+template<typename T>
+struct WeilerAthertonNode {
+  //! Координаты вершины.
+  Point<T> point;
+  //! Номер этой же точки пересечения во втором списке (или -1).
+  std::ptrdiff_t twin;
+  //! Ключ точки на ребре (для сортировки точек пересечения).
+  CrossingKey parameter;
+  //! Входит ли отсекаемый многоугольник в окно в этой точке.
+  bool entry;
+  //! Была ли вершина посещена при обходе.
+  bool visited;
+};
+
+/**
+ * @brief Построить список вершин многоугольника с точками пересечения.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param vertices Вершины многоугольника.
+ * @param crossings Точки пересечения, сгруппированные по рёбрам.
+ * @param position В этот массив запишутся номера точек пересечения
+ * в построенном списке.
+ * @return Список вершин.
+ */
+template<typename T>
+std::vector<WeilerAthertonNode<T>> BuildWeilerAthertonList(
+    const std::vector<Point<T>>& vertices,
+    std::vector<std::vector<std::pair<CrossingKey, size_t>>>* crossings,
+    std::vector<std::ptrdiff_t>* position) {
+  std::vector<WeilerAthertonNode<T>> list;
+
+  for (size_t i = 0; i < vertices.size(); i++) {
+    list.push_back(WeilerAthertonNode<T>{vertices[i], -1, CrossingKey(),
+                                         false, false});
+
+    std::sort((*crossings)[i].begin(), (*crossings)[i].end());
+
+    for (const auto& crossing : (*crossings)[i]) {
+      (*position)[crossing.second] = static_cast<std::ptrdiff_t>(list.size());
+      list.push_back(WeilerAthertonNode<T>{Point<T>(), -1, crossing.first,
+                                           false, false});
+    }
+  }
+
+  return list;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Отсечь многоугольник произвольным окном.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Container Тип контейнера вершин.
+ *
+ * @param subject Отсекаемый многоугольник.
+ * @param window Окно отсечения (простой, возможно невыпуклый многоугольник).
+ * @param precision Абсолютная точность вычислений.
+ * @return Список многоугольников, из которых состоит пересечение.
+ *
+ * Функция реализует алгоритм Вейлера-Азертона. Точки пересечения рёбер
+ * вставляются в списки вершин обоих многоугольников. Затем списки
+ * обходятся, начиная с точек входа в окно: вдоль многоугольника до точки
+ * выхода, затем вдоль окна до следующей точки входа.
+ *
+ * Вырожденные случаи (общие рёбра, касания, вершины одного многоугольника
+ * на рёбрах другого) разрешаются символическим сдвигом отсекаемого
+ * многоугольника на бесконечно малый вектор
+ * \f$ (\varepsilon, \varepsilon^2) \f$ (см. detail::ShiftedCross()).
+ * Координаты точек пересечения вычисляются без сдвига, после чего
+ * из результата удаляются совпавшие и вырожденные вершины
+ * и многоугольники нулевой площади. Время работы
+ * \f$ O(nm + k \log k) \f$, где \f$ k \f$ --- число точек пересечения.
+ * Результат имеет ту же ориентацию, что и исходный многоугольник.
+ */
+template<typename T, typename Container>
+std::vector<Polygon<T, Container>> WeilerAtherton(
+    const Polygon<T, Container>& subject,
+    const Polygon<T, Container>& window,
+    T precision) {
+  std::vector<Polygon<T, Container>> result;
+  std::vector<Point<T>> s(subject.Vertices().begin(),
+                          subject.Vertices().end());
+  std::vector<Point<T>> w(window.Vertices().begin(), window.Vertices().end());
+
+  if (s.size() < 3 || w.size() < 3)
+    return result;
+
+  // Обход ведётся против часовой стрелки.
+  bool subjectClockWise = SignedDoubleArea<T>(s) < 0;
+
+  if (subjectClockWise)
+    std::reverse(s.begin(), s.end());
+  if (SignedDoubleArea<T>(w) < 0)
+    std::reverse(w.begin(), w.end());
+
+  std::vector<std::vector<std::pair<detail::CrossingKey, size_t>>>
+      subjectCrossings(s.size()), windowCrossings(w.size());
+  std::vector<Point<T>> points;
+  std::vector<bool> entries;
+
+  for (size_t i = 0; i < s.size(); i++) {
+    Edge<T> subjectEdge(s[i], s[(i + 1) % s.size()]);
+
+    for (size_t j = 0; j < w.size(); j++) {
+      Edge<T> windowEdge(w[j], w[(j + 1) % w.size()]);
+      detail::CrossingKey subjectKey, windowKey;
+
+      if (!detail::ShiftedCross(subjectEdge, windowEdge, &subjectKey,
+                                &windowKey))
+        continue;
+
+      Point<T> direction = subjectEdge.Destination() - subjectEdge.Origin();
+      Point<T> windowDirection = windowEdge.Destination() -
+                                 windowEdge.Origin();
+
+      subjectCrossings[i].emplace_back(subjectKey, points.size());
+      windowCrossings[j].emplace_back(windowKey, points.size());
+
+      // Многоугольник входит в окно, если его ребро направлено влево
+      // от ребра окна.
+      entries.push_back(static_cast<long double>(windowDirection.X()) *
+                        direction.Y() -
+                        static_cast<long double>(windowDirection.Y()) *
+                        direction.X() > 0);
+      points.push_back(LineIntersection(subjectEdge, windowEdge, precision));
+    }
+  }
+
+  if (points.empty()) {
+    Container vertices;
+
+    // Правило чётности в IsInsidePolygon() относит точки на границе
+    // к многоугольнику так же, как сдвиг точки на (eps, eps^2). Вершина
+    // окна сравнивается со сдвинутым многоугольником, то есть сдвигается
+    // в обратную сторону, поэтому обе фигуры отражаются относительно
+    // начала координат.
+    std::vector<Point<T>> reflected;
+
+    for (const Point<T>& point : s)
+      reflected.push_back(Point<T>(-point.X(), -point.Y()));
+
+    if (IsInsidePolygon(s[0], w)) {
+      vertices = subject.Vertices();
+    } else if (IsInsidePolygon(Point<T>(-w[0].X(), -w[0].Y()), reflected)) {
+      vertices.assign(w.begin(), w.end());
+
+      if (subjectClockWise)
+        std::reverse(vertices.begin(), vertices.end());
+    } else {
+      return result;
+    }
+
+    result.push_back(Polygon<T, Container>(vertices));
+
+    return result;
+  }
+
+  std::vector<std::ptrdiff_t> subjectPosition(points.size());
+  std::vector<std::ptrdiff_t> windowPosition(points.size());
+  auto subjectList = detail::BuildWeilerAthertonList(s, &subjectCrossings,
+                                                     &subjectPosition);
+  auto windowList = detail::BuildWeilerAthertonList(w, &windowCrossings,
+                                                    &windowPosition);
+
+  for (size_t k = 0; k < points.size(); k++) {
+    auto& subjectNode = subjectList[subjectPosition[k]];
+    auto& windowNode = windowList[windowPosition[k]];
+
+    subjectNode.point = windowNode.point = points[k];
+    subjectNode.entry = windowNode.entry = entries[k];
+    subjectNode.twin = windowPosition[k];
+    windowNode.twin = subjectPosition[k];
+  }
+
+  for (size_t k = 0; k < points.size(); k++) {
+    std::ptrdiff_t start = subjectPosition[k];
+
+    if (!entries[k] || subjectList[start].visited)
+      continue;
+
+    std::vector<Point<T>> vertices;
+    bool onSubject = true;
+    std::ptrdiff_t current = start;
+
+    do {
+      auto& list = onSubject ? subjectList : windowList;
+      auto& node = list[current];
+
+      node.visited = true;
+      vertices.push_back(node.point);
+
+      current = (current + 1) % static_cast<std::ptrdiff_t>(list.size());
+
+      // Идём по текущему списку до следующей точки пересечения.
+      while (list[current].twin < 0) {
+        vertices.push_back(list[current].point);
+        current = (current + 1) % static_cast<std::ptrdiff_t>(list.size());
+      }
+
+      list[current].visited = true;
+      current = list[current].twin;
+      onSubject = !onSubject;
+      (onSubject ? subjectList : windowList)[current].visited = true;
+    } while (!(onSubject && current == start));
+
+    detail::RemoveDegenerateVertices(&vertices, precision);
+
+    if (vertices.size() < 3 || SignedDoubleArea<T>(vertices) == 0)
+      continue;
+
+    if (subjectClockWise)
+      std::reverse(vertices.begin(), vertices.end());
+
+    result.push_back(Polygon<T, Container>(Container(vertices.begin(),
+                                                     vertices.end())));
+  }
+
+  return result;
+}
+
+/**
+ * @brief Отсечь ломаную произвольным окном.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Container Тип контейнера вершин.
+ *
+ * @param polyline Вершины ломаной.
+ * @param window Окно отсечения (простой, возможно невыпуклый многоугольник).
+ * @param precision Абсолютная точность вычислений.
+ * @return Список ломаных, из которых состоит часть исходной ломаной
+ * внутри окна.
+ *
+ * Каждое звено пересекается со всеми рёбрами окна, точки пересечения
+ * упорядочиваются вдоль звена, и звено разбивается на части, которые
+ * попеременно лежат внутри и вне окна. Звенья, идущие по границе окна,
+ * разрешаются тем же символическим сдвигом, что и в WeilerAtherton().
+ * Время работы \f$ O(nm + k \log k) \f$.
+ */
+template<typename T, typename Container>
+std::vector<Container> ClipPolyline(const Container& polyline,
+                                    const Polygon<T, Container>& window,
+                                    T precision) {
+  std::vector<Container> result;
+  std::vector<Point<T>> w(window.Vertices().begin(), window.Vertices().end());
+
+  if (polyline.empty() || w.size() < 3)
+    return result;
+
+  std::vector<Point<T>> piece;
+  bool inside = IsInsidePolygon(*polyline.begin(), w);
+
+  // Закончить очередную часть ломаной.
+  auto flush = [&]() {
+    auto equal = [precision](const Point<T>& left, const Point<T>& right) {
+      return Point<T>::IsEqual(left, right, precision);
+    };
+
+    piece.erase(std::unique(piece.begin(), piece.end(), equal), piece.end());
+
+    if (piece.size() >= 2)
+      result.push_back(Container(piece.begin(), piece.end()));
+
+    piece.clear();
+  };
+
+  if (inside)
+    piece.push_back(*polyline.begin());
+
+  for (auto it = polyline.begin(); std::next(it) != polyline.end(); ++it) {
+    Edge<T> edge(*it, *std::next(it));
+    std::vector<std::pair<detail::CrossingKey, Point<T>>> crossings;
+
+    for (size_t j = 0; j < w.size(); j++) {
+      Edge<T> windowEdge(w[j], w[(j + 1) % w.size()]);
+      detail::CrossingKey key, windowKey;
+
+      if (detail::ShiftedCross(edge, windowEdge, &key, &windowKey)) {
+        crossings.emplace_back(key, LineIntersection(edge, windowEdge,
+                                                     precision));
+      }
+    }
+
+    std::sort(crossings.begin(), crossings.end(),
+              [](const auto& left, const auto& right) {
+      return left.first < right.first;
+    });
+
+    for (const auto& crossing : crossings) {
+      piece.push_back(crossing.second);
+
+      if (inside)
+        flush();
+
+      inside = !inside;
+    }
+
+    if (inside)
+      piece.push_back(edge.Destination());
+  }
+
+  flush();
+
+  return result;
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_CLIP_POLYGON_HPP_
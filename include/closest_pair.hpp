@@ -0,0 +1,279 @@
+/**
+ * @file include/closest_pair.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Поиск ближайшей пары точек и ближайшего соседа каждой точки.
+ */
+
+#ifndef INCLUDE_CLOSEST_PAIR_HPP_
+#define INCLUDE_CLOSEST_PAIR_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <point.hpp>
+#include "kd_tree.hpp"
+#include "parallel.hpp"
+
+namespace geometry {
+
+namespace detail {
+
+/**
+ * @brief Поиск ближайшей пары методом «разделяй и властвуй».
+ *
+ * @tparam T Тип данных координат.
+ *
+ * Точки упорядочиваются по абсциссе и делятся пополам вертикальной
+ * прямой. Ближайшие пары половин ищутся рекурсивно, после чего
+ * половины сливаются по ординате, как в сортировке слиянием, и
+ * проверяется полоса ширины 2d вокруг прямой раздела: каждую точку
+ * полосы достаточно сравнить с несколькими следующими по ординате.
+ * Общее время \f$ O(n \log n) \f$. Половины верхних уровней
+ * обрабатываются в отдельных потоках.
+ */
+template<typename T>
+class ClosestPairFinder {
+ public:
+  //! Тип квадрата расстояния (как в KdTree).
+  using DistanceType = std::conditional_t<std::is_same_v<T, long double>,
+                                          long double, double>;
+
+  /**
+   * @brief Подготовить поиск.
+   *
+   * @param points Набор точек.
+   */
+  explicit ClosestPairFinder(const std::vector<Point<T>>& points);
+
+  /**
+   * @brief Найти ближайшую пару.
+   *
+   * @param threads Число потоков.
+   * @return Номера точек пары (меньший первым).
+   */
+  std::pair<size_t, size_t> Find(size_t threads);
+
+ private:
+  //! Число точек, начиная с которого половина обрабатывается
+  //! в отдельном потоке.
+  static constexpr size_t kParallelThreshold = 1 << 15;
+
+  //! Число точек, которые перебираются полностью.
+  static constexpr size_t kBruteForceSize = 3;
+
+  /**
+   * @brief Точка вместе с номером в исходном наборе.
+   */
+  struct Entry {
+    //! Точка.
+    Point<T> point;
+    //! Номер точки в исходном наборе.
+    size_t id;
+  };
+
+  /**
+   * @brief Найденная пара: квадрат расстояния и номера точек.
+   */
+  struct Candidate {
+    //! Квадрат расстояния.
+    DistanceType distance;
+    //! Номер первой точки.
+    size_t first;
+    //! Номер второй точки.
+    size_t second;
+  };
+
+  //! Точки; после обработки отрезка он упорядочен по ординате.
+  std::vector<Entry> entries;
+  //! Буфер для слияния и построения полосы.
+  std::vector<Entry> buffer;
+
+  /**
+   * @brief Вычислить квадрат расстояния между точками.
+   *
+   * @param a Первая точка.
+   * @param b Вторая точка.
+   * @return Квадрат расстояния.
+   */
+  static DistanceType Distance(const Point<T>& a, const Point<T>& b) {
+    DistanceType dx = static_cast<DistanceType>(a.X()) - b.X();
+    DistanceType dy = static_cast<DistanceType>(a.Y()) - b.Y();
+
+    return dx * dx + dy * dy;
+  }
+
+  /**
+   * @brief Обновить пару, если точки a и b ближе.
+   *
+   * @param a Первая точка.
+   * @param b Вторая точка.
+   * @param best Лучшая найденная пара.
+   */
+  static void Update(const Entry& a, const Entry& b, Candidate* best) {
+    DistanceType distance = Distance(a.point, b.point);
+
+    if (distance < best->distance)
+      *best = Candidate{distance, a.id, b.id};
+  }
+
+  /**
+   * @brief Найти ближайшую пару на отрезке и упорядочить его по ординате.
+   *
+   * @param begin Начало отрезка.
+   * @param end Конец отрезка.
+   * @param threads Число потоков, доступных для отрезка.
+   * @return Ближайшая пара отрезка.
+   */
+  Candidate Find(size_t begin, size_t end, size_t threads);
+};
+
+template<typename T>
+ClosestPairFinder<T>::ClosestPairFinder(const std::vector<Point<T>>& points) :
+    entries(points.size()),
+    buffer(points.size()) {
+  for (size_t i = 0; i < points.size(); i++)
+    entries[i] = Entry{points[i], i};
+}
+
+template<typename T>
+std::pair<size_t, size_t> ClosestPairFinder<T>::Find(size_t threads) {
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) {
+    return a.point.X() < b.point.X();
+  });
+
+  Candidate best = Find(0, entries.size(), threads);
+
+  return std::minmax(best.first, best.second);
+}
+
+template<typename T>
+typename ClosestPairFinder<T>::Candidate
+ClosestPairFinder<T>::Find(size_t begin, size_t end, size_t threads) {
+  auto lessY = [](const Entry& a, const Entry& b) {
+    return a.point.Y() < b.point.Y();
+  };
+  Candidate best{std::numeric_limits<DistanceType>::infinity(), 0, 0};
+
+  if (end - begin <= kBruteForceSize) {
+    for (size_t i = begin; i < end; i++) {
+      for (size_t j = i + 1; j < end; j++)
+        Update(entries[i], entries[j], &best);
+    }
+
+    std::sort(entries.begin() + begin, entries.begin() + end, lessY);
+
+    return best;
+  }
+
+  size_t middle = begin + (end - begin) / 2;
+  T split = entries[middle].point.X();
+  Candidate left, right;
+
+  if (threads > 1 && end - begin >= kParallelThreshold) {
+    // Левая половина обрабатывается в новом потоке, правая --- в текущем.
+    std::thread worker([this, begin, middle, threads, &left]() {
+      left = Find(begin, middle, threads / 2);
+    });
+
+    right = Find(middle, end, threads - threads / 2);
+    worker.join();
+  } else {
+    left = Find(begin, middle, 1);
+    right = Find(middle, end, 1);
+  }
+
+  best = left.distance <= right.distance ? left : right;
+
+  std::merge(entries.begin() + begin, entries.begin() + middle,
+             entries.begin() + middle, entries.begin() + end,
+             buffer.begin() + begin, lessY);
+  std::copy(buffer.begin() + begin, buffer.begin() + end,
+            entries.begin() + begin);
+
+  // Полоса строится в свободной после слияния части буфера. Точки
+  // полосы упорядочены по ординате, поэтому перебор для каждой точки
+  // прекращается, как только разность ординат достигает d.
+  size_t strip = begin;
+
+  for (size_t i = begin; i < end; i++) {
+    DistanceType dx = static_cast<DistanceType>(entries[i].point.X()) - split;
+
+    if (dx * dx < best.distance)
+      buffer[strip++] = entries[i];
+  }
+
+  for (size_t i = begin; i < strip; i++) {
+    for (size_t j = i + 1; j < strip; j++) {
+      DistanceType dy = static_cast<DistanceType>(buffer[j].point.Y()) -
+                        buffer[i].point.Y();
+
+      if (dy * dy >= best.distance)
+        break;
+
+      Update(buffer[i], buffer[j], &best);
+    }
+  }
+
+  return best;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Найти ближайшую пару точек.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param points Набор из не менее чем двух точек.
+ * @param threads Число потоков (0 означает число аппаратных потоков,
+ * большие значения ограничиваются им же).
+ * @return Номера точек пары в наборе (меньший первым).
+ *
+ * Время работы \f$ O(n \log n) \f$. Совпадающие точки образуют пару
+ * на нулевом расстоянии.
+ */
+template<typename T>
+std::pair<size_t, size_t> ClosestPair(const std::vector<Point<T>>& points,
+                                      size_t threads = 0) {
+  return detail::ClosestPairFinder<T>(points).Find(ThreadCount(threads));
+}
+
+/**
+ * @brief Найти ближайшего соседа каждой точки.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param points Набор из не менее чем двух точек.
+ * @param threads Число потоков (0 означает число аппаратных потоков,
+ * большие значения ограничиваются им же).
+ * @return Для каждой точки номер ближайшей к ней другой точки набора.
+ *
+ * Строится k-d дерево, и для каждой точки ищутся два ближайших соседа:
+ * один из них может оказаться самой точкой. Построение дерева и
+ * запросы выполняются параллельно. Ожидаемое время
+ * \f$ O(n \log n) \f$.
+ */
+template<typename T>
+std::vector<size_t> AllNearestNeighbours(const std::vector<Point<T>>& points,
+                                         size_t threads = 0) {
+  std::vector<size_t> result(points.size());
+  KdTree<T> tree(points, threads);
+
+  ParallelFor(points.size(), [&](size_t i) {
+    std::vector<size_t> nearest = tree.Nearest(points[i], 2);
+
+    result[i] = nearest[0] != i ? nearest[0] : nearest[1];
+  }, threads);
+
+  return result;
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_CLOSEST_PAIR_HPP_
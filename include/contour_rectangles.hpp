@@ -8,6 +8,7 @@
 #ifndef INCLUDE_CONTOUR_RECTANGLES_HPP_
 #define INCLUDE_CONTOUR_RECTANGLES_HPP_
 
+#include <algorithm>
 #include <iostream>
 #include <list>
 #include <utility>
@@ -55,14 +56,20 @@ template <typename T> AxisParallelEdge<T> **BuildSchedule(Rectangle<T>*,
 /**
  * @brief Строит контур объединения прямоугольников
  * @tparam T тип данных координат точек
+ * @tparam Function тип обработчика событий
  *
  * @param r Массив прямоугольников
  * @param n Их количество
+ * @param handle Функция, которая вызывается после обработки каждого
+ * события с номером прямоугольника в массиве и признаком левой стороны.
+ * Позволяет за тот же проход вычислять другие характеристики объединения
+ * (например, RectangleComponents).
  *
  * @return Указатель на список указателей на ребра контура
  */
-template <typename T>
-std::list<Edge<T> *> *ContourRectangles(Rectangle<T> r[], int n) {
+template <typename T, typename Function>
+std::list<Edge<T> *> *ContourRectangles(Rectangle<T> r[], int n,
+                                        Function handle) {
   AxisParallelEdge<T> **schedule = BuildSchedule(r, static_cast<size_t>(n));
   std::list<Edge<T> *> *segments = new std::list<Edge<T> *>;
   std::vector<AxisParallelEdge<T> *> _arr;
@@ -73,7 +80,7 @@ std::list<Edge<T> *> *ContourRectangles(Rectangle<T> r[], int n) {
                                                AxisParallelEdge<T>::T_MAX), -1);
   sweepline.Insert(new AxisParallelEdge<T>(sentinel, Side::BOTTOM_SIDE));
 
-  for (size_t i = 0; i < static_cast<size_t>(2 * n); i++)
+  for (size_t i = 0; i < static_cast<size_t>(2 * n); i++) {
     switch (schedule[i]->type) {
     case Side::LEFT_SIDE:
       schedule[i]->HandleLeftEdge(&sweepline, segments);
@@ -87,6 +94,10 @@ std::list<Edge<T> *> *ContourRectangles(Rectangle<T> r[], int n) {
       break;
     }
 
+    handle(static_cast<size_t>(schedule[i]->r - r),
+           schedule[i]->type == Side::LEFT_SIDE);
+  }
+
   delete sentinel;
   for (size_t i = 0; i < static_cast<size_t>(2 * n); i++) {
     delete schedule[i];
@@ -105,6 +116,20 @@ std::list<Edge<T> *> *ContourRectangles(Rectangle<T> r[], int n) {
   return segments;
 }
 
+/**
+ * @brief Строит контур объединения прямоугольников
+ * @tparam T тип данных координат точек
+ *
+ * @param r Массив прямоугольников
+ * @param n Их количество
+ *
+ * @return Указатель на список указателей на ребра контура
+ */
+template <typename T>
+std::list<Edge<T> *> *ContourRectangles(Rectangle<T> r[], int n) {
+  return ContourRectangles(r, n, [](size_t, bool) { });
+}
+
 template <typename T>
 AxisParallelEdge<T> **BuildSchedule(Rectangle<T> r[], size_t n) {
   AxisParallelEdge<T> **schedule = new AxisParallelEdge<T> *[2 * n];
@@ -134,10 +159,9 @@ int AxisParallelEdgeCmp(AxisParallelEdge<T> *a, AxisParallelEdge<T> *b) {
 }
 
 template <typename T> void Sort(T *arr, size_t size, int (*cmp)(T, T)) {
-  for (size_t i = 0; i < size - 1; i++)
-    for (size_t j = 0; j < size - 1; j++)
-      if (cmp(arr[j], arr[j + 1]) > 0)
-        std::swap(arr[j], arr[j + 1]);
+  // Устойчивая сортировка сохраняет порядок равных элементов таким же,
+  // как у сортировки пузырьком, но работает за O(n log n).
+  std::stable_sort(arr, arr + size, [cmp](T a, T b) { return cmp(a, b) < 0; });
 }
 
 }  // namespace geometry
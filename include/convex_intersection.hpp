@@ -0,0 +1,420 @@
+/**
+ * @file include/convex_intersection.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Пересечение выпуклых многоугольников за линейное время и быстрая
+ * проверка их пересечения по теореме о разделяющей оси.
+ */
+
+#ifndef INCLUDE_CONVEX_INTERSECTION_HPP_
+#define INCLUDE_CONVEX_INTERSECTION_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+#include <common.hpp>
+#include <point.hpp>
+#include <edge.hpp>
+#include <polygon.hpp>
+#include "clip_polygon.hpp"
+
+namespace geometry {
+
+namespace detail {
+
+/**
+ * @brief Получить вершины многоугольника против часовой стрелки.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Container Тип контейнера вершин.
+ *
+ * @param vertices Вершины многоугольника.
+ * @param clockwise Указатель, по которому записывается, были ли вершины
+ * перечислены по часовой стрелке.
+ * @return Вершины против часовой стрелки.
+ */
+template<typename T, typename Container>
+std::vector<Point<T>> CounterClockWiseVertices(const Container& vertices,
+                                               bool* clockwise) {
+  std::vector<Point<T>> result(vertices.begin(), vertices.end());
+
+  *clockwise = SignedDoubleArea<T>(vertices) < 0;
+
+  if (*clockwise)
+    std::reverse(result.begin(), result.end());
+
+  return result;
+}
+
+/**
+ * @brief Определить положение точки относительно выпуклого многоугольника.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param point Точка.
+ * @param polygon Вершины многоугольника против часовой стрелки.
+ * @param precision Абсолютная точность вычислений.
+ * @return 1, если точка лежит строго внутри, 0, если на границе, и -1,
+ * если снаружи.
+ */
+template<typename T>
+int LocateInConvex(const Point<T>& point,
+                   const std::vector<Point<T>>& polygon, T precision) {
+  int result = 1;
+
+  for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    Position position = point.Classify(polygon[j], polygon[i], precision);
+
+    if (position == Position::Right)
+      return -1;
+    if (position != Position::Left)
+      result = 0;
+  }
+
+  return result;
+}
+
+/**
+ * @brief Проверить, содержится ли один выпуклый многоугольник в другом.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param inner Вершины первого многоугольника.
+ * @param outer Вершины второго многоугольника против часовой стрелки.
+ * @param precision Абсолютная точность вычислений.
+ * @return true, если первый многоугольник лежит во втором.
+ *
+ * Предполагается, что границы многоугольников не пересекаются трансверсально.
+ * Тогда достаточно найти первую вершину inner, не лежащую на границе
+ * outer.
+ */
+template<typename T>
+bool ContainsConvex(const std::vector<Point<T>>& inner,
+                    const std::vector<Point<T>>& outer, T precision) {
+  for (const Point<T>& vertex : inner) {
+    int location = LocateInConvex(vertex, outer, precision);
+
+    if (location != 0)
+      return location > 0;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Пересечь выпуклые многоугольники алгоритмом О'Рурка.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param p Вершины первого многоугольника против часовой стрелки.
+ * @param q Вершины второго многоугольника против часовой стрелки.
+ * @param precision Абсолютная точность вычислений.
+ * @return Вершины пересечения против часовой стрелки.
+ *
+ * По границам многоугольников одновременно движутся два ребра.
+ * На каждом шаге продвигается то ребро, которое «нацелено» на прямую
+ * другого и не может пересечь её дальше по ходу обхода; вершины,
+ * пройденные внутри другого многоугольника, и точки пересечения рёбер
+ * образуют ответ. Каждая граница обходится не более двух раз, поэтому
+ * время работы \f$ O(n + m) \f$.
+ */
+template<typename T>
+std::vector<Point<T>> ConvexIntersection(const std::vector<Point<T>>& p,
+                                         const std::vector<Point<T>>& q,
+                                         T precision) {
+  // Какой многоугольник внутри другого на текущем участке границы.
+  enum class Inside { Unknown, First, Second };
+
+  size_t n = p.size(), m = q.size();
+  size_t a = 0, b = 0, advancedA = 0, advancedB = 0;
+  Inside inside = Inside::Unknown;
+  bool first = true;
+  std::vector<Point<T>> result;
+
+  auto emit = [&](const Point<T>& point) {
+    if (result.empty() || !Point<T>::IsEqual(result.back(), point, precision))
+      result.push_back(point);
+  };
+  auto advanceA = [&]() {
+    if (inside == Inside::First)
+      emit(p[a]);
+
+    a = (a + 1) % n;
+    advancedA++;
+  };
+  auto advanceB = [&]() {
+    if (inside == Inside::Second)
+      emit(q[b]);
+
+    b = (b + 1) % m;
+    advancedB++;
+  };
+
+  do {
+    Edge<T> edgeP(p[(a + n - 1) % n], p[a]);
+    Edge<T> edgeQ(q[(b + m - 1) % m], q[b]);
+    Point<T> directionP = edgeP.Destination() - edgeP.Origin();
+    Point<T> directionQ = edgeQ.Destination() - edgeQ.Origin();
+    Position turn = directionQ.Classify(Point<T>(), directionP, precision);
+    Position pSide = p[a].Classify(edgeQ, precision);
+    Position qSide = q[b].Classify(edgeP, precision);
+    T t = T();
+    Intersection crossing = edgeP.Cross(edgeQ, &t, precision);
+
+    if (crossing == Intersection::SkewCross) {
+      Point<T> point = LineIntersection(edgeP, edgeQ, precision);
+
+      if (inside == Inside::Unknown && first) {
+        advancedA = advancedB = 0;
+        first = false;
+      }
+
+      emit(point);
+
+      if (pSide == Position::Left)
+        inside = Inside::First;
+      else if (qSide == Position::Left)
+        inside = Inside::Second;
+    }
+
+    bool collinear = pSide != Position::Left && pSide != Position::Right &&
+                     qSide != Position::Left && qSide != Position::Right;
+
+    if (crossing == Intersection::Collinear && collinear &&
+        directionP * directionQ < 0) {
+      // Рёбра противоположно направлены и перекрываются: многоугольники
+      // лежат по разные стороны общей прямой и касаются по отрезку.
+      T lower = std::max(directionP * edgeP.Origin(),
+                         directionP * edgeQ.Destination());
+      T upper = std::min(directionP * edgeP.Destination(),
+                         directionP * edgeQ.Origin());
+
+      if (lower <= upper) {
+        result.clear();
+        emit(directionP * edgeP.Origin() == lower ? edgeP.Origin() :
+                                                     edgeQ.Destination());
+        emit(directionP * edgeP.Destination() == upper ?
+             edgeP.Destination() : edgeQ.Origin());
+
+        return result;
+      }
+    }
+
+    bool parallel = turn != Position::Left && turn != Position::Right;
+
+    if (parallel && pSide == Position::Right && qSide == Position::Right) {
+      // Рёбра параллельны, и многоугольники лежат по разные стороны.
+      return std::vector<Point<T>>();
+    } else if (parallel && collinear) {
+      if (inside == Inside::First)
+        advanceB();
+      else
+        advanceA();
+    } else if (turn == Position::Left || parallel) {
+      if (qSide == Position::Left)
+        advanceA();
+      else
+        advanceB();
+    } else {
+      if (pSide == Position::Left)
+        advanceB();
+      else
+        advanceA();
+    }
+  } while ((advancedA < n || advancedB < m) &&
+           advancedA < 2 * n && advancedB < 2 * m);
+
+  if (inside == Inside::Unknown) {
+    // Границы не пересекаются: один многоугольник внутри другого или
+    // они не пересекаются вовсе.
+    if (ContainsConvex(p, q, precision))
+      return p;
+    if (ContainsConvex(q, p, precision))
+      return q;
+
+    return std::vector<Point<T>>();
+  }
+
+  if (result.size() > 1 &&
+      Point<T>::IsEqual(result.front(), result.back(), precision))
+    result.pop_back();
+
+  return result;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Пересечь два выпуклых многоугольника.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Container Тип контейнера вершин.
+ *
+ * @param first Первый выпуклый многоугольник.
+ * @param second Второй выпуклый многоугольник.
+ * @param precision Абсолютная точность вычислений.
+ * @return Пересечение, ориентированное так же, как первый многоугольник.
+ *
+ * Используется алгоритм О'Рурка, время работы \f$ O(n + m) \f$.
+ * Многоугольники могут быть ориентированы как по часовой, так и против
+ * часовой стрелки. Если многоугольники не пересекаются, возвращается
+ * пустой многоугольник. Если они только касаются, результат может
+ * быть вырожденным (точкой или отрезком).
+ */
+template<typename T, typename Container>
+Polygon<T, Container> ConvexIntersection(const Polygon<T, Container>& first,
+                                         const Polygon<T, Container>& second,
+                                         T precision) {
+  if (first.Size() < 3 || second.Size() < 3)
+    return Polygon<T, Container>();
+
+  bool clockwise = false, ignored = false;
+  std::vector<Point<T>> p =
+      detail::CounterClockWiseVertices<T>(first.Vertices(), &clockwise);
+  std::vector<Point<T>> q =
+      detail::CounterClockWiseVertices<T>(second.Vertices(), &ignored);
+  std::vector<Point<T>> result = detail::ConvexIntersection(p, q, precision);
+
+  if (clockwise && !result.empty())
+    std::reverse(result.begin() + 1, result.end());
+
+  return Polygon<T, Container>(Container(result.begin(), result.end()));
+}
+
+/**
+ * @brief Многоугольник, подготовленный для проверки пересечения
+ * по теореме о разделяющей оси.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * Координаты вершин хранятся в двух отдельных массивах (x и y), поэтому
+ * проекции всех вершин на ось вычисляются простым циклом без ветвлений
+ * по двум непрерывным массивам. Вместе с вершинами хранится
+ * ограничивающий прямоугольник: его проверка отсекает большую часть
+ * непересекающихся пар до проекций на нормали рёбер.
+ */
+template<typename T>
+class ConvexSeparationShape {
+ public:
+  //! Тип вычислений (как в KdTree).
+  using ValueType = std::conditional_t<std::is_same_v<T, long double>,
+                                       long double, double>;
+
+  /**
+   * @brief Подготовить многоугольник.
+   *
+   * @tparam Container Тип контейнера вершин.
+   *
+   * @param polygon Выпуклый многоугольник с любой ориентацией.
+   */
+  template<typename Container>
+  explicit ConvexSeparationShape(const Polygon<T, Container>& polygon) {
+    bool clockwise = false;
+    std::vector<Point<T>> vertices =
+        detail::CounterClockWiseVertices<T>(polygon.Vertices(), &clockwise);
+
+    xs.reserve(vertices.size());
+    ys.reserve(vertices.size());
+
+    for (const Point<T>& vertex : vertices) {
+      xs.push_back(static_cast<ValueType>(vertex.X()));
+      ys.push_back(static_cast<ValueType>(vertex.Y()));
+    }
+
+    if (!xs.empty()) {
+      auto [minX, maxX] = std::minmax_element(xs.begin(), xs.end());
+      auto [minY, maxY] = std::minmax_element(ys.begin(), ys.end());
+
+      lower = Point<ValueType>(*minX, *minY);
+      upper = Point<ValueType>(*maxX, *maxY);
+    }
+  }
+
+  /**
+   * @brief Проверить, пересекаются ли многоугольники.
+   *
+   * @param other Второй многоугольник.
+   * @return true, если многоугольники имеют общую точку (касание
+   * считается пересечением).
+   *
+   * Проверка завершается на первой найденной разделяющей оси. Время
+   * работы в худшем случае \f$ O(nm) \f$, но каждый шаг --- это
+   * проход без ветвлений по массивам координат.
+   */
+  bool Intersects(const ConvexSeparationShape& other) const {
+    if (xs.empty() || other.xs.empty())
+      return false;
+
+    if (upper.X() < other.lower.X() || other.upper.X() < lower.X() ||
+        upper.Y() < other.lower.Y() || other.upper.Y() < lower.Y())
+      return false;
+
+    return !other.Separates(*this) && !Separates(other);
+  }
+
+ private:
+  //! Абсциссы вершин против часовой стрелки.
+  std::vector<ValueType> xs;
+  //! Ординаты вершин против часовой стрелки.
+  std::vector<ValueType> ys;
+  //! Левый нижний угол ограничивающего прямоугольника.
+  Point<ValueType> lower;
+  //! Правый верхний угол ограничивающего прямоугольника.
+  Point<ValueType> upper;
+
+  /**
+   * @brief Проверить, разделяет ли одна из сторон многоугольники.
+   *
+   * @param other Второй многоугольник.
+   * @return true, если все вершины other лежат строго снаружи одной
+   * из сторон текущего многоугольника.
+   */
+  bool Separates(const ConvexSeparationShape& other) const {
+    size_t n = xs.size(), m = other.xs.size();
+    const ValueType* otherX = other.xs.data();
+    const ValueType* otherY = other.ys.data();
+
+    for (size_t i = 0, j = n - 1; i < n; j = i++) {
+      // Внешняя нормаль стороны (j, i) многоугольника против часовой
+      // стрелки.
+      ValueType nx = ys[i] - ys[j], ny = xs[j] - xs[i];
+      ValueType ox = xs[j], oy = ys[j];
+      int touching = 0;
+
+      // Свёртка по целому флагу не требует перестановки операций
+      // с плавающей точкой, поэтому цикл допускает векторизацию.
+      for (size_t k = 0; k < m; k++)
+        touching |= nx * (otherX[k] - ox) + ny * (otherY[k] - oy) <= 0;
+
+      if (touching == 0)
+        return true;
+    }
+
+    return false;
+  }
+};
+
+/**
+ * @brief Проверить, пересекаются ли два выпуклых многоугольника.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Container Тип контейнера вершин.
+ *
+ * @param first Первый выпуклый многоугольник.
+ * @param second Второй выпуклый многоугольник.
+ * @return true, если многоугольники имеют общую точку.
+ *
+ * Если один многоугольник проверяется со многими, его выгоднее один раз
+ * подготовить как ConvexSeparationShape.
+ */
+template<typename T, typename Container>
+bool ConvexPolygonsIntersect(const Polygon<T, Container>& first,
+                             const Polygon<T, Container>& second) {
+  return ConvexSeparationShape<T>(first).Intersects(
+      ConvexSeparationShape<T>(second));
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_CONVEX_INTERSECTION_HPP_
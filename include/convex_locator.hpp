@@ -0,0 +1,309 @@
+/**
+ * @file include/convex_locator.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Структура для определения положения точек относительно выпуклого
+ * многоугольника за логарифмическое время.
+ */
+
+#ifndef INCLUDE_CONVEX_LOCATOR_HPP_
+#define INCLUDE_CONVEX_LOCATOR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+#include <exact_arithmetic.hpp>
+#include <orientation.hpp>
+#include <point.hpp>
+#include <polygon.hpp>
+#include "clip_polygon.hpp"
+#include "parallel.hpp"
+
+namespace geometry {
+
+/**
+ * @brief Выпуклый многоугольник, подготовленный для запросов положения точки.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * Вершины хранятся против часовой стрелки начиная с самой нижней левой
+ * вершины \f$ v_0 \f$, коллинеарные вершины удаляются. Лучи из \f$ v_0 \f$
+ * в остальные вершины делят многоугольник на клинья. Клин, в который
+ * попадает точка, находится двоичным поиском по знаку векторного
+ * произведения, после чего точка сравнивается с единственной стороной
+ * клина. Поэтому запрос выполняется за \f$ O(\log h) \f$ вместо
+ * \f$ O(h) \f$ при обходе всех сторон.
+ *
+ * Для целочисленных координат все предикаты точны. Вырожденные
+ * многоугольники (точка или отрезок) также поддерживаются.
+ *
+ * Запросы могут выполняться одновременно из разных потоков.
+ */
+template<typename T>
+class ConvexLocator {
+ private:
+  //! Тип, в котором хранятся координаты. Разности целочисленных координат
+  //! вычисляются в 64-битном типе без переполнения.
+  using ValueType = std::conditional_t<std::is_integral_v<T>,
+                                       std::int64_t, T>;
+
+  //! Число точек, которые пакетный запрос обрабатывает одновременно.
+  static constexpr size_t kBlockSize = 64;
+
+  //! Координаты \f$ X \f$ вершин.
+  std::vector<ValueType> xs;
+  //! Координаты \f$ Y \f$ вершин.
+  std::vector<ValueType> ys;
+
+ public:
+  /**
+   * @brief Подготовить многоугольник к запросам.
+   *
+   * @tparam Container Тип контейнера вершин.
+   *
+   * @param polygon Выпуклый многоугольник (например, результат
+   * GrahamScan()). Вершины могут быть перечислены в любом направлении.
+   */
+  template<typename Container>
+  explicit ConvexLocator(const Polygon<T, Container>& polygon);
+
+  /**
+   * @brief Получить число вершин многоугольника.
+   *
+   * Коллинеарные и совпадающие вершины не учитываются.
+   */
+  size_t Size() const { return xs.size(); }
+
+  /**
+   * @brief Определить положение точки.
+   *
+   * @param point Точка.
+   * @return 1, если точка лежит строго внутри многоугольника, 0, если
+   * на границе, и -1, если снаружи.
+   */
+  int Locate(const Point<T>& point) const;
+
+  /**
+   * @brief Проверить, принадлежит ли точка многоугольнику.
+   *
+   * @param point Точка.
+   * @return true, если точка лежит внутри или на границе.
+   */
+  bool Contains(const Point<T>& point) const { return Locate(point) >= 0; }
+
+  /**
+   * @brief Определить положение набора точек.
+   *
+   * @param points Точки.
+   * @param threads Число потоков (0 означает число аппаратных потоков).
+   * @return Положение каждой точки в том же формате, что и у Locate().
+   *
+   * Точки обрабатываются блоками по kBlockSize. Число шагов двоичного
+   * поиска зависит только от числа вершин, поэтому все точки блока
+   * проходят шаги поиска одновременно: внутренний цикл по точкам не
+   * содержит ветвлений и зависимостей между итерациями. Это позволяет
+   * перекрыть задержки обращений к памяти и векторизовать цикл.
+   */
+  std::vector<int> Locate(const std::vector<Point<T>>& points,
+                          size_t threads = 0) const;
+
+ private:
+  /**
+   * @brief Вычислить знак векторного произведения (b - a) x (c - a).
+   */
+  static int Side(ValueType ax, ValueType ay, ValueType bx, ValueType by,
+                  ValueType cx, ValueType cy) {
+    if constexpr (std::is_integral_v<T>) {
+      return ProductDifferenceSign(bx - ax, cy - ay, cx - ax, by - ay);
+    } else {
+      return Sign((bx - ax) * (cy - ay) - (cx - ax) * (by - ay));
+    }
+  }
+
+  /**
+   * @brief Знак векторного произведения (v_i - v_0) x (p - v_0).
+   */
+  int Ray(size_t i, ValueType x, ValueType y) const {
+    return Side(xs[0], ys[0], xs[i], ys[i], x, y);
+  }
+
+  /**
+   * @brief Положение точки относительно вырожденного многоугольника.
+   */
+  int LocateDegenerate(ValueType x, ValueType y) const;
+
+  /**
+   * @brief Положение точки, лежащей в клине между лучами в вершины
+   * wedge и wedge + 1.
+   */
+  int LocateInWedge(size_t wedge, ValueType x, ValueType y) const;
+};
+
+template<typename T>
+template<typename Container>
+ConvexLocator<T>::ConvexLocator(const Polygon<T, Container>& polygon) {
+  std::vector<Point<T>> vertices(polygon.Vertices().begin(),
+                                 polygon.Vertices().end());
+
+  if (vertices.empty())
+    return;
+
+  auto lowerLeft = [](const Point<T>& a, const Point<T>& b) {
+    return a.Y() < b.Y() || (a.Y() == b.Y() && a.X() < b.X());
+  };
+
+  if (SignedDoubleArea<T>(vertices) < 0)
+    std::reverse(vertices.begin(), vertices.end());
+
+  std::rotate(vertices.begin(),
+              std::min_element(vertices.begin(), vertices.end(), lowerLeft),
+              vertices.end());
+
+  // Самая нижняя левая вершина не может лежать внутри стороны, поэтому
+  // коллинеарные и совпадающие вершины удаляются одним проходом.
+  std::vector<Point<T>> hull;
+
+  for (const Point<T>& vertex : vertices) {
+    while (hull.size() >= 2 &&
+           Orientation(hull[hull.size() - 2], hull.back(), vertex, T(0)) <= 0)
+      hull.pop_back();
+
+    if (hull.empty() || !Point<T>::IsEqual(hull.back(), vertex, T(0)))
+      hull.push_back(vertex);
+  }
+
+  while (hull.size() >= 3 &&
+         Orientation(hull[hull.size() - 2], hull.back(), hull[0], T(0)) <= 0)
+    hull.pop_back();
+
+  if (hull.size() < 3) {
+    // Вырожденный многоугольник хранится как отрезок между крайними
+    // вершинами (или как одна точка).
+    auto [first, last] = std::minmax_element(vertices.begin(),
+                                             vertices.end(), lowerLeft);
+
+    hull = { *first };
+
+    if (!Point<T>::IsEqual(*first, *last, T(0)))
+      hull.push_back(*last);
+  }
+
+  xs.reserve(hull.size());
+  ys.reserve(hull.size());
+
+  for (const Point<T>& vertex : hull) {
+    xs.push_back(vertex.X());
+    ys.push_back(vertex.Y());
+  }
+}
+
+template<typename T>
+int ConvexLocator<T>::Locate(const Point<T>& point) const {
+  ValueType x = point.X(), y = point.Y();
+  size_t size = xs.size();
+
+  if (size < 3)
+    return LocateDegenerate(x, y);
+
+  if (Ray(1, x, y) < 0 || Ray(size - 1, x, y) > 0)
+    return -1;
+
+  // Ищется последний луч, относительно которого точка не лежит справа.
+  size_t wedge = 1;
+
+  for (size_t count = size - 2; count > 1; ) {
+    size_t half = count / 2;
+
+    wedge += (Ray(wedge + half, x, y) >= 0) ? half : 0;
+    count -= half;
+  }
+
+  return LocateInWedge(wedge, x, y);
+}
+
+template<typename T>
+std::vector<int> ConvexLocator<T>::Locate(const std::vector<Point<T>>& points,
+                                          size_t threads) const {
+  std::vector<int> result(points.size());
+  size_t size = xs.size();
+  size_t blocks = (points.size() + kBlockSize - 1) / kBlockSize;
+
+  if (size < 3) {
+    for (size_t i = 0; i < points.size(); i++)
+      result[i] = Locate(points[i]);
+
+    return result;
+  }
+
+  ParallelFor(blocks, [&](size_t block) {
+    size_t begin = block * kBlockSize;
+    size_t count = std::min(kBlockSize, points.size() - begin);
+    ValueType x[kBlockSize], y[kBlockSize];
+    size_t wedge[kBlockSize];
+
+    for (size_t k = 0; k < count; k++) {
+      x[k] = points[begin + k].X();
+      y[k] = points[begin + k].Y();
+      wedge[k] = 1;
+    }
+
+    for (size_t remaining = size - 2; remaining > 1; ) {
+      size_t half = remaining / 2;
+
+      for (size_t k = 0; k < count; k++)
+        wedge[k] += half * (Ray(wedge[k] + half, x[k], y[k]) >= 0);
+
+      remaining -= half;
+    }
+
+    // Точки вне угла между первым и последним лучами найденный клин
+    // не меняют, они отсекаются здесь.
+    for (size_t k = 0; k < count; k++) {
+      if (Ray(1, x[k], y[k]) < 0 || Ray(size - 1, x[k], y[k]) > 0)
+        result[begin + k] = -1;
+      else
+        result[begin + k] = LocateInWedge(wedge[k], x[k], y[k]);
+    }
+  }, threads);
+
+  return result;
+}
+
+template<typename T>
+int ConvexLocator<T>::LocateDegenerate(ValueType x, ValueType y) const {
+  if (xs.empty())
+    return -1;
+
+  if (xs.size() == 1)
+    return (x == xs[0] && y == ys[0]) ? 0 : -1;
+
+  if (Side(xs[0], ys[0], xs[1], ys[1], x, y) != 0)
+    return -1;
+
+  bool inside = std::min(xs[0], xs[1]) <= x && x <= std::max(xs[0], xs[1]) &&
+                std::min(ys[0], ys[1]) <= y && y <= std::max(ys[0], ys[1]);
+
+  return inside ? 0 : -1;
+}
+
+template<typename T>
+int ConvexLocator<T>::LocateInWedge(size_t wedge, ValueType x,
+                                    ValueType y) const {
+  int side = Side(xs[wedge], ys[wedge], xs[wedge + 1], ys[wedge + 1], x, y);
+
+  if (side <= 0)
+    return side;
+
+  // Крайние клинья ограничены сторонами многоугольника, выходящими из v_0.
+  if ((wedge == 1 && Ray(1, x, y) == 0) ||
+      (wedge == xs.size() - 2 && Ray(xs.size() - 1, x, y) == 0))
+    return 0;
+
+  return 1;
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_CONVEX_LOCATOR_HPP_
@@ -0,0 +1,338 @@
+/**
+ * @file include/coverage_depth.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Максимальная глубина покрытия плоскости набором прямоугольников.
+ */
+
+#ifndef INCLUDE_COVERAGE_DEPTH_HPP_
+#define INCLUDE_COVERAGE_DEPTH_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <point.hpp>
+#include "rectangle.h"
+#include "rectangle_intersections.hpp"
+
+namespace geometry {
+
+/**
+ * @brief Результат вычисления глубины покрытия.
+ *
+ * @tparam T Тип данных координат.
+ */
+template<typename T>
+struct RectangleCoverage {
+  //! Тип площади. Вычисления в long double заметно медленнее, поэтому
+  //! он используется только для координат типа long double.
+  using AreaType = std::conditional_t<std::is_same_v<T, long double>,
+                                      long double, double>;
+
+  //! Максимальное число прямоугольников, содержащих одну точку.
+  size_t depth = 0;
+  //! Точка, в которой достигается максимальная глубина.
+  Point<T> witness;
+  //! Площадь частей ограничивающего прямоугольника, покрытых ровно
+  //! d прямоугольниками (d от 0 до depth). Заполняется по запросу.
+  std::vector<AreaType> histogram;
+};
+
+namespace detail {
+
+/**
+ * @brief Дерево отрезков с прибавлением на отрезке и поиском максимума.
+ *
+ * Отложенные прибавления хранятся в узлах и не проталкиваются к детям:
+ * максимум узла равен его прибавлению плюс максимум из детей. Вместе
+ * с максимумом хранится номер самой левой позиции, где он достигается.
+ */
+class MaxAddTree {
+ private:
+  //! Максимум в поддереве с учётом прибавлений в нём.
+  std::vector<size_t> maximum;
+  //! Позиция максимума.
+  std::vector<size_t> position;
+  //! Прибавление ко всему отрезку узла.
+  std::vector<size_t> lazy;
+  //! Число позиций.
+  size_t size;
+
+ public:
+  /**
+   * @brief Создать дерево из size нулей.
+   */
+  explicit MaxAddTree(size_t size) :
+      maximum(4 * size, 0),
+      position(4 * size, 0),
+      lazy(4 * size, 0),
+      size(size) {
+    if (size > 0)
+      Build(1, 0, size);
+  }
+
+  /**
+   * @brief Прибавить delta к позициям [first, last).
+   *
+   * Значения хранятся без знака, вычитание выполняется прибавлением
+   * дополнения (по модулю \f$ 2^{64} \f$).
+   */
+  void Add(size_t first, size_t last, size_t delta) {
+    Add(1, 0, size, first, last, delta);
+  }
+
+  //! Максимальное значение.
+  size_t Maximum() const { return maximum[1]; }
+
+  //! Самая левая позиция максимального значения.
+  size_t Position() const { return position[1]; }
+
+ private:
+  void Build(size_t node, size_t begin, size_t end) {
+    position[node] = begin;
+
+    if (end - begin == 1)
+      return;
+
+    size_t middle = begin + (end - begin) / 2;
+
+    Build(2 * node, begin, middle);
+    Build(2 * node + 1, middle, end);
+  }
+
+  void Add(size_t node, size_t begin, size_t end, size_t first, size_t last,
+           size_t delta) {
+    if (last <= begin || end <= first)
+      return;
+
+    if (first <= begin && end <= last) {
+      lazy[node] += delta;
+      maximum[node] += delta;
+      return;
+    }
+
+    size_t middle = begin + (end - begin) / 2;
+    size_t left = 2 * node, right = 2 * node + 1;
+
+    Add(left, begin, middle, first, last, delta);
+    Add(right, middle, end, first, last, delta);
+
+    size_t best = maximum[right] > maximum[left] ? right : left;
+
+    maximum[node] = maximum[best] + lazy[node];
+    position[node] = position[best];
+  }
+};
+
+/**
+ * @brief Дерево отрезков для распределения длины по глубине покрытия.
+ *
+ * @tparam AreaType Тип длины.
+ *
+ * Листья соответствуют элементарным отрезкам между соседними
+ * координатами. Число отрезков, покрывающих узел целиком, хранится
+ * в узле и не проталкивается. Для узла хранится гистограмма: длина его
+ * отрезка, покрытая ровно d раз отрезками, добавленными в его поддерево.
+ * Обновление пересчитывает гистограммы на \f$ O(\log n) \f$ узлах, каждая
+ * за время, пропорциональное глубине.
+ */
+template<typename AreaType>
+class DepthHistogramTree {
+ private:
+  //! Длины элементарных отрезков.
+  std::vector<AreaType> lengths;
+  //! Число отрезков, покрывающих узел целиком.
+  std::vector<size_t> cover;
+  //! Гистограммы узлов.
+  std::vector<std::vector<AreaType>> histograms;
+
+ public:
+  /**
+   * @brief Создать дерево по длинам элементарных отрезков.
+   */
+  explicit DepthHistogramTree(std::vector<AreaType> lengths) :
+      lengths(std::move(lengths)),
+      cover(4 * this->lengths.size(), 0),
+      histograms(4 * this->lengths.size()) {
+    if (!this->lengths.empty())
+      Build(1, 0, this->lengths.size());
+  }
+
+  /**
+   * @brief Прибавить delta (1 или -1) к покрытию отрезков [first, last).
+   */
+  void Add(size_t first, size_t last, int delta) {
+    if (first < last)
+      Add(1, 0, lengths.size(), first, last, delta);
+  }
+
+  /**
+   * @brief Гистограмма всего отрезка.
+   */
+  const std::vector<AreaType>& Histogram() const { return histograms[1]; }
+
+ private:
+  void Build(size_t node, size_t begin, size_t end) {
+    if (end - begin > 1) {
+      size_t middle = begin + (end - begin) / 2;
+
+      Build(2 * node, begin, middle);
+      Build(2 * node + 1, middle, end);
+    }
+
+    Update(node, begin, end);
+  }
+
+  void Add(size_t node, size_t begin, size_t end, size_t first, size_t last,
+           int delta) {
+    if (last <= begin || end <= first)
+      return;
+
+    if (first <= begin && end <= last) {
+      cover[node] += delta;
+    } else {
+      size_t middle = begin + (end - begin) / 2;
+
+      Add(2 * node, begin, middle, first, last, delta);
+      Add(2 * node + 1, middle, end, first, last, delta);
+    }
+
+    Update(node, begin, end);
+  }
+
+  void Update(size_t node, size_t begin, size_t end) {
+    std::vector<AreaType>& histogram = histograms[node];
+
+    histogram.assign(cover[node], AreaType(0));
+
+    if (end - begin == 1) {
+      histogram.push_back(lengths[begin]);
+      return;
+    }
+
+    const std::vector<AreaType>& left = histograms[2 * node];
+    const std::vector<AreaType>& right = histograms[2 * node + 1];
+
+    histogram.resize(cover[node] + std::max(left.size(), right.size()), 0);
+
+    for (size_t d = 0; d < left.size(); d++)
+      histogram[cover[node] + d] += left[d];
+
+    for (size_t d = 0; d < right.size(); d++)
+      histogram[cover[node] + d] += right[d];
+
+    while (histogram.size() > 1 && histogram.back() == 0)
+      histogram.pop_back();
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Найти максимальную глубину покрытия набором прямоугольников.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param r Массив прямоугольников (sw не больше ne по обеим осям).
+ * @param n Их количество.
+ * @param histogram Вычислять ли распределение площади по глубине.
+ * @return Максимальная глубина, точка, где она достигается, и (если
+ * запрошено) гистограмма площадей.
+ *
+ * Прямоугольники считаются замкнутыми, как и в
+ * ReportRectangleIntersections(): касающиеся прямоугольники
+ * покрывают общую границу дважды. Сканирующая прямая движется по
+ * \f$ x \f$ в порядке BuildSchedule(), покрытие по \f$ y \f$ хранится
+ * в дереве отрезков по сжатым концам с отложенным прибавлением. После
+ * каждой левой стороны максимум дерева сравнивается с лучшим найденным.
+ * Время работы \f$ O(n \log n) \f$.
+ *
+ * Гистограмма вычисляется вторым деревом, в узлах которого хранится
+ * распределение длины по глубине. Она требует \f$ O(n D \log n) \f$
+ * времени, где \f$ D \f$ --- максимальная глубина, поэтому строится
+ * только по запросу.
+ */
+template<typename T>
+RectangleCoverage<T> MaxCoverageDepth(Rectangle<T> r[], size_t n,
+                                      bool histogram = false) {
+  using AreaType = typename RectangleCoverage<T>::AreaType;
+
+  RectangleCoverage<T> result;
+  std::vector<T> keys;
+
+  keys.reserve(2 * n);
+
+  for (size_t i = 0; i < n; i++) {
+    keys.push_back(r[i].sw.Y());
+    keys.push_back(r[i].ne.Y());
+  }
+
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  auto rank = [&](T value) {
+    return static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(),
+                                                value) - keys.begin());
+  };
+
+  std::vector<AreaType> lengths;
+
+  // Если все прямоугольники вырождены по y, площадь покрытия нулевая.
+  histogram = histogram && keys.size() > 1;
+
+  if (histogram) {
+    for (size_t i = 0; i + 1 < keys.size(); i++)
+      lengths.push_back(static_cast<AreaType>(keys[i + 1]) - keys[i]);
+  }
+
+  detail::MaxAddTree depth(keys.size());
+  detail::DepthHistogramTree<AreaType> slabs(std::move(lengths));
+  bool started = false;
+  T previous = T(0);
+
+  detail::SweepRectangles(r, n, [&](size_t i, bool left) {
+    size_t low = rank(r[i].sw.Y()), high = rank(r[i].ne.Y());
+    T x = left ? r[i].sw.X() : r[i].ne.X();
+
+    if (histogram) {
+      if (started) {
+        const std::vector<AreaType>& current = slabs.Histogram();
+        AreaType width = static_cast<AreaType>(x) - previous;
+
+        if (result.histogram.size() < current.size())
+          result.histogram.resize(current.size(), 0);
+
+        for (size_t d = 0; d < current.size(); d++)
+          result.histogram[d] += current[d] * width;
+      }
+
+      slabs.Add(low, high, left ? 1 : -1);
+    }
+
+    started = true;
+    previous = x;
+
+    if (!left) {
+      depth.Add(low, high + 1, static_cast<size_t>(-1));
+      return;
+    }
+
+    depth.Add(low, high + 1, 1);
+
+    if (depth.Maximum() > result.depth) {
+      result.depth = depth.Maximum();
+      result.witness = Point<T>(x, keys[depth.Position()]);
+    }
+  });
+
+  while (result.histogram.size() > 1 && result.histogram.back() == 0)
+    result.histogram.pop_back();
+
+  return result;
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_COVERAGE_DEPTH_HPP_
@@ -0,0 +1,650 @@
+/**
+ * @file include/delaunay.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Инкрементальное построение триангуляции Делоне и диаграммы Вороного.
+ */
+
+#ifndef INCLUDE_DELAUNAY_HPP_
+#define INCLUDE_DELAUNAY_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <point.hpp>
+#include "robust_predicates.hpp"
+
+namespace geometry {
+
+/**
+ * @brief Вычислить индекс точки на кривой Гильберта.
+ *
+ * @param x Первая координата (младшие 16 бит).
+ * @param y Вторая координата (младшие 16 бит).
+ * @return Номер клетки решётки \f$ 2^{16} \times 2^{16} \f$ при обходе
+ * её кривой Гильберта.
+ */
+inline uint32_t HilbertCode(uint32_t x, uint32_t y) {
+  const uint32_t side = 1U << 16;
+  uint32_t code = 0;
+
+  x &= side - 1;
+  y &= side - 1;
+
+  for (uint32_t s = side / 2; s > 0; s /= 2) {
+    uint32_t rx = (x & s) ? 1 : 0;
+    uint32_t ry = (y & s) ? 1 : 0;
+
+    code += s * s * ((3 * rx) ^ ry);
+
+    // Поворот квадранта, чтобы кривая в нём начиналась в нужном углу.
+    if (ry == 0) {
+      if (rx == 1) {
+        x = side - 1 - x;
+        y = side - 1 - y;
+      }
+
+      std::swap(x, y);
+    }
+  }
+
+  return code;
+}
+
+/**
+ * @brief Диаграмма Вороного.
+ *
+ * @tparam C Тип данных координат вершин.
+ *
+ * Вершины диаграммы --- центры описанных окружностей треугольников
+ * Делоне (i-я вершина соответствует i-му треугольнику). Ребро соединяет
+ * центры соседних треугольников. Каждому ребру выпуклой оболочки
+ * соответствует луч, выходящий из центра прилежащего треугольника
+ * во внешнюю сторону.
+ */
+template<typename C>
+struct VoronoiDiagram {
+  //! Вершины диаграммы.
+  std::vector<Point<C>> vertices;
+  //! Конечные рёбра (пары номеров вершин).
+  std::vector<std::pair<size_t, size_t>> edges;
+  //! Лучи (номер начальной вершины и направление).
+  std::vector<std::pair<size_t, Point<C>>> rays;
+};
+
+/**
+ * @brief Триангуляция Делоне.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * Точки вставляются по одной алгоритмом Боуэра--Ватсона: треугольники,
+ * описанные окружности которых содержат новую точку, удаляются,
+ * и образовавшаяся полость соединяется с точкой. Чтобы не обрабатывать
+ * вставку вне выпуклой оболочки отдельно, каждое ребро оболочки
+ * дополняется фиктивным треугольником с бесконечно удалённой вершиной.
+ *
+ * Порядок вставки --- BRIO: случайная перестановка делится на раунды
+ * геометрически растущего размера, а внутри раунда точки сортируются
+ * по кривой Гильберта. Поэтому поиск треугольника, содержащего новую
+ * точку, прямым обходом от последнего созданного треугольника делает
+ * в среднем O(1) шагов, а ожидаемое время построения равно
+ * \f$ O(n \log n) \f$.
+ *
+ * Треугольники хранятся в двух плоских массивах по три числа на
+ * треугольник: номера вершин (против часовой стрелки) и номера соседей
+ * (i-й сосед лежит напротив i-й вершины). Освободившиеся при вставке
+ * ячейки сразу занимаются новыми треугольниками.
+ *
+ * Ориентация и проверка принадлежности окружности вычисляются
+ * устойчивыми предикатами, поэтому совпадающие, коллинеарные
+ * и лежащие на одной окружности точки обрабатываются корректно.
+ * Из нескольких совпадающих точек вставляется одна (какая именно,
+ * зависит от порядка вставки), остальные не входят в треугольники.
+ */
+template<typename T>
+class DelaunayTriangulation {
+ public:
+  //! Тип данных координат вершин диаграммы Вороного.
+  using CoordinateType = std::conditional_t<std::is_same_v<T, long double>,
+                                            long double, double>;
+
+  //! Треугольник: номера вершин в исходном наборе против часовой стрелки.
+  using Triangle = std::array<size_t, 3>;
+
+  /**
+   * @brief Построить триангуляцию.
+   *
+   * @param data Набор точек (менее \f$ 2^{32} - 1 \f$ точек).
+   * @param seed Начальное значение генератора случайной перестановки.
+   *
+   * Если все точки лежат на одной прямой, триангуляция пуста.
+   */
+  explicit DelaunayTriangulation(const std::vector<Point<T>>& data,
+                                 uint32_t seed = 2022);
+
+  /**
+   * @brief Получить число треугольников.
+   * @return Число треугольников (без фиктивных).
+   */
+  size_t Size() const { return size; }
+
+  /**
+   * @brief Получить треугольники.
+   * @return Треугольники в порядке хранения.
+   */
+  std::vector<Triangle> Triangles() const;
+
+  /**
+   * @brief Построить диаграмму Вороного, двойственную триангуляции.
+   * @return Диаграмма Вороного.
+   */
+  VoronoiDiagram<CoordinateType> Voronoi() const;
+
+ private:
+  //! Номер бесконечно удалённой вершины.
+  static constexpr uint32_t kGhost = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * @brief Ребро границы полости.
+   */
+  struct BoundaryEdge {
+    //! Начало ребра.
+    uint32_t first;
+    //! Конец ребра.
+    uint32_t second;
+    //! Треугольник снаружи полости.
+    uint32_t outside;
+  };
+
+  //! Точки.
+  std::vector<Point<T>> points;
+  //! Вершины треугольников (по три на треугольник).
+  std::vector<uint32_t> corners;
+  //! Соседи треугольников (по три на треугольник).
+  std::vector<uint32_t> neighbors;
+  //! Отметки треугольников, проверенных при текущей вставке.
+  std::vector<uint32_t> marks;
+  //! Число треугольников без фиктивных.
+  size_t size = 0;
+  //! Последний созданный треугольник (начало обхода).
+  uint32_t last = 0;
+  //! Номер текущей вставки.
+  uint32_t stamp = 0;
+  //! Состояние генератора, выбирающего первое ребро при обходе.
+  uint32_t state = 1;
+  //! Треугольники полости (буфер).
+  std::vector<uint32_t> cavity;
+  //! Граница полости (буфер).
+  std::vector<BoundaryEdge> boundary;
+  //! Начала рёбер границы и новые треугольники (буфер).
+  std::vector<std::pair<uint32_t, uint32_t>> starts;
+
+  /**
+   * @brief Получить вершину треугольника.
+   *
+   * @param t Номер треугольника.
+   * @param i Номер вершины (по модулю 3).
+   * @return Номер точки.
+   */
+  uint32_t Corner(uint32_t t, unsigned i) const {
+    return corners[3 * size_t(t) + i % 3];
+  }
+
+  /**
+   * @brief Проверить, является ли треугольник фиктивным.
+   *
+   * @param t Номер треугольника.
+   * @return true, если третья вершина треугольника бесконечно удалена.
+   *
+   * У фиктивного треугольника (a, b, G) ребро ab лежит на выпуклой
+   * оболочке, а триангуляция находится справа от ab.
+   */
+  bool IsGhost(uint32_t t) const { return Corner(t, 2) == kGhost; }
+
+  /**
+   * @brief Упорядочить точки для вставки (BRIO).
+   *
+   * @param seed Начальное значение генератора.
+   * @return Номера точек в порядке вставки.
+   */
+  std::vector<uint32_t> InsertionOrder(uint32_t seed) const;
+
+  /**
+   * @brief Создать треугольник.
+   *
+   * @param a Первая вершина.
+   * @param b Вторая вершина.
+   * @param c Третья вершина.
+   * @param t Номер ячейки или kGhost, если треугольник добавляется в конец.
+   * @return Номер треугольника.
+   *
+   * Вершины циклически сдвигаются так, чтобы бесконечно удалённая
+   * вершина оказалась последней.
+   */
+  uint32_t MakeTriangle(uint32_t a, uint32_t b, uint32_t c, uint32_t t);
+
+  /**
+   * @brief Записать соседа треугольника через ребро.
+   *
+   * @param t Номер треугольника.
+   * @param first Начало ребра в порядке обхода треугольника t.
+   * @param second Конец ребра.
+   * @param neighbor Номер соседа.
+   */
+  void Link(uint32_t t, uint32_t first, uint32_t second, uint32_t neighbor);
+
+  /**
+   * @brief Найти треугольник, описанная окружность которого содержит точку.
+   *
+   * @param point Точка.
+   * @return Треугольник, содержащий точку (возможно, на границе),
+   * или фиктивный треугольник, если точка лежит вне выпуклой оболочки.
+   */
+  uint32_t Locate(const Point<T>& point);
+
+  /**
+   * @brief Проверить, конфликтует ли треугольник с точкой.
+   *
+   * @param t Номер треугольника.
+   * @param point Точка.
+   * @return true, если точка лежит строго внутри описанной окружности.
+   *
+   * Описанной окружностью фиктивного треугольника (a, b, G) считается
+   * открытая полуплоскость слева от ab вместе с внутренностью отрезка ab.
+   */
+  bool InConflict(uint32_t t, const Point<T>& point) const;
+
+  /**
+   * @brief Вставить точку.
+   *
+   * @param vertex Номер точки.
+   */
+  void Insert(uint32_t vertex);
+
+  /**
+   * @brief Вычислить центр описанной окружности треугольника.
+   *
+   * @param t Номер треугольника.
+   * @return Центр описанной окружности.
+   */
+  Point<CoordinateType> Circumcenter(uint32_t t) const;
+};
+
+template<typename T>
+DelaunayTriangulation<T>::DelaunayTriangulation(
+    const std::vector<Point<T>>& data, uint32_t seed) : points(data) {
+  std::vector<uint32_t> order = InsertionOrder(seed);
+  size_t second = 1, third = 1;
+
+  // Первый треугольник образуют первая точка, первая отличная от неё
+  // и первая не лежащая с ними на одной прямой.
+  while (second < order.size() &&
+         points[order[second]].X() == points[order[0]].X() &&
+         points[order[second]].Y() == points[order[0]].Y())
+    second++;
+
+  third = second + 1;
+
+  while (third < order.size() &&
+         RobustOrientation(points[order[0]], points[order[second]],
+                           points[order[third]]) == 0)
+    third++;
+
+  if (third >= order.size())
+    return;
+
+  uint32_t a = order[0], b = order[second], c = order[third];
+
+  if (RobustOrientation(points[a], points[b], points[c]) < 0)
+    std::swap(b, c);
+
+  order.erase(order.begin() + third);
+  order.erase(order.begin() + second);
+  order.erase(order.begin());
+
+  MakeTriangle(a, b, c, kGhost);
+  MakeTriangle(c, b, kGhost, kGhost);
+  MakeTriangle(a, c, kGhost, kGhost);
+  MakeTriangle(b, a, kGhost, kGhost);
+
+  for (uint32_t t = 0; t < 4; t++) {
+    for (uint32_t u = 0; u < 4; u++) {
+      for (unsigned i = 0; i < 3 && u != t; i++)
+        Link(t, Corner(u, i + 2), Corner(u, i + 1), u);
+    }
+  }
+
+  size = 1;
+  last = 0;
+
+  for (uint32_t vertex : order)
+    Insert(vertex);
+}
+
+template<typename T>
+std::vector<uint32_t> DelaunayTriangulation<T>::InsertionOrder(
+    uint32_t seed) const {
+  // Раунды меньше этого размера объединяются с первым раундом.
+  const size_t kMinRound = 64;
+  std::vector<uint32_t> order(points.size());
+
+  std::iota(order.begin(), order.end(), 0);
+
+  if (points.empty())
+    return order;
+
+  std::mt19937 gen(seed);
+
+  std::shuffle(order.begin(), order.end(), gen);
+
+  long double minX = points[0].X(), maxX = minX;
+  long double minY = points[0].Y(), maxY = minY;
+
+  for (const Point<T>& point : points) {
+    minX = std::min<long double>(minX, point.X());
+    maxX = std::max<long double>(maxX, point.X());
+    minY = std::min<long double>(minY, point.Y());
+    maxY = std::max<long double>(maxY, point.Y());
+  }
+
+  long double scale = std::max(maxX - minX, maxY - minY);
+
+  scale = scale > 0 ? ((1U << 16) - 1) / scale : 0;
+
+  std::vector<uint32_t> codes(points.size());
+
+  for (size_t i = 0; i < points.size(); i++) {
+    long double x = std::floor((points[i].X() - minX) * scale);
+    long double y = std::floor((points[i].Y() - minY) * scale);
+
+    // Отрицание отбрасывает NaN.
+    codes[i] = HilbertCode(!(x > 0) ? 0 : static_cast<uint32_t>(x),
+                           !(y > 0) ? 0 : static_cast<uint32_t>(y));
+  }
+
+  auto less = [&codes](uint32_t a, uint32_t b) {
+    return codes[a] < codes[b];
+  };
+
+  // Раунд [end / 2, end) вставляется после всех предыдущих.
+  for (size_t end = order.size(); end > 0; end /= 2) {
+    size_t begin = end / 2 < kMinRound ? 0 : end / 2;
+
+    std::sort(order.begin() + begin, order.begin() + end, less);
+
+    if (begin == 0)
+      break;
+  }
+
+  return order;
+}
+
+template<typename T>
+uint32_t DelaunayTriangulation<T>::MakeTriangle(uint32_t a, uint32_t b,
+                                                uint32_t c, uint32_t t) {
+  if (a == kGhost) {
+    a = b;
+    b = c;
+    c = kGhost;
+  } else if (b == kGhost) {
+    b = a;
+    a = c;
+    c = kGhost;
+  }
+
+  if (t == kGhost) {
+    t = static_cast<uint32_t>(corners.size() / 3);
+    corners.resize(corners.size() + 3);
+    neighbors.resize(neighbors.size() + 3, kGhost);
+    marks.push_back(0);
+  }
+
+  corners[3 * size_t(t)] = a;
+  corners[3 * size_t(t) + 1] = b;
+  corners[3 * size_t(t) + 2] = c;
+
+  return t;
+}
+
+template<typename T>
+void DelaunayTriangulation<T>::Link(uint32_t t, uint32_t first,
+                                    uint32_t second, uint32_t neighbor) {
+  for (unsigned i = 0; i < 3; i++) {
+    if (Corner(t, i + 1) == first && Corner(t, i + 2) == second) {
+      neighbors[3 * size_t(t) + i] = neighbor;
+      return;
+    }
+  }
+}
+
+template<typename T>
+uint32_t DelaunayTriangulation<T>::Locate(const Point<T>& point) {
+  uint32_t t = last;
+
+  if (IsGhost(t))
+    t = neighbors[3 * size_t(t) + 2];
+
+  // Прямой обход: переходим через ребро, от которого точка лежит справа.
+  // Первое проверяемое ребро выбирается случайно, чтобы обход
+  // не зацикливался.
+  while (!IsGhost(t)) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    unsigned offset = state % 3;
+    bool moved = false;
+
+    for (unsigned j = 0; j < 3 && !moved; j++) {
+      unsigned i = (offset + j) % 3;
+
+      if (RobustOrientation(points[Corner(t, i + 1)], points[Corner(t, i + 2)],
+                            point) < 0) {
+        t = neighbors[3 * size_t(t) + i];
+        moved = true;
+      }
+    }
+
+    if (!moved)
+      return t;
+  }
+
+  return t;
+}
+
+template<typename T>
+bool DelaunayTriangulation<T>::InConflict(uint32_t t,
+                                          const Point<T>& point) const {
+  const Point<T>& a = points[Corner(t, 0)];
+  const Point<T>& b = points[Corner(t, 1)];
+
+  if (!IsGhost(t))
+    return RobustInCircle(a, b, points[Corner(t, 2)], point) > 0;
+
+  int orientation = RobustOrientation(a, b, point);
+
+  if (orientation != 0)
+    return orientation > 0;
+
+  if (a.X() != b.X()) {
+    return (a.X() < point.X() && point.X() < b.X()) ||
+           (b.X() < point.X() && point.X() < a.X());
+  }
+
+  return (a.Y() < point.Y() && point.Y() < b.Y()) ||
+         (b.Y() < point.Y() && point.Y() < a.Y());
+}
+
+template<typename T>
+void DelaunayTriangulation<T>::Insert(uint32_t vertex) {
+  const Point<T>& point = points[vertex];
+  uint32_t start = Locate(point);
+
+  if (!IsGhost(start)) {
+    for (unsigned i = 0; i < 3; i++) {
+      const Point<T>& corner = points[Corner(start, i)];
+
+      if (corner.X() == point.X() && corner.Y() == point.Y())
+        return;
+    }
+  }
+
+  // Полость ищется обходом в ширину от найденного треугольника.
+  // Треугольник полости отмечается 2 * stamp, проверенный треугольник
+  // вне полости --- 2 * stamp + 1.
+  stamp++;
+
+  uint32_t inside = 2 * stamp, outside = 2 * stamp + 1;
+
+  cavity.clear();
+  boundary.clear();
+  cavity.push_back(start);
+  marks[start] = inside;
+
+  for (size_t k = 0; k < cavity.size(); k++) {
+    uint32_t t = cavity[k];
+
+    for (unsigned i = 0; i < 3; i++) {
+      uint32_t neighbor = neighbors[3 * size_t(t) + i];
+
+      if (marks[neighbor] == inside)
+        continue;
+
+      if (marks[neighbor] != outside && InConflict(neighbor, point)) {
+        marks[neighbor] = inside;
+        cavity.push_back(neighbor);
+        continue;
+      }
+
+      marks[neighbor] = outside;
+      boundary.push_back(BoundaryEdge{Corner(t, i + 1), Corner(t, i + 2),
+                                      neighbor});
+    }
+  }
+
+  for (uint32_t t : cavity)
+    size -= IsGhost(t) ? 0 : 1;
+
+  // Каждое ребро границы соединяется с точкой. Новых треугольников на два
+  // больше, чем удалённых, поэтому все ячейки полости используются снова.
+  starts.clear();
+
+  for (size_t j = 0; j < boundary.size(); j++) {
+    const BoundaryEdge& edge = boundary[j];
+    uint32_t t = MakeTriangle(edge.first, edge.second, vertex,
+                              j < cavity.size() ? cavity[j] : kGhost);
+
+    Link(t, edge.first, edge.second, edge.outside);
+    Link(edge.outside, edge.second, edge.first, t);
+    starts.emplace_back(edge.first, t);
+
+    if (!IsGhost(t)) {
+      size++;
+      last = t;
+    }
+  }
+
+  std::sort(starts.begin(), starts.end());
+
+  for (const std::pair<uint32_t, uint32_t>& entry : starts) {
+    uint32_t t = entry.second;
+    unsigned i = 0;
+
+    // Ребро (second, vertex) нового треугольника t.
+    while (Corner(t, i) == vertex || Corner(t, i + 1) != vertex)
+      i++;
+
+    uint32_t second = Corner(t, i);
+    auto next = std::lower_bound(starts.begin(), starts.end(),
+                                 std::make_pair(second, uint32_t(0)));
+
+    Link(t, second, vertex, next->second);
+    Link(next->second, vertex, second, t);
+  }
+}
+
+template<typename T>
+std::vector<typename DelaunayTriangulation<T>::Triangle>
+DelaunayTriangulation<T>::Triangles() const {
+  std::vector<Triangle> result;
+
+  result.reserve(size);
+
+  for (uint32_t t = 0; t < corners.size() / 3; t++) {
+    if (!IsGhost(t))
+      result.push_back(Triangle{Corner(t, 0), Corner(t, 1), Corner(t, 2)});
+  }
+
+  return result;
+}
+
+template<typename T>
+Point<typename DelaunayTriangulation<T>::CoordinateType>
+DelaunayTriangulation<T>::Circumcenter(uint32_t t) const {
+  using C = CoordinateType;
+
+  const Point<T>& a = points[Corner(t, 0)];
+  const Point<T>& b = points[Corner(t, 1)];
+  const Point<T>& c = points[Corner(t, 2)];
+  C bx = C(b.X()) - a.X(), by = C(b.Y()) - a.Y();
+  C cx = C(c.X()) - a.X(), cy = C(c.Y()) - a.Y();
+  C bLength = bx * bx + by * by, cLength = cx * cx + cy * cy;
+  C denominator = 2 * (bx * cy - by * cx);
+
+  return Point<C>(a.X() + (cy * bLength - by * cLength) / denominator,
+                  a.Y() + (bx * cLength - cx * bLength) / denominator);
+}
+
+template<typename T>
+VoronoiDiagram<typename DelaunayTriangulation<T>::CoordinateType>
+DelaunayTriangulation<T>::Voronoi() const {
+  using C = CoordinateType;
+
+  VoronoiDiagram<C> diagram;
+  std::vector<size_t> index(corners.size() / 3);
+
+  diagram.vertices.reserve(size);
+
+  for (uint32_t t = 0; t < index.size(); t++) {
+    if (!IsGhost(t)) {
+      index[t] = diagram.vertices.size();
+      diagram.vertices.push_back(Circumcenter(t));
+    }
+  }
+
+  for (uint32_t t = 0; t < index.size(); t++) {
+    if (IsGhost(t))
+      continue;
+
+    for (unsigned i = 0; i < 3; i++) {
+      uint32_t neighbor = neighbors[3 * size_t(t) + i];
+
+      if (IsGhost(neighbor)) {
+        // Ребро оболочки ab обходится против часовой стрелки, внешняя
+        // нормаль направлена вправо.
+        const Point<T>& a = points[Corner(t, i + 1)];
+        const Point<T>& b = points[Corner(t, i + 2)];
+
+        diagram.rays.emplace_back(index[t],
+                                  Point<C>(C(b.Y()) - a.Y(),
+                                           C(a.X()) - b.X()));
+      } else if (t < neighbor) {
+        diagram.edges.emplace_back(index[t], index[neighbor]);
+      }
+    }
+  }
+
+  return diagram;
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_DELAUNAY_HPP_
@@ -19,6 +19,10 @@ class Point;
  * @brief Класс ребра.
  *
  * @tparam T Тип данных, используемый для арифметики.
+ *
+ * Для целочисленных типов проверки параллельности, пересечения
+ * и вертикальности выполняются точно, без перехода к арифметике
+ * с плавающей точкой.
  */
 template<typename T>
 class Edge {
@@ -37,7 +41,7 @@ class Edge {
    *
    * Создаёт ребро с координатами (0, 0) и (1, 0).
    */
-  Edge();
+  constexpr Edge();
 
   /**
    * @brief Специальный конструктор для ребра.
@@ -47,31 +51,31 @@ class Edge {
    *
    * Создать ребро от одной заданной точки до другой заданной точки.
    */
-  Edge(const Point<T>& origin, const Point<T>& destination);
+  constexpr Edge(const Point<T>& origin, const Point<T>& destination);
 
   /**
    * @brief Получить точку начало ребра.
    * @return Начало ребра.
    */
-  const Point<T>& Origin() const { return origin; }
+  constexpr const Point<T>& Origin() const { return origin; }
 
   /**
    * @brief Изменить точку начало ребра.
    * @return Начало ребра.
    */
-  Point<T>& Origin() { return origin; }
+  constexpr Point<T>& Origin() { return origin; }
 
   /**
    * @brief Получить точку конца ребра.
    * @return Конец ребра.
    */
-  const Point<T>&  Destination() const { return destination; }
+  constexpr const Point<T>& Destination() const { return destination; }
 
   /**
    * @brief Получить точку конца ребра.
    * @return Конец ребра.
    */
-  Point<T>&  Destination() { return destination; }
+  constexpr Point<T>& Destination() { return destination; }
 
   /**
    * @brief Повернуть ребро по часовой стрелке на 90 градусов.
@@ -80,7 +84,7 @@ class Edge {
    * Функция поворачивает ребро по часовой стрелке на 90 градусов и возвращает
    * ссылку на текущий объект.
    */
-  Edge& Rotate();
+  constexpr Edge& Rotate();
 
   /**
    * @brief Развернуть ребро на 180 градусов.
@@ -89,7 +93,7 @@ class Edge {
    * Функция разворачивает ребро на 180 градусов и возвращает ссылку
    * на текущий объект.
    */
-  Edge& Flip();
+  constexpr Edge& Flip();
 
   /**
    * @brief Получить точку на прямой, содержащей данное ребро.
@@ -102,7 +106,7 @@ class Edge {
    *   \mathrm{origin} +  t \cdot \mathrm{destination}.
    * \f]
    */
-  Point<T> Value(T t) const;
+  constexpr Point<T> Value(T t) const;
 
   /**
    * @brief Определить, пересекаются ли две прямые, содержащие рёбра.
@@ -161,6 +165,33 @@ class Edge {
    * @return Значение \f$ Y \f$ координаты.
    */
   T Y(T x, T precision) const;
+
+ private:
+  /**
+   * @brief Точно определить, пересекаются ли две прямые, содержащие рёбра.
+   *
+   * @param edge Второе ребро.
+   * @param t В эту переменную запишется значение параметра, соответствующего
+   * точке пересечения.
+   * @return Тип пересечения.
+   *
+   * Целочисленная версия функции Intersect(). Параллельность проверяется
+   * точно, значение параметра округляется к типу T.
+   */
+  Intersection IntersectExact(const Edge& edge, T* t) const;
+
+  /**
+   * @brief Точно определить, пересекаются ли два ребра.
+   *
+   * @param edge Второе ребро.
+   * @param t В эту переменную запишется значение параметра, соответствующего
+   * точке пересечения.
+   * @return Тип пересечения.
+   *
+   * Целочисленная версия функции Cross(). Наличие пересечения определяется
+   * по знакам векторных произведений, без вычисления параметров.
+   */
+  Intersection CrossExact(const Edge& edge, T* t) const;
 };
 
 }  // namespace geometry
@@ -12,25 +12,27 @@
 #include <limits>
 #include <utility>
 #include <algorithm>
+#include <type_traits>
+#include <exact_arithmetic.hpp>
 #include <point.hpp>
 #include <edge.hpp>
 
 namespace geometry {
 
 template<typename T>
-Edge<T>::Edge() :
+constexpr Edge<T>::Edge() :
   origin(Point(T(0.0), T(0.0))),
   destination(Point(T(1.0), T(0.0)))
 { }
 
 template<typename T>
-Edge<T>::Edge(const Point<T>& origin, const Point<T>& destination) :
+constexpr Edge<T>::Edge(const Point<T>& origin, const Point<T>& destination) :
   origin(origin),
   destination(destination)
 { }
 
 template<typename T>
-Edge<T>& Edge<T>::Rotate() {
+constexpr Edge<T>& Edge<T>::Rotate() {
   Point<T> middle = T(0.5) * (origin + destination);
   Point direction = destination - origin;
   Point normal(direction.Y(), -direction.X());
@@ -42,74 +44,87 @@ Edge<T>& Edge<T>::Rotate() {
 }
 
 template<typename T>
-Edge<T>& Edge<T>::Flip() {
-  std::swap(origin, destination);
+constexpr Edge<T>& Edge<T>::Flip() {
+  Point<T> temp = origin;
+
+  origin = destination;
+  destination = temp;
 
   return *this;
 }
 
 template<typename T>
-Point<T> Edge<T>::Value(T t) const {
+constexpr Point<T> Edge<T>::Value(T t) const {
   return Point(origin + t * (destination - origin));
 }
 
 template<typename T>
 Intersection Edge<T>::Intersect(const Edge& edge, T* t, T precision) const {
-  Point<T> direction = destination - origin;
-  Point<T> otherDirection = edge.destination - edge.origin;
+  if constexpr (std::is_integral_v<T>) {
+    return IntersectExact(edge, t);
+  } else {
+    Point<T> direction = destination - origin;
+    Point<T> otherDirection = edge.destination - edge.origin;
 
-  Point<T> otherNormal = Point(otherDirection.Y(),
-      -otherDirection.X());
+    Point<T> otherNormal = Point(otherDirection.Y(),
+        -otherDirection.X());
 
-  T denominator = otherNormal * direction;
+    T denominator = otherNormal * direction;
 
-  if (std::fabs(denominator) < precision) {
-    Position type = origin.Classify(edge, precision);
+    if (std::fabs(denominator) < precision) {
+      Position type = origin.Classify(edge, precision);
 
-    if (type == Position::Left || type == Position::Right)
-      return Intersection::Parallel;
-    else
-      return Intersection::Collinear;
-  }
+      if (type == Position::Left || type == Position::Right)
+        return Intersection::Parallel;
+      else
+        return Intersection::Collinear;
+    }
 
-  T numerator = otherNormal * (origin - edge.origin);
-  *t = - numerator / denominator;
+    T numerator = otherNormal * (origin - edge.origin);
+    *t = - numerator / denominator;
 
-  return Intersection::Skew;
+    return Intersection::Skew;
+  }
 }
 
 template<typename T>
 Intersection Edge<T>::Cross(const Edge& edge, T* t, T precision) {
-  T s;
-  Intersection crossType = edge.Intersect(*this, &s, precision);
+  if constexpr (std::is_integral_v<T>) {
+    return CrossExact(edge, t);
+  } else {
+    T s;
+    Intersection crossType = edge.Intersect(*this, &s, precision);
 
-  if (crossType == Intersection::Collinear ||
-      crossType == Intersection::Parallel)
-    return crossType;
+    if (crossType == Intersection::Collinear ||
+        crossType == Intersection::Parallel)
+      return crossType;
 
-  if (s < T(0) || s > T(1))
-    return Intersection::SkewNoCross;
+    if (s < T(0) || s > T(1))
+      return Intersection::SkewNoCross;
 
-  Intersect(edge, t, precision);
+    Intersect(edge, t, precision);
 
-  if (T(0) <= *t && *t <= T(1))
-    return Intersection::SkewCross;
+    if (T(0) <= *t && *t <= T(1))
+      return Intersection::SkewCross;
 
-  return Intersection::SkewNoCross;
+    return Intersection::SkewNoCross;
+  }
 }
 
 template<typename T>
 bool Edge<T>::IsVertical(T precision) const {
-  return std::fabs(origin.X() - destination.X()) <=
-      precision * std::max(std::fabs(origin.X()), std::fabs(destination.X()));
+  if constexpr (std::is_integral_v<T>) {
+    return origin.X() == destination.X();
+  } else {
+    return std::fabs(origin.X() - destination.X()) <= precision *
+        std::max(std::fabs(origin.X()), std::fabs(destination.X()));
+  }
 }
 
 template<typename T>
 T Edge<T>::Slope(T precision) const {
-  if (std::fabs(origin.X() - destination.X()) > precision *
-      std::max(std::fabs(origin.X()), std::fabs(destination.X()))) {
+  if (!IsVertical(precision))
     return (destination.Y() - origin.Y()) / (destination.X() - origin.X());
-  }
 
   return std::numeric_limits<T>::max();
 }
@@ -119,6 +134,73 @@ T Edge<T>::Y(T x, T precision) const {
   return Slope(precision) * (x - origin.X()) + origin.Y();
 }
 
+template<typename T>
+Intersection Edge<T>::IntersectExact(const Edge& edge, T* t) const {
+  std::int64_t dx = std::int64_t(destination.X()) - origin.X();
+  std::int64_t dy = std::int64_t(destination.Y()) - origin.Y();
+  std::int64_t ex = std::int64_t(edge.destination.X()) - edge.origin.X();
+  std::int64_t ey = std::int64_t(edge.destination.Y()) - edge.origin.Y();
+
+  if (ProductDifferenceSign(ey, dx, ex, dy) == 0) {
+    Position type = origin.Classify(edge, T(0));
+
+    if (type == Position::Left || type == Position::Right)
+      return Intersection::Parallel;
+    else
+      return Intersection::Collinear;
+  }
+
+  // Разности начал рёбер в типе T могут переполниться, поэтому операнды
+  // расширяются до вычитания.
+  std::int64_t fx = std::int64_t(origin.X()) - edge.origin.X();
+  std::int64_t fy = std::int64_t(origin.Y()) - edge.origin.Y();
+
+#ifdef __SIZEOF_INT128__
+  // Числитель и знаменатель вычисляются точно, в тип T переводится только
+  // их частное (целочисленное деление округляет к нулю, как и приведение
+  // к целому типу).
+  __int128 denominator = static_cast<__int128>(ey) * dx -
+                         static_cast<__int128>(ex) * dy;
+  __int128 numerator = static_cast<__int128>(ey) * fx -
+                       static_cast<__int128>(ex) * fy;
+#else
+  long double denominator = static_cast<long double>(ey) * dx -
+                            static_cast<long double>(ex) * dy;
+  long double numerator = static_cast<long double>(ey) * fx -
+                          static_cast<long double>(ex) * fy;
+#endif
+
+  *t = static_cast<T>(-numerator / denominator);
+
+  return Intersection::Skew;
+}
+
+template<typename T>
+Intersection Edge<T>::CrossExact(const Edge& edge, T* t) const {
+  Intersection crossType = IntersectExact(edge, t);
+
+  if (crossType != Intersection::Skew)
+    return crossType;
+
+  int s0 = CrossProductSign(edge.origin.X(), edge.origin.Y(),
+                            edge.destination.X(), edge.destination.Y(),
+                            origin.X(), origin.Y());
+  int s1 = CrossProductSign(edge.origin.X(), edge.origin.Y(),
+                            edge.destination.X(), edge.destination.Y(),
+                            destination.X(), destination.Y());
+  int t0 = CrossProductSign(origin.X(), origin.Y(),
+                            destination.X(), destination.Y(),
+                            edge.origin.X(), edge.origin.Y());
+  int t1 = CrossProductSign(origin.X(), origin.Y(),
+                            destination.X(), destination.Y(),
+                            edge.destination.X(), edge.destination.Y());
+
+  if (s0 * s1 <= 0 && t0 * t1 <= 0)
+    return Intersection::SkewCross;
+
+  return Intersection::SkewNoCross;
+}
+
 }  // namespace geometry
 
 #endif  // INCLUDE_EDGE_IMPL_HPP_
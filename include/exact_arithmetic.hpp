@@ -0,0 +1,188 @@
+/**
+ * @file include/exact_arithmetic.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Точные знаковые тесты для целочисленных координат.
+ */
+
+#ifndef INCLUDE_EXACT_ARITHMETIC_HPP_
+#define INCLUDE_EXACT_ARITHMETIC_HPP_
+
+#include <cstdint>
+#include <type_traits>
+
+namespace geometry {
+
+/**
+ * @brief Вычислить знак числа.
+ *
+ * @tparam T Тип данных числа.
+ *
+ * @param value Число.
+ * @return Функция возвращает 1, если число положительно, -1, если
+ * отрицательно, и 0, если число равно нулю.
+ */
+template<typename T>
+constexpr int Sign(T value) {
+  return static_cast<int>(T(0) < value) - static_cast<int>(value < T(0));
+}
+
+namespace detail {
+
+/**
+ * @brief Вычислить модуль 64-битного числа без переполнения.
+ *
+ * @param value Число.
+ * @return Модуль числа в виде беззнакового 64-битного числа.
+ */
+constexpr std::uint64_t UnsignedAbs(std::int64_t value) {
+  return value < 0 ? std::uint64_t(0) - static_cast<std::uint64_t>(value) :
+                     static_cast<std::uint64_t>(value);
+}
+
+/**
+ * @brief Перемножить два беззнаковых 64-битных числа.
+ *
+ * @param a Первый множитель.
+ * @param b Второй множитель.
+ * @param hi В эту переменную запишутся старшие 64 бита произведения.
+ * @param lo В эту переменную запишутся младшие 64 бита произведения.
+ *
+ * Функция не использует расширений компилятора и поэтому применяется
+ * на платформах, где нет 128-битного целого типа.
+ */
+constexpr void MultiplyUnsigned(std::uint64_t a, std::uint64_t b,
+                                std::uint64_t* hi, std::uint64_t* lo) {
+  const std::uint64_t mask = 0xffffffffULL;
+  std::uint64_t p0 = (a & mask) * (b & mask);
+  std::uint64_t p1 = (a & mask) * (b >> 32);
+  std::uint64_t p2 = (a >> 32) * (b & mask);
+  std::uint64_t p3 = (a >> 32) * (b >> 32);
+  std::uint64_t middle = (p0 >> 32) + (p1 & mask) + (p2 & mask);
+
+  *lo = (p0 & mask) | (middle << 32);
+  *hi = p3 + (p1 >> 32) + (p2 >> 32) + (middle >> 32);
+}
+
+/**
+ * @brief Вычислить знак выражения a * b - c * d без 128-битного типа.
+ *
+ * @param a Первый множитель первого произведения.
+ * @param b Второй множитель первого произведения.
+ * @param c Первый множитель второго произведения.
+ * @param d Второй множитель второго произведения.
+ * @return Знак выражения.
+ */
+constexpr int PortableProductDifferenceSign(std::int64_t a, std::int64_t b,
+                                            std::int64_t c, std::int64_t d) {
+  int leftSign = Sign(a) * Sign(b);
+  int rightSign = Sign(c) * Sign(d);
+
+  if (leftSign != rightSign)
+    return leftSign > rightSign ? 1 : -1;
+
+  if (leftSign == 0)
+    return 0;
+
+  std::uint64_t leftHi = 0, leftLo = 0;
+  std::uint64_t rightHi = 0, rightLo = 0;
+
+  MultiplyUnsigned(UnsignedAbs(a), UnsignedAbs(b), &leftHi, &leftLo);
+  MultiplyUnsigned(UnsignedAbs(c), UnsignedAbs(d), &rightHi, &rightLo);
+
+  int magnitude = 0;
+
+  if (leftHi != rightHi)
+    magnitude = leftHi > rightHi ? 1 : -1;
+  else if (leftLo != rightLo)
+    magnitude = leftLo > rightLo ? 1 : -1;
+
+  return leftSign * magnitude;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Точно вычислить знак выражения a * b - c * d.
+ *
+ * @param a Первый множитель первого произведения.
+ * @param b Второй множитель первого произведения.
+ * @param c Первый множитель второго произведения.
+ * @param d Второй множитель второго произведения.
+ * @return Функция возвращает 1, если выражение положительно, -1, если
+ * отрицательно, и 0, если оно равно нулю.
+ *
+ * Произведения вычисляются со 128-битной точностью, поэтому результат
+ * точен для любых 64-битных аргументов. Функция используется
+ * целочисленными специализациями предикатов ориентации и классификации
+ * точек.
+ */
+constexpr int ProductDifferenceSign(std::int64_t a, std::int64_t b,
+                                    std::int64_t c, std::int64_t d) {
+#ifdef __SIZEOF_INT128__
+  __int128 value = static_cast<__int128>(a) * b -
+                   static_cast<__int128>(c) * d;
+
+  return Sign(value);
+#else
+  return detail::PortableProductDifferenceSign(a, b, c, d);
+#endif
+}
+
+/**
+ * @brief Вычислить разность двух целых чисел без переполнения.
+ *
+ * @tparam T Целочисленный тип.
+ *
+ * @param a Уменьшаемое.
+ * @param b Вычитаемое.
+ * @return Разность a - b в виде long double.
+ *
+ * Операнды расширяются до вычитания (до 128 бит, если такой тип есть),
+ * поэтому разность не переполняется даже для 64-битных чисел.
+ */
+template<typename T>
+constexpr long double WideDifference(T a, T b) {
+  static_assert(std::is_integral_v<T>,
+                "WideDifference() requires an integral type");
+
+#ifdef __SIZEOF_INT128__
+  return static_cast<long double>(static_cast<__int128>(a) -
+                                  static_cast<__int128>(b));
+#else
+  return static_cast<long double>(a) - static_cast<long double>(b);
+#endif
+}
+
+/**
+ * @brief Точно вычислить знак векторного произведения.
+ *
+ * @tparam T Целочисленный тип координат.
+ *
+ * @param x0 \f$ X \f$ координата начала векторов.
+ * @param y0 \f$ Y \f$ координата начала векторов.
+ * @param x1 \f$ X \f$ координата конца первого вектора.
+ * @param y1 \f$ Y \f$ координата конца первого вектора.
+ * @param x2 \f$ X \f$ координата конца второго вектора.
+ * @param y2 \f$ Y \f$ координата конца второго вектора.
+ * @return Знак векторного произведения векторов (x1 - x0, y1 - y0)
+ * и (x2 - x0, y2 - y0).
+ *
+ * Разности координат вычисляются в 64-битном типе, поэтому для 64-битных
+ * координат предполагается, что их модуль меньше \f$ 2^{62} \f$.
+ */
+template<typename T>
+constexpr int CrossProductSign(T x0, T y0, T x1, T y1, T x2, T y2) {
+  static_assert(std::is_integral_v<T>,
+                "CrossProductSign() requires an integral type");
+
+  return ProductDifferenceSign(
+      static_cast<std::int64_t>(x1) - static_cast<std::int64_t>(x0),
+      static_cast<std::int64_t>(y2) - static_cast<std::int64_t>(y0),
+      static_cast<std::int64_t>(x2) - static_cast<std::int64_t>(x0),
+      static_cast<std::int64_t>(y1) - static_cast<std::int64_t>(y0));
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_EXACT_ARITHMETIC_HPP_
@@ -0,0 +1,76 @@
+/**
+ * @file include/fixed_point.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Перевод координат на целочисленную сетку и обратно (режим фиксированной
+ * точки).
+ */
+
+#ifndef INCLUDE_FIXED_POINT_HPP_
+#define INCLUDE_FIXED_POINT_HPP_
+
+#include <cmath>
+#include <cstdint>
+
+namespace geometry {
+
+//! Целочисленный тип координат в режиме фиксированной точки.
+using FixedPointType = std::int64_t;
+
+//! Максимальный модуль координаты на сетке.
+constexpr FixedPointType kMaxFixedPointCoordinate =
+    FixedPointType(1) << 53;
+
+/**
+ * @brief Проверить, можно ли использовать число в качестве масштаба сетки.
+ *
+ * @param scale Масштаб (число узлов сетки на единицу длины).
+ * @return Функция возвращает true, если масштаб конечен и положителен.
+ */
+inline bool IsValidScale(long double scale) {
+  return std::isfinite(scale) && scale > 0;
+}
+
+/**
+ * @brief Перевести координату на целочисленную сетку.
+ *
+ * @param value Исходная координата.
+ * @param scale Масштаб (число узлов сетки на единицу длины).
+ * @param result В эту переменную запишется координата на сетке.
+ * @return Функция возвращает false, если координата не помещается на сетку.
+ *
+ * Координата умножается на масштаб и округляется до ближайшего целого.
+ * Модуль результата ограничен величиной kMaxFixedPointCoordinate, поэтому
+ * целочисленные предикаты на сетке вычисляются точно, а обратный перевод
+ * не теряет точности для типа double.
+ */
+inline bool SnapToGrid(long double value, long double scale,
+                       FixedPointType* result) {
+  long double scaled = std::round(value * scale);
+
+  if (!std::isfinite(scaled) ||
+      std::fabs(scaled) > static_cast<long double>(kMaxFixedPointCoordinate))
+    return false;
+
+  *result = static_cast<FixedPointType>(scaled);
+
+  return true;
+}
+
+/**
+ * @brief Перевести координату с целочисленной сетки обратно.
+ *
+ * @tparam T Тип данных результата.
+ *
+ * @param value Координата на сетке.
+ * @param scale Масштаб (число узлов сетки на единицу длины).
+ * @return Координата в исходных единицах.
+ */
+template<typename T>
+T FromGrid(FixedPointType value, long double scale) {
+  return static_cast<T>(static_cast<long double>(value) / scale);
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_FIXED_POINT_HPP_
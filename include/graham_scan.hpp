@@ -13,7 +13,9 @@
 #include <cstddef>
 #include <list>
 #include <algorithm>
+#include <type_traits>
 #include <common.hpp>
+#include <exact_arithmetic.hpp>
 #include <point.hpp>
 #include <polygon.hpp>
 
@@ -25,23 +27,62 @@ class Point;
 template<typename T, typename Container>
 class Polygon;
 
+/**
+ * Точное сравнение вершин по их углу для целочисленных координат.
+ *
+ * Полярный угол отсчитывается так же, как в Point::PolarAngle(): нулевой
+ * вектор меньше всех, а положительное направление оси \f$ X \f$ имеет
+ * угол 360 градусов. Углы сравниваются по полуплоскости и знаку векторного
+ * произведения, без вычисления арктангенса.
+ **/
+template<typename T>
+int polarCmpExact(const Point<T>& p, const Point<T>& q) {
+  auto halfPlane = [](const Point<T>& v) {
+    if (v.X() == 0 && v.Y() == 0)
+      return -1;
+
+    return (v.Y() > 0 || (v.Y() == 0 && v.X() < 0)) ? 0 : 1;
+  };
+
+  int pHalf = halfPlane(p);
+  int qHalf = halfPlane(q);
+
+  if (pHalf != qHalf)
+    return pHalf < qHalf;
+  if (pHalf == -1)
+    return 0;
+
+  int orientation = CrossProductSign(T(0), T(0), p.X(), p.Y(), q.X(), q.Y());
+
+  if (orientation != 0)
+    return orientation > 0;
+
+  // Вектора сонаправлены, более длинный считается меньшим.
+  return detail::UnsignedAbs(p.X()) + detail::UnsignedAbs(p.Y()) >
+         detail::UnsignedAbs(q.X()) + detail::UnsignedAbs(q.Y());
+}
+
 /**
  * Функция сравнения вершин по их углу
  **/
 template<typename T>
 int polarCmp(Point<T> p, Point<T> q) {
-  T precision = T(0.001);
-  T pPolar = p.PolarAngle(precision);
-  T qPolar = q.PolarAngle(precision);
-  long double vpl = std::sqrt(p.X() * p.X() + p.Y() * p.Y());
-  long double vql = std::sqrt(q.X() * q.X() + q.Y() * q.Y());
-  if (pPolar < qPolar) return 1;
-  if (pPolar > qPolar) return 0;
-  if (vpl < vql) return 0;
-  if (vpl > vql) return 1;
-  // return p.X() > q.X();
-  // return pPolar > qPolar;
-  return 0;
+  if constexpr (std::is_integral_v<T>) {
+    return polarCmpExact(p, q);
+  } else {
+    T precision = T(0.001);
+    T pPolar = p.PolarAngle(precision);
+    T qPolar = q.PolarAngle(precision);
+    long double vpl = std::sqrt(p.X() * p.X() + p.Y() * p.Y());
+    long double vql = std::sqrt(q.X() * q.X() + q.Y() * q.Y());
+    if (pPolar < qPolar) return 1;
+    if (pPolar > qPolar) return 0;
+    if (vpl < vql) return 0;
+    if (vpl > vql) return 1;
+    // return p.X() > q.X();
+    // return pPolar > qPolar;
+    return 0;
+  }
 }
 /*   
 Polygon *GrahamScan(Point pts[], int n){
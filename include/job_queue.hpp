@@ -0,0 +1,416 @@
+/**
+ * @file include/job_queue.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Очередь фоновых задач с опросом состояния, получением результата
+ * и отменой.
+ */
+
+#ifndef INCLUDE_JOB_QUEUE_HPP_
+#define INCLUDE_JOB_QUEUE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "thread_pool.hpp"
+
+namespace geometry {
+
+//! Состояние фоновой задачи.
+enum class JobState {
+  //! Задача ждёт в очереди.
+  kQueued,
+  //! Задача выполняется.
+  kRunning,
+  //! Задача завершилась успешно.
+  kDone,
+  //! Задача завершилась с ошибкой во входных данных.
+  kFailed,
+  //! Задача отменена.
+  kCancelled
+};
+
+/**
+ * @brief Название состояния задачи.
+ *
+ * @param state Состояние.
+ * @return Строка "queued", "running", "done", "failed" или "cancelled".
+ */
+inline const char* JobStateName(JobState state) {
+  switch (state) {
+    case JobState::kQueued:
+      return "queued";
+    case JobState::kRunning:
+      return "running";
+    case JobState::kDone:
+      return "done";
+    case JobState::kFailed:
+      return "failed";
+    case JobState::kCancelled:
+      return "cancelled";
+  }
+
+  return "unknown";
+}
+
+//! Состояние фоновой задачи вместе с оценкой выполненной части.
+struct JobStatus {
+  //! Состояние.
+  JobState state = JobState::kQueued;
+  //! Оценка выполненной части работы от 0 до 1.
+  double progress = 0;
+};
+
+/**
+ * @brief Очередь фоновых задач.
+ *
+ * Задачи выполняются собственным пулом из фиксированного числа потоков,
+ * поэтому долгие вычисления не занимают потоки, обрабатывающие запросы.
+ * Число задач, ожидающих в очереди, ограничено: если очередь заполнена,
+ * новая задача не принимается. Результаты завершённых задач хранятся,
+ * пока их не вытеснят более новые: хранится не больше retained задач,
+ * и суммарный размер их результатов не больше retainedBytes (последний
+ * результат хранится всегда, даже если он больше этого предела).
+ * Результат хранится в виде std::shared_ptr на константную строку,
+ * поэтому при получении он не копируется под блокировкой.
+ *
+ * Алгоритмы не сообщают о своём продвижении, поэтому выполненная часть
+ * оценивается по времени: для каждого вида задач запоминается скорость
+ * (объём работы в секунду) последних завершённых задач, и ожидаемое
+ * время выполнения равно объёму работы, делённому на эту скорость.
+ *
+ * Задачу из очереди отмена удаляет сразу. Выполняющуюся задачу прервать
+ * нельзя: она помечается отменённой, а её результат по завершении
+ * отбрасывается.
+ */
+class JobQueue {
+ public:
+  /**
+   * @brief Задача: записывает результат и возвращает отрицательное число
+   * в случае ошибки во входных данных.
+   */
+  using Job = std::function<int(std::string* output)>;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  //! Запись о задаче.
+  struct Entry {
+    //! Вид задачи (для оценки скорости).
+    std::string kind;
+    //! MIME тип результата.
+    std::string type;
+    //! Объём работы.
+    double work;
+    //! Задача (пустая после запуска или отмены).
+    Job job;
+    //! Состояние.
+    JobState state = JobState::kQueued;
+    //! Время запуска.
+    Clock::time_point start;
+    //! Результат.
+    std::shared_ptr<const std::string> output;
+  };
+
+  //! Мьютекс, защищающий все поля, кроме пула.
+  mutable std::mutex mutex;
+  //! Задачи по идентификаторам.
+  std::unordered_map<uint64_t, std::shared_ptr<Entry>> jobs;
+  //! Завершённые задачи в порядке завершения.
+  std::deque<uint64_t> finished;
+  //! Скорость выполнения задач каждого вида (объём работы в секунду).
+  std::map<std::string, double> rates;
+  //! Идентификатор следующей задачи.
+  uint64_t next = 1;
+  //! Число задач в очереди.
+  size_t queued = 0;
+  //! Наибольшее число задач в очереди.
+  size_t capacity;
+  //! Наибольшее число хранимых завершённых задач.
+  size_t retained;
+  //! Наибольший суммарный размер хранимых результатов.
+  size_t retainedBytes;
+  //! Суммарный размер хранимых результатов.
+  size_t bytes = 0;
+  //! Пул потоков (объявлен последним, чтобы остановиться первым).
+  ThreadPool pool;
+
+ public:
+  /**
+   * @brief Создать очередь.
+   *
+   * @param threads Число потоков, выполняющих задачи.
+   * @param capacity Наибольшее число задач, ожидающих в очереди.
+   * @param retained Наибольшее число хранимых завершённых задач.
+   * @param retainedBytes Наибольший суммарный размер их результатов.
+   */
+  JobQueue(size_t threads, size_t capacity, size_t retained = 1024,
+           size_t retainedBytes = size_t(256) << 20) :
+      capacity(capacity),
+      retained(std::max<size_t>(retained, 1)),
+      retainedBytes(retainedBytes),
+      pool(threads) { }
+
+  JobQueue(const JobQueue&) = delete;
+  JobQueue& operator=(const JobQueue&) = delete;
+
+  /**
+   * @brief Отменить задачи в очереди и дождаться выполняющихся.
+   */
+  ~JobQueue() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      for (auto& job : jobs) {
+        if (job.second->state == JobState::kQueued) {
+          job.second->state = JobState::kCancelled;
+          job.second->job = nullptr;
+        }
+      }
+    }
+
+    pool.Shutdown();
+  }
+
+  /**
+   * @brief Добавить задачу в очередь.
+   *
+   * @param kind Вид задачи. Скорость выполнения оценивается отдельно
+   * для каждого вида.
+   * @param type MIME тип результата.
+   * @param work Объём работы в произвольных единицах (например, размер
+   * входных данных).
+   * @param job Задача.
+   * @return Идентификатор задачи или 0, если очередь заполнена.
+   */
+  uint64_t Submit(const std::string& kind, const std::string& type,
+                  double work, Job job) {
+    uint64_t id = 0;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      if (queued >= capacity)
+        return 0;
+
+      auto entry = std::make_shared<Entry>();
+
+      entry->kind = kind;
+      entry->type = type;
+      entry->work = work;
+      entry->job = std::move(job);
+
+      id = next++;
+      jobs[id] = std::move(entry);
+      queued++;
+    }
+
+    if (!pool.Enqueue([this, id]() { Run(id); })) {
+      Cancel(id);
+      return 0;
+    }
+
+    return id;
+  }
+
+  /**
+   * @brief Получить состояние задачи.
+   *
+   * @param id Идентификатор задачи.
+   * @param status Состояние задачи.
+   * @return false, если задача не найдена.
+   */
+  bool Status(uint64_t id, JobStatus* status) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = jobs.find(id);
+
+    if (it == jobs.end())
+      return false;
+
+    *status = StatusOf(*it->second);
+    return true;
+  }
+
+  /**
+   * @brief Получить результат задачи.
+   *
+   * @param id Идентификатор задачи.
+   * @param status Состояние задачи.
+   * @param output Результат (только для завершённой задачи).
+   * @param type MIME тип результата.
+   * @return false, если задача не найдена.
+   *
+   * Результат остаётся доступным по указателю, даже если задачу
+   * вытеснят более новые.
+   */
+  bool Result(uint64_t id, JobStatus* status,
+              std::shared_ptr<const std::string>* output,
+              std::string* type) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = jobs.find(id);
+
+    if (it == jobs.end())
+      return false;
+
+    *status = StatusOf(*it->second);
+    *type = it->second->type;
+
+    if (status->state == JobState::kDone ||
+        status->state == JobState::kFailed)
+      *output = it->second->output;
+
+    return true;
+  }
+
+  /**
+   * @brief Отменить задачу.
+   *
+   * @param id Идентификатор задачи.
+   * @param status Состояние задачи после отмены (может быть nullptr).
+   * @return false, если задача не найдена.
+   *
+   * Завершённая задача не изменяется.
+   */
+  bool Cancel(uint64_t id, JobStatus* status = nullptr) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = jobs.find(id);
+
+    if (it == jobs.end())
+      return false;
+
+    Entry& entry = *it->second;
+
+    if (entry.state == JobState::kQueued) {
+      entry.state = JobState::kCancelled;
+      entry.job = nullptr;
+      queued--;
+      Retire(id);
+    } else if (entry.state == JobState::kRunning) {
+      entry.state = JobState::kCancelled;
+    }
+
+    if (status)
+      *status = StatusOf(entry);
+
+    return true;
+  }
+
+  //! Число задач в очереди.
+  size_t Queued() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return queued;
+  }
+
+ private:
+  void Run(uint64_t id) {
+    std::shared_ptr<Entry> entry;
+    Job job;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto it = jobs.find(id);
+
+      // Задача отменена, пока ждала в очереди.
+      if (it == jobs.end() || it->second->state != JobState::kQueued)
+        return;
+
+      entry = it->second;
+      entry->state = JobState::kRunning;
+      entry->start = Clock::now();
+      job = std::move(entry->job);
+      entry->job = nullptr;
+      queued--;
+    }
+
+    std::string output;
+    int result = -1;
+
+    // Исключение в потоке пула завершило бы программу.
+    try {
+      result = job(&output);
+    } catch (...) {
+      result = -1;
+    }
+
+    // Входные данные задачи больше не нужны.
+    job = nullptr;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    double seconds = std::chrono::duration<double>(Clock::now() -
+                                                   entry->start).count();
+
+    if (seconds > 0 && entry->work > 0) {
+      double rate = entry->work / seconds;
+      auto known = rates.find(entry->kind);
+
+      if (known == rates.end())
+        rates[entry->kind] = rate;
+      else
+        known->second = (known->second + rate) / 2;
+    }
+
+    if (entry->state == JobState::kRunning) {
+      entry->state = result < 0 ? JobState::kFailed : JobState::kDone;
+      entry->output = std::make_shared<const std::string>(std::move(output));
+    }
+
+    Retire(id);
+  }
+
+  JobStatus StatusOf(const Entry& entry) const {
+    JobStatus status;
+
+    status.state = entry.state;
+
+    if (entry.state == JobState::kDone || entry.state == JobState::kFailed) {
+      status.progress = 1;
+    } else if (entry.state == JobState::kRunning) {
+      auto rate = rates.find(entry.kind);
+
+      // Пока не завершилась ни одна задача этого вида, скорость неизвестна.
+      if (rate != rates.end() && entry.work > 0) {
+        double seconds = std::chrono::duration<double>(Clock::now() -
+                                                       entry.start).count();
+
+        status.progress = std::min(seconds * rate->second / entry.work, 0.99);
+      }
+    }
+
+    return status;
+  }
+
+  void Retire(uint64_t id) {
+    finished.push_back(id);
+    bytes += OutputSize(id);
+
+    while (finished.size() > retained ||
+           (finished.size() > 1 && bytes > retainedBytes)) {
+      bytes -= OutputSize(finished.front());
+      jobs.erase(finished.front());
+      finished.pop_front();
+    }
+  }
+
+  size_t OutputSize(uint64_t id) const {
+    auto it = jobs.find(id);
+
+    if (it == jobs.end() || !it->second->output)
+      return 0;
+
+    return it->second->output->size();
+  }
+};
+
+}  // namespace geometry
+
+#endif  // INCLUDE_JOB_QUEUE_HPP_
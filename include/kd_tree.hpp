@@ -0,0 +1,338 @@
+/**
+ * @file include/kd_tree.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Статическое k-d дерево для поиска ближайших соседей.
+ */
+
+#ifndef INCLUDE_KD_TREE_HPP_
+#define INCLUDE_KD_TREE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <point.hpp>
+#include "parallel.hpp"
+
+namespace geometry {
+
+/**
+ * @brief Статическое k-d дерево.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * Дерево хранится неявно в одном массиве точек: корнем отрезка
+ * [begin, end) является его середина, левое поддерево занимает отрезок
+ * слева от середины, правое --- справа. Отрезки длины не больше
+ * kLeafSize являются листьями и просматриваются целиком. Кроме точек
+ * для каждого узла хранится только номер координаты разбиения, поэтому
+ * дерево не выполняет выделений памяти на узел.
+ *
+ * Дерево строится разбиением по медиане (std::nth_element) вдоль
+ * координаты с наибольшим разбросом. Поддеревья верхних уровней строятся
+ * в отдельных потоках.
+ *
+ * Запросы возвращают номера точек в исходном наборе и могут выполняться
+ * одновременно из разных потоков.
+ */
+template<typename T>
+class KdTree {
+ private:
+  //! Максимальное число точек в листе.
+  static constexpr size_t kLeafSize = 8;
+
+  //! Число точек, начиная с которого поддерево строится в отдельном потоке.
+  static constexpr size_t kParallelThreshold = 1 << 15;
+
+  /**
+   * @brief Точка вместе с номером в исходном наборе.
+   */
+  struct Entry {
+    //! Точка.
+    Point<T> point;
+    //! Номер точки в исходном наборе.
+    size_t id;
+  };
+
+  //! Тип квадрата расстояния. Вычисления в long double заметно медленнее,
+  //! поэтому он используется только для координат типа long double.
+  using DistanceType = std::conditional_t<std::is_same_v<T, long double>,
+                                          long double, double>;
+
+  //! Элемент кучи найденных соседей: квадрат расстояния и номер точки.
+  using Candidate = std::pair<DistanceType, size_t>;
+
+  //! Точки в порядке неявного дерева.
+  std::vector<Entry> entries;
+  //! Координата разбиения для каждого узла (по номеру середины отрезка).
+  std::vector<uint8_t> axes;
+
+ public:
+  /**
+   * @brief Построить дерево.
+   *
+   * @param points Набор точек.
+   * @param threads Число потоков (0 означает число аппаратных потоков,
+   * большие значения ограничиваются им же).
+   *
+   * Время построения \f$ O(n \log n) \f$.
+   */
+  explicit KdTree(const std::vector<Point<T>>& points, size_t threads = 0);
+
+  /**
+   * @brief Получить число точек в дереве.
+   * @return Число точек.
+   */
+  size_t Size() const { return entries.size(); }
+
+  /**
+   * @brief Найти k ближайших соседей точки.
+   *
+   * @param query Точка запроса.
+   * @param k Число соседей.
+   * @param epsilon Допустимая относительная погрешность.
+   * @return Номера точек в порядке возрастания расстояния.
+   *
+   * При epsilon = 0 поиск точный. При epsilon > 0 поддерево
+   * отбрасывается, если оно дальше, чем d / (1 + epsilon), где d ---
+   * расстояние до k-го найденного соседа. Тогда расстояние до i-го
+   * найденного соседа превосходит расстояние до истинного i-го соседа
+   * не более чем в (1 + epsilon) раз.
+   */
+  std::vector<size_t> Nearest(const Point<T>& query, size_t k,
+                              double epsilon = 0) const;
+
+  /**
+   * @brief Найти точки, лежащие в круге.
+   *
+   * @tparam OutputIterator Тип итератора вывода.
+   *
+   * @param query Центр круга.
+   * @param radius Радиус круга (граница включается).
+   * @param output Итератор, в который записываются номера точек.
+   * @return Итератор вывода после записи результата.
+   */
+  template<typename OutputIterator>
+  OutputIterator Radius(const Point<T>& query, T radius,
+                        OutputIterator output) const {
+    DistanceType bound = static_cast<DistanceType>(radius) * radius;
+
+    return Radius(0, entries.size(), query, bound, output);
+  }
+
+ private:
+  /**
+   * @brief Построить поддерево.
+   *
+   * @param begin Начало отрезка.
+   * @param end Конец отрезка.
+   * @param threads Число потоков, доступных для построения поддерева.
+   */
+  void Build(size_t begin, size_t end, size_t threads);
+
+  /**
+   * @brief Вычислить квадрат расстояния между точками.
+   *
+   * @param a Первая точка.
+   * @param b Вторая точка.
+   * @return Квадрат расстояния.
+   */
+  static DistanceType Distance(const Point<T>& a, const Point<T>& b) {
+    DistanceType dx = static_cast<DistanceType>(a.X()) - b.X();
+    DistanceType dy = static_cast<DistanceType>(a.Y()) - b.Y();
+
+    return dx * dx + dy * dy;
+  }
+
+  /**
+   * @brief Рекурсивный поиск ближайших соседей.
+   *
+   * @param begin Начало отрезка.
+   * @param end Конец отрезка.
+   * @param query Точка запроса.
+   * @param k Число соседей.
+   * @param shrink Множитель \f$ 1 / (1 + \varepsilon)^2 \f$.
+   * @param best Куча найденных соседей (наиболее далёкий на вершине).
+   */
+  void Nearest(size_t begin, size_t end, const Point<T>& query, size_t k,
+               DistanceType shrink,
+               std::priority_queue<Candidate>* best) const;
+
+  /**
+   * @brief Рекурсивный поиск точек в круге.
+   *
+   * @tparam OutputIterator Тип итератора вывода.
+   *
+   * @param begin Начало отрезка.
+   * @param end Конец отрезка.
+   * @param query Центр круга.
+   * @param bound Квадрат радиуса.
+   * @param output Итератор, в который записываются номера точек.
+   * @return Итератор вывода после записи результата.
+   */
+  template<typename OutputIterator>
+  OutputIterator Radius(size_t begin, size_t end, const Point<T>& query,
+                        DistanceType bound, OutputIterator output) const {
+    if (end - begin <= kLeafSize) {
+      for (size_t i = begin; i < end; i++) {
+        if (Distance(entries[i].point, query) <= bound)
+          *output++ = entries[i].id;
+      }
+
+      return output;
+    }
+
+    size_t middle = begin + (end - begin) / 2;
+    const Point<T>& split = entries[middle].point;
+    DistanceType difference = static_cast<DistanceType>(query[axes[middle]]) -
+                              split[axes[middle]];
+
+    if (Distance(split, query) <= bound)
+      *output++ = entries[middle].id;
+
+    if (difference <= 0 || difference * difference <= bound)
+      output = Radius(begin, middle, query, bound, output);
+    if (difference >= 0 || difference * difference <= bound)
+      output = Radius(middle + 1, end, query, bound, output);
+
+    return output;
+  }
+};
+
+template<typename T>
+KdTree<T>::KdTree(const std::vector<Point<T>>& points, size_t threads) :
+    entries(points.size()),
+    axes(points.size()) {
+  for (size_t i = 0; i < points.size(); i++)
+    entries[i] = Entry{points[i], i};
+
+  Build(0, entries.size(), ThreadCount(threads));
+}
+
+template<typename T>
+void KdTree<T>::Build(size_t begin, size_t end, size_t threads) {
+  if (end - begin <= kLeafSize)
+    return;
+
+  T minX = entries[begin].point.X(), maxX = minX;
+  T minY = entries[begin].point.Y(), maxY = minY;
+
+  for (size_t i = begin + 1; i < end; i++) {
+    minX = std::min(minX, entries[i].point.X());
+    maxX = std::max(maxX, entries[i].point.X());
+    minY = std::min(minY, entries[i].point.Y());
+    maxY = std::max(maxY, entries[i].point.Y());
+  }
+
+  uint8_t axis = static_cast<DistanceType>(maxX) - minX >=
+                 static_cast<DistanceType>(maxY) - minY ? 0 : 1;
+  size_t middle = begin + (end - begin) / 2;
+
+  std::nth_element(entries.begin() + begin, entries.begin() + middle,
+                   entries.begin() + end,
+                   [axis](const Entry& a, const Entry& b) {
+    return a.point[axis] < b.point[axis];
+  });
+
+  axes[middle] = axis;
+
+  if (threads > 1 && end - begin >= kParallelThreshold) {
+    // Левое поддерево строится в новом потоке, правое --- в текущем.
+    std::thread left([this, begin, middle, threads]() {
+      Build(begin, middle, threads / 2);
+    });
+
+    Build(middle + 1, end, threads - threads / 2);
+    left.join();
+  } else {
+    Build(begin, middle, 1);
+    Build(middle + 1, end, 1);
+  }
+}
+
+template<typename T>
+std::vector<size_t> KdTree<T>::Nearest(const Point<T>& query, size_t k,
+                                       double epsilon) const {
+  std::vector<size_t> result;
+
+  if (k == 0 || entries.empty())
+    return result;
+
+  // Больше, чем точек в дереве, соседей не бывает, а k может прийти
+  // из запроса клиента.
+  k = std::min(k, entries.size());
+
+  std::vector<Candidate> storage;
+
+  storage.reserve(k + 1);
+
+  std::priority_queue<Candidate> best(std::less<Candidate>(),
+                                      std::move(storage));
+  DistanceType shrink = 1 / ((1 + static_cast<DistanceType>(epsilon)) *
+                             (1 + static_cast<DistanceType>(epsilon)));
+
+  Nearest(0, entries.size(), query, k, shrink, &best);
+
+  result.resize(best.size());
+
+  for (size_t i = result.size(); i > 0; i--) {
+    result[i - 1] = entries[best.top().second].id;
+    best.pop();
+  }
+
+  return result;
+}
+
+template<typename T>
+void KdTree<T>::Nearest(size_t begin, size_t end, const Point<T>& query,
+                        size_t k, DistanceType shrink,
+                        std::priority_queue<Candidate>* best) const {
+  auto consider = [&](size_t i) {
+    Candidate candidate(Distance(entries[i].point, query), i);
+
+    if (best->size() < k) {
+      best->push(candidate);
+    } else if (candidate < best->top()) {
+      best->pop();
+      best->push(candidate);
+    }
+  };
+
+  if (end - begin <= kLeafSize) {
+    for (size_t i = begin; i < end; i++)
+      consider(i);
+
+    return;
+  }
+
+  size_t middle = begin + (end - begin) / 2;
+  uint8_t axis = axes[middle];
+  DistanceType difference = static_cast<DistanceType>(query[axis]) -
+                            entries[middle].point[axis];
+
+  consider(middle);
+
+  // Сначала обходится поддерево, содержащее точку запроса.
+  if (difference <= 0) {
+    Nearest(begin, middle, query, k, shrink, best);
+
+    if (best->size() < k ||
+        difference * difference < best->top().first * shrink)
+      Nearest(middle + 1, end, query, k, shrink, best);
+  } else {
+    Nearest(middle + 1, end, query, k, shrink, best);
+
+    if (best->size() < k ||
+        difference * difference < best->top().first * shrink)
+      Nearest(begin, middle, query, k, shrink, best);
+  }
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_KD_TREE_HPP_
@@ -0,0 +1,183 @@
+/**
+ * @file include/minkowski_sum.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Сумма Минковского выпуклых многоугольников слиянием рёбер.
+ */
+
+#ifndef INCLUDE_MINKOWSKI_SUM_HPP_
+#define INCLUDE_MINKOWSKI_SUM_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+#include <point.hpp>
+#include <polygon.hpp>
+#include "clip_polygon.hpp"
+#include "parallel.hpp"
+#include "robust_predicates.hpp"
+
+namespace geometry {
+
+/**
+ * @brief Подготовленное слагаемое суммы Минковского.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * Вершины выпуклого многоугольника переупорядочиваются против часовой
+ * стрелки, начиная с нижней (а среди нижних --- левой) вершины. Тогда
+ * рёбра многоугольника упорядочены по полярному углу, и сумма с другим
+ * выпуклым многоугольником получается слиянием двух последовательностей
+ * рёбер, как в сортировке слиянием, за \f$ O(n + m) \f$.
+ *
+ * Подготовка выполняется один раз, поэтому одно слагаемое можно
+ * складывать со многими многоугольниками. Функция Sum() может
+ * вызываться одновременно из разных потоков.
+ */
+template<typename T>
+class MinkowskiSummand {
+ public:
+  /**
+   * @brief Подготовить слагаемое.
+   *
+   * @tparam Container Тип контейнера вершин.
+   *
+   * @param polygon Выпуклый многоугольник, ориентированный по или
+   * против часовой стрелки.
+   */
+  template<typename Container>
+  explicit MinkowskiSummand(const Polygon<T, Container>& polygon) :
+      clockwise(SignedDoubleArea<T>(polygon.Vertices()) < 0),
+      vertices(Normalize(polygon.Vertices())) { }
+
+  /**
+   * @brief Сложить слагаемое с многоугольником.
+   *
+   * @tparam Container Тип контейнера вершин.
+   *
+   * @param other Выпуклый многоугольник.
+   * @return Сумма Минковского. Она ориентирована так же, как
+   * подготовленное слагаемое, и начинается с нижней левой вершины.
+   *
+   * Рёбра, параллельные и сонаправленные в обоих многоугольниках,
+   * сливаются в одно ребро суммы.
+   */
+  template<typename Container>
+  Polygon<T, Container> Sum(const Polygon<T, Container>& other) const {
+    std::vector<Point<T>> second = Normalize(other.Vertices());
+    std::vector<Point<T>> result;
+    size_t n = vertices.size(), m = second.size();
+
+    if (n == 0 || m == 0)
+      return Polygon<T, Container>();
+
+    result.reserve(n + m);
+
+    for (size_t i = 0, j = 0; i < n || j < m;) {
+      const Point<T>& a = vertices[i % n];
+      const Point<T>& b = second[j % m];
+
+      result.push_back(a + b);
+
+      // Знак векторного произведения очередных рёбер показывает,
+      // какое из них идёт раньше по полярному углу.
+      int turn = i == n ? -1 : j == m ? 1 :
+                 RobustOrientation(Point<T>(),
+                                   vertices[(i + 1) % n] - a,
+                                   second[(j + 1) % m] - b);
+
+      if (turn >= 0)
+        i++;
+      if (turn <= 0)
+        j++;
+    }
+
+    if (clockwise)
+      std::reverse(result.begin() + 1, result.end());
+
+    return Polygon<T, Container>(Container(result.begin(), result.end()));
+  }
+
+ private:
+  //! Было ли слагаемое ориентировано по часовой стрелке.
+  bool clockwise;
+  //! Вершины против часовой стрелки, начиная с нижней левой.
+  std::vector<Point<T>> vertices;
+
+  /**
+   * @brief Переупорядочить вершины многоугольника.
+   *
+   * @tparam Container Тип контейнера вершин.
+   *
+   * @param polygon Вершины выпуклого многоугольника.
+   * @return Вершины против часовой стрелки, начиная с нижней левой.
+   */
+  template<typename Container>
+  static std::vector<Point<T>> Normalize(const Container& polygon) {
+    std::vector<Point<T>> result(polygon.begin(), polygon.end());
+
+    if (SignedDoubleArea<T>(polygon) < 0)
+      std::reverse(result.begin(), result.end());
+
+    auto lowest = std::min_element(result.begin(), result.end(),
+                                   [](const Point<T>& a, const Point<T>& b) {
+      return a.Y() < b.Y() || (a.Y() == b.Y() && a.X() < b.X());
+    });
+
+    std::rotate(result.begin(), lowest, result.end());
+
+    return result;
+  }
+};
+
+/**
+ * @brief Вычислить сумму Минковского двух выпуклых многоугольников.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Container Тип контейнера вершин.
+ *
+ * @param first Первый выпуклый многоугольник.
+ * @param second Второй выпуклый многоугольник.
+ * @return Сумма Минковского, ориентированная так же, как первый
+ * многоугольник.
+ *
+ * Время работы \f$ O(n + m) \f$.
+ */
+template<typename T, typename Container>
+Polygon<T, Container> MinkowskiSum(const Polygon<T, Container>& first,
+                                   const Polygon<T, Container>& second) {
+  return MinkowskiSummand<T>(first).Sum(second);
+}
+
+/**
+ * @brief Сложить выпуклый многоугольник с каждым из набора.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Container Тип контейнера вершин.
+ *
+ * @param first Выпуклый многоугольник.
+ * @param others Выпуклые многоугольники.
+ * @param threads Число потоков (0 означает число аппаратных потоков).
+ * @return Суммы Минковского в порядке набора others.
+ *
+ * Многоугольник first подготавливается один раз, суммы вычисляются
+ * параллельно.
+ */
+template<typename T, typename Container>
+std::vector<Polygon<T, Container>> MinkowskiSum(
+    const Polygon<T, Container>& first,
+    const std::vector<Polygon<T, Container>>& others,
+    size_t threads = 0) {
+  MinkowskiSummand<T> summand(first);
+  std::vector<Polygon<T, Container>> result(others.size());
+
+  ParallelFor(others.size(), [&](size_t i) {
+    result[i] = summand.Sum(others[i]);
+  }, threads);
+
+  return result;
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_MINKOWSKI_SUM_HPP_
@@ -8,7 +8,9 @@
 #ifndef INCLUDE_ORIENTATION_HPP_
 #define INCLUDE_ORIENTATION_HPP_
 
+#include <type_traits>
 #include <point.hpp>
+#include <exact_arithmetic.hpp>
 
 namespace geometry {
 
@@ -27,22 +29,31 @@ namespace geometry {
  * В случае, если вектора положительно ориентированы, функция возвращает 1,
  * если отрицательно ориентированы, то функция возвращает -1 и функция
  * возвращает 0, если вектора коллинеарны.
+ *
+ * Для целочисленных типов ориентация вычисляется точно (без переполнения
+ * и без перехода к числам с плавающей точкой), параметр precision
+ * игнорируется. Функция может вычисляться на этапе компиляции.
  */
 template<typename ValueType>
-int Orientation(const Point<ValueType>& pt0,
-                const Point<ValueType>& pt1,
-                const Point<ValueType>& pt2,
-                ValueType precision) {
-  Point a = pt1 - pt0;
-  Point b = pt2 - pt0;
-  ValueType sa = a.X() * b.Y() - b.X() * a.Y();
-
-  if (sa > precision)
-    return 1;
-  else if (sa < -precision)
-    return -1;
-
-  return 0;
+constexpr int Orientation(const Point<ValueType>& pt0,
+                          const Point<ValueType>& pt1,
+                          const Point<ValueType>& pt2,
+                          ValueType precision) {
+  if constexpr (std::is_integral_v<ValueType>) {
+    return CrossProductSign(pt0.X(), pt0.Y(), pt1.X(), pt1.Y(),
+                            pt2.X(), pt2.Y());
+  } else {
+    Point a = pt1 - pt0;
+    Point b = pt2 - pt0;
+    ValueType sa = a.X() * b.Y() - b.X() * a.Y();
+
+    if (sa > precision)
+      return 1;
+    else if (sa < -precision)
+      return -1;
+
+    return 0;
+  }
 }
 
 }  // namespace geometry
@@ -0,0 +1,112 @@
+/**
+ * @file include/parallel.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Простейшие средства для параллельной обработки независимых задач.
+ */
+
+#ifndef INCLUDE_PARALLEL_HPP_
+#define INCLUDE_PARALLEL_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace geometry {
+
+/**
+ * @brief Получить число потоков по умолчанию.
+ * @return Число аппаратных потоков (не меньше 1).
+ */
+inline size_t DefaultThreadCount() {
+  return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Ограничить запрошенное число потоков.
+ *
+ * @param threads Запрошенное число потоков (0 означает число аппаратных
+ * потоков).
+ * @return Число потоков от 1 до DefaultThreadCount().
+ *
+ * Число потоков часто приходит из запроса клиента, поэтому оно не может
+ * превышать число аппаратных потоков.
+ */
+inline size_t ThreadCount(size_t threads) {
+  size_t hardware = DefaultThreadCount();
+
+  return threads == 0 ? hardware : std::min(threads, hardware);
+}
+
+/**
+ * @brief Выполнить функцию для каждого номера из диапазона параллельно.
+ *
+ * @tparam Function Тип функции.
+ *
+ * @param count Число задач.
+ * @param function Функция, принимающая номер задачи.
+ * @param threads Число потоков (0 означает число аппаратных потоков,
+ * большие значения ограничиваются им же, см. ThreadCount()).
+ *
+ * Диапазон делится на непрерывные отрезки примерно одинаковой длины,
+ * каждый отрезок обрабатывается отдельным потоком. Функция должна быть
+ * безопасна для одновременного вызова с разными номерами.
+ *
+ * Если функция выбрасывает исключение, поток прекращает обработку своего
+ * отрезка. После завершения всех потоков первое по номеру отрезка
+ * исключение повторно выбрасывается в вызывающем потоке.
+ */
+template<typename Function>
+void ParallelFor(size_t count, Function function, size_t threads = 0) {
+  threads = std::min(ThreadCount(threads), count);
+
+  if (threads <= 1) {
+    for (size_t i = 0; i < count; i++)
+      function(i);
+
+    return;
+  }
+
+  std::vector<std::thread> workers;
+  std::vector<std::exception_ptr> errors(threads);
+  size_t chunk = (count + threads - 1) / threads;
+
+  // Исключение в потоке завершило бы программу, поэтому каждый поток
+  // запоминает своё первое исключение и прекращает работу.
+  auto run = [&function, &errors](size_t worker, size_t first, size_t last) {
+    try {
+      for (size_t i = first; i < last; i++)
+        function(i);
+    } catch (...) {
+      errors[worker] = std::current_exception();
+    }
+  };
+
+  workers.reserve(threads);
+
+  for (size_t worker = 0, first = 0; first < count; worker++, first += chunk) {
+    size_t last = std::min(first + chunk, count);
+
+    try {
+      workers.emplace_back(run, worker, first, last);
+    } catch (const std::system_error&) {
+      // Поток не удалось запустить: отрезок обрабатывается в текущем.
+      run(worker, first, last);
+    }
+  }
+
+  for (std::thread& worker : workers)
+    worker.join();
+
+  for (const std::exception_ptr& error : errors) {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_PARALLEL_HPP_
@@ -9,9 +9,12 @@
 #define INCLUDE_POINT_HPP_
 
 #include <cmath>
+#include <cstdint>
 #include <utility>
 #include <algorithm>
+#include <type_traits>
 #include <common.hpp>
+#include <exact_arithmetic.hpp>
 
 namespace geometry {
 
@@ -22,6 +25,10 @@ class Edge;
  * @brief Класс точки.
  *
  * @tparam T Тип данных, используемый для арифметики.
+ *
+ * Арифметические операции над точками доступны на этапе компиляции.
+ * Для целочисленных типов предикаты сравнения и классификации вычисляются
+ * точно, параметр precision в этом случае игнорируется.
  */
 template<typename T>
 class Point {
@@ -38,34 +45,31 @@ class Point {
    * @param x \f$ X \f$ координата точки.
    * @param y \f$ Y \f$ координита точки.
    */
-  explicit Point(T x = 0, T y = 0) noexcept {
-    data[0] = x;
-    data[1] = y;
-  }
+  explicit constexpr Point(T x = 0, T y = 0) noexcept : data{x, y} { }
 
   /**
    * @brief Получить значение \f$ X \f$ координаты.
    * @return \f$ X \f$ координата.
    */
-  T X() const { return data[0]; }
+  constexpr T X() const { return data[0]; }
 
   /**
    * @brief Изменить значение \f$ X \f$ координаты.
    * @return \f$ X \f$ координата.
    */
-  T& X() { return data[0]; }
+  constexpr T& X() { return data[0]; }
 
   /**
    * @brief Получить значение \f$ Y \f$ координаты.
    * @return \f$ Y \f$ координата.
    */
-  T Y() const { return data[1]; }
+  constexpr T Y() const { return data[1]; }
 
   /**
    * @brief Изменить значение \f$ Y \f$ координаты.
    * @return \f$ Y \f$ координата.
    */
-  T& Y() { return data[1]; }
+  constexpr T& Y() { return data[1]; }
 
   /**
    * @brief Сложить две точки.
@@ -75,7 +79,7 @@ class Point {
    *
    * Функция вычисляет сумму текущей точки и точки other и возвращает результат.
    */
-  Point operator+(const Point& other) const {
+  constexpr Point operator+(const Point& other) const {
     return Point(X() + other.X(), Y() + other.Y());
   }
 
@@ -88,7 +92,7 @@ class Point {
    * Функция вычисляет разность текущей точки и точки other и возвращает
    * результат.
    */
-  Point operator-(const Point& other) const {
+  constexpr Point operator-(const Point& other) const {
     return Point(X() - other.X(), Y() - other.Y());
   }
 
@@ -103,7 +107,7 @@ class Point {
    *   x^2 + y^2.
    * \f]
    */
-  T operator*(const Point& other) const {
+  constexpr T operator*(const Point& other) const {
     return X() * other.X() + Y() * other.Y();
   }
 
@@ -115,7 +119,7 @@ class Point {
    *
    * Функция возвращает \f$ \mathrm{index} \f$ координату точки.
    */
-  T operator[] (int index) const {
+  constexpr T operator[] (int index) const {
     return data[index];
   }
 
@@ -127,7 +131,7 @@ class Point {
    *
    * Функция возвращает ссылку на \f$ \mathrm{index} \f$ координату точки.
    */
-  T& operator[] (int index) {
+  constexpr T& operator[] (int index) {
     return data[index];
   }
 
@@ -141,16 +145,20 @@ class Point {
    *
    * Функция позволяет узнать, совпадают ли две точки.
    */
-  static bool IsEqual(const Point& left,
-                      const Point& right,
-                      T precision) {
-    if (std::fabs(left.X() - right.X()) <=
-        precision * std::max(std::fabs(left.X()), std::fabs(right.X())) &&
-        std::fabs(left.Y() - right.Y()) <=
-        precision * std::max(std::fabs(left.Y()), std::fabs(right.Y())))
-      return true;
-
-    return false;
+  static constexpr bool IsEqual(const Point& left,
+                                const Point& right,
+                                T precision) {
+    if constexpr (std::is_integral_v<T>) {
+      return left.X() == right.X() && left.Y() == right.Y();
+    } else {
+      if (std::fabs(left.X() - right.X()) <=
+          precision * std::max(std::fabs(left.X()), std::fabs(right.X())) &&
+          std::fabs(left.Y() - right.Y()) <=
+          precision * std::max(std::fabs(left.Y()), std::fabs(right.Y())))
+        return true;
+
+      return false;
+    }
   }
 
   /**
@@ -162,7 +170,7 @@ class Point {
    * Функция возвращает true, если текущая точка лексикографически
    * меньше второй и false в противном случае.
    */
-  bool operator<(const Point& other) const {
+  constexpr bool operator<(const Point& other) const {
     return std::pair(X(), Y()) < std::pair(other.X(), other.Y());
   }
 
@@ -175,7 +183,7 @@ class Point {
    * Функция возвращает true, если текущая точка лексикографически
    * больше второй и false в противном случае.
    */
-  bool operator>(const Point& other) const {
+  constexpr bool operator>(const Point& other) const {
     return std::pair(X(), Y()) > std::pair(other.X(), other.Y());
   }
 
@@ -189,25 +197,30 @@ class Point {
    *
    * Функция определяет положение текущей точки относительно прямой (p0, p1).
    */
-  Position Classify(const Point& p0, const Point& p1, T precision) const {
-    Point a = p1 - p0;
-    Point b = *this - p0;
-    T sa = a.X() * b.Y() - b.X() * a.Y();
-
-    if (sa > precision)
-      return Position::Left;
-    else if (sa < -precision)
-      return Position::Right;
-    else if ((a.X() * b.X() < 0) || (a.Y() * b.Y() < 0))
-      return Position::Behind;
-    else if (a.Length() < b.Length())
-      return Position::Beyond;
-    else if (IsEqual(p0, *this, precision))
-      return Position::Origin;
-    else if (IsEqual(p1, *this, precision))
-      return Position::Destination;
-
-    return Position::Between;
+  constexpr Position Classify(const Point& p0, const Point& p1,
+                              T precision) const {
+    if constexpr (std::is_integral_v<T>) {
+      return ClassifyExact(p0, p1);
+    } else {
+      Point a = p1 - p0;
+      Point b = *this - p0;
+      T sa = a.X() * b.Y() - b.X() * a.Y();
+
+      if (sa > precision)
+        return Position::Left;
+      else if (sa < -precision)
+        return Position::Right;
+      else if ((a.X() * b.X() < 0) || (a.Y() * b.Y() < 0))
+        return Position::Behind;
+      else if (a.Length() < b.Length())
+        return Position::Beyond;
+      else if (IsEqual(p0, *this, precision))
+        return Position::Origin;
+      else if (IsEqual(p1, *this, precision))
+        return Position::Destination;
+
+      return Position::Between;
+    }
   }
 
   /**
@@ -231,11 +244,19 @@ class Point {
    * Функция вычисляет полярный угол точки в градусах.
    */
   T PolarAngle(T precision) const {
-    if (std::fabs(data[0]) < precision && std::fabs(data[1]) < precision)
-      return -1;
+    if constexpr (std::is_integral_v<T>) {
+      if (data[0] == 0 && data[1] == 0)
+        return -1;
+
+      if (data[0] == 0)
+        return Y() > 0 ? 90 : 270;
+    } else {
+      if (std::fabs(data[0]) < precision && std::fabs(data[1]) < precision)
+        return -1;
 
-    if (std::fabs(data[0]) < precision)
-      return Y() > 0 ? 90 : 270;
+      if (std::fabs(data[0]) < precision)
+        return Y() > 0 ? 90 : 270;
+    }
 
     T theta = T(std::atan(Y() / X()));
     theta *= T(360.0 / (2 * PI));
@@ -265,6 +286,48 @@ class Point {
    * проходящей через ребро edge.
    */
   T Distance(const Edge<T>& edge, T precision) const;
+
+ private:
+  /**
+   * @brief Точно определить положение точки относительно прямой.
+   *
+   * @param p0 Начало отрезка, задающего прямую.
+   * @param p1 Конец отрезка, задающего прямую.
+   * @return Результат классификации.
+   *
+   * Целочисленная версия функции Classify(). Все проверки сводятся
+   * к сравнению знаков и не используют арифметику с плавающей точкой.
+   */
+  constexpr Position ClassifyExact(const Point& p0, const Point& p1) const {
+    int sa = CrossProductSign(p0.X(), p0.Y(), p1.X(), p1.Y(), X(), Y());
+
+    if (sa > 0)
+      return Position::Left;
+    else if (sa < 0)
+      return Position::Right;
+
+    std::int64_t ax = std::int64_t(p1.X()) - std::int64_t(p0.X());
+    std::int64_t ay = std::int64_t(p1.Y()) - std::int64_t(p0.Y());
+    std::int64_t bx = std::int64_t(X()) - std::int64_t(p0.X());
+    std::int64_t by = std::int64_t(Y()) - std::int64_t(p0.Y());
+
+    if (Sign(ax) * Sign(bx) < 0 || Sign(ay) * Sign(by) < 0)
+      return Position::Behind;
+
+    // Вектора коллинеарны и сонаправлены, поэтому их длины можно сравнивать
+    // по сумме модулей координат.
+    std::uint64_t lengthA = detail::UnsignedAbs(ax) + detail::UnsignedAbs(ay);
+    std::uint64_t lengthB = detail::UnsignedAbs(bx) + detail::UnsignedAbs(by);
+
+    if (lengthA < lengthB)
+      return Position::Beyond;
+    else if (p0.X() == X() && p0.Y() == Y())
+      return Position::Origin;
+    else if (p1.X() == X() && p1.Y() == Y())
+      return Position::Destination;
+
+    return Position::Between;
+  }
 };
 
 /**
@@ -277,7 +340,8 @@ class Point {
  * @return Результат операции.
  */
 template<typename ValueType>
-Point<ValueType> operator*(ValueType value, const Point<ValueType>& point) {
+constexpr Point<ValueType> operator*(ValueType value,
+                                     const Point<ValueType>& point) {
   return Point<ValueType>(value * point.X(), value * point.Y());
 }
 
@@ -291,7 +355,8 @@ Point<ValueType> operator*(ValueType value, const Point<ValueType>& point) {
  * @return Результат операции.
  */
 template<typename ValueType>
-Point<ValueType> operator*(const Point<ValueType>& point, ValueType value) {
+constexpr Point<ValueType> operator*(const Point<ValueType>& point,
+                                     ValueType value) {
   return Point<ValueType>(value * point.X(), value * point.Y());
 }
 
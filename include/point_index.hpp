@@ -0,0 +1,511 @@
+/**
+ * @file include/point_index.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Индекс точек для ортогональных запросов: адаптивное PR-дерево
+ * квадрантов или равномерная сетка над точками, упорядоченными
+ * по коду Мортона.
+ */
+
+#ifndef INCLUDE_POINT_INDEX_HPP_
+#define INCLUDE_POINT_INDEX_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+#include <point.hpp>
+#include "rectangle.h"
+
+namespace geometry {
+
+/**
+ * @brief Вид индекса точек.
+ */
+enum class PointIndexKind {
+  //! Равномерная сетка с автоматически подобранным размером ячейки.
+  Grid,
+  //! Адаптивное PR-дерево квадрантов.
+  QuadTree
+};
+
+/**
+ * @brief Вычислить код Мортона.
+ *
+ * @param x Первая координата.
+ * @param y Вторая координата.
+ * @return Код, в котором биты x занимают чётные позиции, а биты y ---
+ * нечётные.
+ */
+inline uint32_t MortonCode(uint32_t x, uint32_t y) {
+  auto spread = [](uint32_t value) {
+    value &= 0x0000ffff;
+    value = (value | (value << 8)) & 0x00ff00ff;
+    value = (value | (value << 4)) & 0x0f0f0f0f;
+    value = (value | (value << 2)) & 0x33333333;
+    value = (value | (value << 1)) & 0x55555555;
+
+    return value;
+  };
+
+  return spread(x) | (spread(y) << 1);
+}
+
+/**
+ * @brief Статический индекс точек для ортогональных запросов.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * Ограничивающий прямоугольник набора делится на решётку
+ * \f$ 2^{16} \times 2^{16} \f$, и точки сортируются по коду Мортона своей
+ * клетки решётки. В этом порядке точки любого квадранта дерева
+ * квадрантов и любой ячейки сетки со стороной степени двойки занимают
+ * непрерывный отрезок массива, поэтому корзины не требуют отдельных
+ * выделений памяти и читаются последовательно.
+ *
+ * Для каждого квадранта (ячейки) хранится точный ограничивающий
+ * прямоугольник его точек. Если он целиком лежит внутри запроса, точки
+ * квадранта учитываются без проверки, а при подсчёте к ответу просто
+ * прибавляется их число.
+ *
+ * Запросы возвращают номера точек в исходном наборе и могут выполняться
+ * одновременно из разных потоков.
+ */
+template<typename T>
+class PointIndex {
+ private:
+  //! Число бит решётки по каждой координате.
+  static constexpr unsigned kBits = 16;
+
+  /**
+   * @brief Ограничивающий прямоугольник.
+   */
+  struct Box {
+    //! Минимальная абсцисса.
+    T minX;
+    //! Минимальная ордината.
+    T minY;
+    //! Максимальная абсцисса.
+    T maxX;
+    //! Максимальная ордината.
+    T maxY;
+  };
+
+  /**
+   * @brief Квадрант дерева или ячейка сетки.
+   */
+  struct Node {
+    //! Ограничивающий прямоугольник точек.
+    Box box;
+    //! Номер первой точки.
+    uint32_t begin;
+    //! Номер точки, следующей за последней.
+    uint32_t end;
+    //! Номер первого из четырёх потомков (-1 для листа).
+    int32_t child;
+  };
+
+  //! Вид индекса.
+  PointIndexKind kind;
+  //! Точки в порядке кодов Мортона.
+  std::vector<Point<T>> points;
+  //! Номера точек в исходном наборе.
+  std::vector<size_t> ids;
+  //! Коды Мортона точек.
+  std::vector<uint32_t> codes;
+  //! Узлы дерева (корень первый) или ячейки сетки в порядке Мортона.
+  std::vector<Node> nodes;
+  //! Число уровней сетки (сторона сетки равна 2^gridLevel ячеек).
+  unsigned gridLevel;
+  //! Начало решётки.
+  long double originX, originY;
+  //! Число клеток решётки на единицу длины.
+  long double scaleX, scaleY;
+
+ public:
+  /**
+   * @brief Построить индекс.
+   *
+   * @param data Набор точек.
+   * @param kind Вид индекса.
+   * @param bucketSize Желаемое число точек в корзине (листе дерева
+   * или ячейке сетки).
+   *
+   * Время построения \f$ O(n \log n) \f$.
+   */
+  PointIndex(const std::vector<Point<T>>& data, PointIndexKind kind,
+             size_t bucketSize = 32);
+
+  /**
+   * @brief Получить число точек.
+   * @return Число точек.
+   */
+  size_t Size() const { return points.size(); }
+
+  /**
+   * @brief Получить вид индекса.
+   * @return Вид индекса.
+   */
+  PointIndexKind Kind() const { return kind; }
+
+  /**
+   * @brief Найти точки, лежащие в прямоугольнике.
+   *
+   * @tparam OutputIterator Тип итератора вывода.
+   *
+   * @param range Прямоугольник запроса (границы включаются).
+   * @param output Итератор, в который записываются номера точек.
+   * @return Итератор вывода после записи результата.
+   */
+  template<typename OutputIterator>
+  OutputIterator Report(const Rectangle<T>& range,
+                        OutputIterator output) const {
+    Box query = MakeBox(range);
+
+    Visit(query, [&](const Node& node, bool whole) {
+      for (size_t i = node.begin; i < node.end; i++) {
+        if (whole || Contains(query, points[i]))
+          *output++ = ids[i];
+      }
+    });
+
+    return output;
+  }
+
+  /**
+   * @brief Подсчитать точки, лежащие в прямоугольнике.
+   *
+   * @param range Прямоугольник запроса (границы включаются).
+   * @return Число точек.
+   */
+  size_t Count(const Rectangle<T>& range) const {
+    Box query = MakeBox(range);
+    size_t count = 0;
+
+    Visit(query, [&](const Node& node, bool whole) {
+      if (whole) {
+        count += node.end - node.begin;
+        return;
+      }
+
+      for (size_t i = node.begin; i < node.end; i++)
+        count += Contains(query, points[i]);
+    });
+
+    return count;
+  }
+
+ private:
+  /**
+   * @brief Перевести прямоугольник в ограничивающий прямоугольник.
+   *
+   * @param rectangle Прямоугольник.
+   * @return Ограничивающий прямоугольник с упорядоченными границами.
+   */
+  static Box MakeBox(const Rectangle<T>& rectangle) {
+    return Box{std::min(rectangle.sw.X(), rectangle.ne.X()),
+               std::min(rectangle.sw.Y(), rectangle.ne.Y()),
+               std::max(rectangle.sw.X(), rectangle.ne.X()),
+               std::max(rectangle.sw.Y(), rectangle.ne.Y())};
+  }
+
+  /**
+   * @brief Проверить, лежит ли точка в прямоугольнике.
+   *
+   * @param box Прямоугольник.
+   * @param point Точка.
+   * @return Булево значение.
+   */
+  static bool Contains(const Box& box, const Point<T>& point) {
+    return box.minX <= point.X() && point.X() <= box.maxX &&
+           box.minY <= point.Y() && point.Y() <= box.maxY;
+  }
+
+  /**
+   * @brief Вычислить ограничивающий прямоугольник отрезка точек.
+   *
+   * @param begin Номер первой точки.
+   * @param end Номер точки, следующей за последней.
+   * @return Ограничивающий прямоугольник.
+   */
+  Box Bound(size_t begin, size_t end) const {
+    Box box{T(), T(), T(), T()};
+
+    if (begin == end)
+      return box;
+
+    box = Box{points[begin].X(), points[begin].Y(),
+              points[begin].X(), points[begin].Y()};
+
+    for (size_t i = begin + 1; i < end; i++) {
+      box.minX = std::min(box.minX, points[i].X());
+      box.minY = std::min(box.minY, points[i].Y());
+      box.maxX = std::max(box.maxX, points[i].X());
+      box.maxY = std::max(box.maxY, points[i].Y());
+    }
+
+    return box;
+  }
+
+  /**
+   * @brief Перевести координату в номер клетки решётки.
+   *
+   * @param value Координата.
+   * @param origin Начало решётки.
+   * @param scale Число клеток на единицу длины.
+   * @return Номер клетки.
+   *
+   * Функция монотонна, поэтому клетки точек прямоугольника запроса
+   * лежат между клетками его углов.
+   */
+  static uint32_t Quantize(T value, long double origin, long double scale) {
+    long double cell = std::floor((value - origin) * scale);
+    uint32_t last = (1U << kBits) - 1;
+
+    if (!(cell > 0))
+      return 0;
+    if (cell > last)
+      return last;
+
+    return static_cast<uint32_t>(cell);
+  }
+
+  /**
+   * @brief Построить поддерево квадрантов.
+   *
+   * @param index Номер узла.
+   * @param level Уровень узла (0 для корня).
+   * @param bucketSize Желаемое число точек в листе.
+   */
+  void BuildQuadTree(size_t index, unsigned level, size_t bucketSize);
+
+  /**
+   * @brief Построить ячейки сетки.
+   *
+   * @param bucketSize Желаемое число точек в ячейке.
+   */
+  void BuildGrid(size_t bucketSize);
+
+  /**
+   * @brief Обойти корзины, пересекающие прямоугольник запроса.
+   *
+   * @tparam Visitor Тип функции, обрабатывающей корзину.
+   *
+   * @param query Прямоугольник запроса.
+   * @param visitor Функция, которая получает корзину и признак того,
+   * что все её точки лежат в прямоугольнике.
+   */
+  template<typename Visitor>
+  void Visit(const Box& query, Visitor visitor) const;
+
+  /**
+   * @brief Обойти поддерево квадрантов.
+   *
+   * @tparam Visitor Тип функции, обрабатывающей корзину.
+   *
+   * @param index Номер узла.
+   * @param query Прямоугольник запроса.
+   * @param visitor Функция, обрабатывающая корзину.
+   */
+  template<typename Visitor>
+  void VisitQuadTree(size_t index, const Box& query, Visitor& visitor) const;
+
+  /**
+   * @brief Классифицировать корзину относительно запроса.
+   *
+   * @tparam Visitor Тип функции, обрабатывающей корзину.
+   *
+   * @param node Корзина.
+   * @param query Прямоугольник запроса.
+   * @param visitor Функция, обрабатывающая корзину.
+   * @return Функция возвращает true, если корзину нужно разбирать дальше
+   * (она пересекает границу запроса и не является листом).
+   */
+  template<typename Visitor>
+  bool VisitNode(const Node& node, const Box& query, Visitor& visitor) const {
+    if (node.begin == node.end)
+      return false;
+
+    const Box& box = node.box;
+
+    if (box.maxX < query.minX || query.maxX < box.minX ||
+        box.maxY < query.minY || query.maxY < box.minY)
+      return false;
+
+    if (query.minX <= box.minX && box.maxX <= query.maxX &&
+        query.minY <= box.minY && box.maxY <= query.maxY) {
+      visitor(node, true);
+      return false;
+    }
+
+    if (node.child < 0) {
+      visitor(node, false);
+      return false;
+    }
+
+    return true;
+  }
+};
+
+template<typename T>
+PointIndex<T>::PointIndex(const std::vector<Point<T>>& data,
+                          PointIndexKind kind,
+                          size_t bucketSize) :
+    kind(kind),
+    points(),
+    ids(data.size()),
+    codes(data.size()),
+    nodes(),
+    gridLevel(0),
+    originX(0),
+    originY(0),
+    scaleX(0),
+    scaleY(0) {
+  bucketSize = std::max<size_t>(bucketSize, 1);
+
+  if (data.empty())
+    return;
+
+  T minX = data[0].X(), minY = data[0].Y();
+  T maxX = data[0].X(), maxY = data[0].Y();
+
+  for (const Point<T>& point : data) {
+    minX = std::min(minX, point.X());
+    minY = std::min(minY, point.Y());
+    maxX = std::max(maxX, point.X());
+    maxY = std::max(maxY, point.Y());
+  }
+
+  originX = minX;
+  originY = minY;
+
+  if (maxX > minX)
+    scaleX = (1U << kBits) / (static_cast<long double>(maxX) - minX);
+  if (maxY > minY)
+    scaleY = (1U << kBits) / (static_cast<long double>(maxY) - minY);
+
+  std::vector<uint32_t> unsortedCodes(data.size());
+
+  for (size_t i = 0; i < data.size(); i++) {
+    unsortedCodes[i] = MortonCode(Quantize(data[i].X(), originX, scaleX),
+                                  Quantize(data[i].Y(), originY, scaleY));
+    ids[i] = i;
+  }
+
+  std::sort(ids.begin(), ids.end(), [&unsortedCodes](size_t a, size_t b) {
+    return unsortedCodes[a] < unsortedCodes[b];
+  });
+
+  points.reserve(data.size());
+
+  for (size_t i = 0; i < ids.size(); i++) {
+    points.push_back(data[ids[i]]);
+    codes[i] = unsortedCodes[ids[i]];
+  }
+
+  if (kind == PointIndexKind::QuadTree) {
+    nodes.push_back(Node{Bound(0, points.size()), 0,
+                         static_cast<uint32_t>(points.size()), -1});
+    BuildQuadTree(0, 0, bucketSize);
+  } else {
+    BuildGrid(bucketSize);
+  }
+}
+
+template<typename T>
+void PointIndex<T>::BuildQuadTree(size_t index, unsigned level,
+                                  size_t bucketSize) {
+  size_t begin = nodes[index].begin, end = nodes[index].end;
+
+  if (end - begin <= bucketSize || level == kBits)
+    return;
+
+  // Все коды квадранта имеют общий префикс длины 2 * level.
+  unsigned shift = 2 * (kBits - level - 1);
+  uint64_t prefix = static_cast<uint64_t>(codes[begin]) >> (shift + 2);
+  size_t child = nodes.size();
+
+  nodes[index].child = static_cast<int32_t>(child);
+
+  for (uint64_t quadrant = 0; quadrant < 4; quadrant++) {
+    uint64_t last = (((prefix << 2) | quadrant) + 1) << shift;
+    auto middle = std::lower_bound(codes.begin() + begin, codes.begin() + end,
+                                   last);
+    size_t split = static_cast<size_t>(middle - codes.begin());
+
+    nodes.push_back(Node{Bound(begin, split), static_cast<uint32_t>(begin),
+                         static_cast<uint32_t>(split), -1});
+    begin = split;
+  }
+
+  for (size_t i = child; i < child + 4; i++)
+    BuildQuadTree(i, level + 1, bucketSize);
+}
+
+template<typename T>
+void PointIndex<T>::BuildGrid(size_t bucketSize) {
+  // Сторона сетки выбирается степенью двойки так, чтобы в ячейке было
+  // в среднем не больше bucketSize точек.
+  while (gridLevel < kBits &&
+         (size_t(1) << (2 * gridLevel)) * bucketSize < points.size())
+    gridLevel++;
+
+  size_t cells = size_t(1) << (2 * gridLevel);
+  unsigned shift = 2 * (kBits - gridLevel);
+  size_t begin = 0;
+
+  nodes.reserve(cells);
+
+  for (size_t cell = 0; cell < cells; cell++) {
+    uint64_t last = static_cast<uint64_t>(cell + 1) << shift;
+    size_t end = begin;
+
+    while (end < codes.size() && codes[end] < last)
+      end++;
+
+    nodes.push_back(Node{Bound(begin, end), static_cast<uint32_t>(begin),
+                         static_cast<uint32_t>(end), -1});
+    begin = end;
+  }
+}
+
+template<typename T>
+template<typename Visitor>
+void PointIndex<T>::Visit(const Box& query, Visitor visitor) const {
+  if (nodes.empty())
+    return;
+
+  if (kind == PointIndexKind::QuadTree) {
+    VisitQuadTree(0, query, visitor);
+    return;
+  }
+
+  unsigned shift = kBits - gridLevel;
+  uint32_t firstX = Quantize(query.minX, originX, scaleX) >> shift;
+  uint32_t lastX = Quantize(query.maxX, originX, scaleX) >> shift;
+  uint32_t firstY = Quantize(query.minY, originY, scaleY) >> shift;
+  uint32_t lastY = Quantize(query.maxY, originY, scaleY) >> shift;
+
+  for (uint32_t y = firstY; y <= lastY; y++) {
+    for (uint32_t x = firstX; x <= lastX; x++)
+      VisitNode(nodes[MortonCode(x, y)], query, visitor);
+  }
+}
+
+template<typename T>
+template<typename Visitor>
+void PointIndex<T>::VisitQuadTree(size_t index, const Box& query,
+                                  Visitor& visitor) const {
+  const Node& node = nodes[index];
+
+  if (!VisitNode(node, query, visitor))
+    return;
+
+  for (size_t i = 0; i < 4; i++)
+    VisitQuadTree(node.child + i, query, visitor);
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_POINT_INDEX_HPP_
@@ -0,0 +1,398 @@
+/**
+ * @file include/rectangle_components.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Компоненты связности и дыры объединения прямоугольников.
+ */
+
+#ifndef INCLUDE_RECTANGLE_COMPONENTS_HPP_
+#define INCLUDE_RECTANGLE_COMPONENTS_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+#include "rectangle.h"
+#include "rectangle_intersections.hpp"
+
+namespace geometry {
+
+namespace detail {
+
+/**
+ * @brief Дерево отрезков для подсчёта связных участков покрытия прямой.
+ *
+ * Листья соответствуют сжатым концам отрезков (чётные позиции) и открытым
+ * промежуткам между соседними концами (нечётные позиции), поэтому
+ * замкнутые отрезки, касающиеся концами, образуют один участок. Число
+ * отрезков, покрывающих узел целиком, хранится в узле и не
+ * проталкивается.
+ *
+ * Кроме того, узел хранит отрезок (владельца), лежащий в одной компоненте
+ * со всеми покрытыми листьями узла, либо признак того, что листья
+ * принадлежат разным компонентам. Компоненты только сливаются, поэтому
+ * владелец остаётся верным, пока покрытие узла не пусто. Компоненты
+ * задаются функцией find(), возвращающей корень системы
+ * непересекающихся множеств.
+ */
+class RunTree {
+ public:
+  //! Сводка по отрезку листьев.
+  struct Summary {
+    //! Число связных покрытых участков.
+    size_t runs;
+    //! Покрыт ли первый лист.
+    bool left;
+    //! Покрыт ли последний лист.
+    bool right;
+  };
+
+ private:
+  //! Владелец узла без покрытых листьев.
+  static constexpr size_t kEmpty = static_cast<size_t>(-1);
+  //! Владелец узла, листья которого принадлежат разным компонентам.
+  static constexpr size_t kMixed = static_cast<size_t>(-2);
+
+  //! Число отрезков, покрывающих узел целиком.
+  std::vector<size_t> cover;
+  //! Сводки узлов.
+  std::vector<Summary> summary;
+  //! Владельцы узлов.
+  std::vector<size_t> owner;
+  //! Число листьев.
+  size_t size;
+
+ public:
+  /**
+   * @brief Создать пустое дерево с size листьями.
+   */
+  explicit RunTree(size_t size) :
+      cover(4 * size, 0),
+      summary(4 * size, Summary{ 0, false, false }),
+      owner(4 * size, kEmpty),
+      size(size) { }
+
+  /**
+   * @brief Прибавить delta (1 или -1) к покрытию листьев [first, last].
+   *
+   * При добавлении отрезок index становится владельцем покрытых им узлов,
+   * поэтому перед добавлением он должен быть объединён с компонентами
+   * листьев [first, last] (см. Unite()).
+   */
+  template<typename Find>
+  void Add(size_t first, size_t last, int delta, size_t index, Find find) {
+    Add(1, 0, size, first, last + 1, delta, index, find);
+  }
+
+  /**
+   * @brief Число связных покрытых участков среди листьев [first, last].
+   */
+  size_t Runs(size_t first, size_t last) const {
+    return Query(1, 0, size, first, last + 1).runs;
+  }
+
+  /**
+   * @brief Объединить отрезок index с компонентами листьев [first, last].
+   *
+   * Функция unite(j) вызывается для владельцев узлов, покрытые листья
+   * которых лежат в одной компоненте; в такие узлы спуск не ведётся.
+   * Узел, листья которого принадлежали разным компонентам, после спуска
+   * получает владельца index, поэтому повторно спускаться в него
+   * придётся, только если его покрытие изменится. Каждое изменение
+   * покрытия затрагивает \f$ O(\log n) \f$ узлов, поэтому суммарное
+   * время работы \f$ O(\log n) \f$ в среднем на вызов.
+   */
+  template<typename Callback, typename Find>
+  void Unite(size_t first, size_t last, size_t index, Callback unite,
+             Find find) {
+    Unite(1, 0, size, first, last + 1, index, unite, find);
+  }
+
+ private:
+  static Summary Merge(const Summary& a, const Summary& b) {
+    return Summary{ a.runs + b.runs - (a.right && b.left ? 1 : 0),
+                    a.left, b.right };
+  }
+
+  template<typename Find>
+  static size_t Combine(size_t a, size_t b, Find find) {
+    if (a == kEmpty)
+      return b;
+
+    if (b == kEmpty)
+      return a;
+
+    if (a == kMixed || b == kMixed || find(a) != find(b))
+      return kMixed;
+
+    return a;
+  }
+
+  template<typename Find>
+  void Add(size_t node, size_t begin, size_t end, size_t first, size_t last,
+           int delta, size_t index, Find find) {
+    if (last <= begin || end <= first)
+      return;
+
+    size_t middle = begin + (end - begin) / 2;
+
+    if (first <= begin && end <= last) {
+      cover[node] += delta;
+
+      if (delta > 0)
+        owner[node] = index;
+    } else {
+      Add(2 * node, begin, middle, first, last, delta, index, find);
+      Add(2 * node + 1, middle, end, first, last, delta, index, find);
+    }
+
+    if (cover[node] > 0) {
+      summary[node] = Summary{ 1, true, true };
+    } else if (end - begin == 1) {
+      summary[node] = Summary{ 0, false, false };
+      owner[node] = kEmpty;
+    } else {
+      summary[node] = Merge(summary[2 * node], summary[2 * node + 1]);
+      owner[node] = Combine(owner[2 * node], owner[2 * node + 1], find);
+    }
+  }
+
+  Summary Query(size_t node, size_t begin, size_t end, size_t first,
+                size_t last) const {
+    if (cover[node] > 0)
+      return Summary{ 1, true, true };
+
+    if (first <= begin && end <= last)
+      return summary[node];
+
+    size_t middle = begin + (end - begin) / 2;
+
+    if (last <= middle)
+      return Query(2 * node, begin, middle, first, last);
+
+    if (middle <= first)
+      return Query(2 * node + 1, middle, end, first, last);
+
+    return Merge(Query(2 * node, begin, middle, first, last),
+                 Query(2 * node + 1, middle, end, first, last));
+  }
+
+  template<typename Callback, typename Find>
+  void Unite(size_t node, size_t begin, size_t end, size_t first,
+             size_t last, size_t index, Callback unite, Find find) {
+    if (last <= begin || end <= first)
+      return;
+
+    bool inside = first <= begin && end <= last;
+
+    if (cover[node] > 0 || (inside && owner[node] != kMixed)) {
+      if (owner[node] != kEmpty)
+        unite(owner[node]);
+
+      return;
+    }
+
+    size_t middle = begin + (end - begin) / 2;
+
+    Unite(2 * node, begin, middle, first, last, index, unite, find);
+    Unite(2 * node + 1, middle, end, first, last, index, unite, find);
+
+    if (inside)
+      owner[node] = index;
+    else
+      owner[node] = Combine(owner[2 * node], owner[2 * node + 1], find);
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Компоненты связности объединения прямоугольников.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * Объект является обработчиком событий сканирования: его нужно вызвать
+ * для каждого события в порядке BuildSchedule(). Это позволяет получить
+ * компоненты за тот же проход, что и контур (см. ContourRectangles()
+ * с обработчиком событий), либо отдельно функцией ConnectedRectangles().
+ *
+ * Прямоугольники замкнуты: касающиеся прямоугольники принадлежат одной
+ * компоненте. Компоненты хранятся в системе непересекающихся множеств.
+ * Активные прямоугольники, образующие один связный участок сечения
+ * объединения сканирующей прямой, пересекаются и потому лежат в одной
+ * компоненте, так что новый прямоугольник достаточно объединить с одним
+ * представителем каждого задетого участка. Представители хранятся
+ * в узлах дерева отрезков (см. detail::RunTree::Unite()), поэтому
+ * вложенные и стопками лежащие прямоугольники не приводят к перебору
+ * всех пересекающихся пар.
+ *
+ * Число дыр компоненты равно \f$ 1 - \chi \f$, где \f$ \chi \f$ ---
+ * её эйлерова характеристика. Она накапливается при сканировании:
+ * добавление прямоугольника, задевающего \f$ k \f$ связных участков
+ * сечения объединения сканирующей прямой, изменяет её на \f$ 1 - k \f$.
+ * Участки подсчитываются тем же деревом отрезков за \f$ O(\log n) \f$,
+ * поэтому общее время работы \f$ O(n \log n) \f$.
+ */
+template<typename T>
+class RectangleComponents {
+ private:
+  //! Массив прямоугольников.
+  Rectangle<T>* r;
+  //! Сжатые концы отрезков по \f$ y \f$.
+  std::vector<T> keys;
+  //! Покрытие сканирующей прямой.
+  detail::RunTree slice;
+  //! Родители в системе непересекающихся множеств.
+  std::vector<size_t> parent;
+  //! Наименьший идентификатор в множестве (хранится в корне).
+  std::vector<int> smallest;
+  //! Эйлерова характеристика множества (хранится в корне).
+  std::vector<ptrdiff_t> euler;
+
+ public:
+  /**
+   * @brief Подготовить сканирование.
+   *
+   * @param r Массив прямоугольников (sw не больше ne по обеим осям).
+   * @param n Их количество.
+   */
+  RectangleComponents(Rectangle<T> r[], size_t n) :
+      r(r),
+      keys(Endpoints(r, n)),
+      slice(keys.empty() ? 0 : 2 * keys.size() - 1),
+      parent(n),
+      smallest(n),
+      euler(n, 0) {
+    for (size_t i = 0; i < n; i++) {
+      parent[i] = i;
+      smallest[i] = r[i].id;
+    }
+  }
+
+  /**
+   * @brief Обработать событие сканирования.
+   *
+   * @param i Номер прямоугольника в массиве.
+   * @param left Признак левой стороны.
+   */
+  void operator()(size_t i, bool left) {
+    T low = r[i].sw.Y(), high = r[i].ne.Y();
+    size_t first = 2 * Rank(low), last = 2 * Rank(high);
+
+    auto find = [this](size_t j) { return Find(j); };
+
+    if (!left) {
+      slice.Add(first, last, -1, i, find);
+      return;
+    }
+
+    ptrdiff_t runs = static_cast<ptrdiff_t>(slice.Runs(first, last));
+
+    slice.Unite(first, last, i, [&](size_t j) { Union(i, j); }, find);
+    slice.Add(first, last, 1, i, find);
+    euler[Find(i)] += 1 - runs;
+  }
+
+  /**
+   * @brief Компоненты прямоугольников.
+   *
+   * @return Для каждого прямоугольника наименьший идентификатор
+   * (Rectangle::id) в его компоненте.
+   */
+  std::vector<int> Components() {
+    std::vector<int> result(parent.size());
+
+    for (size_t i = 0; i < parent.size(); i++)
+      result[i] = smallest[Find(i)];
+
+    return result;
+  }
+
+  /**
+   * @brief Число дыр в каждой компоненте.
+   *
+   * @return Отображение из идентификатора компоненты (см. Components())
+   * в число ограниченных компонент дополнения, окружённых ей.
+   */
+  std::map<int, size_t> Holes() {
+    std::map<int, size_t> result;
+
+    for (size_t i = 0; i < parent.size(); i++) {
+      if (Find(i) == i)
+        result[smallest[i]] = static_cast<size_t>(1 - euler[i]);
+    }
+
+    return result;
+  }
+
+ private:
+  static std::vector<T> Endpoints(Rectangle<T> r[], size_t n) {
+    std::vector<T> result;
+
+    result.reserve(2 * n);
+
+    for (size_t i = 0; i < n; i++) {
+      result.push_back(r[i].sw.Y());
+      result.push_back(r[i].ne.Y());
+    }
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+
+    return result;
+  }
+
+  size_t Rank(T value) const {
+    return static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(),
+                                                value) - keys.begin());
+  }
+
+  size_t Find(size_t i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+
+    return i;
+  }
+
+  void Union(size_t a, size_t b) {
+    a = Find(a);
+    b = Find(b);
+
+    if (a == b)
+      return;
+
+    if (b < a)
+      std::swap(a, b);
+
+    parent[b] = a;
+    smallest[a] = std::min(smallest[a], smallest[b]);
+    euler[a] += euler[b];
+  }
+};
+
+/**
+ * @brief Найти компоненты связности объединения прямоугольников.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param r Массив прямоугольников (sw не больше ne по обеим осям).
+ * @param n Их количество.
+ * @return Обработчик, прошедший все события сканирования.
+ */
+template<typename T>
+RectangleComponents<T> ConnectedRectangles(Rectangle<T> r[], size_t n) {
+  RectangleComponents<T> components(r, n);
+
+  detail::SweepRectangles(r, n, [&](size_t i, bool left) {
+    components(i, left);
+  });
+
+  return components;
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_RECTANGLE_COMPONENTS_HPP_
@@ -0,0 +1,357 @@
+/**
+ * @file include/rectangle_intersections.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Поиск всех пар пересекающихся прямоугольников за
+ * \f$ O(n \log n + k) \f$.
+ */
+
+#ifndef INCLUDE_RECTANGLE_INTERSECTIONS_HPP_
+#define INCLUDE_RECTANGLE_INTERSECTIONS_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+#include "axis_parallel_edge.h"
+#include "contour_rectangles.hpp"
+#include "rectangle.h"
+
+namespace geometry {
+
+namespace detail {
+
+/**
+ * @brief Дерево отрезков \f$ y \f$ активных прямоугольников.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * Скелет дерева --- сбалансированное дерево поиска по всем концам
+ * отрезков, хранящееся неявно в отсортированном массиве: корнем отрезка
+ * массива [begin, end) является его середина. Отрезок хранится в самом
+ * верхнем узле, ключ которого он содержит, причём в двух упорядоченных
+ * множествах: по нижнему концу и по верхнему. Поэтому запрос точки
+ * (все отрезки, содержащие \f$ y \f$) проходит один путь от корня
+ * и выполняется за \f$ O(\log n + k) \f$.
+ *
+ * Запрос пересечения с отрезком [low, high] разбивается на два
+ * непересекающихся: отрезки, содержащие low, и отрезки, нижний конец
+ * которых лежит в (low, high]. Второй запрос выполняется по общему
+ * множеству нижних концов.
+ */
+template<typename T>
+class IntervalTree {
+ private:
+  //! Элемент множества: координата конца и номер отрезка.
+  using Entry = std::pair<T, size_t>;
+
+  //! Отсортированные различные концы отрезков (ключи узлов).
+  std::vector<T> keys;
+  //! Отрезки узла, упорядоченные по нижнему концу.
+  std::vector<std::set<Entry>> byLow;
+  //! Отрезки узла, упорядоченные по верхнему концу.
+  std::vector<std::set<Entry>> byHigh;
+  //! Нижние концы всех отрезков.
+  std::set<Entry> lows;
+
+ public:
+  /**
+   * @brief Создать пустое дерево.
+   *
+   * @param endpoints Все концы отрезков, которые могут быть добавлены.
+   */
+  explicit IntervalTree(std::vector<T> endpoints) :
+      keys(std::move(endpoints)) {
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    byLow.resize(keys.size());
+    byHigh.resize(keys.size());
+  }
+
+  /**
+   * @brief Добавить отрезок.
+   */
+  void Insert(T low, T high, size_t index) {
+    size_t node = Node(low, high);
+
+    byLow[node].emplace(low, index);
+    byHigh[node].emplace(high, index);
+    lows.emplace(low, index);
+  }
+
+  /**
+   * @brief Удалить отрезок.
+   */
+  void Erase(T low, T high, size_t index) {
+    size_t node = Node(low, high);
+
+    byLow[node].erase(Entry(low, index));
+    byHigh[node].erase(Entry(high, index));
+    lows.erase(Entry(low, index));
+  }
+
+  /**
+   * @brief Перечислить отрезки, пересекающиеся с [low, high].
+   *
+   * @param report Функция, принимающая номер отрезка.
+   */
+  template<typename Function>
+  void Query(T low, T high, Function report) const {
+    size_t begin = 0, end = keys.size();
+
+    // Отрезки, содержащие low.
+    while (begin < end) {
+      size_t middle = begin + (end - begin) / 2;
+
+      if (low < keys[middle]) {
+        for (const Entry& entry : byLow[middle]) {
+          if (entry.first > low)
+            break;
+
+          report(entry.second);
+        }
+
+        end = middle;
+      } else {
+        for (auto it = byHigh[middle].rbegin(); it != byHigh[middle].rend();
+             ++it) {
+          if (it->first < low)
+            break;
+
+          report(it->second);
+        }
+
+        if (!(keys[middle] < low))
+          break;
+
+        begin = middle + 1;
+      }
+    }
+
+    // Отрезки, нижний конец которых лежит в (low, high].
+    auto it = lows.upper_bound(Entry(low, static_cast<size_t>(-1)));
+
+    for (; it != lows.end() && !(high < it->first); ++it)
+      report(it->second);
+  }
+
+ private:
+  /**
+   * @brief Найти узел, в котором хранится отрезок.
+   */
+  size_t Node(T low, T high) const {
+    size_t begin = 0, end = keys.size();
+
+    while (true) {
+      size_t middle = begin + (end - begin) / 2;
+
+      if (keys[middle] < low)
+        begin = middle + 1;
+      else if (high < keys[middle])
+        end = middle;
+      else
+        return middle;
+    }
+  }
+};
+
+/**
+ * @brief Счётчик на префиксах массива (дерево Фенвика).
+ */
+class FenwickTree {
+ private:
+  //! Частичные суммы.
+  std::vector<size_t> tree;
+
+ public:
+  /**
+   * @brief Создать счётчик для size позиций.
+   */
+  explicit FenwickTree(size_t size) : tree(size + 1, 0) { }
+
+  /**
+   * @brief Изменить значение в позиции.
+   */
+  void Add(size_t position, size_t value) {
+    for (position++; position < tree.size(); position += position & -position)
+      tree[position] += value;
+  }
+
+  /**
+   * @brief Сумма значений в позициях [0, position).
+   */
+  size_t Prefix(size_t position) const {
+    size_t result = 0;
+
+    for (; position > 0; position -= position & -position)
+      result += tree[position];
+
+    return result;
+  }
+};
+
+/**
+ * @brief Выполнить сканирование прямоугольников по \f$ x \f$.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Function Тип функции обработки события.
+ *
+ * @param r Массив прямоугольников.
+ * @param n Их количество.
+ * @param handle Функция, принимающая номер прямоугольника и признак
+ * левой стороны.
+ *
+ * Порядок событий тот же, что и при построении контура (BuildSchedule()):
+ * при равных \f$ x \f$ левые стороны обрабатываются раньше правых,
+ * поэтому касающиеся прямоугольники считаются пересекающимися.
+ */
+template<typename T, typename Function>
+void SweepRectangles(Rectangle<T> r[], size_t n, Function handle) {
+  if (n == 0)
+    return;
+
+  AxisParallelEdge<T>** schedule = BuildSchedule(r, n);
+
+  for (size_t i = 0; i < 2 * n; i++) {
+    handle(static_cast<size_t>(schedule[i]->r - r),
+           schedule[i]->type == Side::LEFT_SIDE);
+    delete schedule[i];
+  }
+
+  delete[] schedule;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Перечислить все пары пересекающихся прямоугольников.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Function Тип функции.
+ *
+ * @param r Массив прямоугольников (sw не больше ne по обеим осям).
+ * @param n Их количество.
+ * @param report Функция, которая вызывается для каждой пары
+ * пересекающихся прямоугольников с двумя константными ссылками на них.
+ *
+ * Прямоугольники считаются замкнутыми: касание сторонами или углами
+ * является пересечением. Сканирующая прямая движется по \f$ x \f$, при
+ * появлении прямоугольника в дереве отрезков ищутся все активные
+ * прямоугольники, пересекающиеся с ним по \f$ y \f$. Время работы
+ * \f$ O(n \log n + k) \f$, где \f$ k \f$ --- число пар; дополнительная
+ * память \f$ O(n) \f$ и не зависит от \f$ k \f$.
+ */
+template<typename T, typename Function>
+void ReportRectangleIntersections(Rectangle<T> r[], size_t n,
+                                  Function report) {
+  std::vector<T> endpoints;
+
+  endpoints.reserve(2 * n);
+
+  for (size_t i = 0; i < n; i++) {
+    endpoints.push_back(r[i].sw.Y());
+    endpoints.push_back(r[i].ne.Y());
+  }
+
+  detail::IntervalTree<T> active(std::move(endpoints));
+
+  detail::SweepRectangles(r, n, [&](size_t i, bool left) {
+    if (!left) {
+      active.Erase(r[i].sw.Y(), r[i].ne.Y(), i);
+      return;
+    }
+
+    active.Query(r[i].sw.Y(), r[i].ne.Y(), [&](size_t j) {
+      report(static_cast<const Rectangle<T>&>(r[j]),
+             static_cast<const Rectangle<T>&>(r[i]));
+    });
+    active.Insert(r[i].sw.Y(), r[i].ne.Y(), i);
+  });
+}
+
+/**
+ * @brief Найти все пары пересекающихся прямоугольников.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param r Массив прямоугольников.
+ * @param n Их количество.
+ * @return Пары идентификаторов (Rectangle::id) пересекающихся
+ * прямоугольников, меньший идентификатор в паре идёт первым.
+ */
+template<typename T>
+std::vector<std::pair<int, int>> RectangleIntersections(Rectangle<T> r[],
+                                                        size_t n) {
+  std::vector<std::pair<int, int>> result;
+
+  ReportRectangleIntersections(r, n, [&](const Rectangle<T>& a,
+                                         const Rectangle<T>& b) {
+    result.emplace_back(std::min(a.id, b.id), std::max(a.id, b.id));
+  });
+
+  return result;
+}
+
+/**
+ * @brief Подсчитать число пар пересекающихся прямоугольников.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param r Массив прямоугольников.
+ * @param n Их количество.
+ * @return Число пар.
+ *
+ * Пары не перечисляются: при появлении прямоугольника [low, high]
+ * из числа активных вычитаются прямоугольники, лежащие целиком ниже
+ * (верхний конец меньше low) или выше (нижний конец больше high). Оба
+ * числа хранятся в деревьях Фенвика по сжатым координатам, поэтому
+ * время работы \f$ O(n \log n) \f$ независимо от числа пар.
+ */
+template<typename T>
+size_t CountRectangleIntersections(Rectangle<T> r[], size_t n) {
+  std::vector<T> keys;
+
+  keys.reserve(2 * n);
+
+  for (size_t i = 0; i < n; i++) {
+    keys.push_back(r[i].sw.Y());
+    keys.push_back(r[i].ne.Y());
+  }
+
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  auto rank = [&](T value) {
+    return static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(),
+                                                value) - keys.begin());
+  };
+
+  detail::FenwickTree lows(keys.size()), highs(keys.size());
+  size_t active = 0, result = 0;
+
+  detail::SweepRectangles(r, n, [&](size_t i, bool left) {
+    size_t low = rank(r[i].sw.Y()), high = rank(r[i].ne.Y());
+
+    if (!left) {
+      lows.Add(low, static_cast<size_t>(-1));
+      highs.Add(high, static_cast<size_t>(-1));
+      active--;
+      return;
+    }
+
+    size_t below = highs.Prefix(low);
+    size_t above = active - lows.Prefix(high + 1);
+
+    result += active - below - above;
+    lows.Add(low, 1);
+    highs.Add(high, 1);
+    active++;
+  });
+
+  return result;
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_RECTANGLE_INTERSECTIONS_HPP_
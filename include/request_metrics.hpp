@@ -0,0 +1,534 @@
+/**
+ * @file include/request_metrics.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Счётчики и гистограммы времени обработки запросов по этапам
+ * с выводом в текстовом формате Prometheus.
+ */
+
+#ifndef INCLUDE_REQUEST_METRICS_HPP_
+#define INCLUDE_REQUEST_METRICS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace geometry {
+
+//! Этап обработки запроса.
+enum class RequestPhase {
+  //! Разбор запроса и подготовка входных данных алгоритма.
+  kParse,
+  //! Работа алгоритма.
+  kCompute,
+  //! Запись ответа.
+  kSerialize
+};
+
+//! Границы корзин гистограмм времени (в секундах).
+struct LatencyBuckets {
+  static constexpr size_t kSize = 19;
+  static constexpr double kBounds[kSize] = {
+    1e-5, 2.5e-5, 5e-5, 1e-4, 2.5e-4, 5e-4, 1e-3, 2.5e-3, 5e-3, 1e-2,
+    2.5e-2, 5e-2, 0.1, 0.25, 0.5, 1, 2.5, 5, 10
+  };
+};
+
+//! Границы корзин гистограмм размера (в байтах).
+struct SizeBuckets {
+  static constexpr size_t kSize = 13;
+  static constexpr double kBounds[kSize] = {
+    64, 256, 1024, 4096, 16384, 65536, 262144, 1048576, 4194304, 16777216,
+    67108864, 268435456, 1073741824
+  };
+};
+
+/**
+ * @brief Гистограмма, в которую пишет один поток.
+ *
+ * @tparam Buckets Границы корзин.
+ *
+ * Значения меняются только потоком-владельцем, поэтому вместо атомарного
+ * сложения (инструкции с блокировкой шины) используются обычные чтение
+ * и запись. Атомарность нужна только для того, чтобы другой поток мог
+ * в любой момент прочитать согласованные значения отдельных полей.
+ */
+template<typename Buckets>
+class MetricsHistogram {
+ private:
+  //! Число значений в корзинах (последняя корзина --- +Inf).
+  std::array<std::atomic<uint64_t>, Buckets::kSize + 1> buckets{};
+  //! Число значений.
+  std::atomic<uint64_t> count{0};
+  //! Сумма значений.
+  std::atomic<double> sum{0};
+
+ public:
+  //! Добавить значение.
+  void Add(double value) {
+    const double* bounds = Buckets::kBounds;
+    size_t i = std::lower_bound(bounds, bounds + Buckets::kSize, value) -
+               bounds;
+
+    Bump(&buckets[i], 1);
+    Bump(&count, 1);
+    sum.store(sum.load(std::memory_order_relaxed) + value,
+              std::memory_order_relaxed);
+  }
+
+  //! Число значений в корзине i (не накопленное).
+  uint64_t Bucket(size_t i) const {
+    return buckets[i].load(std::memory_order_relaxed);
+  }
+
+  //! Число значений.
+  uint64_t Count() const { return count.load(std::memory_order_relaxed); }
+
+  //! Сумма значений.
+  double Sum() const { return sum.load(std::memory_order_relaxed); }
+
+  //! Увеличить счётчик, в который пишет только текущий поток.
+  static void Bump(std::atomic<uint64_t>* counter, uint64_t value) {
+    counter->store(counter->load(std::memory_order_relaxed) + value,
+                   std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @brief Счётчики запросов одного метода с одним типом координат.
+ */
+struct MetricsSeries {
+  //! Число этапов.
+  static constexpr size_t kPhases = 3;
+
+  //! Метод.
+  std::string method;
+  //! Тип координат.
+  std::string type;
+  //! Время каждого этапа.
+  std::array<MetricsHistogram<LatencyBuckets>, kPhases> phases;
+  //! Полное время обработки.
+  MetricsHistogram<LatencyBuckets> total;
+  //! Размер запроса.
+  MetricsHistogram<SizeBuckets> input;
+  //! Размер ответа.
+  MetricsHistogram<SizeBuckets> output;
+  //! Число ошибок.
+  std::atomic<uint64_t> errors{0};
+
+  MetricsSeries(std::string method, std::string type) :
+      method(std::move(method)),
+      type(std::move(type)) { }
+};
+
+/**
+ * @brief Реестр счётчиков запросов.
+ *
+ * У каждого потока свой набор счётчиков, поэтому запись не требует
+ * блокировок и не вызывает конкуренции потоков за строки кэша. Мьютекс
+ * потока берётся только при появлении новой пары (метод, тип) и при
+ * чтении счётчиков в Write(), которое суммирует наборы всех потоков.
+ * Наборы потоков хранятся и после завершения потоков.
+ */
+class RequestMetrics {
+ private:
+  //! Счётчики одного потока.
+  struct ThreadMetrics {
+    //! Мьютекс, защищающий список счётчиков.
+    std::mutex mutex;
+    //! Счётчики (std::deque не перемещает элементы при добавлении).
+    std::deque<MetricsSeries> series;
+    //! Поиск счётчиков по методу и типу (только поток-владелец).
+    std::unordered_map<std::string, MetricsSeries*> index;
+  };
+
+  //! Мьютекс, защищающий список потоков.
+  std::mutex mutex;
+  //! Счётчики всех потоков.
+  std::vector<std::shared_ptr<ThreadMetrics>> threads;
+
+ public:
+  /**
+   * @brief Получить реестр.
+   * @return Ссылка на реестр.
+   */
+  static RequestMetrics& Instance() {
+    static RequestMetrics metrics;
+
+    return metrics;
+  }
+
+  /**
+   * @brief Найти счётчики текущего потока для метода и типа.
+   *
+   * @param method Метод.
+   * @param type Тип координат.
+   * @return Счётчики, в которые может писать только текущий поток.
+   */
+  MetricsSeries* Local(const std::string& method, const std::string& type) {
+    thread_local std::shared_ptr<ThreadMetrics> local = Register();
+    std::string key = method + '\n' + type;
+    auto it = local->index.find(key);
+
+    if (it != local->index.end())
+      return it->second;
+
+    std::lock_guard<std::mutex> lock(local->mutex);
+
+    local->series.emplace_back(method, type);
+    local->index[key] = &local->series.back();
+
+    return &local->series.back();
+  }
+
+  /**
+   * @brief Записать счётчики в текстовом формате Prometheus.
+   *
+   * @param stream Поток вывода.
+   */
+  void Write(std::ostream* stream) {
+    using Key = std::pair<std::string, std::string>;
+    std::map<Key, std::vector<const MetricsSeries*>> series;
+    std::vector<std::shared_ptr<ThreadMetrics>> snapshot;
+    std::vector<std::unique_lock<std::mutex>> locks;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      snapshot = threads;
+    }
+
+    for (const std::shared_ptr<ThreadMetrics>& thread : snapshot) {
+      locks.emplace_back(thread->mutex);
+
+      for (const MetricsSeries& s : thread->series)
+        series[Key(s.method, s.type)].push_back(&s);
+    }
+
+    static const char* const kPhaseNames[MetricsSeries::kPhases] = {
+      "parse", "compute", "serialize"
+    };
+
+    WriteHeader(stream, "geometry_requests_total", "counter",
+                "Number of processed requests.");
+
+    for (const auto& s : series) {
+      uint64_t count = 0;
+
+      for (const MetricsSeries* part : s.second)
+        count += part->total.Count();
+
+      *stream << "geometry_requests_total{" << Labels(s.first, nullptr)
+              << "} " << count << "\n";
+    }
+
+    WriteHeader(stream, "geometry_request_errors_total", "counter",
+                "Number of requests that failed.");
+
+    for (const auto& s : series) {
+      uint64_t count = 0;
+
+      for (const MetricsSeries* part : s.second)
+        count += part->errors.load(std::memory_order_relaxed);
+
+      *stream << "geometry_request_errors_total{" << Labels(s.first, nullptr)
+              << "} " << count << "\n";
+    }
+
+    WriteHeader(stream, "geometry_request_duration_seconds", "histogram",
+                "Total request processing time.");
+
+    for (const auto& s : series)
+      WriteHistogram(stream, "geometry_request_duration_seconds",
+                     Labels(s.first, nullptr), s.second,
+                     &MetricsSeries::total);
+
+    WriteHeader(stream, "geometry_request_phase_seconds", "histogram",
+                "Time spent in each request processing phase.");
+
+    for (const auto& s : series) {
+      for (size_t phase = 0; phase < MetricsSeries::kPhases; phase++) {
+        std::vector<const MetricsHistogram<LatencyBuckets>*> parts;
+
+        for (const MetricsSeries* part : s.second)
+          parts.push_back(&part->phases[phase]);
+
+        WriteHistogram(stream, "geometry_request_phase_seconds",
+                       Labels(s.first, kPhaseNames[phase]), parts);
+      }
+    }
+
+    WriteHeader(stream, "geometry_request_bytes", "histogram",
+                "Request body size.");
+
+    for (const auto& s : series)
+      WriteHistogram(stream, "geometry_request_bytes",
+                     Labels(s.first, nullptr), s.second,
+                     &MetricsSeries::input);
+
+    WriteHeader(stream, "geometry_response_bytes", "histogram",
+                "Response body size.");
+
+    for (const auto& s : series)
+      WriteHistogram(stream, "geometry_response_bytes",
+                     Labels(s.first, nullptr), s.second,
+                     &MetricsSeries::output);
+  }
+
+ private:
+  RequestMetrics() = default;
+
+  std::shared_ptr<ThreadMetrics> Register() {
+    auto local = std::make_shared<ThreadMetrics>();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    threads.push_back(local);
+
+    return local;
+  }
+
+  static void WriteHeader(std::ostream* stream, const char* name,
+                          const char* type, const char* help) {
+    *stream << "# HELP " << name << " " << help << "\n"
+            << "# TYPE " << name << " " << type << "\n";
+  }
+
+  /**
+   * @brief Записать число без потери точности.
+   *
+   * Целые значения (границы корзин размера, суммы байтов) записываются
+   * без показателя степени, остальные --- кратчайшей записью, которая
+   * читается обратно в то же значение (std::to_chars()).
+   */
+  static void WriteNumber(std::ostream* stream, double value) {
+    if (std::trunc(value) == value && std::fabs(value) < 0x1p63) {
+      *stream << static_cast<int64_t>(value);
+      return;
+    }
+
+    char digits[32];
+    char* last = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+
+    stream->write(digits, last - digits);
+  }
+
+  static std::string Labels(const std::pair<std::string, std::string>& key,
+                            const char* phase) {
+    std::string labels = "method=\"" + key.first + "\",type=\"" +
+                         key.second + "\"";
+
+    if (phase)
+      labels += std::string(",phase=\"") + phase + "\"";
+
+    return labels;
+  }
+
+  template<typename Buckets>
+  static void WriteHistogram(
+      std::ostream* stream, const char* name, const std::string& labels,
+      const std::vector<const MetricsSeries*>& series,
+      MetricsHistogram<Buckets> MetricsSeries::*histogram) {
+    std::vector<const MetricsHistogram<Buckets>*> parts;
+
+    for (const MetricsSeries* part : series)
+      parts.push_back(&(part->*histogram));
+
+    WriteHistogram(stream, name, labels, parts);
+  }
+
+  template<typename Buckets>
+  static void WriteHistogram(
+      std::ostream* stream, const char* name, const std::string& labels,
+      const std::vector<const MetricsHistogram<Buckets>*>& parts) {
+    uint64_t cumulative = 0, count = 0;
+    double sum = 0;
+
+    // Корзины в формате Prometheus накопленные: корзина le="x" содержит
+    // все значения, не превосходящие x.
+    for (size_t i = 0; i <= Buckets::kSize; i++) {
+      for (const MetricsHistogram<Buckets>* part : parts)
+        cumulative += part->Bucket(i);
+
+      *stream << name << "_bucket{" << labels << ",le=\"";
+
+      if (i < Buckets::kSize)
+        WriteNumber(stream, Buckets::kBounds[i]);
+      else
+        *stream << "+Inf";
+
+      *stream << "\"} " << cumulative << "\n";
+    }
+
+    for (const MetricsHistogram<Buckets>* part : parts) {
+      count += part->Count();
+      sum += part->Sum();
+    }
+
+    *stream << name << "_sum{" << labels << "} ";
+    WriteNumber(stream, sum);
+    *stream << "\n" << name << "_count{" << labels << "} " << count << "\n";
+  }
+};
+
+/**
+ * @brief Измерение обработки одного запроса.
+ *
+ * Объект создаётся в начале обработки запроса и записывает счётчики
+ * при уничтожении. Пока он существует, функции Type() и Mark(), которые
+ * вызываются из методов, относятся к нему; если измерение не идёт, они
+ * ничего не делают. Время между соседними вызовами Mark() добавляется
+ * к указанному этапу. Измерения могут быть вложенными (например, вызовы
+ * внутри /Batch): время вложенного измерения входит в следующий этап
+ * внешнего.
+ *
+ * Запрос считается ошибочным, если вызвана Fail() или измерение
+ * завершилось из-за исключения.
+ */
+class MetricsScope {
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  //! Текущее измерение потока.
+  static inline thread_local MetricsScope* current = nullptr;
+
+  //! Метод.
+  std::string method;
+  //! Тип координат.
+  std::string type = "unknown";
+  //! Время начала обработки.
+  Clock::time_point start;
+  //! Время последней отметки.
+  Clock::time_point last;
+  //! Время этапов.
+  std::array<double, MetricsSeries::kPhases> phases{};
+  //! Отмеченные этапы.
+  std::array<bool, MetricsSeries::kPhases> marked{};
+  //! Размеры запроса и ответа заданы.
+  bool sized = false;
+  //! Размер запроса.
+  size_t inputBytes = 0;
+  //! Размер ответа.
+  size_t outputBytes = 0;
+  //! Запрос завершился ошибкой.
+  bool failed = false;
+  //! Число исключений в полёте при создании.
+  int exceptions;
+  //! Внешнее измерение.
+  MetricsScope* previous;
+
+ public:
+  /**
+   * @brief Начать измерение.
+   *
+   * @param method Метод.
+   */
+  explicit MetricsScope(std::string method) :
+      method(std::move(method)),
+      start(Clock::now()),
+      last(start),
+      exceptions(std::uncaught_exceptions()),
+      previous(current) {
+    current = this;
+  }
+
+  MetricsScope(const MetricsScope&) = delete;
+  MetricsScope& operator=(const MetricsScope&) = delete;
+
+  //! Записать счётчики.
+  ~MetricsScope() {
+    current = previous;
+
+    if (std::uncaught_exceptions() > exceptions)
+      failed = true;
+
+    double total = Seconds(start, Clock::now());
+    MetricsSeries* series = RequestMetrics::Instance().Local(method, type);
+
+    for (size_t i = 0; i < phases.size(); i++) {
+      if (marked[i])
+        series->phases[i].Add(phases[i]);
+    }
+
+    series->total.Add(total);
+
+    if (sized) {
+      series->input.Add(static_cast<double>(inputBytes));
+      series->output.Add(static_cast<double>(outputBytes));
+    }
+
+    if (failed)
+      MetricsHistogram<SizeBuckets>::Bump(&series->errors, 1);
+  }
+
+  /**
+   * @brief Задать размеры запроса и ответа.
+   *
+   * @param input Размер запроса в байтах.
+   * @param output Размер ответа в байтах.
+   */
+  void Sizes(size_t input, size_t output) {
+    sized = true;
+    inputBytes = input;
+    outputBytes = output;
+  }
+
+  //! Отметить запрос как ошибочный.
+  void Fail() { failed = true; }
+
+  /**
+   * @brief Задать тип координат текущего измерения.
+   *
+   * Передаётся только название известного типа, проверенное методом,
+   * чтобы данные запроса не порождали новые ряды счётчиков. Если тип
+   * не задан, измерение относится к типу "unknown".
+   *
+   * @param type Тип координат.
+   */
+  static void Type(std::string_view type) {
+    if (current)
+      current->type = std::string(type);
+  }
+
+  /**
+   * @brief Закончить этап текущего измерения.
+   *
+   * @param phase Этап, к которому относится время с предыдущей отметки.
+   */
+  static void Mark(RequestPhase phase) {
+    if (!current)
+      return;
+
+    Clock::time_point now = Clock::now();
+    size_t i = static_cast<size_t>(phase);
+
+    current->phases[i] += Seconds(current->last, now);
+    current->marked[i] = true;
+    current->last = now;
+  }
+
+ private:
+  static double Seconds(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double>(to - from).count();
+  }
+};
+
+}  // namespace geometry
+
+#endif  // INCLUDE_REQUEST_METRICS_HPP_
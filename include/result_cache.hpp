@@ -0,0 +1,303 @@
+/**
+ * @file include/result_cache.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Кэш результатов запросов с вытеснением давно не использованных записей.
+ */
+
+#ifndef INCLUDE_RESULT_CACHE_HPP_
+#define INCLUDE_RESULT_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace geometry {
+
+/**
+ * @brief Кэш результатов запросов.
+ *
+ * Ключом записи служит пара (метод, текст запроса), а значением ---
+ * готовый текст ответа. Поэтому при попадании в кэш запрос не нужно
+ * ни разбирать, ни вычислять. Метод должен различать и формат запроса
+ * (например, "/GrahamScan" для JSON и "/GrahamScan:binary" для двоичного
+ * формата). Текст запроса сравнивается побайтно: запросы, отличающиеся
+ * только пробелами или порядком полей, считаются разными.
+ *
+ * Записи распределены по kShards независимым частям по значению
+ * хэш-функции Hash(). У каждой части свой мьютекс, список записей
+ * в порядке использования и своя доля объёма памяти, поэтому
+ * параллельные запросы блокируют друг друга, только если попадают
+ * в одну часть. Когда объём части превышен, из неё удаляются записи,
+ * которые дольше всего не использовались.
+ *
+ * Ответы хранятся в виде std::shared_ptr на константную строку, поэтому
+ * найденный ответ можно читать и после того, как запись вытеснена.
+ */
+class ResultCache {
+ public:
+  //! Число независимых частей кэша.
+  static constexpr size_t kShards = 16;
+  //! Оценка расходов памяти на одну запись сверх ключа и ответа.
+  static constexpr size_t kEntryOverhead = 160;
+
+ private:
+  //! Запись кэша.
+  struct Entry {
+    //! Значение хэш-функции ключа.
+    uint64_t hash;
+    //! Метод.
+    std::string method;
+    //! Текст запроса.
+    std::string input;
+    //! Текст ответа.
+    std::shared_ptr<const std::string> output;
+
+    //! Объём памяти, занимаемый записью.
+    size_t Bytes() const {
+      return method.size() + input.size() + output->size() + kEntryOverhead;
+    }
+  };
+
+  //! Независимая часть кэша.
+  struct Shard {
+    //! Мьютекс, защищающий список, таблицу и объём.
+    std::mutex mutex;
+    //! Записи в порядке использования (в начале --- последние).
+    std::list<Entry> entries;
+    //! Таблица записей по значению хэш-функции.
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+    //! Объём памяти, занимаемый записями.
+    size_t bytes = 0;
+    //! Число попаданий.
+    std::atomic<size_t> hits{0};
+    //! Число промахов.
+    std::atomic<size_t> misses{0};
+    //! Число вытесненных записей.
+    std::atomic<size_t> evictions{0};
+  };
+
+  //! Наибольший объём памяти, занимаемый записями (в байтах).
+  size_t capacity;
+  //! Части кэша.
+  std::vector<Shard> shards;
+
+ public:
+  /**
+   * @brief Создать кэш.
+   *
+   * @param capacity Наибольший объём памяти под записи в байтах (0
+   * отключает кэш). Каждой части отводится capacity / kShards байт,
+   * ответы большего размера не кэшируются.
+   */
+  explicit ResultCache(size_t capacity) :
+      capacity(capacity),
+      shards(kShards) { }
+
+  ResultCache(const ResultCache&) = delete;
+  ResultCache& operator=(const ResultCache&) = delete;
+
+  /**
+   * @brief Найти ответ на запрос.
+   *
+   * @param method Метод (вместе с форматом запроса).
+   * @param input Текст запроса.
+   * @return Текст ответа или nullptr, если запроса нет в кэше.
+   */
+  std::shared_ptr<const std::string> Find(const std::string& method,
+                                          const std::string& input) {
+    if (capacity == 0)
+      return nullptr;
+
+    uint64_t hash = Hash(method, input);
+    Shard& shard = shards[hash % kShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(hash);
+
+    // Совпадение хэша не гарантирует совпадения ключей.
+    if (it == shard.index.end() || it->second->method != method ||
+        it->second->input != input) {
+      shard.misses.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+    shard.hits.fetch_add(1, std::memory_order_relaxed);
+
+    return it->second->output;
+  }
+
+  /**
+   * @brief Добавить ответ на запрос.
+   *
+   * Запись с тем же значением хэш-функции заменяется.
+   *
+   * @param method Метод (вместе с форматом запроса).
+   * @param input Текст запроса.
+   * @param output Текст ответа.
+   * @return Сохранённый текст ответа.
+   */
+  std::shared_ptr<const std::string> Insert(const std::string& method,
+                                            const std::string& input,
+                                            std::string output) {
+    auto result = std::make_shared<const std::string>(std::move(output));
+    size_t limit = capacity / kShards;
+
+    if (method.size() + input.size() + result->size() + kEntryOverhead >
+        limit)
+      return result;
+
+    uint64_t hash = Hash(method, input);
+    Shard& shard = shards[hash % kShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.index.find(hash);
+
+    if (it != shard.index.end())
+      Erase(&shard, it->second);
+
+    shard.entries.push_front(Entry{hash, method, input, result});
+    shard.index[hash] = shard.entries.begin();
+    shard.bytes += shard.entries.front().Bytes();
+
+    while (shard.bytes > limit) {
+      Erase(&shard, std::prev(shard.entries.end()));
+      shard.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Удалить все записи.
+   */
+  void Clear() {
+    for (Shard& shard : shards) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      shard.entries.clear();
+      shard.index.clear();
+      shard.bytes = 0;
+    }
+  }
+
+  //! Наибольший объём памяти под записи в байтах.
+  size_t Capacity() const { return capacity; }
+
+  //! Число попаданий.
+  size_t Hits() const { return Sum(&Shard::hits); }
+
+  //! Число промахов.
+  size_t Misses() const { return Sum(&Shard::misses); }
+
+  //! Число вытесненных записей.
+  size_t Evictions() const { return Sum(&Shard::evictions); }
+
+  //! Число записей.
+  size_t Entries() {
+    size_t count = 0;
+
+    for (Shard& shard : shards) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      count += shard.entries.size();
+    }
+
+    return count;
+  }
+
+  //! Объём памяти, занимаемый записями.
+  size_t Bytes() {
+    size_t bytes = 0;
+
+    for (Shard& shard : shards) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+
+      bytes += shard.bytes;
+    }
+
+    return bytes;
+  }
+
+  /**
+   * @brief Хэш-функция ключа.
+   *
+   * Текст обрабатывается словами по 8 байт, каждое слово перемешивается
+   * умножением и циклическим сдвигом. Функция не криптографическая:
+   * ключи при попадании всё равно сравниваются целиком.
+   *
+   * @param method Метод.
+   * @param input Текст запроса.
+   * @return Значение хэш-функции.
+   */
+  static uint64_t Hash(const std::string& method, const std::string& input) {
+    uint64_t hash = Hash(method.data(), method.size(), 0x9e3779b97f4a7c15ULL);
+
+    return Hash(input.data(), input.size(), hash);
+  }
+
+ private:
+  static uint64_t Mix(uint64_t hash, uint64_t word) {
+    constexpr uint64_t kMultiplier = 0x87c37b91114253d5ULL;
+
+    word *= kMultiplier;
+    word = (word << 31) | (word >> 33);
+    hash ^= word * 0x4cf5ad432745937fULL;
+
+    return ((hash << 27) | (hash >> 37)) * 5 + 0x52dce729;
+  }
+
+  static uint64_t Hash(const char* data, size_t size, uint64_t seed) {
+    uint64_t hash = seed ^ size;
+    size_t i = 0;
+
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+      uint64_t word;
+
+      std::memcpy(&word, data + i, sizeof(word));
+      hash = Mix(hash, word);
+    }
+
+    uint64_t tail = 0;
+
+    std::memcpy(&tail, data + i, size - i);
+    hash = Mix(hash, tail);
+
+    // Завершающее перемешивание, чтобы все биты зависели от всех слов
+    // (номер части берётся из младших битов).
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+  }
+
+  static void Erase(Shard* shard, std::list<Entry>::iterator entry) {
+    shard->bytes -= entry->Bytes();
+    shard->index.erase(entry->hash);
+    shard->entries.erase(entry);
+  }
+
+  size_t Sum(std::atomic<size_t> Shard::*counter) const {
+    size_t sum = 0;
+
+    for (const Shard& shard : shards)
+      sum += (shard.*counter).load(std::memory_order_relaxed);
+
+    return sum;
+  }
+};
+
+}  // namespace geometry
+
+#endif  // INCLUDE_RESULT_CACHE_HPP_
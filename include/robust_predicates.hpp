@@ -0,0 +1,431 @@
+/**
+ * @file include/robust_predicates.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Устойчивые предикаты ориентации и принадлежности кругу. Предикаты
+ * сначала вычисляются в арифметике с плавающей точкой с оценкой
+ * погрешности, а если знак определить не удалось, то точно
+ * в арифметике разложений (expansions) Шевчука.
+ */
+
+#ifndef INCLUDE_ROBUST_PREDICATES_HPP_
+#define INCLUDE_ROBUST_PREDICATES_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <point.hpp>
+
+namespace geometry {
+
+namespace detail {
+
+/**
+ * @brief Число, представленное суммой неперекрывающихся слагаемых.
+ *
+ * @tparam F Тип слагаемых (double или long double).
+ * @tparam N Наибольшее число слагаемых.
+ *
+ * Слагаемые хранятся в порядке возрастания модуля, их сумма точно
+ * равна представляемому числу. Размер известен на этапе компиляции,
+ * поэтому разложения размещаются на стеке.
+ */
+template<typename F, size_t N>
+struct Expansion {
+  //! Слагаемые.
+  std::array<F, N> terms;
+  //! Число слагаемых.
+  size_t size = 0;
+};
+
+/**
+ * @brief Точно вычислить сумму двух чисел.
+ *
+ * @tparam F Тип чисел.
+ *
+ * @param a Первое слагаемое.
+ * @param b Второе слагаемое.
+ * @param error В эту переменную запишется погрешность округления.
+ * @return Округлённая сумма. Сумма результата и погрешности равна a + b.
+ */
+template<typename F>
+F TwoSum(F a, F b, F* error) {
+  F sum = a + b;
+  F bVirtual = sum - a;
+  F aVirtual = sum - bVirtual;
+
+  *error = (a - aVirtual) + (b - bVirtual);
+
+  return sum;
+}
+
+/**
+ * @brief Точно вычислить произведение двух чисел.
+ *
+ * @tparam F Тип чисел.
+ *
+ * @param a Первый множитель.
+ * @param b Второй множитель.
+ * @param error В эту переменную запишется погрешность округления.
+ * @return Округлённое произведение. Сумма результата и погрешности
+ * равна a * b.
+ */
+template<typename F>
+F TwoProduct(F a, F b, F* error) {
+  F product = a * b;
+
+  *error = std::fma(a, b, -product);
+
+  return product;
+}
+
+/**
+ * @brief Сложить два разложения.
+ *
+ * @tparam F Тип слагаемых.
+ * @tparam N Ёмкость первого разложения.
+ * @tparam M Ёмкость второго разложения.
+ * @tparam R Ёмкость результата (не меньше суммы размеров слагаемых).
+ *
+ * @param e Первое разложение.
+ * @param f Второе разложение.
+ * @param result Разложение суммы (без нулевых слагаемых).
+ *
+ * Слагаемые обоих разложений сливаются в порядке возрастания модуля
+ * и складываются каскадом точных сумм (алгоритм Fast-Expansion-Sum
+ * Шевчука), поэтому время работы линейно.
+ */
+template<typename F, size_t N, size_t M, size_t R>
+void Add(const Expansion<F, N>& e, const Expansion<F, M>& f,
+         Expansion<F, R>* result) {
+  size_t i = 0, j = 0;
+  auto next = [&]() {
+    if (j == f.size ||
+        (i < e.size && std::fabs(e.terms[i]) < std::fabs(f.terms[j])))
+      return e.terms[i++];
+
+    return f.terms[j++];
+  };
+
+  result->size = 0;
+
+  if (e.size + f.size == 0)
+    return;
+
+  F q = next();
+
+  while (i + j < e.size + f.size) {
+    F error = 0;
+
+    q = TwoSum(q, next(), &error);
+
+    if (error != 0)
+      result->terms[result->size++] = error;
+  }
+
+  if (q != 0)
+    result->terms[result->size++] = q;
+}
+
+/**
+ * @brief Умножить разложение на число.
+ *
+ * @tparam F Тип слагаемых.
+ * @tparam N Ёмкость разложения.
+ *
+ * @param e Разложение.
+ * @param b Множитель.
+ * @return Разложение произведения (без нулевых слагаемых).
+ */
+template<typename F, size_t N>
+Expansion<F, 2 * N> Scale(const Expansion<F, N>& e, F b) {
+  Expansion<F, 2 * N> result;
+
+  if (e.size == 0)
+    return result;
+
+  F error = 0;
+  F q = TwoProduct(e.terms[0], b, &error);
+
+  if (error != 0)
+    result.terms[result.size++] = error;
+
+  for (size_t i = 1; i < e.size; i++) {
+    F low = 0;
+    F high = TwoProduct(e.terms[i], b, &low);
+    F sum = TwoSum(q, low, &error);
+
+    if (error != 0)
+      result.terms[result.size++] = error;
+
+    q = TwoSum(high, sum, &error);
+
+    if (error != 0)
+      result.terms[result.size++] = error;
+  }
+
+  if (q != 0)
+    result.terms[result.size++] = q;
+
+  return result;
+}
+
+/**
+ * @brief Перемножить два разложения.
+ *
+ * @tparam F Тип слагаемых.
+ * @tparam N Ёмкость первого разложения.
+ * @tparam M Ёмкость второго разложения.
+ *
+ * @param e Первое разложение.
+ * @param f Второе разложение.
+ * @return Разложение произведения.
+ */
+template<typename F, size_t N, size_t M>
+Expansion<F, 2 * N * M> Multiply(const Expansion<F, N>& e,
+                                 const Expansion<F, M>& f) {
+  Expansion<F, 2 * N * M> buffers[2];
+  size_t current = 0;
+
+  for (size_t i = 0; i < f.size; i++) {
+    Add(buffers[current], Scale(e, f.terms[i]), &buffers[1 - current]);
+    current = 1 - current;
+  }
+
+  return buffers[current];
+}
+
+/**
+ * @brief Изменить знак разложения.
+ *
+ * @tparam F Тип слагаемых.
+ * @tparam N Ёмкость разложения.
+ *
+ * @param e Разложение.
+ * @return Разложение противоположного числа.
+ */
+template<typename F, size_t N>
+Expansion<F, N> Negate(Expansion<F, N> e) {
+  for (size_t i = 0; i < e.size; i++)
+    e.terms[i] = -e.terms[i];
+
+  return e;
+}
+
+/**
+ * @brief Вычислить знак разложения.
+ *
+ * @tparam F Тип слагаемых.
+ * @tparam N Ёмкость разложения.
+ *
+ * @param e Разложение.
+ * @return Знак старшего слагаемого.
+ */
+template<typename F, size_t N>
+int Sign(const Expansion<F, N>& e) {
+  if (e.size == 0)
+    return 0;
+
+  return e.terms[e.size - 1] > 0 ? 1 : -1;
+}
+
+/**
+ * @brief Точно вычислить разность двух чисел.
+ *
+ * @tparam F Тип чисел.
+ *
+ * @param a Уменьшаемое.
+ * @param b Вычитаемое.
+ * @return Разложение разности.
+ */
+template<typename F>
+Expansion<F, 2> Difference(F a, F b) {
+  Expansion<F, 2> result;
+  F error = 0;
+  F difference = TwoSum(a, -b, &error);
+
+  if (error != 0)
+    result.terms[result.size++] = error;
+  if (difference != 0)
+    result.terms[result.size++] = difference;
+
+  return result;
+}
+
+/**
+ * @brief Точно вычислить определитель $ x_1 y_2 - x_2 y_1 $.
+ *
+ * @tparam F Тип слагаемых.
+ * @tparam N Ёмкость разложений координат.
+ *
+ * @param x1 Первая координата первого вектора.
+ * @param y1 Вторая координата первого вектора.
+ * @param x2 Первая координата второго вектора.
+ * @param y2 Вторая координата второго вектора.
+ * @return Разложение определителя.
+ */
+template<typename F, size_t N>
+Expansion<F, 4 * N * N> Cross(const Expansion<F, N>& x1,
+                              const Expansion<F, N>& y1,
+                              const Expansion<F, N>& x2,
+                              const Expansion<F, N>& y2) {
+  Expansion<F, 4 * N * N> result;
+
+  Add(Multiply(x1, y2), Negate(Multiply(x2, y1)), &result);
+
+  return result;
+}
+
+/**
+ * @brief Точно вычислить определитель предиката InCircle.
+ *
+ * @tparam F Тип слагаемых.
+ * @tparam N Ёмкость разложений координат.
+ *
+ * @param d Разности координат: adx, ady, bdx, bdy, cdx, cdy.
+ * @return Знак определителя.
+ */
+template<typename F, size_t N>
+int ExactInCircle(const Expansion<F, N> (&d)[6]) {
+  auto term = [&d](size_t a, size_t b, size_t c) {
+    Expansion<F, 4 * N * N> lift;
+
+    Add(Multiply(d[a], d[a]), Multiply(d[a + 1], d[a + 1]), &lift);
+
+    return Multiply(lift, Cross(d[b], d[b + 1], d[c], d[c + 1]));
+  };
+
+  Expansion<F, 64 * N * N * N * N> partial;
+  Expansion<F, 96 * N * N * N * N> result;
+
+  Add(term(0, 2, 4), term(2, 4, 0), &partial);
+  Add(partial, term(4, 0, 2), &result);
+
+  return Sign(result);
+}
+
+/**
+ * @brief Тип, в котором вычисляются предикаты для координат типа T.
+ *
+ * Координаты типов float, double и int переводятся в double без потерь.
+ * Для long double и 64-битных целых используется long double.
+ */
+template<typename T>
+using PredicateType = std::conditional_t<
+    std::is_same_v<T, long double> ||
+    (std::is_integral_v<T> && sizeof(T) > 4), long double, double>;
+
+}  // namespace detail
+
+/**
+ * @brief Устойчиво вычислить ориентацию тройки точек.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param a Первая точка.
+ * @param b Вторая точка.
+ * @param c Третья точка.
+ * @return Функция возвращает 1, если точки перечислены против часовой
+ * стрелки, -1, если по часовой стрелке, и 0, если они лежат на одной
+ * прямой.
+ *
+ * Результат точен, если координаты представимы в типе вычислений
+ * без округления.
+ */
+template<typename T>
+int RobustOrientation(const Point<T>& a, const Point<T>& b,
+                      const Point<T>& c) {
+  using F = detail::PredicateType<T>;
+  using detail::Difference;
+
+  F ax = a.X(), ay = a.Y(), bx = b.X(), by = b.Y(), cx = c.X(), cy = c.Y();
+  F left = (bx - ax) * (cy - ay);
+  F right = (by - ay) * (cx - ax);
+  F determinant = left - right;
+  F epsilon = std::numeric_limits<F>::epsilon() / 2;
+  F bound = (3 + 16 * epsilon) * epsilon * (std::fabs(left) +
+                                            std::fabs(right));
+
+  if (determinant > bound || -determinant > bound)
+    return determinant > 0 ? 1 : -1;
+
+  return detail::Sign(detail::Cross(Difference(bx, ax), Difference(by, ay),
+                                    Difference(cx, ax), Difference(cy, ay)));
+}
+
+/**
+ * @brief Устойчиво проверить, лежит ли точка внутри описанной окружности.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param a Первая вершина треугольника.
+ * @param b Вторая вершина треугольника.
+ * @param c Третья вершина треугольника.
+ * @param d Проверяемая точка.
+ * @return Для треугольника abc, ориентированного против часовой стрелки,
+ * функция возвращает 1, если точка d лежит строго внутри описанной
+ * окружности, -1, если строго снаружи, и 0, если на окружности.
+ *
+ * Результат точен, если координаты представимы в типе вычислений
+ * без округления.
+ */
+template<typename T>
+int RobustInCircle(const Point<T>& a, const Point<T>& b, const Point<T>& c,
+                   const Point<T>& d) {
+  using F = detail::PredicateType<T>;
+  using detail::Difference;
+
+  F adx = F(a.X()) - F(d.X()), ady = F(a.Y()) - F(d.Y());
+  F bdx = F(b.X()) - F(d.X()), bdy = F(b.Y()) - F(d.Y());
+  F cdx = F(c.X()) - F(d.X()), cdy = F(c.Y()) - F(d.Y());
+
+  F bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+  F cdxady = cdx * ady, adxcdy = adx * cdy;
+  F adxbdy = adx * bdy, bdxady = bdx * ady;
+  F alift = adx * adx + ady * ady;
+  F blift = bdx * bdx + bdy * bdy;
+  F clift = cdx * cdx + cdy * cdy;
+
+  F determinant = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) +
+                  clift * (adxbdy - bdxady);
+  F permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * alift +
+                (std::fabs(cdxady) + std::fabs(adxcdy)) * blift +
+                (std::fabs(adxbdy) + std::fabs(bdxady)) * clift;
+  F epsilon = std::numeric_limits<F>::epsilon() / 2;
+  F bound = (10 + 96 * epsilon) * epsilon * permanent;
+
+  if (determinant > bound || -determinant > bound)
+    return determinant > 0 ? 1 : -1;
+
+  detail::Expansion<F, 2> exact[6] = {
+    Difference(F(a.X()), F(d.X())), Difference(F(a.Y()), F(d.Y())),
+    Difference(F(b.X()), F(d.X())), Difference(F(b.Y()), F(d.Y())),
+    Difference(F(c.X()), F(d.X())), Difference(F(c.Y()), F(d.Y()))
+  };
+
+  // Если разности вычислены без округления (например, для целых
+  // координат), определитель считается по однокомпонентным разложениям.
+  if (std::all_of(std::begin(exact), std::end(exact),
+                  [](const detail::Expansion<F, 2>& e) {
+                    return e.size <= 1;
+                  })) {
+    detail::Expansion<F, 1> simple[6];
+
+    for (size_t i = 0; i < 6; i++) {
+      simple[i].size = exact[i].size;
+      simple[i].terms[0] = exact[i].size == 0 ? 0 : exact[i].terms[0];
+    }
+
+    return detail::ExactInCircle(simple);
+  }
+
+  return detail::ExactInCircle(exact);
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_ROBUST_PREDICATES_HPP_
@@ -0,0 +1,499 @@
+/**
+ * @file include/rtree.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Статическое R-дерево над набором прямоугольников с пакетной загрузкой
+ * методом STR (Sort-Tile-Recursive).
+ */
+
+#ifndef INCLUDE_RTREE_HPP_
+#define INCLUDE_RTREE_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <point.hpp>
+#include "rectangle.h"
+
+namespace geometry {
+
+/**
+ * @brief Статическое R-дерево.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam FanOut Максимальное число потомков узла.
+ *
+ * Дерево строится один раз по заданному набору прямоугольников методом
+ * STR: прямоугольники сортируются по абсциссе центра, делятся на
+ * вертикальные полосы, каждая полоса сортируется по ординате центра
+ * и нарезается на листья по FanOut прямоугольников. Затем та же
+ * процедура применяется к ограничивающим прямоугольникам листьев и так
+ * далее до корня.
+ *
+ * Все узлы хранятся в одном массиве, потомки каждого узла занимают
+ * непрерывный отрезок этого массива (или массива прямоугольников для
+ * листьев), поэтому дерево не выполняет выделений памяти на узел.
+ * Значение FanOut по умолчанию подобрано так, чтобы границы потомков
+ * узла занимали несколько строк кэша.
+ *
+ * Запросы возвращают номера прямоугольников в исходном наборе.
+ */
+template<typename T, size_t FanOut = 16>
+class RTree {
+  static_assert(FanOut >= 2, "RTree requires FanOut >= 2");
+
+ private:
+  /**
+   * @brief Ограничивающий прямоугольник.
+   */
+  struct Box {
+    //! Минимальная абсцисса.
+    T minX;
+    //! Минимальная ордината.
+    T minY;
+    //! Максимальная абсцисса.
+    T maxX;
+    //! Максимальная ордината.
+    T maxY;
+  };
+
+  /**
+   * @brief Узел дерева.
+   */
+  struct Node {
+    //! Ограничивающий прямоугольник узла.
+    Box box;
+    //! Номер первого потомка (узла или прямоугольника для листа).
+    uint32_t first;
+    //! Число потомков.
+    uint32_t count;
+  };
+
+  //! Прямоугольники в порядке обхода листьев.
+  std::vector<Box> entries;
+  //! Номера прямоугольников в исходном наборе.
+  std::vector<size_t> ids;
+  //! Узлы дерева, начиная с листьев. Корень хранится последним.
+  std::vector<Node> nodes;
+  //! Число листьев.
+  size_t leaves;
+
+  //! Тип квадрата расстояния. Вычисления в long double заметно медленнее,
+  //! поэтому он используется только для координат типа long double.
+  using DistanceType = std::conditional_t<std::is_same_v<T, long double>,
+                                          long double, double>;
+
+ public:
+  /**
+   * @brief Построить дерево.
+   *
+   * @param rectangles Набор прямоугольников.
+   *
+   * Время построения \f$ O(n \log n) \f$.
+   */
+  explicit RTree(const std::vector<Rectangle<T>>& rectangles);
+
+  /**
+   * @brief Получить число прямоугольников в дереве.
+   * @return Число прямоугольников.
+   */
+  size_t Size() const { return entries.size(); }
+
+  /**
+   * @brief Получить высоту дерева.
+   * @return Число уровней дерева (0 для пустого дерева).
+   */
+  size_t Height() const;
+
+  /**
+   * @brief Найти прямоугольники, пересекающие окно.
+   *
+   * @tparam OutputIterator Тип итератора вывода.
+   *
+   * @param window Окно запроса.
+   * @param output Итератор, в который записываются номера прямоугольников.
+   * @return Итератор вывода после записи результата.
+   *
+   * Прямоугольники, касающиеся окна границей, также считаются
+   * пересекающими его.
+   */
+  template<typename OutputIterator>
+  OutputIterator Window(const Rectangle<T>& window,
+                        OutputIterator output) const {
+    Box query = MakeBox(window);
+
+    return Search([&query](const Box& box) { return Overlaps(box, query); },
+                  output);
+  }
+
+  /**
+   * @brief Найти прямоугольники, содержащие точку.
+   *
+   * @tparam OutputIterator Тип итератора вывода.
+   *
+   * @param point Точка запроса.
+   * @param output Итератор, в который записываются номера прямоугольников.
+   * @return Итератор вывода после записи результата.
+   */
+  template<typename OutputIterator>
+  OutputIterator Stab(const Point<T>& point, OutputIterator output) const {
+    Box query{point.X(), point.Y(), point.X(), point.Y()};
+
+    return Search([&query](const Box& box) { return Overlaps(box, query); },
+                  output);
+  }
+
+  /**
+   * @brief Найти k ближайших к точке прямоугольников.
+   *
+   * @param point Точка запроса.
+   * @param k Число прямоугольников.
+   * @return Номера прямоугольников в порядке возрастания расстояния.
+   *
+   * Расстояние от точки до прямоугольника равно нулю, если точка лежит
+   * внутри прямоугольника. Узлы обходятся в порядке возрастания
+   * расстояния до их ограничивающих прямоугольников (поиск "сначала
+   * лучший"), а k лучших найденных прямоугольников хранятся в куче.
+   * Обход прекращается, как только ближайший необработанный узел
+   * оказывается дальше k-го найденного прямоугольника.
+   */
+  std::vector<size_t> Nearest(const Point<T>& point, size_t k) const;
+
+ private:
+  /**
+   * @brief Перевести прямоугольник в ограничивающий прямоугольник.
+   *
+   * @param rectangle Прямоугольник.
+   * @return Ограничивающий прямоугольник с упорядоченными границами.
+   */
+  static Box MakeBox(const Rectangle<T>& rectangle) {
+    return Box{std::min(rectangle.sw.X(), rectangle.ne.X()),
+               std::min(rectangle.sw.Y(), rectangle.ne.Y()),
+               std::max(rectangle.sw.X(), rectangle.ne.X()),
+               std::max(rectangle.sw.Y(), rectangle.ne.Y())};
+  }
+
+  /**
+   * @brief Проверить, пересекаются ли прямоугольники.
+   *
+   * @param a Первый прямоугольник.
+   * @param b Второй прямоугольник.
+   * @return Булево значение.
+   */
+  static bool Overlaps(const Box& a, const Box& b) {
+    return a.minX <= b.maxX && b.minX <= a.maxX &&
+           a.minY <= b.maxY && b.minY <= a.maxY;
+  }
+
+  /**
+   * @brief Вычислить квадрат расстояния от точки до прямоугольника.
+   *
+   * @param box Прямоугольник.
+   * @param point Точка.
+   * @return Квадрат расстояния.
+   */
+  static DistanceType Distance(const Box& box, const Point<T>& point) {
+    DistanceType dx = 0, dy = 0;
+
+    if (point.X() < box.minX)
+      dx = static_cast<DistanceType>(box.minX) - point.X();
+    else if (point.X() > box.maxX)
+      dx = static_cast<DistanceType>(point.X()) - box.maxX;
+
+    if (point.Y() < box.minY)
+      dy = static_cast<DistanceType>(box.minY) - point.Y();
+    else if (point.Y() > box.maxY)
+      dy = static_cast<DistanceType>(point.Y()) - box.maxY;
+
+    return dx * dx + dy * dy;
+  }
+
+  /**
+   * @brief Объединить ограничивающие прямоугольники.
+   *
+   * @param a Первый прямоугольник.
+   * @param b Второй прямоугольник.
+   * @return Наименьший прямоугольник, содержащий оба.
+   */
+  static Box Union(const Box& a, const Box& b) {
+    return Box{std::min(a.minX, b.minX), std::min(a.minY, b.minY),
+               std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY)};
+  }
+
+  /**
+   * @brief Упорядочить прямоугольники методом STR.
+   *
+   * @param boxes Прямоугольники.
+   * @param order Перестановка, которую нужно упорядочить.
+   */
+  static void SortTileRecursive(const std::vector<Box>& boxes,
+                                std::vector<size_t>* order);
+
+  /**
+   * @brief Построить уровень дерева.
+   *
+   * @param boxes Ограничивающие прямоугольники узлов предыдущего уровня.
+   * @param offset Номер первого элемента предыдущего уровня.
+   */
+  void BuildLevel(const std::vector<Box>& boxes, size_t offset);
+
+  /**
+   * @brief Обойти дерево, отбирая узлы предикатом.
+   *
+   * @tparam Predicate Тип предиката.
+   * @tparam OutputIterator Тип итератора вывода.
+   *
+   * @param predicate Предикат, которому должны удовлетворять
+   * ограничивающие прямоугольники узлов и сами прямоугольники.
+   * @param output Итератор, в который записываются номера прямоугольников.
+   * @return Итератор вывода после записи результата.
+   */
+  template<typename Predicate, typename OutputIterator>
+  OutputIterator Search(Predicate predicate, OutputIterator output) const {
+    if (nodes.empty())
+      return output;
+
+    return Search(nodes.back(), predicate, output);
+  }
+
+  /**
+   * @brief Обойти поддерево, отбирая узлы предикатом.
+   *
+   * @tparam Predicate Тип предиката.
+   * @tparam OutputIterator Тип итератора вывода.
+   *
+   * @param node Корень поддерева.
+   * @param predicate Предикат.
+   * @param output Итератор, в который записываются номера прямоугольников.
+   * @return Итератор вывода после записи результата.
+   *
+   * Глубина рекурсии равна высоте дерева, поэтому обход не выделяет
+   * память.
+   */
+  template<typename Predicate, typename OutputIterator>
+  OutputIterator Search(const Node& node, Predicate& predicate,
+                        OutputIterator output) const {
+    if (!predicate(node.box))
+      return output;
+
+    if (IsLeaf(node)) {
+      for (size_t i = node.first; i < node.first + node.count; i++) {
+        if (predicate(entries[i]))
+          *output++ = ids[i];
+      }
+    } else {
+      for (size_t i = node.first; i < node.first + node.count; i++)
+        output = Search(nodes[i], predicate, output);
+    }
+
+    return output;
+  }
+
+  /**
+   * @brief Проверить, является ли узел листом.
+   *
+   * @param node Узел.
+   * @return Булево значение.
+   */
+  bool IsLeaf(const Node& node) const {
+    return static_cast<size_t>(&node - nodes.data()) < leaves;
+  }
+};
+
+template<typename T, size_t FanOut>
+RTree<T, FanOut>::RTree(const std::vector<Rectangle<T>>& rectangles) :
+    entries(), ids(rectangles.size()), nodes(), leaves(0) {
+  std::vector<Box> boxes;
+
+  boxes.reserve(rectangles.size());
+
+  for (const Rectangle<T>& rectangle : rectangles)
+    boxes.push_back(MakeBox(rectangle));
+
+  for (size_t i = 0; i < ids.size(); i++)
+    ids[i] = i;
+
+  SortTileRecursive(boxes, &ids);
+
+  entries.reserve(boxes.size());
+
+  for (size_t id : ids)
+    entries.push_back(boxes[id]);
+
+  if (entries.empty())
+    return;
+
+  // Листья ссылаются на отрезки массива entries.
+  for (size_t first = 0; first < entries.size(); first += FanOut) {
+    size_t count = std::min(FanOut, entries.size() - first);
+    Box box = entries[first];
+
+    for (size_t i = first + 1; i < first + count; i++)
+      box = Union(box, entries[i]);
+
+    nodes.push_back(Node{box, static_cast<uint32_t>(first),
+                         static_cast<uint32_t>(count)});
+  }
+
+  leaves = nodes.size();
+
+  size_t offset = 0;
+
+  while (nodes.size() - offset > 1) {
+    std::vector<Box> level;
+    size_t end = nodes.size();
+
+    level.reserve(end - offset);
+
+    for (size_t i = offset; i < end; i++)
+      level.push_back(nodes[i].box);
+
+    BuildLevel(level, offset);
+    offset = end;
+  }
+}
+
+template<typename T, size_t FanOut>
+void RTree<T, FanOut>::SortTileRecursive(const std::vector<Box>& boxes,
+                                         std::vector<size_t>* order) {
+  auto centerX = [&boxes](size_t i) {
+    return static_cast<long double>(boxes[i].minX) + boxes[i].maxX;
+  };
+  auto centerY = [&boxes](size_t i) {
+    return static_cast<long double>(boxes[i].minY) + boxes[i].maxY;
+  };
+
+  std::sort(order->begin(), order->end(), [&](size_t a, size_t b) {
+    return centerX(a) < centerX(b);
+  });
+
+  size_t pages = (order->size() + FanOut - 1) / FanOut;
+  size_t slices = static_cast<size_t>(
+      std::ceil(std::sqrt(static_cast<long double>(pages))));
+  size_t sliceSize = slices * FanOut;
+
+  for (size_t first = 0; first < order->size(); first += sliceSize) {
+    auto begin = order->begin() + first;
+    auto end = order->begin() + std::min(first + sliceSize, order->size());
+
+    std::sort(begin, end, [&](size_t a, size_t b) {
+      return centerY(a) < centerY(b);
+    });
+  }
+}
+
+template<typename T, size_t FanOut>
+void RTree<T, FanOut>::BuildLevel(const std::vector<Box>& boxes,
+                                  size_t offset) {
+  std::vector<size_t> order(boxes.size());
+
+  for (size_t i = 0; i < order.size(); i++)
+    order[i] = i;
+
+  SortTileRecursive(boxes, &order);
+
+  // Потомки узла должны идти подряд, поэтому узлы предыдущего уровня
+  // переставляются в порядке STR.
+  std::vector<Node> level;
+
+  level.reserve(order.size());
+
+  for (size_t i : order)
+    level.push_back(nodes[offset + i]);
+
+  std::copy(level.begin(), level.end(), nodes.begin() + offset);
+
+  for (size_t first = 0; first < level.size(); first += FanOut) {
+    size_t count = std::min(FanOut, level.size() - first);
+    Box box = level[first].box;
+
+    for (size_t i = first + 1; i < first + count; i++)
+      box = Union(box, level[i].box);
+
+    nodes.push_back(Node{box, static_cast<uint32_t>(offset + first),
+                         static_cast<uint32_t>(count)});
+  }
+}
+
+template<typename T, size_t FanOut>
+size_t RTree<T, FanOut>::Height() const {
+  size_t height = 0;
+
+  if (nodes.empty())
+    return height;
+
+  for (size_t i = nodes.size() - 1; ; i = nodes[i].first) {
+    height++;
+
+    if (IsLeaf(nodes[i]))
+      break;
+  }
+
+  return height;
+}
+
+template<typename T, size_t FanOut>
+std::vector<size_t> RTree<T, FanOut>::Nearest(const Point<T>& point,
+                                              size_t k) const {
+  std::vector<size_t> result;
+
+  if (nodes.empty() || k == 0)
+    return result;
+
+  using Item = std::pair<DistanceType, size_t>;
+
+  // Очередь узлов по возрастанию расстояния и k лучших прямоугольников
+  // с наибольшим расстоянием на вершине.
+  std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+  std::priority_queue<Item> best;
+
+  queue.push(Item(Distance(nodes.back().box, point), nodes.size() - 1));
+
+  while (!queue.empty()) {
+    Item item = queue.top();
+    queue.pop();
+
+    // Все оставшиеся узлы дальше k-го найденного прямоугольника.
+    if (best.size() == k && item.first > best.top().first)
+      break;
+
+    const Node& node = nodes[item.second];
+
+    for (size_t i = node.first; i < node.first + node.count; i++) {
+      if (IsLeaf(node)) {
+        Item entry(Distance(entries[i], point), i);
+
+        if (best.size() < k) {
+          best.push(entry);
+        } else if (entry < best.top()) {
+          best.pop();
+          best.push(entry);
+        }
+      } else {
+        DistanceType distance = Distance(nodes[i].box, point);
+
+        if (best.size() < k || distance <= best.top().first)
+          queue.push(Item(distance, i));
+      }
+    }
+  }
+
+  result.resize(best.size());
+
+  for (size_t i = result.size(); i > 0; i--) {
+    result[i - 1] = ids[best.top().second];
+    best.pop();
+  }
+
+  return result;
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_RTREE_HPP_
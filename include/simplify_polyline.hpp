@@ -0,0 +1,388 @@
+/**
+ * @file include/simplify_polyline.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Упрощение ломаных алгоритмами Дугласа-Пекера и Висвалингам-Уайатта,
+ * в том числе в потоковом режиме с ограниченной памятью.
+ */
+
+#ifndef INCLUDE_SIMPLIFY_POLYLINE_HPP_
+#define INCLUDE_SIMPLIFY_POLYLINE_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <queue>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <point.hpp>
+
+namespace geometry {
+
+/**
+ * Алгоритм упрощения ломаной.
+ */
+enum class SimplifyMethod {
+  DouglasPeucker,
+  Visvalingam
+};
+
+namespace detail {
+
+/**
+ * @brief Тип, в котором вычисляются расстояния и площади.
+ *
+ * Вычисления в long double заметно медленнее, поэтому он используется
+ * только для координат типа long double.
+ */
+template<typename T>
+using SimplifyType = std::conditional_t<std::is_same_v<T, long double>,
+                                        long double, double>;
+
+/**
+ * @brief Вычислить квадрат расстояния от точки до отрезка.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param point Точка.
+ * @param a Начало отрезка.
+ * @param b Конец отрезка.
+ * @return Квадрат расстояния.
+ */
+template<typename T>
+SimplifyType<T> SegmentDistance(const Point<T>& point, const Point<T>& a,
+                                const Point<T>& b) {
+  using F = SimplifyType<T>;
+
+  F dx = static_cast<F>(b.X()) - a.X(), dy = static_cast<F>(b.Y()) - a.Y();
+  F px = static_cast<F>(point.X()) - a.X();
+  F py = static_cast<F>(point.Y()) - a.Y();
+  F length = dx * dx + dy * dy;
+
+  if (length > 0) {
+    F t = std::fmin(F(1), std::fmax(F(0), (px * dx + py * dy) / length));
+
+    px -= t * dx;
+    py -= t * dy;
+  }
+
+  return px * px + py * py;
+}
+
+/**
+ * @brief Вычислить площадь треугольника.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param a Первая вершина.
+ * @param b Вторая вершина.
+ * @param c Третья вершина.
+ * @return Площадь треугольника (неотрицательна).
+ */
+template<typename T>
+SimplifyType<T> TriangleArea(const Point<T>& a, const Point<T>& b,
+                             const Point<T>& c) {
+  using F = SimplifyType<T>;
+
+  F abx = static_cast<F>(b.X()) - a.X(), aby = static_cast<F>(b.Y()) - a.Y();
+  F acx = static_cast<F>(c.X()) - a.X(), acy = static_cast<F>(c.Y()) - a.Y();
+
+  return std::fabs(abx * acy - aby * acx) / 2;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Упростить ломаную алгоритмом Дугласа-Пекера.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param points Указатель на непрерывный массив вершин ломаной.
+ * @param size Число вершин.
+ * @param tolerance Максимальное допустимое расстояние от удалённой
+ * вершины до упрощённой ломаной.
+ * @return Номера сохранённых вершин по возрастанию. Первая и последняя
+ * вершины сохраняются всегда.
+ *
+ * Вместо рекурсии используется явный стек отрезков, поэтому глубина
+ * вложенности не ограничена размером стека вызовов. В худшем случае
+ * алгоритм работает за \f$ O(n^2) \f$, обычно --- за \f$ O(n \log n) \f$.
+ */
+template<typename T>
+std::vector<size_t> DouglasPeucker(const Point<T>* points, size_t size,
+                                   detail::SimplifyType<T> tolerance) {
+  std::vector<size_t> result;
+
+  if (size <= 2) {
+    for (size_t i = 0; i < size; i++)
+      result.push_back(i);
+
+    return result;
+  }
+
+  detail::SimplifyType<T> bound = tolerance * tolerance;
+  std::vector<char> keep(size, 0);
+  std::vector<std::pair<size_t, size_t>> stack;
+
+  keep[0] = keep[size - 1] = 1;
+  stack.emplace_back(0, size - 1);
+
+  while (!stack.empty()) {
+    auto [first, last] = stack.back();
+    detail::SimplifyType<T> farthest = -1;
+    size_t index = first;
+
+    stack.pop_back();
+
+    for (size_t i = first + 1; i < last; i++) {
+      detail::SimplifyType<T> distance =
+          detail::SegmentDistance(points[i], points[first], points[last]);
+
+      if (distance > farthest) {
+        farthest = distance;
+        index = i;
+      }
+    }
+
+    if (index == first || farthest <= bound)
+      continue;
+
+    keep[index] = 1;
+    stack.emplace_back(first, index);
+    stack.emplace_back(index, last);
+  }
+
+  for (size_t i = 0; i < size; i++) {
+    if (keep[i])
+      result.push_back(i);
+  }
+
+  return result;
+}
+
+/**
+ * @brief Упростить ломаную алгоритмом Висвалингам-Уайатта.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param points Указатель на непрерывный массив вершин ломаной.
+ * @param size Число вершин.
+ * @param tolerance Площадь, меньше которой треугольник, образованный
+ * вершиной и её соседями, считается несущественным.
+ * @return Номера сохранённых вершин по возрастанию. Первая и последняя
+ * вершины сохраняются всегда.
+ *
+ * Вершина с наименьшей площадью треугольника удаляется, после чего
+ * площади её соседей пересчитываются. Вершины хранятся в двусвязном
+ * списке на массивах, площади --- в двоичной куче. В кучу попадают
+ * только вершины, которые могут быть удалены (площадь меньше допуска).
+ * Устаревшие элементы кучи не удаляются, а пропускаются при извлечении,
+ * поэтому алгоритм работает за \f$ O(n \log n) \f$.
+ */
+template<typename T>
+std::vector<size_t> Visvalingam(const Point<T>* points, size_t size,
+                                detail::SimplifyType<T> tolerance) {
+  using AreaType = detail::SimplifyType<T>;
+  using Entry = std::pair<AreaType, size_t>;
+
+  std::vector<size_t> result;
+
+  if (size <= 2) {
+    for (size_t i = 0; i < size; i++)
+      result.push_back(i);
+
+    return result;
+  }
+
+  std::vector<size_t> previous(size), next(size);
+  std::vector<AreaType> area(size, 0);
+  std::vector<char> removed(size, 0);
+  std::vector<Entry> entries;
+
+  for (size_t i = 0; i < size; i++) {
+    previous[i] = i - 1;
+    next[i] = i + 1;
+  }
+
+  // Вершины с площадью не меньше допуска попадают в кучу, только когда
+  // их площадь уменьшится после удаления соседа.
+  for (size_t i = 1; i + 1 < size; i++) {
+    area[i] = detail::TriangleArea(points[i - 1], points[i], points[i + 1]);
+
+    if (area[i] < tolerance)
+      entries.emplace_back(area[i], i);
+  }
+
+  // Начальная куча строится за линейное время.
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>
+      heap(std::greater<Entry>(), std::move(entries));
+
+  while (!heap.empty()) {
+    auto [value, i] = heap.top();
+
+    heap.pop();
+
+    if (removed[i] || value != area[i])
+      continue;
+
+    removed[i] = 1;
+    next[previous[i]] = next[i];
+    previous[next[i]] = previous[i];
+
+    for (size_t j : { previous[i], next[i] }) {
+      if (j == 0 || j == size - 1)
+        continue;
+
+      area[j] = detail::TriangleArea(points[previous[j]], points[j],
+                                     points[next[j]]);
+
+      if (area[j] < tolerance)
+        heap.emplace(area[j], j);
+    }
+  }
+
+  for (size_t i = 0; i < size; i++) {
+    if (!removed[i])
+      result.push_back(i);
+  }
+
+  return result;
+}
+
+/**
+ * @brief Упростить ломаную выбранным алгоритмом.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param method Алгоритм упрощения.
+ * @param points Указатель на непрерывный массив вершин ломаной.
+ * @param size Число вершин.
+ * @param tolerance Допуск (расстояние или площадь в зависимости
+ * от алгоритма).
+ * @return Номера сохранённых вершин по возрастанию.
+ */
+template<typename T>
+std::vector<size_t> SimplifyPolyline(SimplifyMethod method,
+                                     const Point<T>* points, size_t size,
+                                     detail::SimplifyType<T> tolerance) {
+  if (method == SimplifyMethod::Visvalingam)
+    return Visvalingam(points, size, tolerance);
+
+  return DouglasPeucker(points, size, tolerance);
+}
+
+/**
+ * @brief Потоковое упрощение ломаной с ограниченной памятью.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * Вершины поступают по одной и накапливаются в окне размера window.
+ * Когда окно заполняется, оно упрощается выбранным алгоритмом,
+ * сохранённые вершины (кроме последней) выводятся, а последняя вершина
+ * становится началом следующего окна. Поэтому память ограничена
+ * размером окна независимо от длины ломаной. Границы окон всегда
+ * сохраняются, из-за чего результат может содержать немного больше
+ * вершин, чем упрощение всей ломаной сразу.
+ */
+template<typename T>
+class PolylineSimplifier {
+ private:
+  //! Алгоритм упрощения.
+  SimplifyMethod method;
+  //! Допуск.
+  detail::SimplifyType<T> tolerance;
+  //! Максимальное число вершин в окне.
+  size_t window;
+  //! Текущее окно.
+  std::vector<Point<T>> buffer;
+
+ public:
+  /**
+   * @brief Создать упрощение ломаной.
+   *
+   * @param method Алгоритм упрощения.
+   * @param tolerance Допуск (расстояние или площадь в зависимости
+   * от алгоритма).
+   * @param window Максимальное число вершин в окне (не меньше 3).
+   */
+  PolylineSimplifier(SimplifyMethod method,
+                     detail::SimplifyType<T> tolerance, size_t window) :
+      method(method),
+      tolerance(tolerance),
+      window(window < 3 ? 3 : window) {
+    buffer.reserve(this->window);
+  }
+
+  /**
+   * @brief Добавить очередную вершину ломаной.
+   *
+   * @tparam OutputIterator Тип итератора вывода.
+   *
+   * @param point Вершина.
+   * @param output Итератор, в который записываются окончательно
+   * сохранённые вершины.
+   * @return Итератор вывода после записи.
+   */
+  template<typename OutputIterator>
+  OutputIterator Push(const Point<T>& point, OutputIterator output) {
+    buffer.push_back(point);
+
+    if (buffer.size() < window)
+      return output;
+
+    return Flush(output, false);
+  }
+
+  /**
+   * @brief Завершить ломаную.
+   *
+   * @tparam OutputIterator Тип итератора вывода.
+   *
+   * @param output Итератор, в который записываются оставшиеся вершины.
+   * @return Итератор вывода после записи.
+   *
+   * После вызова объект можно использовать для новой ломаной.
+   */
+  template<typename OutputIterator>
+  OutputIterator Finish(OutputIterator output) {
+    output = Flush(output, true);
+    buffer.clear();
+
+    return output;
+  }
+
+ private:
+  /**
+   * @brief Упростить окно и вывести сохранённые вершины.
+   *
+   * @param output Итератор вывода.
+   * @param last Является ли окно последним.
+   * @return Итератор вывода после записи.
+   */
+  template<typename OutputIterator>
+  OutputIterator Flush(OutputIterator output, bool last) {
+    if (buffer.empty())
+      return output;
+
+    std::vector<size_t> kept = SimplifyPolyline(method, buffer.data(),
+                                                buffer.size(), tolerance);
+    size_t count = last ? kept.size() : kept.size() - 1;
+
+    for (size_t i = 0; i < count; i++)
+      *output++ = buffer[kept[i]];
+
+    if (!last) {
+      Point<T> tail = buffer.back();
+
+      buffer.clear();
+      buffer.push_back(tail);
+    }
+
+    return output;
+  }
+};
+
+}  // namespace geometry
+
+#endif  // INCLUDE_SIMPLIFY_POLYLINE_HPP_
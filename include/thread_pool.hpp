@@ -0,0 +1,259 @@
+/**
+ * @file include/thread_pool.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Пул рабочих потоков с общей очередью задач.
+ */
+
+#ifndef INCLUDE_THREAD_POOL_HPP_
+#define INCLUDE_THREAD_POOL_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace geometry {
+
+/**
+ * @brief Пул рабочих потоков.
+ *
+ * Задачи выполняются в порядке поступления фиксированным числом потоков.
+ * В отличие от ParallelFor(), который создаёт потоки на время одного
+ * цикла, пул живёт долго и обслуживает независимые задачи, например
+ * запросы к серверу.
+ *
+ * По запросу каждый поток закрепляется за одним ядром (поток i за ядром
+ * i по модулю числа ядер). Это уменьшает миграцию потоков между ядрами
+ * и сохраняет кэш при однородной нагрузке. Закрепление поддерживается
+ * только в Linux, в остальных системах флаг игнорируется.
+ */
+class ThreadPool {
+ private:
+  //! Рабочие потоки.
+  std::vector<std::thread> workers;
+  //! Очередь задач.
+  std::queue<std::function<void()>> tasks;
+  //! Мьютекс, защищающий очередь и флаг остановки.
+  std::mutex mutex;
+  //! Условная переменная для ожидания задач.
+  std::condition_variable condition;
+  //! Пул остановлен: новые задачи не принимаются.
+  bool stopped = false;
+  //! Потоки закреплены за ядрами.
+  bool pinned = false;
+
+ public:
+  /**
+   * @brief Запустить пул.
+   *
+   * @param threads Число потоков (не меньше 1).
+   * @param affinity Закрепить потоки за ядрами.
+   */
+  explicit ThreadPool(size_t threads, bool affinity = false) {
+    threads = std::max<size_t>(threads, 1);
+    workers.reserve(threads);
+
+    for (size_t i = 0; i < threads; i++) {
+      workers.emplace_back([this]() { Work(); });
+
+      if (affinity)
+        pinned = Pin(&workers.back(), i) || pinned;
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * @brief Остановить пул, выполнив оставшиеся задачи.
+   */
+  ~ThreadPool() {
+    Shutdown();
+  }
+
+  /**
+   * @brief Добавить задачу в очередь.
+   *
+   * @param task Задача.
+   * @return false, если пул уже остановлен и задача не принята.
+   */
+  bool Enqueue(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      if (stopped)
+        return false;
+
+      tasks.push(std::move(task));
+    }
+
+    condition.notify_one();
+
+    return true;
+  }
+
+  /**
+   * @brief Выполнить задачи, оставшиеся в очереди, и завершить потоки.
+   *
+   * Повторный вызов ничего не делает.
+   */
+  void Shutdown() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+
+      stopped = true;
+    }
+
+    condition.notify_all();
+
+    for (std::thread& worker : workers) {
+      if (worker.joinable())
+        worker.join();
+    }
+  }
+
+  /**
+   * @brief Выполнить функцию для каждого номера из диапазона на потоках
+   * пула.
+   *
+   * @tparam Function Тип функции.
+   *
+   * @param count Число задач.
+   * @param function Функция, принимающая номер задачи.
+   *
+   * В отличие от ParallelFor() потоки не создаются: в очередь пула
+   * добавляются помощники, которые вместе с вызывающим потоком разбирают
+   * номера по одному. Вызывающий поток сам выполняет все номера, которые
+   * не успели взять помощники, поэтому функцию можно вызывать и из задачи
+   * этого же пула: даже если все потоки заняты, она не ждёт очереди.
+   * Функция должна быть безопасна для одновременного вызова с разными
+   * номерами.
+   *
+   * Исключение, выброшенное функцией, не завершает поток пула: первое
+   * из них запоминается и повторно выбрасывается в вызывающем потоке
+   * после того, как обработаны все номера.
+   */
+  template<typename Function>
+  void ParallelFor(size_t count, Function function) {
+    // Помощник может начать работу уже после возврата из функции, поэтому
+    // общее состояние живёт, пока на него есть ссылки.
+    struct State {
+      Function function;
+      size_t count;
+      std::atomic<size_t> next{0};
+      std::mutex mutex;
+      std::condition_variable condition;
+      size_t done = 0;
+      std::exception_ptr error;
+
+      State(Function function, size_t count) :
+          function(std::move(function)),
+          count(count) { }
+
+      void Run() {
+        for (size_t i = next++; i < count; i = next++) {
+          std::exception_ptr exception;
+
+          try {
+            function(i);
+          } catch (...) {
+            exception = std::current_exception();
+          }
+
+          std::lock_guard<std::mutex> lock(mutex);
+
+          if (exception && !error)
+            error = exception;
+
+          if (++done == count)
+            condition.notify_all();
+        }
+      }
+    };
+
+    if (count == 0)
+      return;
+
+    auto state = std::make_shared<State>(std::move(function), count);
+    size_t helpers = std::min(count, workers.size()) - 1;
+
+    for (size_t i = 0; i < helpers; i++) {
+      if (!Enqueue([state]() { state->Run(); }))
+        break;
+    }
+
+    state->Run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+
+    state->condition.wait(lock, [&state]() {
+      return state->done == state->count;
+    });
+
+    if (state->error)
+      std::rethrow_exception(state->error);
+  }
+
+  //! Число потоков.
+  size_t Threads() const { return workers.size(); }
+
+  //! Удалось ли закрепить потоки за ядрами.
+  bool Pinned() const { return pinned; }
+
+ private:
+  void Work() {
+    while (true) {
+      std::function<void()> task;
+
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        condition.wait(lock, [this]() { return stopped || !tasks.empty(); });
+
+        if (tasks.empty())
+          return;
+
+        task = std::move(tasks.front());
+        tasks.pop();
+      }
+
+      task();
+    }
+  }
+
+  static bool Pin(std::thread* worker, size_t index) {
+#ifdef __linux__
+    size_t cores = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+    CPU_SET(index % cores, &set);
+
+    return pthread_setaffinity_np(worker->native_handle(), sizeof(set),
+                                  &set) == 0;
+#else
+    (void) worker;
+    (void) index;
+
+    return false;
+#endif
+  }
+};
+
+}  // namespace geometry
+
+#endif  // INCLUDE_THREAD_POOL_HPP_
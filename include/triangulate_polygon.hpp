@@ -0,0 +1,569 @@
+/**
+ * @file include/triangulate_polygon.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Триангуляция простого многоугольника разбиением на монотонные части.
+ */
+
+#ifndef INCLUDE_TRIANGULATE_POLYGON_HPP_
+#define INCLUDE_TRIANGULATE_POLYGON_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <utility>
+#include <vector>
+#include <point.hpp>
+#include <polygon.hpp>
+#include "robust_predicates.hpp"
+
+namespace geometry {
+
+namespace detail {
+
+/**
+ * @brief Триангуляция простого многоугольника.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * Сначала заметающая прямая, движущаяся сверху вниз, разбивает
+ * многоугольник диагоналями на y-монотонные части (алгоритм из книги
+ * де Берга и др.): диагонали проводятся из вершин разбиения и слияния
+ * к вершинам-помощникам рёбер. Затем грани получившегося планарного
+ * графа обходятся, и каждая монотонная часть триангулируется за
+ * линейное время с помощью стека. Общее время \f$ O(n \log n) \f$.
+ */
+template<typename T>
+class PolygonTriangulator {
+ public:
+  //! Треугольник: номера вершин многоугольника.
+  using Triangle = std::array<size_t, 3>;
+
+  /**
+   * @brief Подготовить триангуляцию.
+   *
+   * @param points Вершины простого многоугольника против часовой стрелки.
+   */
+  explicit PolygonTriangulator(std::vector<Point<T>> points);
+
+  /**
+   * @brief Построить триангуляцию.
+   * @return Треугольники, ориентированные против часовой стрелки.
+   */
+  std::vector<Triangle> Triangulate();
+
+ private:
+  //! Отсутствующая вершина.
+  static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+  /**
+   * @brief Тип вершины относительно заметающей прямой.
+   */
+  enum class VertexType {
+    //! Оба соседа ниже, внутренний угол меньше развёрнутого.
+    Start,
+    //! Оба соседа ниже, внутренний угол больше развёрнутого.
+    Split,
+    //! Оба соседа выше, внутренний угол меньше развёрнутого.
+    End,
+    //! Оба соседа выше, внутренний угол больше развёрнутого.
+    Merge,
+    //! Один сосед выше, другой ниже.
+    Regular
+  };
+
+  /**
+   * @brief Сравнение рёбер статуса по положению на заметающей прямой.
+   *
+   * Ребро задаётся парой (верхний конец, нижний конец). Запрос
+   * по точке v задаётся вырожденным ребром (v, v).
+   */
+  struct EdgeLess {
+    //! Триангуляция, которой принадлежат рёбра.
+    const PolygonTriangulator* owner;
+
+    /**
+     * @brief Проверить, лежит ли первое ребро левее второго.
+     *
+     * @param a Первое ребро.
+     * @param b Второе ребро.
+     * @return true, если ребро a левее ребра b.
+     *
+     * Рёбра статуса не пересекаются, поэтому достаточно сравнить
+     * верхний конец ребра, добавленного позже, с другим ребром.
+     */
+    bool operator()(const std::pair<size_t, size_t>& a,
+                    const std::pair<size_t, size_t>& b) const {
+      if (a == b)
+        return false;
+
+      if (!owner->Above(a.first, b.first)) {
+        int side = owner->Side(b, a.first);
+
+        return (side != 0 ? side : owner->Side(b, a.second)) < 0;
+      }
+
+      int side = owner->Side(a, b.first);
+
+      return (side != 0 ? side : owner->Side(a, b.second)) > 0;
+    }
+  };
+
+  //! Тип статуса заметающей прямой.
+  using Status = std::set<std::pair<size_t, size_t>, EdgeLess>;
+
+  //! Вершины многоугольника.
+  std::vector<Point<T>> points;
+  //! Диагонали, разбивающие многоугольник на монотонные части.
+  std::vector<std::pair<size_t, size_t>> diagonals;
+
+  /**
+   * @brief Следующая вершина многоугольника.
+   */
+  size_t Next(size_t i) const { return i + 1 == points.size() ? 0 : i + 1; }
+
+  /**
+   * @brief Предыдущая вершина многоугольника.
+   */
+  size_t Previous(size_t i) const {
+    return i == 0 ? points.size() - 1 : i - 1;
+  }
+
+  /**
+   * @brief Проверить, обрабатывается ли вершина a раньше вершины b.
+   *
+   * @param a Первая вершина.
+   * @param b Вторая вершина.
+   * @return true, если a выше b или на той же высоте и левее.
+   */
+  bool Above(size_t a, size_t b) const {
+    return points[a].Y() > points[b].Y() ||
+           (points[a].Y() == points[b].Y() && points[a].X() < points[b].X());
+  }
+
+  /**
+   * @brief Определить, с какой стороны от ребра лежит вершина.
+   *
+   * @param edge Ребро (верхний конец, нижний конец).
+   * @param vertex Вершина.
+   * @return 1, если вершина правее ребра, -1, если левее, и 0, если
+   * лежит на его прямой.
+   */
+  int Side(const std::pair<size_t, size_t>& edge, size_t vertex) const {
+    return RobustOrientation(points[edge.first], points[edge.second],
+                             points[vertex]);
+  }
+
+  /**
+   * @brief Определить тип вершины.
+   *
+   * @param i Номер вершины.
+   * @return Тип вершины.
+   */
+  VertexType Type(size_t i) const;
+
+  /**
+   * @brief Провести диагональ.
+   *
+   * @param a Первый конец.
+   * @param b Второй конец.
+   */
+  void AddDiagonal(size_t a, size_t b);
+
+  /**
+   * @brief Разбить многоугольник на монотонные части.
+   */
+  void Decompose();
+
+  /**
+   * @brief Триангулировать монотонную часть.
+   *
+   * @param face Вершины части против часовой стрелки.
+   * @param result Вектор, в который добавляются треугольники.
+   */
+  void TriangulateMonotone(const std::vector<size_t>& face,
+                           std::vector<Triangle>* result) const;
+};
+
+template<typename T>
+PolygonTriangulator<T>::PolygonTriangulator(std::vector<Point<T>> points) :
+    points(std::move(points)) { }
+
+template<typename T>
+typename PolygonTriangulator<T>::VertexType
+PolygonTriangulator<T>::Type(size_t i) const {
+  size_t previous = Previous(i), next = Next(i);
+  bool previousBelow = Above(i, previous), nextBelow = Above(i, next);
+  bool convex = RobustOrientation(points[previous], points[i],
+                                  points[next]) >= 0;
+
+  if (previousBelow && nextBelow)
+    return convex ? VertexType::Start : VertexType::Split;
+  if (!previousBelow && !nextBelow)
+    return convex ? VertexType::End : VertexType::Merge;
+
+  return VertexType::Regular;
+}
+
+template<typename T>
+void PolygonTriangulator<T>::AddDiagonal(size_t a, size_t b) {
+  // Совпадающие диагонали и стороны многоугольника отбрасываются позже.
+  diagonals.emplace_back(std::min(a, b), std::max(a, b));
+}
+
+template<typename T>
+void PolygonTriangulator<T>::Decompose() {
+  size_t n = points.size();
+  std::vector<size_t> order(n);
+  std::vector<VertexType> types(n);
+  // Помощник ребра (i, Next(i)) хранится по номеру i.
+  std::vector<size_t> helper(n, kNone);
+  std::vector<typename Status::iterator> positions(n);
+  Status status(EdgeLess{this});
+
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    return Above(a, b);
+  });
+
+  for (size_t i = 0; i < n; i++)
+    types[i] = Type(i);
+
+  auto fixMerge = [&](size_t edge, size_t v) {
+    if (helper[edge] != kNone && types[helper[edge]] == VertexType::Merge)
+      AddDiagonal(v, helper[edge]);
+  };
+  auto insert = [&](size_t v) {
+    positions[v] = status.insert(std::make_pair(v, Next(v))).first;
+    helper[v] = v;
+  };
+  auto erase = [&](size_t v) {
+    if (helper[v] != kNone) {
+      status.erase(positions[v]);
+      helper[v] = kNone;
+    }
+  };
+  // Ребро статуса, ближайшее слева к вершине.
+  auto left = [&](size_t v) {
+    auto it = status.lower_bound(std::make_pair(v, v));
+
+    return it == status.begin() ? kNone : std::prev(it)->first;
+  };
+
+  for (size_t v : order) {
+    size_t previous = Previous(v), edge = kNone;
+
+    switch (types[v]) {
+      case VertexType::Start:
+        insert(v);
+        break;
+      case VertexType::End:
+        fixMerge(previous, v);
+        erase(previous);
+        break;
+      case VertexType::Split:
+        edge = left(v);
+
+        if (edge != kNone) {
+          AddDiagonal(v, helper[edge]);
+          helper[edge] = v;
+        }
+
+        insert(v);
+        break;
+      case VertexType::Merge:
+        fixMerge(previous, v);
+        erase(previous);
+        edge = left(v);
+
+        if (edge != kNone) {
+          fixMerge(edge, v);
+          helper[edge] = v;
+        }
+        break;
+      case VertexType::Regular:
+        // Внутренность справа: вершина лежит на левой цепи.
+        if (Above(previous, v)) {
+          fixMerge(previous, v);
+          erase(previous);
+          insert(v);
+        } else if ((edge = left(v)) != kNone) {
+          fixMerge(edge, v);
+          helper[edge] = v;
+        }
+        break;
+    }
+  }
+}
+
+template<typename T>
+std::vector<typename PolygonTriangulator<T>::Triangle>
+PolygonTriangulator<T>::Triangulate() {
+  std::vector<Triangle> result;
+  size_t n = points.size();
+
+  if (n < 3)
+    return result;
+
+  result.reserve(n - 2);
+
+  Decompose();
+
+  std::sort(diagonals.begin(), diagonals.end());
+  diagonals.erase(std::unique(diagonals.begin(), diagonals.end()),
+                  diagonals.end());
+  diagonals.erase(std::remove_if(diagonals.begin(), diagonals.end(),
+                                 [n](const std::pair<size_t, size_t>& d) {
+    return d.second - d.first <= 1 || d.second - d.first == n - 1;
+  }), diagonals.end());
+
+  // Соседи вершины v занимают отрезок [offsets[v], offsets[v + 1])
+  // массива targets: сначала стороны многоугольника, затем диагонали.
+  std::vector<size_t> offsets(n + 1, 0), targets, fill(n);
+
+  for (size_t v = 0; v < n; v++)
+    offsets[v + 1] = 2;
+
+  for (const std::pair<size_t, size_t>& d : diagonals) {
+    offsets[d.first + 1]++;
+    offsets[d.second + 1]++;
+  }
+
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  targets.resize(offsets[n]);
+
+  for (size_t v = 0; v < n; v++) {
+    targets[offsets[v]] = Previous(v);
+    targets[offsets[v] + 1] = Next(v);
+    fill[v] = offsets[v] + 2;
+  }
+
+  for (const std::pair<size_t, size_t>& d : diagonals) {
+    targets[fill[d.first]++] = d.second;
+    targets[fill[d.second]++] = d.first;
+  }
+
+  // Соседи вершин с диагоналями упорядочиваются против часовой стрелки.
+  for (size_t v = 0; v < n; v++) {
+    if (offsets[v + 1] - offsets[v] <= 2)
+      continue;
+
+    const Point<T>& origin = points[v];
+    auto half = [&origin](const Point<T>& p) {
+      return p.Y() < origin.Y() || (p.Y() == origin.Y() && p.X() < origin.X());
+    };
+
+    std::sort(targets.begin() + offsets[v], targets.begin() + offsets[v + 1],
+              [&](size_t a, size_t b) {
+      bool aHalf = half(points[a]), bHalf = half(points[b]);
+
+      if (aHalf != bHalf)
+        return bHalf;
+
+      return RobustOrientation(origin, points[a], points[b]) > 0;
+    });
+  }
+
+  // Обход граней: после ребра (u, v) идёт ребро (v, w), где w ---
+  // сосед v, предшествующий u в порядке против часовой стрелки. Рёбра
+  // (v, Previous(v)) ограничивают внешнюю грань и пропускаются.
+  std::vector<bool> used(targets.size(), false);
+  std::vector<size_t> face;
+
+  for (size_t origin = 0; origin < n; origin++) {
+    for (size_t start = offsets[origin]; start < offsets[origin + 1];
+         start++) {
+      if (used[start] || targets[start] == Previous(origin))
+        continue;
+
+      size_t u = origin, edge = start;
+
+      face.clear();
+
+      while (!used[edge]) {
+        size_t v = targets[edge];
+        size_t first = offsets[v], degree = offsets[v + 1] - first;
+        size_t back = static_cast<size_t>(
+            std::find(targets.begin() + first, targets.begin() + first + degree,
+                      u) - targets.begin()) - first;
+
+        used[edge] = true;
+        face.push_back(u);
+        edge = first + (back + degree - 1) % degree;
+        u = v;
+      }
+
+      TriangulateMonotone(face, &result);
+    }
+  }
+
+  return result;
+}
+
+template<typename T>
+void PolygonTriangulator<T>::TriangulateMonotone(
+    const std::vector<size_t>& face, std::vector<Triangle>* result) const {
+  size_t m = face.size();
+
+  if (m < 3)
+    return;
+
+  auto emit = [&](size_t a, size_t b, size_t c) {
+    if (RobustOrientation(points[a], points[b], points[c]) < 0)
+      std::swap(b, c);
+
+    result->push_back(Triangle{a, b, c});
+  };
+
+  size_t top = 0, bottom = 0;
+
+  for (size_t i = 1; i < m; i++) {
+    if (Above(face[i], face[top]))
+      top = i;
+    if (Above(face[bottom], face[i]))
+      bottom = i;
+  }
+
+  // Вершины сливаются в порядке заметающей прямой. Обход против часовой
+  // стрелки от верхней вершины идёт по левой цепи.
+  std::vector<std::pair<size_t, bool>> sorted;
+  size_t forward = (top + 1) % m, backward = (top + m - 1) % m;
+
+  sorted.reserve(m);
+  sorted.emplace_back(face[top], true);
+
+  while (forward != bottom || backward != bottom) {
+    if (backward == bottom ||
+        (forward != bottom && Above(face[forward], face[backward]))) {
+      sorted.emplace_back(face[forward], true);
+      forward = (forward + 1) % m;
+    } else {
+      sorted.emplace_back(face[backward], false);
+      backward = (backward + m - 1) % m;
+    }
+  }
+
+  sorted.emplace_back(face[bottom], false);
+
+  std::vector<std::pair<size_t, bool>> stack = { sorted[0], sorted[1] };
+
+  for (size_t j = 2; j + 1 < m; j++) {
+    std::pair<size_t, bool> current = sorted[j];
+
+    if (current.second != stack.back().second) {
+      while (stack.size() > 1) {
+        size_t vertex = stack.back().first;
+
+        stack.pop_back();
+        emit(current.first, vertex, stack.back().first);
+      }
+
+      stack.clear();
+      stack.push_back(sorted[j - 1]);
+      stack.push_back(current);
+    } else {
+      std::pair<size_t, bool> last = stack.back();
+
+      stack.pop_back();
+
+      // Диагональ проходит внутри, если вершина last выпукла.
+      while (!stack.empty()) {
+        int turn = RobustOrientation(points[stack.back().first],
+                                     points[last.first],
+                                     points[current.first]);
+
+        if (current.second ? turn <= 0 : turn >= 0)
+          break;
+
+        emit(current.first, last.first, stack.back().first);
+        last = stack.back();
+        stack.pop_back();
+      }
+
+      stack.push_back(last);
+      stack.push_back(current);
+    }
+  }
+
+  while (stack.size() > 1) {
+    size_t vertex = stack.back().first;
+
+    stack.pop_back();
+    emit(sorted[m - 1].first, vertex, stack.back().first);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Триангулировать простой многоугольник.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Container Тип контейнера вершин.
+ *
+ * @param vertices Вершины простого многоугольника в порядке обхода
+ * (по или против часовой стрелки).
+ * @return Тройки номеров вершин в контейнере. Треугольники обходятся
+ * в том же направлении, что и многоугольник. Для многоугольника
+ * из n вершин возвращается n - 2 треугольника.
+ *
+ * Время работы \f$ O(n \log n) \f$.
+ */
+template<typename T, typename Container>
+std::vector<std::array<size_t, 3>> TriangulatePolygon(
+    const Container& vertices) {
+  std::vector<Point<T>> points(vertices.begin(), vertices.end());
+  size_t n = points.size();
+  long double area = 0;
+
+  for (size_t i = 0; i < n; i++) {
+    const Point<T>& a = points[i];
+    const Point<T>& b = points[i + 1 == n ? 0 : i + 1];
+
+    area += static_cast<long double>(a.X()) * b.Y() -
+            static_cast<long double>(b.X()) * a.Y();
+  }
+
+  // Алгоритм работает с обходом против часовой стрелки.
+  bool clockwise = area < 0;
+
+  if (clockwise)
+    std::reverse(points.begin(), points.end());
+
+  std::vector<std::array<size_t, 3>> result =
+      detail::PolygonTriangulator<T>(std::move(points)).Triangulate();
+
+  if (clockwise) {
+    for (std::array<size_t, 3>& triangle : result) {
+      for (size_t& vertex : triangle)
+        vertex = n - 1 - vertex;
+
+      std::swap(triangle[1], triangle[2]);
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Триангулировать простой многоугольник.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Container Тип контейнера вершин.
+ *
+ * @param polygon Простой многоугольник.
+ * @return Тройки номеров вершин в порядке контейнера Vertices().
+ */
+template<typename T, typename Container>
+std::vector<std::array<size_t, 3>> TriangulatePolygon(
+    const Polygon<T, Container>& polygon) {
+  return TriangulatePolygon<T>(polygon.Vertices());
+}
+
+}  // namespace geometry
+
+#endif  // INCLUDE_TRIANGULATE_POLYGON_HPP_
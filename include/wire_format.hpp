@@ -0,0 +1,259 @@
+/**
+ * @file include/wire_format.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Двоичный формат обмена данными между клиентом и сервером.
+ */
+
+#ifndef INCLUDE_WIRE_FORMAT_HPP_
+#define INCLUDE_WIRE_FORMAT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace geometry {
+
+/**
+ * @brief Тип координат в двоичном формате.
+ */
+enum class WireType : uint8_t {
+  //! 32-битное целое со знаком (int).
+  Int32 = 1,
+  //! 32-битное число с плавающей точкой (float).
+  Float32 = 2,
+  //! 64-битное число с плавающей точкой (double).
+  Float64 = 3
+};
+
+/**
+ * @brief Код типа координат в двоичном формате.
+ *
+ * @tparam T Тип координат. Поддерживаются int, float и double: размер
+ * long double зависит от платформы, поэтому он передаётся только в JSON.
+ */
+template<typename T>
+constexpr WireType WireTypeOf() {
+  static_assert(std::is_same_v<T, int> || std::is_same_v<T, float> ||
+                std::is_same_v<T, double>,
+                "Unsupported wire coordinate type");
+  static_assert(sizeof(int) == 4 && sizeof(float) == 4 &&
+                sizeof(double) == 8, "Unexpected size of a wire type");
+
+  if constexpr (std::is_same_v<T, int>)
+    return WireType::Int32;
+  else if constexpr (std::is_same_v<T, float>)
+    return WireType::Float32;
+  else
+    return WireType::Float64;
+}
+
+namespace detail {
+
+//! Сигнатура в начале сообщения.
+static constexpr char kWireMagic[4] = { 'G', 'E', 'O', 'B' };
+
+//! Размер заголовка. Кратен 8, поэтому столбцы выровнены для double.
+static constexpr size_t kWireHeaderSize = 24;
+
+/**
+ * @brief Проверить, что машина хранит числа в порядке little-endian.
+ */
+inline bool IsLittleEndian() {
+  const uint16_t value = 1;
+  unsigned char first = 0;
+
+  std::memcpy(&first, &value, 1);
+
+  return first == 1;
+}
+
+/**
+ * @brief Прочитать число в порядке little-endian.
+ */
+template<typename T>
+T LoadLittleEndian(const char* source) {
+  T value;
+
+  if (IsLittleEndian()) {
+    std::memcpy(&value, source, sizeof(T));
+  } else {
+    char bytes[sizeof(T)];
+
+    std::reverse_copy(source, source + sizeof(T), bytes);
+    std::memcpy(&value, bytes, sizeof(T));
+  }
+
+  return value;
+}
+
+/**
+ * @brief Записать число в порядке little-endian.
+ */
+template<typename T>
+void StoreLittleEndian(T value, char* destination) {
+  std::memcpy(destination, &value, sizeof(T));
+
+  if (!IsLittleEndian())
+    std::reverse(destination, destination + sizeof(T));
+}
+
+/**
+ * @brief Размер координаты данного типа в байтах (0 для неизвестного).
+ */
+inline size_t WireTypeSize(uint8_t type) {
+  switch (static_cast<WireType>(type)) {
+  case WireType::Int32:
+  case WireType::Float32:
+    return 4;
+  case WireType::Float64:
+    return 8;
+  default:
+    return 0;
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Разбор сообщения в двоичном формате.
+ *
+ * Сообщение состоит из заголовка (24 байта) и столбцов координат:
+ *
+ * | Смещение | Размер | Поле                                  |
+ * |----------|--------|---------------------------------------|
+ * | 0        | 4      | сигнатура "GEOB"                      |
+ * | 4        | 1      | тип координат (WireType)              |
+ * | 5        | 3      | зарезервировано (нули)                |
+ * | 8        | 8      | идентификатор запроса                 |
+ * | 16       | 8      | число элементов count                 |
+ * | 24       | ...    | столбцы по count координат подряд     |
+ *
+ * Все числа записаны в порядке little-endian. Число столбцов задаётся
+ * методом: например, для точек это столбцы \f$ x \f$ и \f$ y \f$.
+ * Данные не копируются: значения читаются прямо из тела запроса.
+ */
+class WireDecoder {
+ private:
+  //! Начало сообщения.
+  const char* data = nullptr;
+  //! Тип координат.
+  WireType type = WireType::Int32;
+  //! Идентификатор запроса.
+  uint64_t id = 0;
+  //! Число элементов.
+  size_t count = 0;
+
+ public:
+  /**
+   * @brief Проверить сообщение и прочитать заголовок.
+   *
+   * @param message Тело запроса (должно жить, пока используется декодер).
+   * @param columns Ожидаемое число столбцов.
+   * @return false, если сигнатура, тип или размер сообщения неверны.
+   */
+  bool Parse(const std::string& message, size_t columns) {
+    if (message.size() < detail::kWireHeaderSize ||
+        std::memcmp(message.data(), detail::kWireMagic, 4) != 0)
+      return false;
+
+    uint8_t code = static_cast<uint8_t>(message[4]);
+    size_t width = detail::WireTypeSize(code);
+    uint64_t size = detail::LoadLittleEndian<uint64_t>(message.data() + 16);
+    size_t payload = message.size() - detail::kWireHeaderSize;
+
+    if (width == 0 || columns == 0 || size > payload / (width * columns) ||
+        size * width * columns != payload)
+      return false;
+
+    data = message.data();
+    type = static_cast<WireType>(code);
+    id = detail::LoadLittleEndian<uint64_t>(message.data() + 8);
+    count = static_cast<size_t>(size);
+
+    return true;
+  }
+
+  //! Тип координат.
+  WireType Type() const { return type; }
+
+  //! Идентификатор запроса.
+  uint64_t Id() const { return id; }
+
+  //! Число элементов.
+  size_t Count() const { return count; }
+
+  /**
+   * @brief Прочитать координату.
+   *
+   * @tparam T Тип координат (должен соответствовать Type()).
+   *
+   * @param column Номер столбца.
+   * @param i Номер элемента.
+   */
+  template<typename T>
+  T Get(size_t column, size_t i) const {
+    return detail::LoadLittleEndian<T>(data + detail::kWireHeaderSize +
+                                       (column * count + i) * sizeof(T));
+  }
+};
+
+/**
+ * @brief Построение сообщения в двоичном формате (см. WireDecoder).
+ *
+ * @tparam T Тип координат.
+ *
+ * Буфер выделяется один раз под всё сообщение, координаты записываются
+ * прямо в него.
+ */
+template<typename T>
+class WireEncoder {
+ private:
+  //! Сообщение.
+  std::string message;
+  //! Число элементов.
+  size_t count;
+
+ public:
+  /**
+   * @brief Создать сообщение с заголовком и нулевыми столбцами.
+   *
+   * @param id Идентификатор запроса.
+   * @param count Число элементов.
+   * @param columns Число столбцов.
+   */
+  WireEncoder(uint64_t id, size_t count, size_t columns) :
+      message(detail::kWireHeaderSize + count * columns * sizeof(T), '\0'),
+      count(count) {
+    std::memcpy(&message[0], detail::kWireMagic, 4);
+    message[4] = static_cast<char>(WireTypeOf<T>());
+    detail::StoreLittleEndian<uint64_t>(id, &message[8]);
+    detail::StoreLittleEndian<uint64_t>(count, &message[16]);
+  }
+
+  /**
+   * @brief Записать координату.
+   *
+   * @param column Номер столбца.
+   * @param i Номер элемента.
+   * @param value Значение.
+   */
+  void Set(size_t column, size_t i, T value) {
+    detail::StoreLittleEndian<T>(value, &message[detail::kWireHeaderSize +
+                                                 (column * count + i) *
+                                                 sizeof(T)]);
+  }
+
+  /**
+   * @brief Забрать готовое сообщение.
+   */
+  std::string Release() { return std::move(message); }
+};
+
+}  // namespace geometry
+
+#endif  // INCLUDE_WIRE_FORMAT_HPP_
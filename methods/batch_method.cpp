@@ -0,0 +1,129 @@
+/**
+ * @file methods/batch_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функцию, которая выполняет несколько вызовов методов
+ * в одном запросе. Функция принимает и возвращает данные в JSON формате.
+ */
+
+#include <exception>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <request_metrics.hpp>
+#include <thread_pool.hpp>
+#include "method_registry.hpp"
+
+namespace geometry {
+
+/**
+ * @brief Выполнить один вызов пакетного запроса.
+ *
+ * @param name Название метода (для счётчиков /metrics).
+ * @param method Метод.
+ * @param input Входные данные метода.
+ * @param output Результат: метод, код ответа и выходные данные метода.
+ */
+static void RunBatchItem(const std::string& name, JsonMethod method,
+                         const nlohmann::json& input,
+                         nlohmann::json* output) {
+  MetricsScope scope("/Batch/" + name);
+  nlohmann::json result;
+  int status = 200;
+
+  // Исключение в потоке пула завершило бы сервер, поэтому ошибки
+  // в данных (отсутствующие поля, неверные типы) обрабатываются здесь
+  // так же, как отрицательный код возврата. Другие исключения (например,
+  // нехватка памяти) не должны прерывать остальные вызовы пакета и
+  // возвращаются как ошибка этого вызова.
+  try {
+    if (method(input, &result) < 0)
+      status = 400;
+  } catch (const nlohmann::json::exception&) {
+    status = 400;
+  } catch (const std::exception&) {
+    status = 500;
+  } catch (...) {
+    status = 500;
+  }
+
+  if (status != 200)
+    scope.Fail();
+
+  (*output)["status"] = status;
+  (*output)["output"] = std::move(result);
+}
+
+int BatchMethod(const nlohmann::json& input, nlohmann::json* output,
+                ThreadPool* pool) {
+  if (!input.contains("data") || !input.at("data").is_array())
+    return -1;
+
+  const nlohmann::json& items = input.at("data");
+  size_t size = input.value("size", items.size());
+
+  if (size != items.size())
+    return -1;
+
+  // Методы находятся заранее: пакет с неизвестным методом отклоняется
+  // целиком, не начиная вычислений.
+  std::vector<JsonMethod> methods(size);
+
+  for (size_t i = 0; i < size; i++) {
+    const nlohmann::json& item = items[i];
+
+    if (!item.is_object() || !item.contains("method") ||
+        !item.at("method").is_string() || !item.contains("input"))
+      return -1;
+
+    const MethodEntry* entry =
+        FindBatchMethod(item.at("method").get<std::string>());
+
+    if (!entry)
+      return -1;
+
+    methods[i] = entry->json;
+  }
+
+  std::vector<nlohmann::json> results(size);
+
+  // Вызовы выполняются параллельно на потоках пула сервера, результаты
+  // записываются в ответ в порядке вызовов.
+  auto run = [&](size_t i) {
+    const std::string& name = items[i].at("method").get_ref<
+        const std::string&>();
+
+    const nlohmann::json& item = items[i].at("input");
+
+    // Метод, завершившийся ошибкой, может не успеть записать "id" в свой
+    // ответ, поэтому идентификатор вызова копируется в результат здесь.
+    results[i]["method"] = name;
+
+    if (item.is_object() && item.contains("id"))
+      results[i]["id"] = item.at("id");
+
+    RunBatchItem(name, methods[i], item, &results[i]);
+  };
+
+  if (pool) {
+    pool->ParallelFor(size, run);
+  } else {
+    for (size_t i = 0; i < size; i++)
+      run(i);
+  }
+
+  // Идентификатор пакета необязателен.
+  if (input.contains("id"))
+    (*output)["id"] = input.at("id");
+
+  (*output)["size"] = size;
+  (*output)["data"] = nlohmann::json::array();
+
+  for (nlohmann::json& result : results)
+    (*output)["data"].push_back(std::move(result));
+
+  return 0;
+}
+
+}  // namespace geometry
@@ -0,0 +1,127 @@
+/**
+ * @file methods/clip_polygons_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функцию, которая вызывает алгоритмы отсечения
+ * многоугольников окном. Функция принимает и возвращает данные
+ * в JSON формате.
+ */
+
+#include <list>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "clip_polygon.hpp"
+#include "coordinate_types.hpp"
+#include "polygon_json.hpp"
+
+namespace geometry {
+
+template<typename T>
+static int ClipPolygonsMethodHelper(const nlohmann::json& input,
+                                    nlohmann::json* output,
+                                    std::string type);
+
+int ClipPolygonsMethod(const nlohmann::json& input, nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return ClipPolygonsMethodHelper<T>(input, output, type);
+  });
+}
+
+/**
+ * @brief Отсечь набор многоугольников окном.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * В режиме "convex" вершины каждого многоугольника по одной подаются
+ * в потоковый отсекатель Сазерленда-Ходжмана, в режиме "general"
+ * используется алгоритм Вейлера-Азертона. Ломаные (поле "kind" равно
+ * "polyline") в обоих режимах отсекаются функцией ClipPolyline().
+ */
+template<typename T>
+static int ClipPolygonsMethodHelper(const nlohmann::json& input,
+                                    nlohmann::json* output,
+                                    std::string type) {
+  T precision = T(0);
+  std::string mode = input.value("mode", "convex");
+  std::string kind = input.value("kind", "polygon");
+  Polygon<T> window = ReadPolygon<T>(input.at("window"));
+
+  if (window.Size() < 3)
+    return -1;
+
+  if (mode != "convex" && mode != "general")
+    return -1;
+
+  if (kind != "polygon" && kind != "polyline")
+    return -1;
+
+  if (mode == "convex" && !IsConvex(window, precision))
+    return -1;
+
+  (*output)["id"] = input.at("id");
+
+  size_t size = input.at("size");
+
+  (*output)["size"] = size;
+  (*output)["type"] = type;
+  (*output)["mode"] = mode;
+  (*output)["kind"] = kind;
+  (*output)["data"] = nlohmann::json::array();
+
+  std::vector<Point<T>> buffer;
+  SutherlandHodgmanClipper clipper(window, precision,
+                                   std::back_inserter(buffer));
+
+  for (size_t i = 0; i < size; i++) {
+    const nlohmann::json& data = input.at("data").at(i);
+    nlohmann::json result = nlohmann::json::array();
+
+    if (kind == "polyline") {
+      std::list<Point<T>> polyline = ReadPolygon<T>(data).Vertices();
+
+      for (const auto& piece : ClipPolyline(polyline, window, precision)) {
+        result.push_back(nlohmann::json());
+        WritePolygon<T>(piece, &result.back());
+      }
+    } else if (mode == "convex") {
+      size_t count = data.at(0).size();
+
+      buffer.clear();
+
+      for (size_t j = 0; j < count; j++)
+        clipper.Push(Point<T>(data.at(0).at(j), data.at(1).at(j)));
+
+      clipper.Finish();
+
+      if (!buffer.empty()) {
+        result.push_back(nlohmann::json());
+        WritePolygon<T>(buffer, &result.back());
+      }
+    } else {
+      Polygon<T> subject = ReadPolygon<T>(data);
+
+      for (const Polygon<T>& polygon : WeilerAtherton(subject, window,
+                                                      precision)) {
+        result.push_back(nlohmann::json());
+        WritePolygon<T>(polygon.Vertices(), &result.back());
+      }
+    }
+
+    (*output)["data"].push_back(result);
+  }
+
+  return 0;
+}
+
+}  // namespace geometry
@@ -0,0 +1,142 @@
+/**
+ * @file methods/closest_pair_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функции, которые ищут ближайшую пару точек и ближайшего
+ * соседа каждой точки. Функции принимают и возвращают данные в JSON
+ * формате.
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "closest_pair.hpp"
+#include "coordinate_types.hpp"
+
+namespace geometry {
+
+template<typename T>
+static int ClosestPairMethodHelper(const nlohmann::json& input,
+                                   nlohmann::json* output,
+                                   std::string type);
+
+template<typename T>
+static int AllNearestNeighboursMethodHelper(const nlohmann::json& input,
+                                            nlohmann::json* output,
+                                            std::string type);
+
+template<typename T>
+static int ReadPoints(const nlohmann::json& input,
+                      std::vector<Point<T>>* points);
+
+int ClosestPairMethod(const nlohmann::json& input, nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return ClosestPairMethodHelper<T>(input, output, type);
+  });
+}
+
+int AllNearestNeighboursMethod(const nlohmann::json& input,
+                               nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return AllNearestNeighboursMethodHelper<T>(input, output, type);
+  });
+}
+
+/**
+ * @brief Прочитать набор точек.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param points Вектор, в который записываются точки.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число,
+ * если точек меньше двух.
+ */
+template<typename T>
+static int ReadPoints(const nlohmann::json& input,
+                      std::vector<Point<T>>* points) {
+  size_t size = input.at("size");
+
+  if (size < 2)
+    return -1;
+
+  points->reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    points->push_back(Point<T>(input.at("data").at(0).at(i),
+                               input.at("data").at(1).at(i)));
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Метод поиска ближайшей пары точек.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename T>
+static int ClosestPairMethodHelper(const nlohmann::json& input,
+                                   nlohmann::json* output,
+                                   std::string type) {
+  size_t threads = input.value("threads", 0);
+  std::vector<Point<T>> points;
+
+  if (ReadPoints(input, &points) < 0)
+    return -1;
+
+  std::pair<size_t, size_t> pair = ClosestPair(points, threads);
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["size"] = points.size();
+  (*output)["data"] = { pair.first, pair.second };
+
+  return 0;
+}
+
+/**
+ * @brief Метод поиска ближайшего соседа каждой точки.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename T>
+static int AllNearestNeighboursMethodHelper(const nlohmann::json& input,
+                                            nlohmann::json* output,
+                                            std::string type) {
+  size_t threads = input.value("threads", 0);
+  std::vector<Point<T>> points;
+
+  if (ReadPoints(input, &points) < 0)
+    return -1;
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["size"] = points.size();
+  (*output)["data"] = AllNearestNeighbours(points, threads);
+
+  return 0;
+}
+
+}  // namespace geometry
@@ -7,41 +7,161 @@
  * формате.
  */
 
+#include <cmath>
+#include <map>
 #include <string>
+#include <type_traits>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include "contour_rectangles.hpp"
+#include "coordinate_types.hpp"
+#include "fixed_point.hpp"
+#include "json_columns.hpp"
+#include "json_writer.hpp"
+#include "rectangle_components.hpp"
+#include "request_metrics.hpp"
+#include "wire_format.hpp"
 
 namespace geometry {
 
-template <typename T>
+//! Прямоугольники задаются углами: {"data": [[[x, y], [x, y]], ...]}.
+static constexpr ColumnLayout kContourRectanglesLayout = { 3, 0 };
+
+template <typename Columns, typename Output>
+static int ContourRectanglesDispatch(const nlohmann::json &input,
+                                     const Columns &data, Output *output);
+
+template <typename T, typename Columns, typename Output>
 static int ContourRectanglesMethodHelper(const nlohmann::json &input,
-                                         nlohmann::json *output,
+                                         const Columns &data,
+                                         Output *output,
                                          std::string type);
 
+template <typename T, typename Columns, typename Output>
+static int ContourRectanglesFixedPointHelper(const nlohmann::json &input,
+                                             const Columns &data,
+                                             Output *output,
+                                             std::string type);
+
+template <typename T, typename U>
+static void WriteContour(const nlohmann::json &input,
+                         const std::vector<T> &segments,
+                         const std::string &type,
+                         RectangleComponents<U> *components,
+                         nlohmann::json *output);
+
+template <typename T, typename U>
+static void WriteContour(const nlohmann::json &input,
+                         const std::vector<T> &segments,
+                         const std::string &type,
+                         RectangleComponents<U> *components,
+                         JsonWriter *output);
+
+template <typename T>
+static int ContourRectanglesBinaryHelper(const WireDecoder &input,
+                                         std::string *output);
+
+/**
+ * @brief Проверить углы прямоугольника.
+ *
+ * @tparam T Тип данных координат точек.
+ *
+ * @param rectangle Прямоугольник.
+ * @return false, если координата угла не является конечным числом или
+ * угол ne лежит левее или ниже угла sw.
+ *
+ * Алгоритм поиска контура рассчитан только на такие прямоугольники.
+ * Двоичный формат, в отличие от JSON, может передать NaN и бесконечности.
+ */
+template <typename T>
+static bool IsValidRectangle(const Rectangle<T> &rectangle) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if (!std::isfinite(rectangle.sw.X()) ||
+        !std::isfinite(rectangle.sw.Y()) ||
+        !std::isfinite(rectangle.ne.X()) ||
+        !std::isfinite(rectangle.ne.Y()))
+      return false;
+  }
+
+  return rectangle.sw.X() <= rectangle.ne.X() &&
+         rectangle.sw.Y() <= rectangle.ne.Y();
+}
+
 int ContourRectanglesMethod(const nlohmann::json &input,
                             nlohmann::json *output) {
-  std::string type = input.at("type");
+  return ContourRectanglesDispatch(
+      input, JsonColumnView(input, kContourRectanglesLayout), output);
+}
+
+int ContourRectanglesTextMethod(const std::string &input,
+                                std::string *output) {
+  JsonColumnParser parser(kContourRectanglesLayout);
+  nlohmann::json dom;
+  int precision = -1, result = -1;
+
+  // Запрос, который не удалось разобрать потоково, разбирается в дерево,
+  // чтобы ошибки обрабатывались так же, как в ContourRectanglesMethod().
+  bool streamed = parser.Parse(input);
+
+  if (!streamed)
+    dom = nlohmann::json::parse(input);
 
-  if (type == "int") {
-    return ContourRectanglesMethodHelper<int>(input, output, type);
-  } else if (type == "float") {
-    return ContourRectanglesMethodHelper<float>(input, output, type);
-  } else if (type == "double") {
-    return ContourRectanglesMethodHelper<double>(input, output, type);
-  } else if (type == "long double") {
-    return ContourRectanglesMethodHelper<long double>(input, output, type);
+  const nlohmann::json &header = streamed ? parser.Header() : dom;
+
+  output->clear();
+
+  if (JsonWriter::ReadPrecision(header, &precision)) {
+    JsonWriter writer(output, precision);
+
+    result = streamed ?
+        ContourRectanglesDispatch(header, parser, &writer) :
+        ContourRectanglesDispatch(
+            header, JsonColumnView(dom, kContourRectanglesLayout), &writer);
   }
 
-  return -1;
+  if (result < 0)
+    *output = "null";
+
+  return result;
+}
+
+/**
+ * @brief Выбор типа координат по полю "type".
+ *
+ * @tparam Columns Источник координат (JsonColumnView или
+ * JsonColumnParser).
+ * @tparam Output Получатель ответа (nlohmann::json или JsonWriter).
+ *
+ * @param input Поля запроса.
+ * @param data Столбцы координат углов sw и ne.
+ * @param output Выходные данные.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template <typename Columns, typename Output>
+static int ContourRectanglesDispatch(const nlohmann::json &input,
+                                     const Columns &data, Output *output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    MetricsScope::Type(CoordinateName<T>::kValue);
+
+    return ContourRectanglesMethodHelper<T>(input, data, output, type);
+  });
 }
 
 /**
  * @brief Поиск контура объединения прямоугольников
  *
  * @tparam T Тип данных координат точек.
+ * @tparam Columns Источник координат.
+ * @tparam Output Получатель ответа.
  *
- * @param input Входные данные в формате JSON.
- * @param output Выходные данные в формате JSON.
+ * @param input Поля запроса.
+ * @param data Столбцы координат углов sw и ne.
+ * @param output Выходные данные.
  * @param type Строковое представление типа данных координат точек.
  * @return Функция возвращает 0 в случае успеха и отрицательное число
  * если входные данные заданы некорректно.
@@ -50,43 +170,353 @@ int ContourRectanglesMethod(const nlohmann::json &input,
  * в JSON формате. Результат также выдаётся в JSON формате. Функция
  * используется для сокращения кода, необходимого для поддержки различных типов данных.
  */
-template <typename T>
+template <typename T, typename Columns, typename Output>
 static int ContourRectanglesMethodHelper(const nlohmann::json &input,
-                                         nlohmann::json *output,
+                                         const Columns &data,
+                                         Output *output,
                                          std::string type) {
-  (*output)["id"] = input.at("id");
+  if (input.contains("scale"))
+    return ContourRectanglesFixedPointHelper<T>(input, data, output, type);
 
   size_t size = input.at("size");
-  Rectangle<T> *data = new Rectangle<T>[size];
+
+  if (size > data.Count())
+    return -1;
+
+  Rectangle<T> *rectangles = new Rectangle<T>[size];
 
   for (size_t i = 0; i < size; i++) {
-    data[i] = Rectangle<T>(Point<T>(input.at("data").at(i).at(0).at(0),
-                                    input.at("data").at(i).at(0).at(1)),
-                           Point<T>(input.at("data").at(i).at(1).at(0),
-                                    input.at("data").at(i).at(1).at(1)),
-                          static_cast<int>(i + 1));
+    rectangles[i] = Rectangle<T>(Point<T>(data.template Get<T>(0, i),
+                                          data.template Get<T>(1, i)),
+                                 Point<T>(data.template Get<T>(2, i),
+                                          data.template Get<T>(3, i)),
+                                 static_cast<int>(i + 1));
+
+    if (!IsValidRectangle(rectangles[i])) {
+      delete[] rectangles;
+      return -1;
+    }
   }
 
-  std::list<Edge<T> *> *res = ContourRectangles<T>(data,
-                                                   static_cast<int>(size));
-  // std::cout << input.dump() << '\n';
+  MetricsScope::Mark(RequestPhase::kParse);
+
+  // Компоненты связности по запросу вычисляются за тот же проход,
+  // что и контур.
+  bool connected = input.value("components", false);
+  RectangleComponents<T> components(rectangles, connected ? size : 0);
+  std::list<Edge<T> *> *res = ContourRectangles<T>(
+      rectangles, static_cast<int>(size), [&](size_t j, bool left) {
+        if (connected)
+          components(j, left);
+      });
+
+  // Концы рёбер подряд: x и y начала, x и y конца.
+  std::vector<T> segments;
+
+  segments.reserve(4 * res->size());
+
+  for (auto iter = res->begin(); iter != res->end(); iter++) {
+    segments.push_back((*iter)->Origin().X());
+    segments.push_back((*iter)->Origin().Y());
+    segments.push_back((*iter)->Destination().X());
+    segments.push_back((*iter)->Destination().Y());
+    delete (*iter);
+  }
+  delete res;
+  delete[] rectangles;
+
+  MetricsScope::Mark(RequestPhase::kCompute);
+  WriteContour(input, segments, type, connected ? &components : nullptr,
+               output);
+  MetricsScope::Mark(RequestPhase::kSerialize);
+
+  return 0;
+}
+
+/**
+ * @brief Поиск контура объединения прямоугольников в режиме фиксированной
+ * точки.
+ *
+ * @tparam T Тип данных координат во входных и выходных данных.
+ * @tparam Columns Источник координат.
+ * @tparam Output Получатель ответа.
+ *
+ * @param input Поля запроса.
+ * @param data Столбцы координат углов sw и ne.
+ * @param output Выходные данные.
+ * @param type Строковое представление типа данных координат точек.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Углы прямоугольников умножаются на масштаб "scale" и округляются
+ * до целых чисел, контур строится в целочисленных координатах, а затем
+ * переводится обратно в исходные единицы.
+ */
+template <typename T, typename Columns, typename Output>
+static int ContourRectanglesFixedPointHelper(const nlohmann::json &input,
+                                             const Columns &data,
+                                             Output *output,
+                                             std::string type) {
+  long double scale = input.at("scale");
+
+  if (!IsValidScale(scale))
+    return -1;
+
+  size_t size = input.at("size");
+
+  if (size > data.Count())
+    return -1;
+
+  std::vector<Rectangle<FixedPointType>> rectangles(size);
+
+  for (size_t i = 0; i < size; i++) {
+    FixedPointType corners[2][2];
+
+    for (size_t j = 0; j < 2; j++)
+      for (size_t k = 0; k < 2; k++)
+        if (!SnapToGrid(data.template Get<long double>(2 * j + k, i), scale,
+                        &corners[j][k]))
+          return -1;
+
+    rectangles[i] = Rectangle<FixedPointType>(
+        Point<FixedPointType>(corners[0][0], corners[0][1]),
+        Point<FixedPointType>(corners[1][0], corners[1][1]),
+        static_cast<int>(i + 1));
 
-  (*output)["size"] = res->size();
+    if (!IsValidRectangle(rectangles[i]))
+      return -1;
+  }
+
+  MetricsScope::Mark(RequestPhase::kParse);
+
+  bool connected = input.value("components", false);
+  RectangleComponents<FixedPointType> components(rectangles.data(),
+                                                 connected ? size : 0);
+  std::list<Edge<FixedPointType> *> *res = ContourRectangles<FixedPointType>(
+      rectangles.data(), static_cast<int>(size), [&](size_t j, bool left) {
+        if (connected)
+          components(j, left);
+      });
+
+  std::vector<T> segments;
+
+  segments.reserve(4 * res->size());
+
+  for (auto iter = res->begin(); iter != res->end(); iter++) {
+    segments.push_back(FromGrid<T>((*iter)->Origin().X(), scale));
+    segments.push_back(FromGrid<T>((*iter)->Origin().Y(), scale));
+    segments.push_back(FromGrid<T>((*iter)->Destination().X(), scale));
+    segments.push_back(FromGrid<T>((*iter)->Destination().Y(), scale));
+    delete (*iter);
+  }
+  delete res;
+
+  MetricsScope::Mark(RequestPhase::kCompute);
+  WriteContour(input, segments, type, connected ? &components : nullptr,
+               output);
+  MetricsScope::Mark(RequestPhase::kSerialize);
+
+  return 0;
+}
+
+/**
+ * @brief Записать контур в выходные данные в формате JSON.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam U Тип данных координат, в которых искались компоненты.
+ *
+ * @param input Поля запроса.
+ * @param segments Концы рёбер контура (по четыре координаты на ребро).
+ * @param type Строковое представление типа данных координат точек.
+ * @param components Компоненты связности или nullptr, если они не
+ * запрошены.
+ * @param output Выходные данные.
+ *
+ * Идентификаторы прямоугольников начинаются с единицы, а в выходных
+ * данных компонента обозначается наименьшим номером своего
+ * прямоугольника, начиная с нуля (как в /RectangleComponents).
+ */
+template <typename T, typename U>
+static void WriteContour(const nlohmann::json &input,
+                         const std::vector<T> &segments,
+                         const std::string &type,
+                         RectangleComponents<U> *components,
+                         nlohmann::json *output) {
+  (*output)["id"] = input.at("id");
+  (*output)["size"] = segments.size() / 4;
   (*output)["type"] = type;
-  size_t i = 0;
-  for (auto iter = res->begin(); iter != res->end(); iter++, i++) {
-    (*output)["data"][i][0][0] = (*iter)->Origin().X();
-    (*output)["data"][i][0][1] = (*iter)->Origin().Y();
-    (*output)["data"][i][1][0] = (*iter)->Destination().X();
-    (*output)["data"][i][1][1] = (*iter)->Destination().Y();
+
+  if (input.contains("scale"))
+    (*output)["scale"] = input.at("scale");
+
+  if (components) {
+    (*output)["components"] = nlohmann::json::array();
+    (*output)["holes"] = nlohmann::json::array();
+
+    for (int id : components->Components())
+      (*output)["components"].push_back(id - 1);
+
+    for (const std::pair<const int, size_t> &component :
+         components->Holes())
+      (*output)["holes"].push_back({ component.first - 1,
+                                     component.second });
+  }
+
+  for (size_t i = 0; 4 * i < segments.size(); i++) {
+    (*output)["data"][i][0][0] = segments[4 * i];
+    (*output)["data"][i][0][1] = segments[4 * i + 1];
+    (*output)["data"][i][1][0] = segments[4 * i + 2];
+    (*output)["data"][i][1][1] = segments[4 * i + 3];
+  }
+}
+
+/**
+ * @brief Записать контур прямо в текст ответа.
+ *
+ * Ключи записываются в порядке возрастания, как в nlohmann::json::dump(),
+ * а пустой массив "data" пропускается, поэтому для целых координат текст
+ * совпадает с сериализацией дерева.
+ */
+template <typename T, typename U>
+static void WriteContour(const nlohmann::json &input,
+                         const std::vector<T> &segments,
+                         const std::string &type,
+                         RectangleComponents<U> *components,
+                         JsonWriter *output) {
+  // Около 24 байт на координату с разделителями.
+  output->Reserve(24 * segments.size() + 64);
+  output->BeginObject();
+
+  if (components) {
+    output->Key("components");
+    output->BeginArray();
+
+    for (int id : components->Components())
+      output->Number(id - 1);
+
+    output->EndArray();
   }
-  // std::cout << output->dump() << '\n'; //Вывести результат в виде json
+
+  if (!segments.empty()) {
+    output->Key("data");
+    output->BeginArray();
+
+    for (size_t i = 0; i < segments.size(); i += 4) {
+      output->BeginArray();
+      output->BeginArray();
+      output->Number(segments[i]);
+      output->Number(segments[i + 1]);
+      output->EndArray();
+      output->BeginArray();
+      output->Number(segments[i + 2]);
+      output->Number(segments[i + 3]);
+      output->EndArray();
+      output->EndArray();
+    }
+
+    output->EndArray();
+  }
+
+  if (components) {
+    output->Key("holes");
+    output->BeginArray();
+
+    for (const std::pair<const int, size_t> &component :
+         components->Holes()) {
+      output->BeginArray();
+      output->Number(component.first - 1);
+      output->Number(component.second);
+      output->EndArray();
+    }
+
+    output->EndArray();
+  }
+
+  output->Key("id");
+  output->Value(input.at("id"));
+
+  if (input.contains("scale")) {
+    output->Key("scale");
+    output->Value(input.at("scale"));
+  }
+
+  output->Key("size");
+  output->Number(segments.size() / 4);
+  output->Key("type");
+  output->Value(type);
+  output->EndObject();
+}
+
+int ContourRectanglesBinaryMethod(const std::string &input,
+                                  std::string *output) {
+  WireDecoder decoder;
+
+  // Четыре столбца: координаты углов sw и ne.
+  if (!decoder.Parse(input, 4))
+    return -1;
+
+  switch (decoder.Type()) {
+  case WireType::Int32:
+    MetricsScope::Type("int");
+    return ContourRectanglesBinaryHelper<int>(decoder, output);
+  case WireType::Float32:
+    MetricsScope::Type("float");
+    return ContourRectanglesBinaryHelper<float>(decoder, output);
+  case WireType::Float64:
+    MetricsScope::Type("double");
+    return ContourRectanglesBinaryHelper<double>(decoder, output);
+  }
+
+  return -1;
+}
+
+/**
+ * @brief Поиск контура объединения прямоугольников по запросу
+ * в двоичном формате.
+ *
+ * @tparam T Тип данных координат точек.
+ *
+ * @param input Разобранный запрос.
+ * @param output Ответ в двоичном формате: рёбра контура в четырёх
+ * столбцах (начало и конец ребра).
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если прямоугольник задан некорректно (см. IsValidRectangle()).
+ */
+template <typename T>
+static int ContourRectanglesBinaryHelper(const WireDecoder &input,
+                                         std::string *output) {
+  size_t size = input.Count();
+  std::vector<Rectangle<T>> data(size);
+
+  for (size_t i = 0; i < size; i++) {
+    data[i] = Rectangle<T>(Point<T>(input.Get<T>(0, i), input.Get<T>(1, i)),
+                           Point<T>(input.Get<T>(2, i), input.Get<T>(3, i)),
+                           static_cast<int>(i + 1));
+
+    if (!IsValidRectangle(data[i]))
+      return -1;
+  }
+
+  MetricsScope::Mark(RequestPhase::kParse);
+
+  std::list<Edge<T> *> *res = ContourRectangles<T>(data.data(),
+                                                   static_cast<int>(size));
+
+  MetricsScope::Mark(RequestPhase::kCompute);
+  WireEncoder<T> encoder(input.Id(), res->size(), 4);
+  size_t i = 0;
 
   for (auto iter = res->begin(); iter != res->end(); iter++, i++) {
+    encoder.Set(0, i, (*iter)->Origin().X());
+    encoder.Set(1, i, (*iter)->Origin().Y());
+    encoder.Set(2, i, (*iter)->Destination().X());
+    encoder.Set(3, i, (*iter)->Destination().Y());
     delete (*iter);
   }
   delete res;
-  delete[] data;
+
+  *output = encoder.Release();
+  MetricsScope::Mark(RequestPhase::kSerialize);
 
   return 0;
 }
@@ -0,0 +1,107 @@
+/**
+ * @file methods/convex_intersection_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функцию, которая пересекает пары выпуклых многоугольников
+ * или проверяет, пересекаются ли они. Функция принимает и возвращает
+ * данные в JSON формате.
+ */
+
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "convex_intersection.hpp"
+#include "coordinate_types.hpp"
+#include "parallel.hpp"
+#include "polygon_json.hpp"
+
+namespace geometry {
+
+template<typename T>
+static int ConvexIntersectionMethodHelper(const nlohmann::json& input,
+                                          nlohmann::json* output,
+                                          std::string type);
+
+int ConvexIntersectionMethod(const nlohmann::json& input,
+                             nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return ConvexIntersectionMethodHelper<T>(input, output, type);
+  });
+}
+
+/**
+ * @brief Пересечь набор пар выпуклых многоугольников.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename T>
+static int ConvexIntersectionMethodHelper(const nlohmann::json& input,
+                                          nlohmann::json* output,
+                                          std::string type) {
+  std::string mode = input.value("mode", "polygon");
+  size_t threads = input.value("threads", 0);
+  size_t size = input.at("size");
+
+  if (mode != "polygon" && mode != "test")
+    return -1;
+
+  std::vector<Polygon<T>> first, second;
+
+  first.reserve(size);
+  second.reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    first.push_back(ReadPolygon<T>(input.at("data").at(i).at(0)));
+    second.push_back(ReadPolygon<T>(input.at("data").at(i).at(1)));
+
+    if (!IsConvex(first.back(), T(0)) || !IsConvex(second.back(), T(0)))
+      return -1;
+  }
+
+  (*output)["id"] = input.at("id");
+  (*output)["size"] = size;
+  (*output)["type"] = type;
+  (*output)["mode"] = mode;
+
+  if (mode == "test") {
+    std::vector<char> intersects(size);
+
+    ParallelFor(size, [&](size_t i) {
+      intersects[i] = ConvexPolygonsIntersect(first[i], second[i]);
+    }, threads);
+
+    (*output)["data"] = nlohmann::json::array();
+
+    for (char value : intersects)
+      (*output)["data"].push_back(value != 0);
+
+    return 0;
+  }
+
+  std::vector<Polygon<T>> results(size);
+
+  ParallelFor(size, [&](size_t i) {
+    results[i] = ConvexIntersection(first[i], second[i], T(0));
+  }, threads);
+
+  (*output)["data"] = nlohmann::json::array();
+
+  for (const Polygon<T>& result : results) {
+    (*output)["data"].push_back(nlohmann::json());
+    WritePolygon<T>(result.Vertices(), &(*output)["data"].back());
+  }
+
+  return 0;
+}
+
+}  // namespace geometry
@@ -0,0 +1,91 @@
+/**
+ * @file methods/convex_locator_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функцию, которая строит выпуклую оболочку набора точек
+ * и определяет положение точек запроса относительно неё. Функция
+ * принимает и возвращает данные в JSON формате.
+ */
+
+#include <list>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "convex_locator.hpp"
+#include "coordinate_types.hpp"
+#include "graham_scan.hpp"
+
+namespace geometry {
+
+template<typename T>
+static int ConvexLocateMethodHelper(const nlohmann::json& input,
+                                    nlohmann::json* output,
+                                    std::string type);
+
+int ConvexLocateMethod(const nlohmann::json& input, nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return ConvexLocateMethodHelper<T>(input, output, type);
+  });
+}
+
+/**
+ * @brief Построить оболочку и выполнить запросы положения точек.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename T>
+static int ConvexLocateMethodHelper(const nlohmann::json& input,
+                                    nlohmann::json* output,
+                                    std::string type) {
+  size_t threads = input.value("threads", 0);
+  size_t count = input.at("points").at(0).size();
+  size_t size = input.at("size");
+
+  if (count == 0)
+    return -1;
+
+  std::list<Point<T>> points;
+
+  for (size_t i = 0; i < count; i++) {
+    points.push_back(Point<T>(input.at("points").at(0).at(i),
+                              input.at("points").at(1).at(i)));
+  }
+
+  std::vector<Point<T>> queries;
+
+  queries.reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    queries.push_back(Point<T>(input.at("queries").at(0).at(i),
+                               input.at("queries").at(1).at(i)));
+  }
+
+  Polygon<T> hull = GrahamScan<T>(points, count);
+  ConvexLocator<T> locator(hull);
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["size"] = size;
+  (*output)["hull"] = { nlohmann::json::array(), nlohmann::json::array() };
+
+  for (const Point<T>& vertex : hull.Vertices()) {
+    (*output)["hull"][0].push_back(vertex.X());
+    (*output)["hull"][1].push_back(vertex.Y());
+  }
+
+  (*output)["data"] = locator.Locate(queries, threads);
+
+  return 0;
+}
+
+}  // namespace geometry
@@ -0,0 +1,232 @@
+/**
+ * @file methods/coordinate_types.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Список типов координат, которые принимают методы, и выбор экземпляра
+ * шаблона метода по полю "type" запроса.
+ */
+
+#ifndef METHODS_COORDINATE_TYPES_HPP_
+#define METHODS_COORDINATE_TYPES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <string_view>
+#include <utility>
+
+namespace geometry {
+
+/**
+ * @brief Название типа координат в поле "type".
+ *
+ * Чтобы методы принимали новый тип координат, достаточно добавить
+ * специализацию этого шаблона и указать тип в списке CoordinateTypes.
+ */
+template<typename T>
+struct CoordinateName;
+
+template<>
+struct CoordinateName<int> {
+  static constexpr std::string_view kValue = "int";
+};
+
+template<>
+struct CoordinateName<float> {
+  static constexpr std::string_view kValue = "float";
+};
+
+template<>
+struct CoordinateName<double> {
+  static constexpr std::string_view kValue = "double";
+};
+
+template<>
+struct CoordinateName<long double> {
+  static constexpr std::string_view kValue = "long double";
+};
+
+//! Метка типа координат, передаваемая обработчику в DispatchType().
+template<typename T>
+struct CoordinateTag {
+  using Type = T;
+};
+
+namespace detail {
+
+/**
+ * @brief Хеш FNV-1a с заданным начальным значением.
+ */
+constexpr uint32_t CoordinateHash(std::string_view name, uint32_t seed) {
+  uint32_t hash = 2166136261u ^ seed;
+
+  for (char c : name)
+    hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+
+  return hash;
+}
+
+/**
+ * @brief Размер таблицы: наименьшая степень двойки не меньше 2 * size.
+ */
+constexpr size_t CoordinateTableSize(size_t size) {
+  size_t table = 1;
+
+  while (table < 2 * size)
+    table *= 2;
+
+  return table;
+}
+
+/**
+ * @brief Найти начальное значение хеша, при котором у названий нет
+ * коллизий в таблице размера Table.
+ *
+ * @return Начальное значение или 0, если подходящего нет.
+ */
+template<size_t Table, size_t Size>
+constexpr uint32_t CoordinateSeed(
+    const std::array<std::string_view, Size>& names) {
+  for (uint32_t seed = 1; seed < 65536; seed++) {
+    std::array<bool, Table> used{};
+    bool collision = false;
+
+    for (size_t i = 0; i < Size && !collision; i++) {
+      size_t slot = CoordinateHash(names[i], seed) & (Table - 1);
+
+      collision = used[slot];
+      used[slot] = true;
+    }
+
+    if (!collision)
+      return seed;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Построить таблицу: номер типа плюс один в ячейке его названия,
+ * 0 в пустых ячейках.
+ */
+template<size_t Table, size_t Size>
+constexpr std::array<uint8_t, Table> CoordinateTable(
+    const std::array<std::string_view, Size>& names, uint32_t seed) {
+  std::array<uint8_t, Table> table{};
+
+  for (size_t i = 0; i < Size; i++)
+    table[CoordinateHash(names[i], seed) & (Table - 1)] =
+        static_cast<uint8_t>(i + 1);
+
+  return table;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Список типов координат.
+ *
+ * @tparam Types Типы координат.
+ *
+ * Название типа ищется совершенным хешированием: таблица и начальное
+ * значение хеша, при котором названия не дают коллизий, вычисляются
+ * при компиляции. Поиск хеширует строку один раз и сравнивает её
+ * с единственным кандидатом, а экземпляр шаблона выбирается по номеру
+ * типа, из сравнений с которым компилятор строит таблицу переходов.
+ */
+template<typename... Types>
+class CoordinateTypeList {
+ public:
+  //! Число типов.
+  static constexpr size_t kSize = sizeof...(Types);
+
+  static_assert(kSize > 0 && kSize < 256, "unsupported number of types");
+
+  //! Названия типов.
+  static constexpr std::array<std::string_view, kSize> kNames = {
+    CoordinateName<Types>::kValue...
+  };
+
+ private:
+  static constexpr size_t kTableSize = detail::CoordinateTableSize(kSize);
+  static constexpr uint32_t kSeed =
+      detail::CoordinateSeed<kTableSize>(kNames);
+
+  static_assert(kSeed != 0, "no perfect hash for coordinate type names");
+
+  static constexpr std::array<uint8_t, kTableSize> kTable =
+      detail::CoordinateTable<kTableSize>(kNames, kSeed);
+
+ public:
+  /**
+   * @brief Найти тип по названию.
+   *
+   * @param name Название типа.
+   * @return Номер типа в списке или -1, если тип неизвестен.
+   */
+  static constexpr int Find(std::string_view name) {
+    size_t slot = detail::CoordinateHash(name, kSeed) & (kTableSize - 1);
+    int index = static_cast<int>(kTable[slot]) - 1;
+
+    if (index < 0 || kNames[index] != name)
+      return -1;
+
+    return index;
+  }
+
+  /**
+   * @brief Вызвать обработчик для типа с заданным названием.
+   *
+   * @tparam Function Обработчик, принимающий CoordinateTag<T> и
+   * возвращающий int (обычно обобщённая лямбда).
+   *
+   * @param name Название типа.
+   * @param function Обработчик.
+   * @return Результат обработчика или -1, если тип неизвестен.
+   */
+  template<typename Function>
+  static int Dispatch(std::string_view name, Function&& function) {
+    return Call(Find(name), function, std::index_sequence_for<Types...>());
+  }
+
+ private:
+  template<typename Function, size_t... I>
+  static int Call(int index, Function& function, std::index_sequence<I...>) {
+    int result = -1;
+
+    static_cast<void>(((index == static_cast<int>(I) &&
+                        (result = function(CoordinateTag<Types>()), true)) ||
+                       ...));
+
+    return result;
+  }
+};
+
+//! Типы координат, которые принимают методы.
+using CoordinateTypes = CoordinateTypeList<int, float, double, long double>;
+
+/**
+ * @brief Вызвать обработчик для типа координат из поля "type".
+ *
+ * Заменяет цепочку сравнений строки с названиями типов:
+ *
+ * @code
+ * return DispatchType(type, [&](auto coordinate) {
+ *   using T = typename decltype(coordinate)::Type;
+ *
+ *   return MethodHelper<T>(input, output, type);
+ * });
+ * @endcode
+ *
+ * @param type Название типа координат.
+ * @param function Обработчик, принимающий CoordinateTag<T>.
+ * @return Результат обработчика или -1, если тип неизвестен.
+ */
+template<typename Function>
+int DispatchType(std::string_view type, Function&& function) {
+  return CoordinateTypes::Dispatch(type, std::forward<Function>(function));
+}
+
+}  // namespace geometry
+
+#endif  // METHODS_COORDINATE_TYPES_HPP_
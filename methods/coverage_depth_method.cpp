@@ -0,0 +1,80 @@
+/**
+ * @file methods/coverage_depth_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функцию, которая находит максимальную глубину покрытия
+ * плоскости набором прямоугольников. Функция принимает и возвращает
+ * данные в JSON формате.
+ */
+
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "coordinate_types.hpp"
+#include "coverage_depth.hpp"
+
+namespace geometry {
+
+template<typename T>
+static int CoverageDepthMethodHelper(const nlohmann::json& input,
+                                     nlohmann::json* output,
+                                     std::string type);
+
+int CoverageDepthMethod(const nlohmann::json& input, nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return CoverageDepthMethodHelper<T>(input, output, type);
+  });
+}
+
+/**
+ * @brief Найти максимальную глубину покрытия.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename T>
+static int CoverageDepthMethodHelper(const nlohmann::json& input,
+                                     nlohmann::json* output,
+                                     std::string type) {
+  bool histogram = input.value("histogram", false);
+  size_t size = input.at("size");
+
+  std::vector<Rectangle<T>> data(size);
+
+  for (size_t i = 0; i < size; i++) {
+    data[i] = Rectangle<T>(Point<T>(input.at("data").at(i).at(0).at(0),
+                                    input.at("data").at(i).at(0).at(1)),
+                           Point<T>(input.at("data").at(i).at(1).at(0),
+                                    input.at("data").at(i).at(1).at(1)),
+                           static_cast<int>(i));
+
+    if (data[i].ne.X() < data[i].sw.X() || data[i].ne.Y() < data[i].sw.Y())
+      return -1;
+  }
+
+  RectangleCoverage<T> result = MaxCoverageDepth(data.data(), size,
+                                                 histogram);
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["depth"] = result.depth;
+
+  if (result.depth > 0)
+    (*output)["witness"] = { result.witness.X(), result.witness.Y() };
+
+  if (histogram)
+    (*output)["histogram"] = result.histogram;
+
+  return 0;
+}
+
+}  // namespace geometry
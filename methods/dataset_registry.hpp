@@ -0,0 +1,191 @@
+/**
+ * @file methods/dataset_registry.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реестр построенных на сервере структур данных. Структура строится
+ * один раз по запросу клиента и затем используется многими запросами.
+ */
+
+#ifndef METHODS_DATASET_REGISTRY_HPP_
+#define METHODS_DATASET_REGISTRY_HPP_
+
+#include <cstddef>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <nlohmann/json.hpp>
+#include "coordinate_types.hpp"
+
+namespace geometry {
+
+/**
+ * @brief Наибольшее число наборов данных в одном реестре.
+ *
+ * Значение общее для всех реестров и задаётся при запуске сервера
+ * (см. ServerOptions::datasets).
+ *
+ * @return Ссылка на значение.
+ */
+inline std::atomic<size_t>& DatasetCapacity() {
+  static std::atomic<size_t> capacity(64);
+
+  return capacity;
+}
+
+/**
+ * @brief Реестр именованных структур данных.
+ *
+ * @tparam Index Тип структуры данных.
+ *
+ * Для каждого типа структуры существует один реестр. Структуры хранятся
+ * в виде std::shared_ptr на константный объект, поэтому запрос, который
+ * получил структуру, может продолжать с ней работать, даже если
+ * параллельный запрос заменил или удалил её в реестре. Блокировка
+ * удерживается только на время поиска в таблице.
+ *
+ * Число наборов ограничено значением DatasetCapacity(): при добавлении
+ * сверх него удаляются наборы, которые дольше всего не использовались.
+ */
+template<typename Index>
+class DatasetRegistry {
+ private:
+  //! Набор данных.
+  struct Entry {
+    //! Имя набора.
+    std::string name;
+    //! Структура данных.
+    std::shared_ptr<const Index> index;
+  };
+
+  //! Мьютекс, защищающий список и таблицу.
+  std::mutex mutex;
+  //! Наборы в порядке использования (в начале --- последние).
+  std::list<Entry> entries;
+  //! Таблица наборов по имени.
+  std::unordered_map<std::string, typename std::list<Entry>::iterator>
+      datasets;
+
+ public:
+  /**
+   * @brief Получить реестр для данного типа структур.
+   * @return Ссылка на реестр.
+   */
+  static DatasetRegistry& Instance() {
+    static DatasetRegistry registry;
+
+    return registry;
+  }
+
+  /**
+   * @brief Добавить или заменить структуру данных.
+   *
+   * @param name Имя набора данных.
+   * @param index Структура данных.
+   */
+  void Insert(const std::string& name, std::shared_ptr<const Index> index) {
+    size_t capacity = DatasetCapacity().load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = datasets.find(name);
+
+    if (it != datasets.end()) {
+      it->second->index = std::move(index);
+      entries.splice(entries.begin(), entries, it->second);
+      return;
+    }
+
+    entries.push_front(Entry{ name, std::move(index) });
+    datasets[name] = entries.begin();
+
+    while (entries.size() > capacity) {
+      datasets.erase(entries.back().name);
+      entries.pop_back();
+    }
+  }
+
+  /**
+   * @brief Найти структуру данных.
+   *
+   * @param name Имя набора данных.
+   * @return Структура данных или nullptr, если набор не найден.
+   */
+  std::shared_ptr<const Index> Find(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = datasets.find(name);
+
+    if (it == datasets.end())
+      return nullptr;
+
+    entries.splice(entries.begin(), entries, it->second);
+
+    return it->second->index;
+  }
+
+  /**
+   * @brief Удалить структуру данных.
+   *
+   * @param name Имя набора данных.
+   * @return Функция возвращает false, если набор не найден.
+   */
+  bool Erase(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = datasets.find(name);
+
+    if (it == datasets.end())
+      return false;
+
+    entries.erase(it->second);
+    datasets.erase(it);
+
+    return true;
+  }
+
+  /**
+   * @brief Число наборов в реестре.
+   */
+  size_t Size() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return entries.size();
+  }
+
+ private:
+  DatasetRegistry() = default;
+};
+
+/**
+ * @brief Удалить набор данных по запросу клиента.
+ *
+ * @tparam Function Обработчик, принимающий CoordinateTag<T> и имя набора
+ * и удаляющий набор из реестра нужного типа.
+ *
+ * @param input Входные данные в формате JSON ("id", "type" и "name").
+ * @param output Выходные данные в формате JSON.
+ * @param erase Обработчик.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Поле "dropped" ответа равно false, если набора с таким именем нет.
+ */
+template<typename Function>
+int DropDatasetMethod(const nlohmann::json& input, nlohmann::json* output,
+                      Function erase) {
+  std::string type = input.at("type");
+  std::string name = input.at("name");
+
+  return DispatchType(type, [&](auto coordinate) {
+    (*output)["id"] = input.at("id");
+    (*output)["type"] = type;
+    (*output)["name"] = name;
+    (*output)["dropped"] = erase(coordinate, name);
+
+    return 0;
+  });
+}
+
+}  // namespace geometry
+
+#endif  // METHODS_DATASET_REGISTRY_HPP_
@@ -0,0 +1,92 @@
+/**
+ * @file methods/delaunay_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функцию, которая строит триангуляцию Делоне и диаграмму
+ * Вороного. Функция принимает и возвращает данные в JSON формате.
+ */
+
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "coordinate_types.hpp"
+#include "delaunay.hpp"
+
+namespace geometry {
+
+template<typename T>
+static int DelaunayMethodHelper(const nlohmann::json& input,
+                                nlohmann::json* output,
+                                std::string type);
+
+int DelaunayMethod(const nlohmann::json& input, nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return DelaunayMethodHelper<T>(input, output, type);
+  });
+}
+
+/**
+ * @brief Метод построения триангуляции Делоне.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename T>
+static int DelaunayMethodHelper(const nlohmann::json& input,
+                                nlohmann::json* output,
+                                std::string type) {
+  using CoordinateType = typename DelaunayTriangulation<T>::CoordinateType;
+
+  size_t size = input.at("size");
+  bool voronoi = input.value("voronoi", false);
+  std::vector<Point<T>> data;
+
+  data.reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    data.push_back(Point<T>(input.at("data").at(0).at(i),
+                            input.at("data").at(1).at(i)));
+  }
+
+  DelaunayTriangulation<T> triangulation(data);
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["size"] = triangulation.Size();
+  (*output)["data"] = triangulation.Triangles();
+
+  if (!voronoi)
+    return 0;
+
+  VoronoiDiagram<CoordinateType> diagram = triangulation.Voronoi();
+  std::vector<CoordinateType> xs, ys;
+  nlohmann::json rays = nlohmann::json::array();
+
+  xs.reserve(diagram.vertices.size());
+  ys.reserve(diagram.vertices.size());
+
+  for (const Point<CoordinateType>& vertex : diagram.vertices) {
+    xs.push_back(vertex.X());
+    ys.push_back(vertex.Y());
+  }
+
+  for (const auto& ray : diagram.rays)
+    rays.push_back({ ray.first, ray.second.X(), ray.second.Y() });
+
+  (*output)["voronoi"]["vertices"] = { xs, ys };
+  (*output)["voronoi"]["edges"] = diagram.edges;
+  (*output)["voronoi"]["rays"] = rays;
+
+  return 0;
+}
+
+}  // namespace geometry
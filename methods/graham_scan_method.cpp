@@ -11,58 +11,341 @@
 #include <iostream>
 #include <string>
 #include <nlohmann/json.hpp>
+#include "coordinate_types.hpp"
+#include "fixed_point.hpp"
+#include "json_columns.hpp"
+#include "json_writer.hpp"
+#include "request_metrics.hpp"
+#include "wire_format.hpp"
 
 namespace geometry {
 
+//! Точки задаются столбцами: {"data": [[x...], [y...]]}.
+static constexpr ColumnLayout kGrahamScanLayout = { 2, 1 };
+
+template<typename Columns, typename Output>
+static int GrahamScanDispatch(const nlohmann::json& input,
+                              const Columns& data, Output* output);
+
+template<typename T, typename Columns, typename Output>
+static int GrahamScanMethodHelper(const nlohmann::json& input,
+                                  const Columns& data,
+                                  Output* output, std::string type);
+
+template<typename T, typename Columns, typename Output>
+static int GrahamScanFixedPointHelper(const nlohmann::json& input,
+                                      const Columns& data,
+                                      Output* output,
+                                      std::string type);
+
+template<typename T>
+static void WriteHull(const nlohmann::json& input,
+                      const std::list<Point<T>>& hull,
+                      const std::string& type, nlohmann::json* output);
+
+template<typename T>
+static void WriteHull(const nlohmann::json& input,
+                      const std::list<Point<T>>& hull,
+                      const std::string& type, JsonWriter* output);
+
 template<typename T>
-int GrahamScanMethodHelper(const nlohmann::json& input,
-                           nlohmann::json* output, std::string type);
+static int GrahamScanBinaryHelper(const WireDecoder& input,
+                                  std::string* output);
 
 int GrahamScanMethod(const nlohmann::json& input, nlohmann::json* output) {
-  std::string type = input.at("type");
-  if (type == "int") {
-    return GrahamScanMethodHelper<int>(input, output, type);
-  } else if (type == "float") {
-    return GrahamScanMethodHelper<float>(input, output, type);
-  } else if (type == "double") {
-    return GrahamScanMethodHelper<double>(input, output, type);
-  } else if (type == "long double") {
-    return GrahamScanMethodHelper<long double>(input, output, type);
+  return GrahamScanDispatch(input, JsonColumnView(input, kGrahamScanLayout),
+                            output);
+}
+
+int GrahamScanTextMethod(const std::string& input, std::string* output) {
+  JsonColumnParser parser(kGrahamScanLayout);
+  nlohmann::json dom;
+  int precision = -1, result = -1;
+
+  // Запрос, который не удалось разобрать потоково, разбирается в дерево,
+  // чтобы ошибки обрабатывались так же, как в GrahamScanMethod().
+  bool streamed = parser.Parse(input);
+
+  if (!streamed)
+    dom = nlohmann::json::parse(input);
+
+  const nlohmann::json& header = streamed ? parser.Header() : dom;
+
+  output->clear();
+
+  if (JsonWriter::ReadPrecision(header, &precision)) {
+    JsonWriter writer(output, precision);
+
+    result = streamed ?
+        GrahamScanDispatch(header, parser, &writer) :
+        GrahamScanDispatch(header, JsonColumnView(dom, kGrahamScanLayout),
+                           &writer);
   }
 
+  if (result < 0)
+    *output = "null";
+
+  return result;
+}
+
+/**
+ * @brief Выбор типа координат по полю "type".
+ *
+ * @tparam Columns Источник координат (JsonColumnView или
+ * JsonColumnParser).
+ * @tparam Output Получатель ответа (nlohmann::json или JsonWriter).
+ *
+ * @param input Поля запроса.
+ * @param data Столбцы координат.
+ * @param output Выходные данные.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename Columns, typename Output>
+static int GrahamScanDispatch(const nlohmann::json& input,
+                              const Columns& data, Output* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    MetricsScope::Type(CoordinateName<T>::kValue);
+
+    return GrahamScanMethodHelper<T>(input, data, output, type);
+  });
+}
+
+template<typename T, typename Columns, typename Output>
+static int GrahamScanMethodHelper(const nlohmann::json& input,
+                                  const Columns& data,
+                                  Output* output, std::string type) {
+  if (input.contains("scale"))
+    return GrahamScanFixedPointHelper<T>(input, data, output, type);
+
+  size_t size = input.at("size");
+
+  if (size > data.Count())
     return -1;
+
+  std::list<Point<T>> points;
+  for (size_t i = 0; i < size; i++) {
+    points.push_back(Point<T>(data.template Get<T>(0, i),
+                              data.template Get<T>(1, i)));
+  }
+
+  MetricsScope::Mark(RequestPhase::kParse);
+
+  Polygon<T> P = GrahamScan<T>(points, size);
+
+  MetricsScope::Mark(RequestPhase::kCompute);
+  WriteHull(input, P.Vertices(), type, output);
+  MetricsScope::Mark(RequestPhase::kSerialize);
+
+  return 0;
 }
 
-template<typename T>
-int GrahamScanMethodHelper(const nlohmann::json& input,
-                           nlohmann::json* output, std::string type) {
-  (*output)["id"] = input.at("id");
+/**
+ * @brief Построение выпуклой оболочки в режиме фиксированной точки.
+ *
+ * @tparam T Тип данных координат во входных и выходных данных.
+ * @tparam Columns Источник координат.
+ * @tparam Output Получатель ответа.
+ *
+ * @param input Поля запроса.
+ * @param data Столбцы координат.
+ * @param output Выходные данные.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Координаты умножаются на масштаб "scale" и округляются до целых чисел,
+ * после чего оболочка строится точными целочисленными предикатами.
+ * Вершины оболочки переводятся обратно в исходные единицы.
+ */
+template<typename T, typename Columns, typename Output>
+static int GrahamScanFixedPointHelper(const nlohmann::json& input,
+                                      const Columns& data,
+                                      Output* output,
+                                      std::string type) {
+  long double scale = input.at("scale");
+
+  if (!IsValidScale(scale))
+    return -1;
 
   size_t size = input.at("size");
 
-  std::list<Point<T>> data;
+  if (size > data.Count())
+    return -1;
+
+  std::list<Point<FixedPointType>> points;
   for (size_t i = 0; i < size; i++) {
-    data.push_back(Point<T>(input.at("data").at(0).at(i),
-                            input.at("data").at(1).at(i)));
+    FixedPointType x = 0, y = 0;
+
+    if (!SnapToGrid(data.template Get<long double>(0, i), scale, &x) ||
+        !SnapToGrid(data.template Get<long double>(1, i), scale, &y))
+      return -1;
+
+    points.push_back(Point<FixedPointType>(x, y));
   }
 
-  Polygon<T> P = GrahamScan<T>(data, size);
+  MetricsScope::Mark(RequestPhase::kParse);
 
-  size = P.Size();
-  data = P.Vertices();
-  (*output)["size"] = size;
+  Polygon<FixedPointType> P = GrahamScan<FixedPointType>(points, size);
+  std::list<Point<T>> hull;
+
+  for (const Point<FixedPointType>& n : P.Vertices())
+    hull.push_back(Point<T>(FromGrid<T>(n.X(), scale),
+                            FromGrid<T>(n.Y(), scale)));
+
+  MetricsScope::Mark(RequestPhase::kCompute);
+  WriteHull(input, hull, type, output);
+  MetricsScope::Mark(RequestPhase::kSerialize);
+
+  return 0;
+}
+
+/**
+ * @brief Записать оболочку в выходные данные в формате JSON.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Поля запроса.
+ * @param hull Вершины оболочки.
+ * @param type Строковое представление типа данных координат.
+ * @param output Выходные данные.
+ */
+template<typename T>
+static void WriteHull(const nlohmann::json& input,
+                      const std::list<Point<T>>& hull,
+                      const std::string& type, nlohmann::json* output) {
+  (*output)["id"] = input.at("id");
+  (*output)["size"] = hull.size();
   (*output)["type"] = type;
 
+  if (input.contains("scale"))
+    (*output)["scale"] = input.at("scale");
+
   size_t i = 0;
-  for (Point<T> n : data) {
+  for (Point<T> n : hull) {
     (*output)["data"][0][i] = n.X();
     (*output)["data"][1][i] = n.Y();
     i++;
   }
+}
+
+/**
+ * @brief Записать оболочку прямо в текст ответа.
+ *
+ * Ключи записываются в порядке возрастания, как в nlohmann::json::dump(),
+ * а пустой массив "data" пропускается, поэтому для целых координат текст
+ * совпадает с сериализацией дерева.
+ */
+template<typename T>
+static void WriteHull(const nlohmann::json& input,
+                      const std::list<Point<T>>& hull,
+                      const std::string& type, JsonWriter* output) {
+  // Около 24 байт на координату с разделителем.
+  output->Reserve(48 * hull.size() + 64);
+  output->BeginObject();
+
+  if (!hull.empty()) {
+    output->Key("data");
+    output->BeginArray();
+    output->BeginArray();
+
+    for (const Point<T>& n : hull)
+      output->Number(n.X());
+
+    output->EndArray();
+    output->BeginArray();
+
+    for (const Point<T>& n : hull)
+      output->Number(n.Y());
+
+    output->EndArray();
+    output->EndArray();
+  }
+
+  output->Key("id");
+  output->Value(input.at("id"));
+
+  if (input.contains("scale")) {
+    output->Key("scale");
+    output->Value(input.at("scale"));
+  }
+
+  output->Key("size");
+  output->Number(hull.size());
+  output->Key("type");
+  output->Value(type);
+  output->EndObject();
+}
+
+int GrahamScanBinaryMethod(const std::string& input, std::string* output) {
+  WireDecoder decoder;
+
+  // Два столбца: координаты x и y.
+  if (!decoder.Parse(input, 2))
+    return -1;
+
+  switch (decoder.Type()) {
+  case WireType::Int32:
+    MetricsScope::Type("int");
+    return GrahamScanBinaryHelper<int>(decoder, output);
+  case WireType::Float32:
+    MetricsScope::Type("float");
+    return GrahamScanBinaryHelper<float>(decoder, output);
+  case WireType::Float64:
+    MetricsScope::Type("double");
+    return GrahamScanBinaryHelper<double>(decoder, output);
+  }
 
   return -1;
 }
 
+/**
+ * @brief Построение выпуклой оболочки по запросу в двоичном формате.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Разобранный запрос.
+ * @param output Ответ в двоичном формате.
+ * @return Функция возвращает 0 в случае успеха.
+ *
+ * Точки читаются из тела запроса прямо в список, передаваемый
+ * алгоритму, без промежуточного JSON представления.
+ */
+template<typename T>
+static int GrahamScanBinaryHelper(const WireDecoder& input,
+                                  std::string* output) {
+  size_t size = input.Count();
+  std::list<Point<T>> data;
+
+  for (size_t i = 0; i < size; i++)
+    data.push_back(Point<T>(input.Get<T>(0, i), input.Get<T>(1, i)));
+
+  MetricsScope::Mark(RequestPhase::kParse);
+
+  if (size > 0)
+    data = GrahamScan<T>(data, size).Vertices();
+
+  MetricsScope::Mark(RequestPhase::kCompute);
+
+  WireEncoder<T> encoder(input.Id(), data.size(), 2);
+  size_t i = 0;
+
+  for (const Point<T>& n : data) {
+    encoder.Set(0, i, n.X());
+    encoder.Set(1, i, n.Y());
+    i++;
+  }
+
+  *output = encoder.Release();
+  MetricsScope::Mark(RequestPhase::kSerialize);
+
+  return 0;
+}
+
 // template<typename T>
 // static int InsertionSortMethodHelper(const nlohmann::json& input,
 //                                      nlohmann::json* output,
@@ -0,0 +1,441 @@
+/**
+ * @file methods/json_columns.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Чтение координат из поля "data" запроса в формате JSON в виде столбцов
+ * без построения дерева JSON.
+ */
+
+#ifndef METHODS_JSON_COLUMNS_HPP_
+#define METHODS_JSON_COLUMNS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <charconv>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace geometry {
+
+/**
+ * @brief Расположение координат в массиве "data".
+ *
+ * Координаты лежат в массивах глубины depth. Индекс элемента (точки или
+ * прямоугольника) находится на уровне axis, на остальных уровнях
+ * индексы равны 0 или 1 и вместе задают номер столбца (старший бит на
+ * верхнем уровне). Например, точки {"data": [[x...], [y...]]} имеют
+ * depth = 2 и axis = 1, а прямоугольники {"data": [[[x, y], [x, y]], ...]}
+ * имеют depth = 3 и axis = 0 (четыре столбца: углы sw и ne).
+ */
+struct ColumnLayout {
+  //! Глубина вложенности координат.
+  size_t depth;
+  //! Уровень индекса элемента.
+  size_t axis;
+
+  //! Число столбцов.
+  size_t Columns() const { return size_t(1) << (depth - 1); }
+};
+
+/**
+ * @brief Доступ к столбцам координат в уже разобранном запросе.
+ *
+ * Используется методами, которые получают запрос в виде nlohmann::json.
+ * Каждое обращение проходит путь по дереву JSON с проверкой индексов.
+ */
+class JsonColumnView {
+ private:
+  //! Массив "data" (nullptr, если его нет).
+  const nlohmann::json* data;
+  //! Расположение координат.
+  ColumnLayout layout;
+
+ public:
+  /**
+   * @brief Создать представление столбцов запроса.
+   *
+   * @param input Входные данные в формате JSON.
+   * @param layout Расположение координат в массиве "data".
+   */
+  JsonColumnView(const nlohmann::json& input, ColumnLayout layout) :
+      data(input.contains("data") ? &input.at("data") : nullptr),
+      layout(layout) { }
+
+  /**
+   * @brief Число элементов, заданных во всех столбцах.
+   */
+  size_t Count() const {
+    return data ? Count(*data, 0) : 0;
+  }
+
+  /**
+   * @brief Прочитать координату.
+   *
+   * @tparam T Тип координаты.
+   *
+   * @param column Номер столбца.
+   * @param i Номер элемента.
+   */
+  template<typename T>
+  T Get(size_t column, size_t i) const {
+    const nlohmann::json* node = data;
+    size_t bit = layout.depth - 1;
+
+    for (size_t level = 0; level < layout.depth; level++) {
+      if (level == layout.axis)
+        node = &node->at(i);
+      else
+        node = &node->at((column >> --bit) & 1);
+    }
+
+    return node->get<T>();
+  }
+
+ private:
+  size_t Count(const nlohmann::json& node, size_t level) const {
+    if (!node.is_array())
+      return 0;
+
+    if (level == layout.axis)
+      return node.size();
+
+    if (node.size() < 2)
+      return 0;
+
+    return std::min(Count(node[0], level + 1), Count(node[1], level + 1));
+  }
+};
+
+/**
+ * @brief Потоковый разбор запроса в формате JSON.
+ *
+ * Массив "data" разбирается за один проход по тексту запроса: числа
+ * читаются функцией std::from_chars() и сразу дописываются в столбцы
+ * типа double. Остальные поля верхнего уровня (они небольшие) разбираются
+ * nlohmann::json и собираются в объект Header(). Дерево JSON для
+ * координат не строится: узел nlohmann::json занимает 16 байт и ещё
+ * один вектор на каждый вложенный массив, а столбец хранит 8 байт на
+ * координату и не требует обхода дерева с проверкой индексов при чтении.
+ *
+ * Парсер nlohmann::json хранит вещественные числа в double, а
+ * std::from_chars() округляет так же, поэтому результат совпадает
+ * с разбором в дерево. Целые числа по модулю больше \f$ 2^{53} \f$
+ * в double непредставимы, поэтому для них, как и для синтаксических
+ * ошибок и координат, нарушающих расположение, Parse() возвращает
+ * false, и запрос следует разобрать обычным образом.
+ */
+class JsonColumnParser {
+ private:
+  //! Расположение координат.
+  ColumnLayout layout;
+  //! Поля запроса, кроме "data".
+  nlohmann::json header;
+  //! Столбцы координат.
+  std::vector<std::vector<double>> columns;
+  //! Индексы текущих элементов в открытых массивах "data".
+  std::vector<size_t> path;
+  //! Конец текста запроса.
+  const char* end = nullptr;
+  //! Текущая позиция разбора.
+  const char* position = nullptr;
+
+ public:
+  /**
+   * @brief Создать парсер.
+   *
+   * @param layout Расположение координат в массиве "data".
+   */
+  explicit JsonColumnParser(ColumnLayout layout) :
+      layout(layout),
+      columns(layout.Columns()),
+      path(layout.depth) { }
+
+  /**
+   * @brief Разобрать текст запроса.
+   *
+   * @param body Текст запроса.
+   * @return false, если текст не является объектом JSON, содержит
+   * ошибку или координаты не соответствуют расположению.
+   */
+  bool Parse(const std::string& body) {
+    header = nlohmann::json::object();
+    position = body.data();
+    end = position + body.size();
+
+    for (std::vector<double>& column : columns)
+      column.clear();
+
+    if (!Skip('{'))
+      return false;
+
+    bool seen = false;
+
+    if (!Skip('}')) {
+      do {
+        std::string name;
+
+        if (!Key(&name) || !Skip(':'))
+          return false;
+
+        if (name != "data") {
+          if (!Field(name))
+            return false;
+        } else if (seen || !Array(0)) {
+          return false;
+        } else {
+          seen = true;
+        }
+      } while (Skip(','));
+
+      if (!Skip('}'))
+        return false;
+    }
+
+    SkipSpaces();
+
+    return position == end;
+  }
+
+  //! Поля запроса, кроме "data".
+  const nlohmann::json& Header() const { return header; }
+
+  /**
+   * @brief Число элементов, заданных во всех столбцах.
+   */
+  size_t Count() const {
+    size_t count = columns[0].size();
+
+    for (const std::vector<double>& column : columns)
+      count = std::min(count, column.size());
+
+    return count;
+  }
+
+  /**
+   * @brief Прочитать координату.
+   *
+   * @tparam T Тип координаты.
+   *
+   * @param column Номер столбца.
+   * @param i Номер элемента.
+   */
+  template<typename T>
+  T Get(size_t column, size_t i) const {
+    return static_cast<T>(columns[column][i]);
+  }
+
+ private:
+  //! Наибольшее целое число, точно представимое в double.
+  static constexpr int64_t kExact = int64_t(1) << 53;
+
+  void SkipSpaces() {
+    while (position < end && (*position == ' ' || *position == '\n' ||
+                              *position == '\r' || *position == '\t'))
+      position++;
+  }
+
+  /**
+   * @brief Пропустить пробелы и символ symbol, если он следует за ними.
+   */
+  bool Skip(char symbol) {
+    SkipSpaces();
+
+    if (position == end || *position != symbol)
+      return false;
+
+    position++;
+    return true;
+  }
+
+  /**
+   * @brief Пропустить строку, начинающуюся с текущей позиции.
+   */
+  bool SkipString() {
+    for (position++; position < end; position++) {
+      if (*position == '"') {
+        position++;
+        return true;
+      }
+
+      if (*position == '\\' && ++position == end)
+        return false;
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Пропустить значение, не разбирая его (проверку выполняет
+   * nlohmann::json в Field()).
+   */
+  bool SkipValue() {
+    size_t nesting = 0;
+
+    SkipSpaces();
+
+    while (position < end) {
+      char symbol = *position;
+
+      if (symbol == '"') {
+        if (!SkipString())
+          return false;
+      } else if (symbol == '[' || symbol == '{') {
+        nesting++;
+        position++;
+      } else if (symbol == ']' || symbol == '}') {
+        if (nesting == 0)
+          return true;
+
+        nesting--;
+        position++;
+      } else if (symbol == ',' && nesting == 0) {
+        return true;
+      } else {
+        position++;
+      }
+
+      if (nesting == 0 && (symbol == '"' || symbol == ']' || symbol == '}'))
+        return true;
+    }
+
+    return nesting == 0;
+  }
+
+  bool Key(std::string* name) {
+    SkipSpaces();
+
+    const char* first = position;
+
+    if (position == end || *position != '"' || !SkipString())
+      return false;
+
+    nlohmann::json key = nlohmann::json::parse(first, position, nullptr,
+                                               false);
+
+    if (!key.is_string())
+      return false;
+
+    *name = key.get<std::string>();
+    return true;
+  }
+
+  bool Field(const std::string& name) {
+    SkipSpaces();
+
+    const char* first = position;
+
+    if (!SkipValue())
+      return false;
+
+    nlohmann::json value = nlohmann::json::parse(first, position, nullptr,
+                                                 false);
+
+    if (value.is_discarded())
+      return false;
+
+    header[name] = std::move(value);
+    return true;
+  }
+
+  /**
+   * @brief Разобрать массив уровня level внутри "data".
+   */
+  bool Array(size_t level) {
+    if (!Skip('['))
+      return false;
+
+    path[level] = 0;
+
+    if (Skip(']'))
+      return true;
+
+    do {
+      if (level + 1 < layout.depth ? !Array(level + 1) : !Number())
+        return false;
+
+      path[level]++;
+    } while (Skip(','));
+
+    return Skip(']');
+  }
+
+  bool Number() {
+    SkipSpaces();
+
+    const char* first = position;
+    bool integer = true;
+
+    while (position < end &&
+           ((*position >= '0' && *position <= '9') || *position == '-' ||
+            *position == '+' || *position == '.' || *position == 'e' ||
+            *position == 'E')) {
+      if (*position == '.' || *position == 'e' || *position == 'E')
+        integer = false;
+
+      position++;
+    }
+
+    // Запись числа в JSON начинается с минуса или цифры, а незначащие
+    // нули запрещены.
+    const char* digits = first < position && *first == '-' ? first + 1
+                                                          : first;
+
+    if (digits == position || *digits < '0' || *digits > '9' ||
+        (*digits == '0' && digits + 1 < position && digits[1] >= '0' &&
+         digits[1] <= '9'))
+      return false;
+
+    double value = 0;
+
+    if (integer) {
+      int64_t number = 0;
+      std::from_chars_result result = std::from_chars(first, position,
+                                                      number);
+
+      if (result.ec != std::errc() || result.ptr != position ||
+          number < -kExact || number > kExact)
+        return false;
+
+      value = static_cast<double>(number);
+    } else {
+      std::from_chars_result result = std::from_chars(first, position,
+                                                      value);
+
+      if (result.ec != std::errc() || result.ptr != position)
+        return false;
+    }
+
+    return Store(value);
+  }
+
+  bool Store(double value) {
+    size_t column = 0;
+
+    for (size_t level = 0; level < layout.depth; level++) {
+      if (level == layout.axis)
+        continue;
+
+      if (path[level] > 1)
+        return false;
+
+      column = 2 * column + path[level];
+    }
+
+    // Элементы каждого столбца должны идти подряд, без пропусков.
+    std::vector<double>& target = columns[column];
+
+    if (target.size() != path[layout.axis])
+      return false;
+
+    target.push_back(value);
+    return true;
+  }
+};
+
+}  // namespace geometry
+
+#endif  // METHODS_JSON_COLUMNS_HPP_
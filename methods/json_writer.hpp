@@ -0,0 +1,265 @@
+/**
+ * @file methods/json_writer.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Запись ответа в формате JSON прямо в строку без построения дерева JSON.
+ */
+
+#ifndef METHODS_JSON_WRITER_HPP_
+#define METHODS_JSON_WRITER_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <nlohmann/json.hpp>
+
+namespace geometry {
+
+/**
+ * @brief Запись JSON в строку.
+ *
+ * Значения дописываются в конец буфера по мере вызова методов, запятые
+ * между элементами расставляются автоматически. Ключи объектов нужно
+ * передавать в порядке возрастания: тогда результат для целых чисел
+ * и строк совпадает байт в байт с nlohmann::json::dump() (он хранит
+ * объекты в std::map).
+ *
+ * Вещественные числа по умолчанию записываются кратчайшей строкой,
+ * из которой число того же типа восстанавливается точно
+ * (std::to_chars()), в том же виде, что и у nlohmann::json: с ".0"
+ * у целых значений и в экспоненциальной записи вне диапазона
+ * \f$ [10^{-5}, 10^{15}) \f$. Алгоритм Grisu2 в nlohmann::json изредка
+ * выдаёт на одну-две цифры больше, поэтому для double запись совпадает
+ * с dump() или короче неё. Если задана точность, числа записываются
+ * с фиксированным числом знаков после запятой.
+ */
+class JsonWriter {
+ public:
+  //! Наибольшее допустимое число знаков после запятой.
+  static constexpr int kMaxPrecision = 30;
+
+ private:
+  //! Буфер, в который записывается ответ.
+  std::string* buffer;
+  //! Число знаков после запятой (-1 для кратчайшей записи).
+  int precision;
+  //! Перед следующим значением нужна запятая.
+  bool separate = false;
+
+ public:
+  /**
+   * @brief Создать объект записи.
+   *
+   * @param buffer Буфер, в конец которого записывается ответ.
+   * @param precision Число знаков после запятой у вещественных чисел
+   * или -1 для кратчайшей точной записи.
+   */
+  explicit JsonWriter(std::string* buffer, int precision = -1) :
+      buffer(buffer),
+      precision(precision) { }
+
+  /**
+   * @brief Прочитать необязательное поле "precision" запроса.
+   *
+   * @param input Поля запроса.
+   * @param precision Число знаков после запятой (-1, если поле не задано).
+   * @return false, если поле задано и не является целым числом от 0
+   * до kMaxPrecision.
+   */
+  static bool ReadPrecision(const nlohmann::json& input, int* precision) {
+    *precision = -1;
+
+    if (!input.contains("precision"))
+      return true;
+
+    const nlohmann::json& value = input.at("precision");
+
+    if (!value.is_number_integer() || value < 0 || value > kMaxPrecision)
+      return false;
+
+    *precision = value.get<int>();
+    return true;
+  }
+
+  /**
+   * @brief Зарезервировать место в буфере.
+   *
+   * @param bytes Ожидаемый размер ответа в байтах.
+   */
+  void Reserve(size_t bytes) { buffer->reserve(buffer->size() + bytes); }
+
+  //! Начать объект.
+  void BeginObject() { Open('{'); }
+
+  //! Закончить объект.
+  void EndObject() { Close('}'); }
+
+  //! Начать массив.
+  void BeginArray() { Open('['); }
+
+  //! Закончить массив.
+  void EndArray() { Close(']'); }
+
+  /**
+   * @brief Записать ключ объекта.
+   *
+   * @param name Ключ (не требует экранирования).
+   */
+  void Key(const char* name) {
+    Separate();
+    buffer->push_back('"');
+    buffer->append(name);
+    buffer->append("\":");
+    separate = false;
+  }
+
+  /**
+   * @brief Записать число.
+   *
+   * @tparam T Тип числа.
+   */
+  template<typename T>
+  void Number(T value) {
+    Separate();
+
+    if constexpr (std::is_integral_v<T>) {
+      char digits[24];
+      char* last = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+
+      buffer->append(digits, last);
+    } else {
+      AppendFloat(value);
+    }
+
+    separate = true;
+  }
+
+  /**
+   * @brief Записать произвольное значение JSON (например, поле запроса).
+   */
+  void Value(const nlohmann::json& value) {
+    Separate();
+    buffer->append(value.dump());
+    separate = true;
+  }
+
+ private:
+  void Separate() {
+    if (separate)
+      buffer->push_back(',');
+  }
+
+  void Open(char symbol) {
+    Separate();
+    buffer->push_back(symbol);
+    separate = false;
+  }
+
+  void Close(char symbol) {
+    buffer->push_back(symbol);
+    separate = true;
+  }
+
+  template<typename T>
+  void AppendFloat(T value) {
+    // nlohmann::json записывает бесконечности и NaN как null.
+    if (!std::isfinite(value)) {
+      buffer->append("null");
+      return;
+    }
+
+    char digits[128];
+
+    // Слишком большие числа в записи с фиксированной точностью не
+    // помещаются в буфер и записываются кратчайшим образом.
+    if (precision >= 0) {
+      std::to_chars_result result = std::to_chars(digits,
+                                                  digits + sizeof(digits),
+                                                  value,
+                                                  std::chars_format::fixed,
+                                                  precision);
+
+      if (result.ec == std::errc()) {
+        buffer->append(digits, result.ptr);
+        return;
+      }
+    }
+
+    // Кратчайшая запись в экспоненциальной форме d.ddde+XX даёт цифры
+    // и порядок, которые затем располагаются как в nlohmann::json.
+    char* last = std::to_chars(digits, digits + sizeof(digits), value,
+                               std::chars_format::scientific).ptr;
+    char* first = digits;
+
+    if (*first == '-') {
+      buffer->push_back('-');
+      first++;
+    }
+
+    char* exponent = static_cast<char*>(std::memchr(first, 'e',
+                                                    last - first));
+    int power = 0;
+
+    std::from_chars(exponent[1] == '+' ? exponent + 2 : exponent + 1, last,
+                    power);
+
+    // Цифры без точки: v = 0.d1d2...dk * 10^n.
+    char mantissa[64];
+    int k = 0;
+
+    for (char* p = first; p < exponent; p++) {
+      if (*p != '.')
+        mantissa[k++] = *p;
+    }
+
+    AppendDigits(mantissa, k, power + 1);
+  }
+
+  void AppendDigits(const char* mantissa, int k, int n) {
+    constexpr int kMinExp = -4;
+    constexpr int kMaxExp = std::numeric_limits<double>::digits10;
+
+    if (k <= n && n <= kMaxExp) {
+      buffer->append(mantissa, k);
+      buffer->append(n - k, '0');
+      buffer->append(".0");
+    } else if (0 < n && n <= kMaxExp) {
+      buffer->append(mantissa, n);
+      buffer->push_back('.');
+      buffer->append(mantissa + n, k - n);
+    } else if (kMinExp < n && n <= 0) {
+      buffer->append("0.");
+      buffer->append(-n, '0');
+      buffer->append(mantissa, k);
+    } else {
+      int power = n - 1;
+
+      buffer->push_back(mantissa[0]);
+
+      if (k > 1) {
+        buffer->push_back('.');
+        buffer->append(mantissa + 1, k - 1);
+      }
+
+      buffer->push_back('e');
+      buffer->push_back(power < 0 ? '-' : '+');
+
+      if (power < 0)
+        power = -power;
+
+      if (power < 10)
+        buffer->push_back('0');
+
+      buffer->append(std::to_string(power));
+    }
+  }
+};
+
+}  // namespace geometry
+
+#endif  // METHODS_JSON_WRITER_HPP_
@@ -0,0 +1,164 @@
+/**
+ * @file methods/kd_tree_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функции, которые строят k-d дерево и выполняют запросы
+ * поиска ближайших соседей. Функции принимают и возвращают данные
+ * в JSON формате.
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "coordinate_types.hpp"
+#include "kd_tree.hpp"
+#include "parallel.hpp"
+#include "dataset_registry.hpp"
+
+namespace geometry {
+
+template<typename T>
+static int KdTreeBuildMethodHelper(const nlohmann::json& input,
+                                   nlohmann::json* output,
+                                   std::string type);
+
+template<typename T>
+static int KdTreeQueryMethodHelper(const nlohmann::json& input,
+                                   nlohmann::json* output,
+                                   std::string type);
+
+int KdTreeBuildMethod(const nlohmann::json& input, nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return KdTreeBuildMethodHelper<T>(input, output, type);
+  });
+}
+
+int KdTreeQueryMethod(const nlohmann::json& input, nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return KdTreeQueryMethodHelper<T>(input, output, type);
+  });
+}
+
+int KdTreeDropMethod(const nlohmann::json& input, nlohmann::json* output) {
+  return DropDatasetMethod(input, output, [](auto coordinate,
+                                             const std::string& name) {
+    using T = typename decltype(coordinate)::Type;
+
+    return DatasetRegistry<KdTree<T>>::Instance().Erase(name);
+  });
+}
+
+/**
+ * @brief Построить k-d дерево и сохранить его в реестре.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename T>
+static int KdTreeBuildMethodHelper(const nlohmann::json& input,
+                                   nlohmann::json* output,
+                                   std::string type) {
+  std::string name = input.at("name");
+  size_t threads = input.value("threads", 0);
+  size_t size = input.at("size");
+  std::vector<Point<T>> data;
+
+  data.reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    data.push_back(Point<T>(input.at("data").at(0).at(i),
+                            input.at("data").at(1).at(i)));
+  }
+
+  auto tree = std::make_shared<const KdTree<T>>(data, threads);
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["name"] = name;
+  (*output)["size"] = tree->Size();
+
+  DatasetRegistry<KdTree<T>>::Instance().Insert(name, std::move(tree));
+
+  return 0;
+}
+
+/**
+ * @brief Выполнить набор запросов к k-d дереву.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно или дерево не найдено.
+ */
+template<typename T>
+static int KdTreeQueryMethodHelper(const nlohmann::json& input,
+                                   nlohmann::json* output,
+                                   std::string type) {
+  std::string name = input.at("name");
+  std::string mode = input.value("mode", "nearest");
+  size_t threads = input.value("threads", 0);
+  std::shared_ptr<const KdTree<T>> tree =
+      DatasetRegistry<KdTree<T>>::Instance().Find(name);
+
+  if (!tree || (mode != "nearest" && mode != "radius"))
+    return -1;
+
+  size_t k = std::min<size_t>(input.value("k", 1), tree->Size());
+  double epsilon = input.value("epsilon", 0.0);
+  T radius = mode == "radius" ? input.at("radius").get<T>() : T(0);
+
+  if (epsilon < 0 || radius < 0)
+    return -1;
+
+  size_t size = input.at("size");
+  std::vector<Point<T>> queries;
+
+  queries.reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    queries.push_back(Point<T>(input.at("queries").at(0).at(i),
+                               input.at("queries").at(1).at(i)));
+  }
+
+  std::vector<std::vector<size_t>> results(size);
+
+  ParallelFor(size, [&](size_t i) {
+    if (mode == "nearest")
+      results[i] = tree->Nearest(queries[i], k, epsilon);
+    else
+      tree->Radius(queries[i], radius, std::back_inserter(results[i]));
+  }, threads);
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["name"] = name;
+  (*output)["mode"] = mode;
+  (*output)["size"] = size;
+  (*output)["data"] = nlohmann::json::array();
+
+  for (const std::vector<size_t>& result : results)
+    (*output)["data"].push_back(result);
+
+  return 0;
+}
+
+}  // namespace geometry
@@ -6,89 +6,411 @@
  */
 
 #include <httplib.h>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
 #include <nlohmann/json.hpp>
+#include <job_queue.hpp>
+#include <request_metrics.hpp>
+#include <result_cache.hpp>
+#include "coordinate_types.hpp"
+#include "dataset_registry.hpp"
+#include "method_registry.hpp"
 #include "methods.hpp"
+#include "server_options.hpp"
 
-using geometry::GrahamScanMethod;
-using geometry::ContourRectanglesMethod;
+using geometry::BatchMethod;
+using geometry::ConfigureServer;
+using geometry::CoordinateTypes;
+using geometry::DatasetCapacity;
+using geometry::ParseServerOptions;
+using geometry::PrintServerOptions;
+using geometry::ResultCache;
+using geometry::JobQueue;
+using geometry::JobState;
+using geometry::JobStateName;
+using geometry::JobStatus;
+using geometry::MethodEntry;
+using geometry::MethodRegistry;
+using geometry::MetricsScope;
+using geometry::RequestMetrics;
+using geometry::RequestPhase;
+using geometry::ServerOptions;
+using geometry::ThreadPool;
 
-int main(int argc, char* argv[]) {
-  // Порт по-умолчанию.
-  int port = 8080;
-
-  if (argc >= 2) {
-    // Меняем порт по умолчанию, если предоставлен соответствующий
-    // аргумент командной строки.
-    if (std::sscanf(argv[1], "%d", &port) != 1)
-      return -1;
+/**
+ * @brief Проверить, передано ли тело запроса в двоичном формате.
+ *
+ * @param req Запрос.
+ * @return true, если MIME тип запроса application/octet-stream.
+ */
+static bool IsBinaryRequest(const httplib::Request& req) {
+  return req.get_header_value("Content-Type")
+      .rfind("application/octet-stream", 0) == 0;
+}
+
+/**
+ * @brief Выполнить метод, используя кэш результатов.
+ *
+ * Если ответ на такой же запрос уже есть в кэше, метод не вызывается
+ * и текст запроса не разбирается. Кэшируются только успешные ответы.
+ *
+ * @param cache Кэш результатов.
+ * @param method Название метода вместе с форматом запроса.
+ * @param req Запрос.
+ * @param res Ответ.
+ * @param type MIME тип ответа.
+ * @param function Метод, принимающий и возвращающий текст.
+ */
+static void RunCached(ResultCache* cache, const std::string& method,
+                      const httplib::Request& req, httplib::Response* res,
+                      const char* type,
+                      int (*function)(const std::string&, std::string*)) {
+  MetricsScope scope(method);
+  std::shared_ptr<const std::string> cached = cache->Find(method, req.body);
+
+  if (cached) {
+    res->set_content(*cached, type);
+    scope.Sizes(req.body.size(), res->body.size());
+    return;
+  }
+
+  std::string output;
+
+  int result = function(req.body, &output);
+
+  scope.Sizes(req.body.size(), output.size());
+
+  /* Если метод завершился с ошибкой, то выставляем статус 400. */
+  if (result < 0) {
+    res->status = 400;
+    scope.Fail();
+    res->set_content(std::move(output), type);
+    return;
   }
 
-  std::cerr << "Listening on port " << port << "..." << std::endl;
+  if (cache->Capacity() > 0)
+    res->set_content(*cache->Insert(method, req.body, std::move(output)),
+                     type);
+  else
+    res->set_content(std::move(output), type);
+}
+
+/**
+ * @brief Выполнить метод, принимающий и возвращающий JSON.
+ *
+ * Время разбора запроса, работы метода и записи ответа учитывается
+ * в счётчиках /metrics. Если метод сам не отмечает этапы, то построение
+ * дерева ответа входит в этап вычислений.
+ *
+ * @param method Название метода.
+ * @param req Запрос.
+ * @param res Ответ.
+ * @param function Метод.
+ */
+template<typename Function>
+static void RunJsonMethod(const std::string& method,
+                          const httplib::Request& req,
+                          httplib::Response* res, Function function) {
+  MetricsScope scope(method);
+  nlohmann::json input = nlohmann::json::parse(req.body);
+  nlohmann::json output;
+
+  // Неизвестный тип не создаёт новый ряд счётчиков.
+  if (input.is_object() && input.contains("type") &&
+      input.at("type").is_string()) {
+    const std::string& type = input.at("type").get_ref<const std::string&>();
+
+    if (CoordinateTypes::Find(type) >= 0)
+      MetricsScope::Type(type);
+  }
+
+  MetricsScope::Mark(RequestPhase::kParse);
+
+  /* Если метод завершился с ошибкой, то выставляем статус 400. */
+  if (function(input, &output) < 0) {
+    res->status = 400;
+    scope.Fail();
+  }
+
+  MetricsScope::Mark(RequestPhase::kCompute);
+
+  std::string body = output.dump();
+
+  MetricsScope::Mark(RequestPhase::kSerialize);
+  scope.Sizes(req.body.size(), body.size());
+  res->set_content(std::move(body), "application/json");
+}
+
+/**
+ * @brief Поставить вызов метода в очередь фоновых задач.
+ *
+ * Ответ содержит идентификатор задачи. Если очередь заполнена,
+ * выставляется статус 503.
+ *
+ * @param jobs Очередь фоновых задач.
+ * @param method Название метода вместе с форматом запроса.
+ * @param req Запрос (тот же, что и для синхронного вызова метода).
+ * @param res Ответ.
+ * @param type MIME тип результата.
+ * @param function Метод, принимающий и возвращающий текст.
+ */
+static void SubmitJob(JobQueue* jobs, const std::string& method,
+                      const httplib::Request& req, httplib::Response* res,
+                      const char* type,
+                      int (*function)(const std::string&, std::string*)) {
+  // Задача хранит копию запроса: объект req живёт только до ответа.
+  auto job = [body = req.body, function, method](std::string* output) {
+    MetricsScope scope("/Jobs" + method);
+    int result = function(body, output);
+
+    if (result < 0)
+      scope.Fail();
+
+    scope.Sizes(body.size(), output->size());
+    return result;
+  };
+  double work = static_cast<double>(req.body.size());
+  uint64_t id = jobs->Submit(method, type, work, std::move(job));
+  nlohmann::json output;
+
+  if (id == 0) {
+    res->status = 503;
+  } else {
+    output["job"] = id;
+    output["state"] = JobStateName(JobState::kQueued);
+  }
+
+  res->set_content(output.dump(), "application/json");
+}
+
+/**
+ * @brief Прочитать идентификатор задачи из запроса {"job": id}.
+ *
+ * @param req Запрос.
+ * @param id Идентификатор задачи.
+ * @return false, если идентификатор не задан.
+ */
+static bool ReadJobId(const httplib::Request& req, uint64_t* id) {
+  nlohmann::json input = nlohmann::json::parse(req.body, nullptr, false);
+
+  if (!input.is_object() || !input.contains("job") ||
+      !input.at("job").is_number_unsigned())
+    return false;
+
+  *id = input.at("job").get<uint64_t>();
+  return true;
+}
+
+/**
+ * @brief Записать состояние задачи в ответ.
+ *
+ * @param id Идентификатор задачи.
+ * @param status Состояние задачи.
+ * @param res Ответ.
+ */
+static void WriteJobStatus(uint64_t id, const JobStatus& status,
+                           httplib::Response* res) {
+  nlohmann::json output;
+
+  output["job"] = id;
+  output["state"] = JobStateName(status.state);
+  output["progress"] = status.progress;
+
+  res->set_content(output.dump(), "application/json");
+}
+
+int main(int argc, char* argv[]) {
+  // Порт и параметры пула потоков можно изменить аргументами командной
+  // строки (см. ParseServerOptions()).
+  ServerOptions options;
+
+  if (!ParseServerOptions(argc, argv, &options))
+    return -1;
+
+  std::cerr << "Listening on port " << options.port << "..." << std::endl;
+  PrintServerOptions(options, &std::cerr);
 
   httplib::Server svr;
 
+  // Пул рабочих потоков обрабатывает соединения и вызовы из /Batch.
+  std::shared_ptr<ThreadPool> pool = ConfigureServer(options, &svr);
+
+  // Кэш ответов на повторяющиеся запросы /GrahamScan и /ContourRectangles.
+  ResultCache cache(options.cacheSize << 20);
+
+  // Число хранимых наборов данных /RTreeBuild, /PointIndexBuild
+  // и /KdTreeBuild.
+  DatasetCapacity() = options.datasets;
+
+  // Очередь долгих вычислений, которые выполняются отдельно от потоков,
+  // обрабатывающих запросы.
+  JobQueue jobs(options.jobThreads, options.jobQueue);
+
   // Обработчик для GET запроса по адресу /stop. Этот обработчик
   // останавливает сервер.
   svr.Get("/stop", [&](const httplib::Request&, httplib::Response&) {
     svr.stop();
   });
 
-  /* Сюда нужно вставить обработчик post запроса для алгоритма. */
-
-/* /ContourRectangles это адрес для запросов на поиск контура
-  на сервере. */
-  svr.Post("/GrahamScan", [&](const httplib::Request& req,
-                                 httplib::Response& res) {
-    /*
-    Поле body структуры httplib::Request содержит текст запроса.
-    Функция nlohmann::json::parse() используется для того,
-    чтобы преобразовать текст в объект типа nlohmann::json.
-    */
-    nlohmann::json input = nlohmann::json::parse(req.body);
+  // Обработчик для GET запроса по адресу /CacheStats. Возвращает счётчики
+  // кэша результатов.
+  svr.Get("/CacheStats", [&](const httplib::Request&,
+                             httplib::Response& res) {
     nlohmann::json output;
 
-    /* Если метод завершился с ошибкой, то выставляем статус 400. */
-    if (GrahamScanMethod(input, &output) < 0)
-      res.status = 400;
+    output["capacity"] = cache.Capacity();
+    output["entries"] = cache.Entries();
+    output["bytes"] = cache.Bytes();
+    output["hits"] = cache.Hits();
+    output["misses"] = cache.Misses();
+    output["evictions"] = cache.Evictions();
 
-    /*
-    Метод nlohmann::json::dump() используется для сериализации
-    объекта типа nlohmann::json в строку. Метод set_content()
-    позволяет задать содержимое ответа на запрос. Если передаются
-    JSON данные, то MIME тип следует выставить application/json.
-    */
     res.set_content(output.dump(), "application/json");
   });
 
-  svr.Post("/ContourRectangles", [&](const httplib::Request& req,
-                                 httplib::Response& res) {
-    /*
-    Поле body структуры httplib::Request содержит текст запроса.
-    Функция nlohmann::json::parse() используется для того,
-    чтобы преобразовать текст в объект типа nlohmann::json.
-    */
-    nlohmann::json input = nlohmann::json::parse(req.body);
-    nlohmann::json output;
+  // Обработчик для GET запроса по адресу /metrics. Возвращает счётчики
+  // запросов в текстовом формате Prometheus.
+  svr.Get("/metrics", [&](const httplib::Request&, httplib::Response& res) {
+    std::ostringstream stream;
+
+    RequestMetrics::Instance().Write(&stream);
 
-    /* Если метод завершился с ошибкой, то выставляем статус 400. */
-    if (ContourRectanglesMethod(input, &output) < 0)
+    stream << "# HELP geometry_cache_hits_total Result cache hits.\n"
+           << "# TYPE geometry_cache_hits_total counter\n"
+           << "geometry_cache_hits_total " << cache.Hits() << "\n"
+           << "# HELP geometry_cache_misses_total Result cache misses.\n"
+           << "# TYPE geometry_cache_misses_total counter\n"
+           << "geometry_cache_misses_total " << cache.Misses() << "\n"
+           << "# HELP geometry_jobs_queued Background jobs in the queue.\n"
+           << "# TYPE geometry_jobs_queued gauge\n"
+           << "geometry_jobs_queued " << jobs.Queued() << "\n";
+
+    res.set_content(stream.str(), "text/plain; version=0.0.4");
+  });
+
+  /* Сюда нужно вставить обработчик post запроса для алгоритма. */
+
+  /*
+  Обработчики методов строятся по таблице MethodRegistry(), поэтому новый
+  метод достаточно добавить в таблицу. Поле body структуры
+  httplib::Request содержит текст запроса. Методы с текстовым вариантом
+  разбирают его и записывают ответ сами, не строя дерево nlohmann::json
+  для координат (см. JsonColumnParser и JsonWriter), принимают двоичный
+  формат (см. WireDecoder) и кэшируют ответы. Такие методы также доступны
+  как фоновые задачи: запрос /Jobs/<метод> принимает те же данные, что
+  и синхронный метод, и сразу возвращает идентификатор задачи.
+  */
+  for (const MethodEntry& entry : MethodRegistry()) {
+    // httplib::Server принимает шаблон адреса как const char*.
+    const std::string path = std::string("/") + entry.name;
+
+    if (!entry.text) {
+      svr.Post(path.c_str(), [&entry, path](const httplib::Request& req,
+                                            httplib::Response& res) {
+        RunJsonMethod(path, req, &res, entry.json);
+      });
+      continue;
+    }
+
+    // Ключи кэша и названия в счётчиках различают форматы запроса.
+    const std::string binary = path + ":binary";
+    const std::string job = "/Jobs" + path;
+
+    svr.Post(path.c_str(), [&cache, &entry, path, binary](
+        const httplib::Request& req, httplib::Response& res) {
+      if (entry.binary && IsBinaryRequest(req))
+        RunCached(&cache, binary, req, &res, "application/octet-stream",
+                  entry.binary);
+      else
+        RunCached(&cache, path, req, &res, "application/json", entry.text);
+    });
+
+    svr.Post(job.c_str(), [&jobs, &entry, path, binary](
+        const httplib::Request& req, httplib::Response& res) {
+      if (entry.binary && IsBinaryRequest(req))
+        SubmitJob(&jobs, binary, req, &res, "application/octet-stream",
+                  entry.binary);
+      else
+        SubmitJob(&jobs, path, req, &res, "application/json", entry.text);
+    });
+  }
+
+  svr.Post("/Batch", [&](const httplib::Request& req,
+                         httplib::Response& res) {
+    RunJsonMethod("/Batch", req, &res, [&](const nlohmann::json& input,
+                                           nlohmann::json* output) {
+      return BatchMethod(input, output, pool.get());
+    });
+  });
+
+  /*
+  Состояние, результат и отмена фоновых задач. Запросы получают
+  {"job": id}.
+  */
+  svr.Post("/Jobs/Status", [&](const httplib::Request& req,
+                               httplib::Response& res) {
+    uint64_t id = 0;
+    JobStatus status;
+
+    if (!ReadJobId(req, &id))
       res.status = 400;
+    else if (!jobs.Status(id, &status))
+      res.status = 404;
+    else
+      WriteJobStatus(id, status, &res);
+  });
 
-    /*
-    Метод nlohmann::json::dump() используется для сериализации
-    объекта типа nlohmann::json в строку. Метод set_content()
-    позволяет задать содержимое ответа на запрос. Если передаются
-    JSON данные, то MIME тип следует выставить application/json.
-    */
-    res.set_content(output.dump(), "application/json");
+  /*
+  Результат завершённой задачи возвращается так же, как ответ синхронного
+  метода (со статусом 400 при ошибке во входных данных). Для задачи,
+  которая ещё не завершилась, возвращается её состояние со статусом 202,
+  для отменённой --- со статусом 410.
+  */
+  svr.Post("/Jobs/Result", [&](const httplib::Request& req,
+                               httplib::Response& res) {
+    uint64_t id = 0;
+    JobStatus status;
+    std::shared_ptr<const std::string> output;
+    std::string type;
+
+    if (!ReadJobId(req, &id)) {
+      res.status = 400;
+    } else if (!jobs.Result(id, &status, &output, &type)) {
+      res.status = 404;
+    } else if (status.state == JobState::kDone ||
+               status.state == JobState::kFailed) {
+      if (status.state == JobState::kFailed)
+        res.status = 400;
+
+      res.set_content(*output, type.c_str());
+    } else {
+      res.status = status.state == JobState::kCancelled ? 410 : 202;
+      WriteJobStatus(id, status, &res);
+    }
+  });
+
+  svr.Post("/Jobs/Cancel", [&](const httplib::Request& req,
+                               httplib::Response& res) {
+    uint64_t id = 0;
+    JobStatus status;
+
+    if (!ReadJobId(req, &id))
+      res.status = 400;
+    else if (!jobs.Cancel(id, &status))
+      res.status = 404;
+    else
+      WriteJobStatus(id, status, &res);
   });
 
   /* Конец вставки. */
 
   // Эта функция запускает сервер на указанном порту. Программа не завершится
   // до тех пор, пока сервер не будет остановлен.
-  svr.listen("0.0.0.0", port);
+  svr.listen("0.0.0.0", options.port);
 
   return 0;
 }
@@ -0,0 +1,115 @@
+/**
+ * @file methods/method_registry.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Таблица методов сервера, по которой строятся обработчики запросов
+ * и список методов, доступных в /Batch.
+ */
+
+#ifndef METHODS_METHOD_REGISTRY_HPP_
+#define METHODS_METHOD_REGISTRY_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "methods.hpp"
+
+namespace geometry {
+
+//! Метод, принимающий и возвращающий данные в формате JSON.
+using JsonMethod = int (*)(const nlohmann::json&, nlohmann::json*);
+
+//! Метод, принимающий и возвращающий тело запроса и ответа.
+using BodyMethod = int (*)(const std::string&, std::string*);
+
+/**
+ * @brief Запись о методе сервера.
+ *
+ * Метод обрабатывает POST запросы по адресу "/" + name. Если у метода
+ * есть вариант, работающий с текстом запроса, то ответы кэшируются,
+ * метод принимает запросы в двоичном формате и доступен как фоновая
+ * задача "/Jobs/" + name.
+ */
+struct MethodEntry {
+  //! Название метода.
+  const char* name;
+  //! Метод, работающий с деревом JSON.
+  JsonMethod json;
+  //! Метод, работающий с текстом запроса (nullptr, если его нет).
+  BodyMethod text;
+  //! Метод, работающий с двоичным форматом (nullptr, если его нет).
+  BodyMethod binary;
+  //! Метод можно вызывать в пакетном запросе /Batch.
+  bool batch;
+};
+
+/**
+ * @brief Таблица методов сервера.
+ *
+ * Чтобы добавить метод, достаточно объявить его в methods.hpp и добавить
+ * запись в эту таблицу.
+ */
+inline const std::vector<MethodEntry>& MethodRegistry() {
+  static const std::vector<MethodEntry> methods = {
+    { "AllNearestNeighbours", AllNearestNeighboursMethod, nullptr, nullptr,
+      false },
+    { "ClipPolygons", ClipPolygonsMethod, nullptr, nullptr, false },
+    { "ClosestPair", ClosestPairMethod, nullptr, nullptr, false },
+    { "ContourRectangles", ContourRectanglesMethod,
+      ContourRectanglesTextMethod, ContourRectanglesBinaryMethod, true },
+    { "ConvexIntersection", ConvexIntersectionMethod, nullptr, nullptr,
+      false },
+    { "ConvexLocate", ConvexLocateMethod, nullptr, nullptr, false },
+    { "CoverageDepth", CoverageDepthMethod, nullptr, nullptr, false },
+    { "Delaunay", DelaunayMethod, nullptr, nullptr, false },
+    { "GrahamScan", GrahamScanMethod, GrahamScanTextMethod,
+      GrahamScanBinaryMethod, true },
+    { "KdTreeBuild", KdTreeBuildMethod, nullptr, nullptr, false },
+    { "KdTreeDrop", KdTreeDropMethod, nullptr, nullptr, false },
+    { "KdTreeQuery", KdTreeQueryMethod, nullptr, nullptr, false },
+    { "MinkowskiSum", MinkowskiSumMethod, nullptr, nullptr, false },
+    { "PointIndexBuild", PointIndexBuildMethod, nullptr, nullptr, false },
+    { "PointIndexDrop", PointIndexDropMethod, nullptr, nullptr, false },
+    { "PointIndexQuery", PointIndexQueryMethod, nullptr, nullptr, false },
+    { "RTreeBuild", RTreeBuildMethod, nullptr, nullptr, false },
+    { "RTreeDrop", RTreeDropMethod, nullptr, nullptr, false },
+    { "RTreeQuery", RTreeQueryMethod, nullptr, nullptr, false },
+    { "RectangleComponents", RectangleComponentsMethod, nullptr, nullptr,
+      false },
+    { "RectangleIntersections", RectangleIntersectionsMethod, nullptr,
+      nullptr, false },
+    { "SimplifyPolyline", SimplifyPolylineMethod, nullptr, nullptr, false },
+    { "TriangulatePolygon", TriangulatePolygonMethod, nullptr, nullptr,
+      false }
+  };
+
+  return methods;
+}
+
+/**
+ * @brief Найти метод, доступный в пакетном запросе.
+ *
+ * @param name Название метода.
+ * @return Запись о методе или nullptr, если метода нет или его нельзя
+ * вызывать в /Batch.
+ */
+inline const MethodEntry* FindBatchMethod(const std::string& name) {
+  static const std::map<std::string, const MethodEntry*> methods = [] {
+    std::map<std::string, const MethodEntry*> batch;
+
+    for (const MethodEntry& entry : MethodRegistry()) {
+      if (entry.batch)
+        batch[entry.name] = &entry;
+    }
+
+    return batch;
+  }();
+  auto it = methods.find(name);
+
+  return it == methods.end() ? nullptr : it->second;
+}
+
+}  // namespace geometry
+
+#endif  // METHODS_METHOD_REGISTRY_HPP_
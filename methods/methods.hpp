@@ -12,6 +12,8 @@
 
 namespace geometry {
 
+class ThreadPool;
+
 /* Сюда нужно вставить объявление серверной части алгоритма. */
 
 /**
@@ -22,14 +24,429 @@ namespace geometry {
  * @return Функция возвращает 0 в случае успеха и отрицательное число
  * если входные данные заданы некорректно.
  *
- * Функция запускает алгоритм сортировки вставками, используя входные данные
+ * Функция запускает алгоритм построения контура, используя входные данные
  * в JSON формате. Результат также выдаётся в JSON формате.
+ *
+ * Если во входных данных задано поле "scale", то координаты переводятся
+ * на целочисленную сетку с этим масштабом, контур строится точными
+ * целочисленными предикатами и переводится обратно в исходные единицы.
+ *
+ * Если поле "components" равно true, за тот же проход вычисляются
+ * компоненты связности объединения в формате /RectangleComponents.
  */
 int ContourRectanglesMethod(const nlohmann::json& input,
                             nlohmann::json* output);
+
+/**
+ * @brief Метод построения контура объединения прямоугольников по тексту
+ * запроса.
+ *
+ * @param input Текст запроса в формате JSON.
+ * @param output Текст ответа в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * В отличие от ContourRectanglesMethod(), координаты читаются потоковым
+ * парсером прямо в столбцы (см. JsonColumnParser) без построения дерева
+ * JSON, что уменьшает время разбора и расход памяти на больших запросах.
+ * Ответ также записывается прямо в строку (см. JsonWriter). Необязательное
+ * поле "precision" задаёт число знаков после запятой у вещественных
+ * координат ответа, по умолчанию они записываются кратчайшим точным
+ * образом.
+ */
+int ContourRectanglesTextMethod(const std::string& input,
+                                std::string* output);
+
+/**
+ * @brief Метод построения контура объединения прямоугольников
+ * в двоичном формате.
+ *
+ * @param input Тело запроса в двоичном формате (см. WireDecoder):
+ * четыре столбца с координатами углов sw и ne.
+ * @param output Тело ответа в двоичном формате: четыре столбца
+ * с координатами начала и конца рёбер контура.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+int ContourRectanglesBinaryMethod(const std::string& input,
+                                  std::string* output);
+
+/**
+ * @brief Метод построения выпуклой оболочки обходом Грэхема.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Если во входных данных задано поле "scale", то оболочка строится
+ * в режиме фиксированной точки (см. ContourRectanglesMethod()).
+ */
 int GrahamScanMethod(const nlohmann::json& input,
                             nlohmann::json* output);
 
+/**
+ * @brief Метод построения выпуклой оболочки по тексту запроса.
+ *
+ * @param input Текст запроса в формате JSON.
+ * @param output Текст ответа в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Запрос разбирается, а ответ записывается без построения дерева JSON
+ * (см. ContourRectanglesTextMethod()).
+ */
+int GrahamScanTextMethod(const std::string& input,
+                         std::string* output);
+
+/**
+ * @brief Метод построения выпуклой оболочки в двоичном формате.
+ *
+ * @param input Тело запроса в двоичном формате (см. WireDecoder):
+ * столбцы координат x и y.
+ * @param output Тело ответа в двоичном формате: столбцы координат
+ * вершин оболочки.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+int GrahamScanBinaryMethod(const std::string& input, std::string* output);
+
+/**
+ * @brief Метод отсечения многоугольников окном.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Поле "window" задаёт окно отсечения, поле "data" --- набор
+ * отсекаемых многоугольников. В режиме "convex" (по умолчанию) окно
+ * должно быть выпуклым, и используется потоковый алгоритм
+ * Сазерленда-Ходжмана. В режиме "general" окно может быть невыпуклым,
+ * и используется алгоритм Вейлера-Азертона. Для каждого многоугольника
+ * возвращается список многоугольников, из которых состоит пересечение.
+ * Если поле "kind" равно "polyline", элементы "data" считаются ломаными,
+ * и для каждой возвращается список ломаных внутри окна.
+ */
+int ClipPolygonsMethod(const nlohmann::json& input, nlohmann::json* output);
+
+/**
+ * @brief Метод построения R-дерева над набором прямоугольников.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Дерево сохраняется на сервере под именем "name" и используется
+ * последующими запросами RTreeQueryMethod(). Повторное построение
+ * с тем же именем заменяет дерево. Число деревьев на сервере ограничено,
+ * при превышении удаляются дольше всего не использованные.
+ */
+int RTreeBuildMethod(const nlohmann::json& input, nlohmann::json* output);
+
+/**
+ * @brief Метод выполнения запросов к R-дереву.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно или дерево не построено.
+ *
+ * Поле "queries" содержит запросы вида "window" (прямоугольники,
+ * пересекающие окно), "stab" (прямоугольники, содержащие точку)
+ * и "nearest" (k ближайших к точке прямоугольников). Для каждого
+ * запроса возвращаются номера прямоугольников в наборе, по которому
+ * построено дерево.
+ */
+int RTreeQueryMethod(const nlohmann::json& input, nlohmann::json* output);
+
+/**
+ * @brief Метод удаления R-дерева с сервера.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Поле "dropped" ответа равно false, если дерева с таким именем нет.
+ */
+int RTreeDropMethod(const nlohmann::json& input, nlohmann::json* output);
+
+/**
+ * @brief Метод построения индекса точек.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Поле "kind" выбирает PR-дерево квадрантов ("quadtree", по умолчанию)
+ * или равномерную сетку ("grid"), поле "bucket" задаёт желаемое число
+ * точек в корзине. Индекс сохраняется на сервере под именем "name".
+ */
+int PointIndexBuildMethod(const nlohmann::json& input,
+                          nlohmann::json* output);
+
+/**
+ * @brief Метод выполнения ортогональных запросов к индексу точек.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно или индекс не построен.
+ *
+ * В режиме "report" (по умолчанию) для каждого прямоугольника
+ * возвращаются номера попавших в него точек, в режиме "count" ---
+ * их число. Запросы выполняются параллельно в "threads" потоках
+ * (по умолчанию и не больше, чем число аппаратных потоков).
+ */
+int PointIndexQueryMethod(const nlohmann::json& input,
+                          nlohmann::json* output);
+
+/**
+ * @brief Метод удаления индекса точек с сервера.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Поле "dropped" ответа равно false, если индекса с таким именем нет.
+ */
+int PointIndexDropMethod(const nlohmann::json& input,
+                         nlohmann::json* output);
+
+/**
+ * @brief Метод построения k-d дерева.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Дерево сохраняется на сервере под именем "name". Поле "threads"
+ * задаёт число потоков для построения (не больше числа аппаратных
+ * потоков).
+ */
+int KdTreeBuildMethod(const nlohmann::json& input, nlohmann::json* output);
+
+/**
+ * @brief Метод поиска ближайших соседей в k-d дереве.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно или дерево не построено.
+ *
+ * В режиме "nearest" (по умолчанию) для каждой точки запроса
+ * возвращаются "k" ближайших соседей; при "epsilon" > 0 поиск
+ * приближённый с погрешностью (1 + epsilon). В режиме "radius"
+ * возвращаются все точки на расстоянии не больше "radius". Запросы
+ * выполняются параллельно в "threads" потоках.
+ */
+int KdTreeQueryMethod(const nlohmann::json& input, nlohmann::json* output);
+
+/**
+ * @brief Метод удаления k-d дерева с сервера.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Поле "dropped" ответа равно false, если дерева с таким именем нет.
+ */
+int KdTreeDropMethod(const nlohmann::json& input, nlohmann::json* output);
+
+/**
+ * @brief Метод построения триангуляции Делоне.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Треугольники возвращаются тройками номеров точек против часовой
+ * стрелки. Если "voronoi" равно true, дополнительно возвращается
+ * двойственная диаграмма Вороного: вершины, рёбра и лучи.
+ */
+int DelaunayMethod(const nlohmann::json& input, nlohmann::json* output);
+
+/**
+ * @brief Метод триангуляции простого многоугольника.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Треугольники возвращаются тройками номеров вершин многоугольника
+ * и обходятся в том же направлении, что и многоугольник.
+ */
+int TriangulatePolygonMethod(const nlohmann::json& input,
+                             nlohmann::json* output);
+
+/**
+ * @brief Метод поиска ближайшей пары точек.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Возвращаются номера двух точек пары (меньший первым). Половины
+ * верхних уровней обрабатываются параллельно в "threads" потоках.
+ */
+int ClosestPairMethod(const nlohmann::json& input, nlohmann::json* output);
+
+/**
+ * @brief Метод поиска ближайшего соседа каждой точки.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Для каждой точки возвращается номер ближайшей к ней другой точки.
+ * Вычисления выполняются параллельно в "threads" потоках.
+ */
+int AllNearestNeighboursMethod(const nlohmann::json& input,
+                               nlohmann::json* output);
+
+/**
+ * @brief Метод вычисления сумм Минковского выпуклых многоугольников.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Многоугольник "polygon" складывается с каждым многоугольником набора
+ * "data". Все многоугольники должны быть выпуклыми. Суммы вычисляются
+ * параллельно в "threads" потоках и ориентированы так же, как "polygon".
+ */
+int MinkowskiSumMethod(const nlohmann::json& input, nlohmann::json* output);
+
+/**
+ * @brief Метод пересечения пар выпуклых многоугольников.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * В режиме "polygon" (по умолчанию) для каждой пары возвращается
+ * многоугольник пересечения, в режиме "test" --- только признак того,
+ * пересекаются ли многоугольники. Пары обрабатываются параллельно
+ * в "threads" потоках.
+ */
+int ConvexIntersectionMethod(const nlohmann::json& input,
+                             nlohmann::json* output);
+
+/**
+ * @brief Метод определения положения точек относительно выпуклой оболочки.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * По точкам "points" строится выпуклая оболочка (возвращается в "hull"),
+ * после чего для каждой из "size" точек "queries" возвращается 1, если
+ * точка лежит строго внутри оболочки, 0, если на границе, и -1, если
+ * снаружи. Каждый запрос выполняется за логарифмическое время, запросы
+ * обрабатываются в "threads" потоках.
+ */
+int ConvexLocateMethod(const nlohmann::json& input, nlohmann::json* output);
+
+/**
+ * @brief Метод упрощения ломаной.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Поле "method" выбирает алгоритм: "douglas-peucker" (по умолчанию,
+ * "tolerance" --- допустимое расстояние) или "visvalingam" ("tolerance"
+ * --- минимальная площадь треугольника). Если задано "window", ломаная
+ * обрабатывается потоково окнами из "window" вершин. Если "closed"
+ * равно true, ломаная считается замкнутой.
+ */
+int SimplifyPolylineMethod(const nlohmann::json& input,
+                           nlohmann::json* output);
+
+/**
+ * @brief Метод поиска пар пересекающихся прямоугольников.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Прямоугольники задаются так же, как для /ContourRectangles, и
+ * нумеруются с нуля. В режиме "pairs" (по умолчанию) возвращаются все
+ * пары номеров пересекающихся прямоугольников, в режиме "count" ---
+ * только их число в поле "size". Касание считается пересечением.
+ */
+int RectangleIntersectionsMethod(const nlohmann::json& input,
+                                 nlohmann::json* output);
+
+/**
+ * @brief Метод поиска максимальной глубины покрытия прямоугольниками.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Прямоугольники задаются так же, как для /ContourRectangles. В поле
+ * "depth" возвращается наибольшее число прямоугольников, содержащих
+ * одну точку, в поле "witness" --- такая точка. Если "histogram" равно
+ * true, в поле "histogram" возвращается площадь частей ограничивающего
+ * прямоугольника, покрытых ровно 0, 1, ..., "depth" прямоугольниками.
+ */
+int CoverageDepthMethod(const nlohmann::json& input, nlohmann::json* output);
+
+/**
+ * @brief Метод поиска компонент связности объединения прямоугольников.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Прямоугольники задаются так же, как для /ContourRectangles, и
+ * нумеруются с нуля; касающиеся прямоугольники связаны. В поле
+ * "components" для каждого прямоугольника возвращается наименьший номер
+ * прямоугольника в его компоненте, в поле "holes" --- пары из номера
+ * компоненты и числа дыр в ней, в поле "size" --- число компонент.
+ */
+int RectangleComponentsMethod(const nlohmann::json& input,
+                              nlohmann::json* output);
+
+/**
+ * @brief Метод выполнения нескольких вызовов в одном запросе.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param pool Пул потоков, на котором выполняются вызовы (nullptr для
+ * последовательного выполнения).
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * В поле "data" передаётся массив вызовов вида {"method": "GrahamScan",
+ * "input": {...}}, где "input" --- входные данные метода /GrahamScan или
+ * /ContourRectangles. Вызовы выполняются параллельно, в поле "data"
+ * ответа в том же порядке возвращаются объекты с полями "method",
+ * "status" (200 или 400) и "output" --- ответом метода. Ошибка в одном
+ * вызове не влияет на остальные, а неизвестный метод делает некорректным
+ * весь запрос.
+ */
+int BatchMethod(const nlohmann::json& input, nlohmann::json* output,
+                ThreadPool* pool);
+
 
 /* Конец вставки. */
 
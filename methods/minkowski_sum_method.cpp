@@ -0,0 +1,82 @@
+/**
+ * @file methods/minkowski_sum_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функцию, которая складывает выпуклый многоугольник
+ * с набором выпуклых многоугольников по Минковскому. Функция принимает
+ * и возвращает данные в JSON формате.
+ */
+
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "coordinate_types.hpp"
+#include "minkowski_sum.hpp"
+#include "polygon_json.hpp"
+
+namespace geometry {
+
+template<typename T>
+static int MinkowskiSumMethodHelper(const nlohmann::json& input,
+                                    nlohmann::json* output,
+                                    std::string type);
+
+int MinkowskiSumMethod(const nlohmann::json& input, nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return MinkowskiSumMethodHelper<T>(input, output, type);
+  });
+}
+
+/**
+ * @brief Сложить многоугольник с набором многоугольников.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename T>
+static int MinkowskiSumMethodHelper(const nlohmann::json& input,
+                                    nlohmann::json* output,
+                                    std::string type) {
+  size_t threads = input.value("threads", 0);
+  Polygon<T> polygon = ReadPolygon<T>(input.at("polygon"));
+
+  if (!IsConvex(polygon, T(0)))
+    return -1;
+
+  size_t size = input.at("size");
+  std::vector<Polygon<T>> others;
+
+  others.reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    others.push_back(ReadPolygon<T>(input.at("data").at(i)));
+
+    if (!IsConvex(others.back(), T(0)))
+      return -1;
+  }
+
+  std::vector<Polygon<T>> sums = MinkowskiSum(polygon, others, threads);
+
+  (*output)["id"] = input.at("id");
+  (*output)["size"] = size;
+  (*output)["type"] = type;
+  (*output)["data"] = nlohmann::json::array();
+
+  for (const Polygon<T>& sum : sums) {
+    (*output)["data"].push_back(nlohmann::json());
+    WritePolygon<T>(sum.Vertices(), &(*output)["data"].back());
+  }
+
+  return 0;
+}
+
+}  // namespace geometry
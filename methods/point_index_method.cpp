@@ -0,0 +1,183 @@
+/**
+ * @file methods/point_index_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функции, которые строят индекс точек и выполняют
+ * ортогональные запросы к нему. Функции принимают и возвращают данные
+ * в JSON формате.
+ */
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "coordinate_types.hpp"
+#include "point_index.hpp"
+#include "parallel.hpp"
+#include "dataset_registry.hpp"
+
+namespace geometry {
+
+template<typename T>
+static int PointIndexBuildMethodHelper(const nlohmann::json& input,
+                                       nlohmann::json* output,
+                                       std::string type);
+
+template<typename T>
+static int PointIndexQueryMethodHelper(const nlohmann::json& input,
+                                       nlohmann::json* output,
+                                       std::string type);
+
+int PointIndexBuildMethod(const nlohmann::json& input,
+                          nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return PointIndexBuildMethodHelper<T>(input, output, type);
+  });
+}
+
+int PointIndexQueryMethod(const nlohmann::json& input,
+                          nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return PointIndexQueryMethodHelper<T>(input, output, type);
+  });
+}
+
+int PointIndexDropMethod(const nlohmann::json& input,
+                         nlohmann::json* output) {
+  return DropDatasetMethod(input, output, [](auto coordinate,
+                                             const std::string& name) {
+    using T = typename decltype(coordinate)::Type;
+
+    return DatasetRegistry<PointIndex<T>>::Instance().Erase(name);
+  });
+}
+
+/**
+ * @brief Построить индекс точек и сохранить его в реестре.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename T>
+static int PointIndexBuildMethodHelper(const nlohmann::json& input,
+                                       nlohmann::json* output,
+                                       std::string type) {
+  std::string name = input.at("name");
+  std::string kind = input.value("kind", "quadtree");
+  size_t bucket = input.value("bucket", 32);
+  size_t size = input.at("size");
+
+  if (kind != "quadtree" && kind != "grid")
+    return -1;
+
+  std::vector<Point<T>> data;
+
+  data.reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    data.push_back(Point<T>(input.at("data").at(0).at(i),
+                            input.at("data").at(1).at(i)));
+  }
+
+  auto index = std::make_shared<const PointIndex<T>>(
+      data,
+      kind == "grid" ? PointIndexKind::Grid : PointIndexKind::QuadTree,
+      bucket);
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["name"] = name;
+  (*output)["kind"] = kind;
+  (*output)["size"] = index->Size();
+
+  DatasetRegistry<PointIndex<T>>::Instance().Insert(name, std::move(index));
+
+  return 0;
+}
+
+/**
+ * @brief Выполнить набор ортогональных запросов к индексу точек.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно или индекс не найден.
+ *
+ * Запросы распределяются между потоками, результат каждого запроса
+ * записывается в свою ячейку, поэтому порядок ответов совпадает
+ * с порядком запросов.
+ */
+template<typename T>
+static int PointIndexQueryMethodHelper(const nlohmann::json& input,
+                                       nlohmann::json* output,
+                                       std::string type) {
+  std::string name = input.at("name");
+  std::string mode = input.value("mode", "report");
+  size_t threads = input.value("threads", 0);
+  std::shared_ptr<const PointIndex<T>> index =
+      DatasetRegistry<PointIndex<T>>::Instance().Find(name);
+
+  if (!index || (mode != "report" && mode != "count"))
+    return -1;
+
+  size_t size = input.at("size");
+  std::vector<Rectangle<T>> queries;
+
+  queries.reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    const nlohmann::json& range = input.at("queries").at(i);
+
+    queries.push_back(Rectangle<T>(Point<T>(range.at(0).at(0),
+                                            range.at(0).at(1)),
+                                   Point<T>(range.at(1).at(0),
+                                            range.at(1).at(1))));
+  }
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["name"] = name;
+  (*output)["mode"] = mode;
+  (*output)["size"] = size;
+  (*output)["data"] = nlohmann::json::array();
+
+  if (mode == "count") {
+    std::vector<size_t> counts(size);
+
+    ParallelFor(size, [&](size_t i) {
+      counts[i] = index->Count(queries[i]);
+    }, threads);
+
+    (*output)["data"] = counts;
+  } else {
+    std::vector<std::vector<size_t>> reports(size);
+
+    ParallelFor(size, [&](size_t i) {
+      index->Report(queries[i], std::back_inserter(reports[i]));
+    }, threads);
+
+    for (const std::vector<size_t>& report : reports)
+      (*output)["data"].push_back(report);
+  }
+
+  return 0;
+}
+
+}  // namespace geometry
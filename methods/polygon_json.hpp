@@ -0,0 +1,64 @@
+/**
+ * @file methods/polygon_json.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Чтение и запись многоугольников в формате JSON, общие для методов,
+ * работающих с многоугольниками.
+ */
+
+#ifndef METHODS_POLYGON_JSON_HPP_
+#define METHODS_POLYGON_JSON_HPP_
+
+#include <cstddef>
+#include <list>
+#include <nlohmann/json.hpp>
+#include <point.hpp>
+#include <polygon.hpp>
+
+namespace geometry {
+
+/**
+ * @brief Считать многоугольник из JSON.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param data Координаты вершин в формате [[x1, x2, ...], [y1, y2, ...]].
+ * @return Многоугольник.
+ */
+template<typename T>
+Polygon<T> ReadPolygon(const nlohmann::json& data) {
+  std::list<Point<T>> vertices;
+  size_t count = data.at(0).size();
+
+  for (size_t i = 0; i < count; i++)
+    vertices.push_back(Point<T>(data.at(0).at(i), data.at(1).at(i)));
+
+  return Polygon<T>(vertices);
+}
+
+/**
+ * @brief Записать вершины многоугольника в JSON.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Container Тип контейнера вершин.
+ *
+ * @param vertices Вершины многоугольника.
+ * @param output Координаты вершин в формате [[x1, x2, ...], [y1, y2, ...]].
+ */
+template<typename T, typename Container>
+void WritePolygon(const Container& vertices, nlohmann::json* output) {
+  size_t i = 0;
+
+  (*output)[0] = nlohmann::json::array();
+  (*output)[1] = nlohmann::json::array();
+
+  for (const Point<T>& point : vertices) {
+    (*output)[0][i] = point.X();
+    (*output)[1][i] = point.Y();
+    i++;
+  }
+}
+
+}  // namespace geometry
+
+#endif  // METHODS_POLYGON_JSON_HPP_
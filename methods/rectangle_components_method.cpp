@@ -0,0 +1,80 @@
+/**
+ * @file methods/rectangle_components_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функцию, которая находит компоненты связности
+ * объединения прямоугольников и число дыр в них. Функция принимает
+ * и возвращает данные в JSON формате.
+ */
+
+#include <map>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "coordinate_types.hpp"
+#include "rectangle_components.hpp"
+
+namespace geometry {
+
+template<typename T>
+static int RectangleComponentsMethodHelper(const nlohmann::json& input,
+                                           nlohmann::json* output,
+                                           std::string type);
+
+int RectangleComponentsMethod(const nlohmann::json& input,
+                              nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return RectangleComponentsMethodHelper<T>(input, output, type);
+  });
+}
+
+/**
+ * @brief Найти компоненты связности объединения прямоугольников.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename T>
+static int RectangleComponentsMethodHelper(const nlohmann::json& input,
+                                           nlohmann::json* output,
+                                           std::string type) {
+  size_t size = input.at("size");
+
+  std::vector<Rectangle<T>> data(size);
+
+  for (size_t i = 0; i < size; i++) {
+    data[i] = Rectangle<T>(Point<T>(input.at("data").at(i).at(0).at(0),
+                                    input.at("data").at(i).at(0).at(1)),
+                           Point<T>(input.at("data").at(i).at(1).at(0),
+                                    input.at("data").at(i).at(1).at(1)),
+                           static_cast<int>(i));
+
+    if (data[i].ne.X() < data[i].sw.X() || data[i].ne.Y() < data[i].sw.Y())
+      return -1;
+  }
+
+  RectangleComponents<T> components = ConnectedRectangles(data.data(), size);
+  std::map<int, size_t> holes = components.Holes();
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["size"] = holes.size();
+  (*output)["components"] = components.Components();
+  (*output)["holes"] = nlohmann::json::array();
+
+  for (const std::pair<const int, size_t>& component : holes)
+    (*output)["holes"].push_back({ component.first, component.second });
+
+  return 0;
+}
+
+}  // namespace geometry
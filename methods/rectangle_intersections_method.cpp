@@ -0,0 +1,91 @@
+/**
+ * @file methods/rectangle_intersections_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функцию, которая находит все пары пересекающихся
+ * прямоугольников или их число. Функция принимает и возвращает данные
+ * в JSON формате.
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "coordinate_types.hpp"
+#include "rectangle_intersections.hpp"
+
+namespace geometry {
+
+template<typename T>
+static int RectangleIntersectionsMethodHelper(const nlohmann::json& input,
+                                              nlohmann::json* output,
+                                              std::string type);
+
+int RectangleIntersectionsMethod(const nlohmann::json& input,
+                                 nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return RectangleIntersectionsMethodHelper<T>(input, output, type);
+  });
+}
+
+/**
+ * @brief Найти пары пересекающихся прямоугольников.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename T>
+static int RectangleIntersectionsMethodHelper(const nlohmann::json& input,
+                                              nlohmann::json* output,
+                                              std::string type) {
+  std::string mode = input.value("mode", "pairs");
+  size_t size = input.at("size");
+
+  if (mode != "pairs" && mode != "count")
+    return -1;
+
+  std::vector<Rectangle<T>> data(size);
+
+  for (size_t i = 0; i < size; i++) {
+    data[i] = Rectangle<T>(Point<T>(input.at("data").at(i).at(0).at(0),
+                                    input.at("data").at(i).at(0).at(1)),
+                           Point<T>(input.at("data").at(i).at(1).at(0),
+                                    input.at("data").at(i).at(1).at(1)),
+                           static_cast<int>(i));
+
+    if (data[i].ne.X() < data[i].sw.X() || data[i].ne.Y() < data[i].sw.Y())
+      return -1;
+  }
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["mode"] = mode;
+
+  if (mode == "count") {
+    (*output)["size"] = CountRectangleIntersections(data.data(), size);
+
+    return 0;
+  }
+
+  std::vector<std::pair<int, int>> pairs =
+      RectangleIntersections(data.data(), size);
+
+  (*output)["size"] = pairs.size();
+  (*output)["data"] = nlohmann::json::array();
+
+  for (const std::pair<int, int>& pair : pairs)
+    (*output)["data"].push_back({ pair.first, pair.second });
+
+  return 0;
+}
+
+}  // namespace geometry
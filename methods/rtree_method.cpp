@@ -0,0 +1,167 @@
+/**
+ * @file methods/rtree_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функции, которые строят R-дерево над набором
+ * прямоугольников и выполняют запросы к нему. Функции принимают
+ * и возвращают данные в JSON формате.
+ */
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "coordinate_types.hpp"
+#include "rtree.hpp"
+#include "dataset_registry.hpp"
+
+namespace geometry {
+
+template<typename T>
+static int RTreeBuildMethodHelper(const nlohmann::json& input,
+                                  nlohmann::json* output,
+                                  std::string type);
+
+template<typename T>
+static int RTreeQueryMethodHelper(const nlohmann::json& input,
+                                  nlohmann::json* output,
+                                  std::string type);
+
+int RTreeBuildMethod(const nlohmann::json& input, nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return RTreeBuildMethodHelper<T>(input, output, type);
+  });
+}
+
+int RTreeQueryMethod(const nlohmann::json& input, nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return RTreeQueryMethodHelper<T>(input, output, type);
+  });
+}
+
+int RTreeDropMethod(const nlohmann::json& input, nlohmann::json* output) {
+  return DropDatasetMethod(input, output, [](auto coordinate,
+                                             const std::string& name) {
+    using T = typename decltype(coordinate)::Type;
+
+    return DatasetRegistry<RTree<T>>::Instance().Erase(name);
+  });
+}
+
+/**
+ * @brief Построить R-дерево и сохранить его в реестре.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename T>
+static int RTreeBuildMethodHelper(const nlohmann::json& input,
+                                  nlohmann::json* output,
+                                  std::string type) {
+  std::string name = input.at("name");
+  size_t size = input.at("size");
+  std::vector<Rectangle<T>> data;
+
+  data.reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    const nlohmann::json& rectangle = input.at("data").at(i);
+
+    data.push_back(Rectangle<T>(Point<T>(rectangle.at(0).at(0),
+                                         rectangle.at(0).at(1)),
+                                Point<T>(rectangle.at(1).at(0),
+                                         rectangle.at(1).at(1)),
+                                static_cast<int>(i)));
+  }
+
+  auto tree = std::make_shared<const RTree<T>>(data);
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["name"] = name;
+  (*output)["size"] = tree->Size();
+  (*output)["height"] = tree->Height();
+
+  DatasetRegistry<RTree<T>>::Instance().Insert(name, std::move(tree));
+
+  return 0;
+}
+
+/**
+ * @brief Выполнить набор запросов к построенному R-дереву.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно или дерево не найдено.
+ */
+template<typename T>
+static int RTreeQueryMethodHelper(const nlohmann::json& input,
+                                  nlohmann::json* output,
+                                  std::string type) {
+  std::string name = input.at("name");
+  std::shared_ptr<const RTree<T>> tree =
+      DatasetRegistry<RTree<T>>::Instance().Find(name);
+
+  if (!tree)
+    return -1;
+
+  size_t size = input.at("size");
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["name"] = name;
+  (*output)["size"] = size;
+  (*output)["data"] = nlohmann::json::array();
+
+  std::vector<size_t> result;
+
+  for (size_t i = 0; i < size; i++) {
+    const nlohmann::json& query = input.at("queries").at(i);
+    std::string kind = query.at("kind");
+
+    result.clear();
+
+    if (kind == "window") {
+      const nlohmann::json& window = query.at("window");
+
+      tree->Window(Rectangle<T>(Point<T>(window.at(0).at(0),
+                                         window.at(0).at(1)),
+                                Point<T>(window.at(1).at(0),
+                                         window.at(1).at(1))),
+                   std::back_inserter(result));
+    } else if (kind == "stab") {
+      tree->Stab(Point<T>(query.at("point").at(0), query.at("point").at(1)),
+                 std::back_inserter(result));
+    } else if (kind == "nearest") {
+      result = tree->Nearest(Point<T>(query.at("point").at(0),
+                                      query.at("point").at(1)),
+                             query.at("k"));
+    } else {
+      return -1;
+    }
+
+    (*output)["data"].push_back(result);
+  }
+
+  return 0;
+}
+
+}  // namespace geometry
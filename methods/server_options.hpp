@@ -0,0 +1,206 @@
+/**
+ * @file methods/server_options.hpp
+ * @author Mikhail Lozhnikov
+ *
+ * Параметры запуска сервера: порт, пул рабочих потоков, ограничения
+ * на соединения, объём кэша результатов, очередь фоновых задач и число
+ * хранимых наборов данных.
+ */
+
+#ifndef METHODS_SERVER_OPTIONS_HPP_
+#define METHODS_SERVER_OPTIONS_HPP_
+
+#include <httplib.h>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <thread_pool.hpp>
+
+namespace geometry {
+
+/**
+ * @brief Параметры запуска сервера.
+ *
+ * Значения по умолчанию совпадают с настройками httplib::Server.
+ */
+struct ServerOptions {
+  //! Порт.
+  int port = 8080;
+  //! Число рабочих потоков (0 означает значение httplib по умолчанию).
+  size_t threads = 0;
+  //! Закрепить рабочие потоки за ядрами.
+  bool affinity = false;
+  //! Максимальное число запросов в одном соединении.
+  size_t keepAliveMax = CPPHTTPLIB_KEEPALIVE_MAX_COUNT;
+  //! Время ожидания следующего запроса в соединении (в секундах).
+  time_t keepAliveTimeout = CPPHTTPLIB_KEEPALIVE_TIMEOUT_SECOND;
+  //! Отключить алгоритм Нейгла для сокетов клиентов.
+  bool tcpNoDelay = CPPHTTPLIB_TCP_NODELAY;
+  //! Объём кэша результатов в мегабайтах (0 отключает кэш).
+  size_t cacheSize = 64;
+  //! Число потоков, выполняющих фоновые задачи.
+  size_t jobThreads = 2;
+  //! Наибольшее число фоновых задач, ожидающих в очереди.
+  size_t jobQueue = 16;
+  //! Наибольшее число наборов данных каждого вида (см. DatasetRegistry).
+  size_t datasets = 64;
+};
+
+/**
+ * @brief Очередь задач httplib, выполняемых пулом ThreadPool.
+ *
+ * Сервер создаёт очередь при запуске и передаёт в неё обработку каждого
+ * принятого соединения. Пул httplib по умолчанию не позволяет закрепить
+ * потоки за ядрами, поэтому используется собственный пул. Тот же пул
+ * доступен обработчикам запросов (см. ConfigureServer()).
+ */
+class ServerTaskQueue : public httplib::TaskQueue {
+ private:
+  //! Пул рабочих потоков.
+  std::shared_ptr<ThreadPool> pool;
+
+ public:
+  /**
+   * @brief Создать очередь.
+   *
+   * @param pool Пул рабочих потоков.
+   */
+  explicit ServerTaskQueue(std::shared_ptr<ThreadPool> pool) :
+      pool(std::move(pool)) { }
+
+  void enqueue(std::function<void()> fn) override {
+    pool->Enqueue(std::move(fn));
+  }
+
+  void shutdown() override {
+    pool->Shutdown();
+  }
+};
+
+/**
+ * @brief Разобрать аргументы командной строки.
+ *
+ * @param argc Число аргументов.
+ * @param argv Аргументы.
+ * @param options Параметры, в которые записываются значения.
+ * @return false, если встретился неизвестный или некорректный аргумент.
+ *
+ * Первый аргумент без префикса задаёт порт. Остальные параметры
+ * задаются в виде --threads=N, --affinity, --keep-alive-max=N,
+ * --keep-alive-timeout=S, --tcp-nodelay=0|1, --cache-size=MB,
+ * --job-threads=N, --job-queue=N и --datasets=N.
+ */
+inline bool ParseServerOptions(int argc, char* argv[],
+                               ServerOptions* options) {
+  bool portSet = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    const char* value = std::strchr(arg, '=');
+    size_t number = 0;
+
+    if (std::strncmp(arg, "--", 2) != 0) {
+      if (portSet || std::sscanf(arg, "%d", &options->port) != 1)
+        return false;
+
+      portSet = true;
+    } else if (std::strcmp(arg, "--affinity") == 0) {
+      options->affinity = true;
+    } else if (!value) {
+      return false;
+    } else if (std::strncmp(arg, "--threads=", 10) == 0 &&
+               std::sscanf(value + 1, "%zu", &number) == 1) {
+      options->threads = number;
+    } else if (std::strncmp(arg, "--keep-alive-max=", 17) == 0 &&
+               std::sscanf(value + 1, "%zu", &number) == 1 && number > 0) {
+      options->keepAliveMax = number;
+    } else if (std::strncmp(arg, "--keep-alive-timeout=", 21) == 0 &&
+               std::sscanf(value + 1, "%zu", &number) == 1) {
+      options->keepAliveTimeout = static_cast<time_t>(number);
+    } else if (std::strncmp(arg, "--tcp-nodelay=", 14) == 0 &&
+               std::sscanf(value + 1, "%zu", &number) == 1 && number <= 1) {
+      options->tcpNoDelay = number == 1;
+    } else if (std::strncmp(arg, "--cache-size=", 13) == 0 &&
+               std::sscanf(value + 1, "%zu", &number) == 1) {
+      options->cacheSize = number;
+    } else if (std::strncmp(arg, "--job-threads=", 14) == 0 &&
+               std::sscanf(value + 1, "%zu", &number) == 1 && number > 0) {
+      options->jobThreads = number;
+    } else if (std::strncmp(arg, "--job-queue=", 12) == 0 &&
+               std::sscanf(value + 1, "%zu", &number) == 1) {
+      options->jobQueue = number;
+    } else if (std::strncmp(arg, "--datasets=", 11) == 0 &&
+               std::sscanf(value + 1, "%zu", &number) == 1 && number > 0) {
+      options->datasets = number;
+    } else {
+      return false;
+    }
+  }
+
+  if (options->threads == 0)
+    options->threads = CPPHTTPLIB_THREAD_POOL_COUNT;
+
+  return true;
+}
+
+/**
+ * @brief Применить параметры к серверу.
+ *
+ * @param options Параметры запуска.
+ * @param svr Сервер (до вызова listen()).
+ * @return Пул рабочих потоков сервера. Обработчики запросов могут
+ * выполнять в нём части своей работы (см. ThreadPool::ParallelFor()).
+ */
+inline std::shared_ptr<ThreadPool> ConfigureServer(
+    const ServerOptions& options, httplib::Server* svr) {
+  auto pool = std::make_shared<ThreadPool>(options.threads, options.affinity);
+
+  if (options.affinity && !pool->Pinned())
+    std::cerr << "Could not pin worker threads to cores." << std::endl;
+
+  svr->new_task_queue = [pool]() {
+    return new ServerTaskQueue(pool);
+  };
+
+  svr->set_keep_alive_max_count(options.keepAliveMax);
+  svr->set_keep_alive_timeout(options.keepAliveTimeout);
+  svr->set_tcp_nodelay(options.tcpNoDelay);
+
+  return pool;
+}
+
+/**
+ * @brief Вывести действующие параметры.
+ *
+ * @param options Параметры запуска.
+ * @param stream Поток вывода.
+ */
+inline void PrintServerOptions(const ServerOptions& options,
+                               std::ostream* stream) {
+  *stream << "Worker threads: " << options.threads
+          << (options.affinity ? " (pinned to cores)" : "") << std::endl;
+  *stream << "Keep-alive: at most " << options.keepAliveMax
+          << " requests per connection, " << options.keepAliveTimeout
+          << " s timeout" << std::endl;
+  *stream << "TCP_NODELAY: " << (options.tcpNoDelay ? "on" : "off")
+          << std::endl;
+  *stream << "Result cache: ";
+
+  if (options.cacheSize > 0)
+    *stream << options.cacheSize << " MB" << std::endl;
+  else
+    *stream << "off" << std::endl;
+
+  *stream << "Background jobs: " << options.jobThreads << " threads, "
+          << "at most " << options.jobQueue << " queued" << std::endl;
+  *stream << "Datasets: at most " << options.datasets << " of each kind"
+          << std::endl;
+}
+
+}  // namespace geometry
+
+#endif  // METHODS_SERVER_OPTIONS_HPP_
@@ -0,0 +1,113 @@
+/**
+ * @file methods/simplify_polyline_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функцию, которая упрощает ломаную алгоритмом
+ * Дугласа-Пекера или Висвалингам-Уайатта. Функция принимает и возвращает
+ * данные в JSON формате.
+ */
+
+#include <iterator>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "coordinate_types.hpp"
+#include "simplify_polyline.hpp"
+
+namespace geometry {
+
+template<typename T>
+static int SimplifyPolylineMethodHelper(const nlohmann::json& input,
+                                        nlohmann::json* output,
+                                        std::string type);
+
+int SimplifyPolylineMethod(const nlohmann::json& input,
+                           nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return SimplifyPolylineMethodHelper<T>(input, output, type);
+  });
+}
+
+/**
+ * @brief Упростить ломаную.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename T>
+static int SimplifyPolylineMethodHelper(const nlohmann::json& input,
+                                        nlohmann::json* output,
+                                        std::string type) {
+  using ToleranceType = detail::SimplifyType<T>;
+
+  std::string name = input.value("method", "douglas-peucker");
+  ToleranceType tolerance = input.at("tolerance").get<ToleranceType>();
+  size_t window = input.value("window", 0);
+  bool closed = input.value("closed", false);
+  size_t size = input.at("size");
+  SimplifyMethod method = SimplifyMethod::DouglasPeucker;
+
+  if (name == "visvalingam")
+    method = SimplifyMethod::Visvalingam;
+  else if (name != "douglas-peucker")
+    return -1;
+
+  if (tolerance < 0)
+    return -1;
+
+  std::vector<Point<T>> points;
+
+  points.reserve(size + 1);
+
+  for (size_t i = 0; i < size; i++) {
+    points.push_back(Point<T>(input.at("data").at(0).at(i),
+                              input.at("data").at(1).at(i)));
+  }
+
+  // Замкнутая ломаная упрощается как незамкнутая, которая начинается
+  // и заканчивается в первой вершине.
+  if (closed && size > 0)
+    points.push_back(points.front());
+
+  std::vector<Point<T>> result;
+
+  if (window == 0) {
+    for (size_t i : SimplifyPolyline(method, points.data(), points.size(),
+                                     tolerance))
+      result.push_back(points[i]);
+  } else {
+    PolylineSimplifier<T> simplifier(method, tolerance, window);
+    auto inserter = std::back_inserter(result);
+
+    for (const Point<T>& point : points)
+      inserter = simplifier.Push(point, inserter);
+
+    simplifier.Finish(inserter);
+  }
+
+  if (closed && result.size() > 1)
+    result.pop_back();
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["size"] = result.size();
+  (*output)["data"] = { nlohmann::json::array(), nlohmann::json::array() };
+
+  for (const Point<T>& point : result) {
+    (*output)["data"][0].push_back(point.X());
+    (*output)["data"][1].push_back(point.Y());
+  }
+
+  return 0;
+}
+
+}  // namespace geometry
@@ -0,0 +1,74 @@
+/**
+ * @file methods/triangulate_polygon_method.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Файл содержит функцию, которая триангулирует простой многоугольник.
+ * Функция принимает и возвращает данные в JSON формате.
+ */
+
+#include <array>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "coordinate_types.hpp"
+#include "triangulate_polygon.hpp"
+
+namespace geometry {
+
+template<typename T>
+static int TriangulatePolygonMethodHelper(const nlohmann::json& input,
+                                          nlohmann::json* output,
+                                          std::string type);
+
+int TriangulatePolygonMethod(const nlohmann::json& input,
+                             nlohmann::json* output) {
+  std::string type = input.at("type");
+
+  return DispatchType(type, [&](auto coordinate) {
+    using T = typename decltype(coordinate)::Type;
+
+    return TriangulatePolygonMethodHelper<T>(input, output, type);
+  });
+}
+
+/**
+ * @brief Метод триангуляции многоугольника.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа данных координат.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ */
+template<typename T>
+static int TriangulatePolygonMethodHelper(const nlohmann::json& input,
+                                          nlohmann::json* output,
+                                          std::string type) {
+  size_t size = input.at("size");
+
+  if (size < 3)
+    return -1;
+
+  std::vector<Point<T>> vertices;
+
+  vertices.reserve(size);
+
+  for (size_t i = 0; i < size; i++) {
+    vertices.push_back(Point<T>(input.at("data").at(0).at(i),
+                                input.at("data").at(1).at(i)));
+  }
+
+  std::vector<std::array<size_t, 3>> triangles =
+      TriangulatePolygon<T>(vertices);
+
+  (*output)["id"] = input.at("id");
+  (*output)["type"] = type;
+  (*output)["size"] = triangles.size();
+  (*output)["data"] = triangles;
+
+  return 0;
+}
+
+}  // namespace geometry
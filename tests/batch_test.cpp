@@ -0,0 +1,193 @@
+/**
+ * @file tests/batch_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для пакетных запросов.
+ */
+
+#include <httplib.h>
+#include <random>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+static void SimpleTest(httplib::Client* cli);
+static void RandomTest(httplib::Client* cli);
+static void InvalidTest(httplib::Client* cli);
+
+void TestBatch(httplib::Client* cli) {
+  TestSuite suite("TestBatch");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, InvalidTest);
+}
+
+/**
+ * @brief Простейший статический тест.
+ *
+ * Оболочка и контур в одном запросе, третий вызов содержит ошибку
+ * и не влияет на остальные.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "size": 3,
+    "data": [
+      {
+        "method": "GrahamScan",
+        "input": {
+          "id": 10,
+          "type": "int",
+          "size": 5,
+          "data": [ [0, 2, 2, 0, 1], [0, 0, 2, 2, 1] ]
+        }
+      },
+      {
+        "method": "ContourRectangles",
+        "input": {
+          "id": 11,
+          "type": "int",
+          "size": 1,
+          "data": [ [ [0, 0], [1, 1] ] ]
+        }
+      },
+      {
+        "method": "GrahamScan",
+        "input": {
+          "id": 12,
+          "type": "int",
+          "size": 3,
+          "data": [ [0, 1], [0, 1] ]
+        }
+      }
+    ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/Batch", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(200, res->status);
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL(3, output["size"]);
+
+  REQUIRE_EQUAL("GrahamScan", output["data"][0]["method"]);
+  REQUIRE_EQUAL(200, output["data"][0]["status"]);
+  REQUIRE_EQUAL(10, output["data"][0]["output"]["id"]);
+  REQUIRE_EQUAL(4, output["data"][0]["output"]["size"]);
+
+  REQUIRE_EQUAL("ContourRectangles", output["data"][1]["method"]);
+  REQUIRE_EQUAL(200, output["data"][1]["status"]);
+  REQUIRE_EQUAL(11, output["data"][1]["output"]["id"]);
+  REQUIRE_EQUAL(4, output["data"][1]["output"]["size"]);
+
+  REQUIRE_EQUAL(400, output["data"][2]["status"]);
+
+  // Идентификатор вызова возвращается и для вызова с ошибкой.
+  for (size_t i = 0; i < 3; i++)
+    REQUIRE_EQUAL(10 + static_cast<int>(i), output["data"][i]["id"]);
+}
+
+/**
+ * @brief Тест со случайными данными.
+ *
+ * Ответ на каждый вызов пакета должен совпадать с ответом на отдельный
+ * запрос к тому же методу.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void RandomTest(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<int> coordinate(-1000, 1000);
+  std::uniform_int_distribution<int> length(1, 100);
+  const size_t size = 32;
+  nlohmann::json input;
+
+  input["id"] = "batch";
+  input["size"] = size;
+
+  for (size_t i = 0; i < size; i++) {
+    nlohmann::json call;
+
+    call["id"] = i;
+    call["type"] = "int";
+    call["size"] = 50;
+
+    for (size_t j = 0; j < 50; j++) {
+      int x = coordinate(gen), y = coordinate(gen);
+
+      if (i % 2 == 0) {
+        call["data"][0][j] = x;
+        call["data"][1][j] = y;
+      } else {
+        call["data"][j] = { { x, y }, { x + length(gen), y + length(gen) } };
+      }
+    }
+
+    input["data"][i]["method"] = i % 2 == 0 ? "GrahamScan"
+                                            : "ContourRectangles";
+    input["data"][i]["input"] = call;
+  }
+
+  httplib::Result res = cli->Post("/Batch", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(200, res->status);
+  REQUIRE_EQUAL("batch", output["id"]);
+  REQUIRE_EQUAL(size, output["data"].size());
+
+  for (size_t i = 0; i < size; i++) {
+    std::string method = input["data"][i]["method"];
+    httplib::Result single = cli->Post(("/" + method).c_str(),
+                                       input["data"][i]["input"].dump(),
+                                       "application/json");
+
+    REQUIRE_EQUAL(200, output["data"][i]["status"]);
+    REQUIRE_EQUAL(i, output["data"][i]["output"]["id"]);
+    REQUIRE(output["data"][i]["output"] ==
+            nlohmann::json::parse(single->body));
+  }
+}
+
+/**
+ * @brief Тест на некорректные пакетные запросы.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void InvalidTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "data": [
+      {
+        "method": "Unknown",
+        "input": { "id": 1, "type": "int", "size": 0, "data": [] }
+      }
+    ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/Batch", input.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+
+  input["data"][0] = { { "method", "GrahamScan" } };
+  res = cli->Post("/Batch", input.dump(), "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+
+  input = { { "id", 1 }, { "size", 0 }, { "data", nlohmann::json::array() } };
+  res = cli->Post("/Batch", input.dump(), "application/json");
+
+  REQUIRE_EQUAL(200, res->status);
+  REQUIRE_EQUAL(0, nlohmann::json::parse(res->body)["size"]);
+}
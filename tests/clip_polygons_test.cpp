@@ -0,0 +1,388 @@
+/**
+ * @file tests/clip_polygons_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для алгоритмов отсечения многоугольников окном.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+#define NUM_TRIES_FOR_RANDOM_TEST 100
+
+static void ConvexTest(httplib::Client* cli);
+static void GeneralTest(httplib::Client* cli);
+static void RandomTest(httplib::Client* cli);
+static void InvalidWindowTest(httplib::Client* cli);
+static void DegenerateTest(httplib::Client* cli);
+static void PolylineTest(httplib::Client* cli);
+
+static double Area(const nlohmann::json& polygon);
+static double TotalArea(const nlohmann::json& polygons);
+
+void TestClipPolygons(httplib::Client* cli) {
+  TestSuite suite("TestClipPolygons");
+
+  RUN_TEST_REMOTE(suite, cli, ConvexTest);
+  RUN_TEST_REMOTE(suite, cli, GeneralTest);
+  RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, InvalidWindowTest);
+  RUN_TEST_REMOTE(suite, cli, DegenerateTest);
+  RUN_TEST_REMOTE(suite, cli, PolylineTest);
+}
+
+/**
+ * @brief Простейший статический тест отсечения прямоугольным окном.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void ConvexTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "type": "int",
+    "window": [[2, 2, 6, 6], [1, 3, 3, 1]],
+    "size": 3,
+    "data": [
+      [[0, 0, 4, 4], [0, 4, 4, 0]],
+      [[7, 7, 9], [0, 2, 0]],
+      [[3, 5, 4], [2, 2, 3]]
+    ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/ClipPolygons", input.dump(),
+                                  "application/json");
+
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL(3, output["size"]);
+  REQUIRE_EQUAL("int", output["type"]);
+  REQUIRE_EQUAL("convex", output["mode"]);
+
+  REQUIRE_EQUAL(1U, output["data"][0].size());
+  REQUIRE_EQUAL(4U, output["data"][0][0][0].size());
+  REQUIRE_CLOSE(4.0, std::fabs(Area(output["data"][0][0])), 1e-9);
+
+  REQUIRE_EQUAL(0U, output["data"][1].size());
+
+  REQUIRE_EQUAL(1U, output["data"][2].size());
+  REQUIRE_EQUAL(to_string(input["data"][2]),
+                to_string(output["data"][2][0]));
+}
+
+/**
+ * @brief Отсечение невыпуклым окном.
+ *
+ * Окно в форме буквы U, прямоугольник пересекает обе его ветви,
+ * поэтому пересечение состоит из двух многоугольников.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void GeneralTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 2,
+    "type": "double",
+    "mode": "general",
+    "window": [[0, 6, 6, 4, 4, 2, 2, 0], [0, 0, 6, 6, 2, 2, 6, 6]],
+    "size": 3,
+    "data": [
+      [[-1, -1, 7, 7], [3, 5, 5, 3]],
+      [[0.5, 0.5, 1.5, 1.5], [0.5, 1.5, 1.5, 0.5]],
+      [[2.5, 2.5, 3.5, 3.5], [3, 5, 5, 3]]
+    ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/ClipPolygons", input.dump(),
+                                  "application/json");
+
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(2, output["id"]);
+  REQUIRE_EQUAL(3, output["size"]);
+  REQUIRE_EQUAL("general", output["mode"]);
+
+  REQUIRE_EQUAL(2U, output["data"][0].size());
+  REQUIRE_CLOSE(4.0, std::fabs(Area(output["data"][0][0])), 1e-9);
+  REQUIRE_CLOSE(4.0, std::fabs(Area(output["data"][0][1])), 1e-9);
+
+  // Многоугольник целиком внутри окна.
+  REQUIRE_EQUAL(1U, output["data"][1].size());
+  REQUIRE_EQUAL(to_string(input["data"][1]),
+                to_string(output["data"][1][0]));
+
+  // Многоугольник целиком в вырезе окна.
+  REQUIRE_EQUAL(0U, output["data"][2].size());
+}
+
+/**
+ * @brief Сравнение площадей результатов двух алгоритмов.
+ *
+ * Звёздные многоугольники отсекаются случайными прямоугольниками
+ * в обоих режимах. Суммарные площади результатов должны совпадать.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void RandomTest(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_real_distribution<double> coordinate(-100.0, 100.0);
+  std::uniform_real_distribution<double> radius(10.0, 100.0);
+  std::uniform_real_distribution<double> jitter(0.0, 1.0);
+  std::uniform_int_distribution<size_t> vertices(5, 30);
+
+  for (size_t i = 0; i < NUM_TRIES_FOR_RANDOM_TEST; i++) {
+    double x1 = coordinate(gen), x2 = coordinate(gen);
+    double y1 = coordinate(gen), y2 = coordinate(gen);
+
+    nlohmann::json input;
+
+    input["id"] = i;
+    input["type"] = "double";
+    input["size"] = 1;
+    input["window"][0] = { std::min(x1, x2), std::min(x1, x2),
+                           std::max(x1, x2), std::max(x1, x2) };
+    input["window"][1] = { std::min(y1, y2), std::max(y1, y2),
+                           std::max(y1, y2), std::min(y1, y2) };
+
+    // Соседние вершины отстоят от начала координат на угол меньше pi,
+    // поэтому многоугольник является звёздным и не имеет самопересечений.
+    std::vector<double> angles(vertices(gen));
+
+    for (size_t j = 0; j < angles.size(); j++)
+      angles[j] = 2 * std::acos(-1.0) * (j + jitter(gen)) / angles.size();
+
+    for (size_t j = 0; j < angles.size(); j++) {
+      double r = radius(gen);
+
+      input["data"][0][0][j] = r * std::cos(angles[j]);
+      input["data"][0][1][j] = r * std::sin(angles[j]);
+    }
+
+    input["mode"] = "convex";
+
+    httplib::Result convex = cli->Post("/ClipPolygons", input.dump(),
+                                       "application/json");
+
+    input["mode"] = "general";
+
+    httplib::Result general = cli->Post("/ClipPolygons", input.dump(),
+                                        "application/json");
+
+    nlohmann::json convexOutput = nlohmann::json::parse(convex->body);
+    nlohmann::json generalOutput = nlohmann::json::parse(general->body);
+
+    REQUIRE_CLOSE(TotalArea(convexOutput["data"][0]),
+                  TotalArea(generalOutput["data"][0]), 1e-6);
+  }
+}
+
+/**
+ * @brief Невыпуклое окно в режиме "convex" является ошибкой.
+ *
+ * Кроме невыпуклого окна проверяются самопересекающаяся звезда, у которой
+ * все повороты имеют один знак, окно с повторяющейся вершиной и квадрат,
+ * обойдённый дважды.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void InvalidWindowTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 4,
+    "type": "int",
+    "size": 1,
+    "data": [ [[0, 0, 4, 4], [0, 4, 4, 0]] ]
+  }
+)"_json;
+  nlohmann::json windows = R"(
+  [
+    [[0, 6, 6, 4, 4, 2, 2, 0], [0, 0, 6, 6, 2, 2, 6, 6]],
+    [[0, 4, 1, 2, 3], [0, 0, 3, -1, 3]],
+    [[0, 4, 4, 4, 0], [0, 0, 4, 4, 4]],
+    [[0, 4, 4, 0, 0, 4, 4, 0], [0, 0, 4, 4, 0, 0, 4, 4]]
+  ]
+)"_json;
+
+  for (const nlohmann::json& window : windows) {
+    input["window"] = window;
+
+    httplib::Result res = cli->Post("/ClipPolygons", input.dump(),
+                                    "application/json");
+
+    REQUIRE_EQUAL(400, res->status);
+  }
+}
+
+/**
+ * @brief Вырожденные случаи в режиме "general".
+ *
+ * Квадрат отсекается окнами, у которых с ним общее ребро, окном-ромбом,
+ * вершины которого лежат на рёбрах квадрата, ромбом, касающимся квадрата
+ * вершиной снаружи, и ромбом, рёбра которого проходят через вершины
+ * квадрата. Результат не должен содержать точек вне окна, повторяющихся
+ * вершин и многоугольников нулевой площади.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void DegenerateTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 5,
+    "type": "int",
+    "mode": "general",
+    "size": 1,
+    "data": [ [[0, 4, 4, 0], [0, 0, 4, 4]] ]
+  }
+)"_json;
+  nlohmann::json windows = R"(
+  [
+    [[2, 6, 6, 2], [0, 0, 4, 4]],
+    [[0, 4, 4, 0], [0, 0, 4, 4]],
+    [[2, 4, 2, 0], [0, 2, 4, 2]],
+    [[4, 6, 8, 6], [2, 0, 2, 4]],
+    [[2, 6, 2, -2], [-2, 2, 6, 2]]
+  ]
+)"_json;
+  nlohmann::json expected = R"(
+  [
+    [ [[2, 4, 4, 2], [0, 0, 4, 4]] ],
+    [ [[0, 4, 4, 0], [0, 0, 4, 4]] ],
+    [ [[2, 4, 2, 0], [0, 2, 4, 2]] ],
+    [],
+    [ [[0, 4, 4, 0], [0, 0, 4, 4]] ]
+  ]
+)"_json;
+
+  for (size_t i = 0; i < windows.size(); i++) {
+    input["window"] = windows[i];
+
+    httplib::Result res = cli->Post("/ClipPolygons", input.dump(),
+                                    "application/json");
+
+    nlohmann::json output = nlohmann::json::parse(res->body);
+    const nlohmann::json& polygons = output["data"][0];
+
+    REQUIRE_EQUAL(expected[i].size(), polygons.size());
+
+    for (size_t j = 0; j < polygons.size(); j++) {
+      const nlohmann::json& polygon = polygons[j];
+      size_t size = polygon[0].size();
+      size_t shift = 0;
+
+      // Первая вершина результата может быть любой.
+      while (shift < size &&
+             (polygon[0][shift] != expected[i][j][0][0] ||
+              polygon[1][shift] != expected[i][j][1][0]))
+        shift++;
+
+      REQUIRE_EQUAL(expected[i][j][0].size(), size);
+      REQUIRE(shift < size);
+
+      for (size_t k = 0; k < size; k++) {
+        REQUIRE_EQUAL(expected[i][j][0][k], polygon[0][(k + shift) % size]);
+        REQUIRE_EQUAL(expected[i][j][1][k], polygon[1][(k + shift) % size]);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Отсечение ломаных.
+ *
+ * Ломаная дважды пересекает невыпуклое окно, вторая ломаная входит
+ * в окно в точке на его нижнем ребре и идёт вдоль этого ребра, третья
+ * целиком лежит вне окна. Затем ломаная отсекается выпуклым окном.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void PolylineTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 6,
+    "type": "int",
+    "mode": "general",
+    "kind": "polyline",
+    "window": [[0, 6, 6, 4, 4, 2, 2, 0], [0, 0, 6, 6, 2, 2, 6, 6]],
+    "size": 3,
+    "data": [
+      [[-1, 7], [4, 4]],
+      [[-2, 2, 8], [-2, 0, 0]],
+      [[3, 3, 10], [3, 10, 10]]
+    ]
+  }
+)"_json;
+  nlohmann::json expected = R"(
+  [
+    [ [[0, 2], [4, 4]], [[4, 6], [4, 4]] ],
+    [ [[2, 6], [0, 0]] ],
+    []
+  ]
+)"_json;
+
+  httplib::Result res = cli->Post("/ClipPolygons", input.dump(),
+                                  "application/json");
+
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(6, output["id"]);
+  REQUIRE_EQUAL("polyline", output["kind"]);
+  REQUIRE_EQUAL(to_string(expected), to_string(output["data"]));
+
+  input["mode"] = "convex";
+  input["window"] = R"([[0, 4, 4, 0], [0, 0, 4, 4]])"_json;
+  input["size"] = 1;
+  input["data"] = R"([ [[-1, 2, 2, 5], [1, 1, 3, 3]] ])"_json;
+
+  res = cli->Post("/ClipPolygons", input.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(to_string(R"([ [ [[0, 2, 2, 4], [1, 1, 3, 3]] ] ])"_json),
+                to_string(output["data"]));
+}
+
+/**
+ * @brief Вычислить ориентированную площадь многоугольника.
+ *
+ * @param polygon Координаты вершин в формате [[x1, ...], [y1, ...]].
+ * @return Ориентированная площадь.
+ */
+static double Area(const nlohmann::json& polygon) {
+  double area = 0;
+  size_t size = polygon[0].size();
+
+  for (size_t i = 0; i < size; i++) {
+    size_t j = (i + 1) % size;
+    double xi = polygon[0][i], yi = polygon[1][i];
+    double xj = polygon[0][j], yj = polygon[1][j];
+
+    area += xi * yj - xj * yi;
+  }
+
+  return area / 2;
+}
+
+/**
+ * @brief Вычислить суммарную площадь набора многоугольников.
+ *
+ * @param polygons Набор многоугольников.
+ * @return Суммарная площадь.
+ */
+static double TotalArea(const nlohmann::json& polygons) {
+  double area = 0;
+
+  for (const nlohmann::json& polygon : polygons)
+    area += std::fabs(Area(polygon));
+
+  return area;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file tests/closest_pair_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для поиска ближайшей пары точек и ближайших
+ * соседей.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+#define NUM_TRIES_FOR_RANDOM_TEST 10
+
+static void SimpleTest(httplib::Client* cli);
+static void DuplicateTest(httplib::Client* cli);
+static void RandomTest(httplib::Client* cli);
+static void InvalidInputTest(httplib::Client* cli);
+
+void TestClosestPair(httplib::Client* cli) {
+  TestSuite suite("TestClosestPair");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, DuplicateTest);
+  RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, InvalidInputTest);
+}
+
+/**
+ * @brief Простейший статический тест.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "type": "int",
+    "size": 5,
+    "data": [ [0, 9, 0, 10, 8], [0, 0, 11, 10, 9] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/ClosestPair", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL(5, output["size"]);
+  REQUIRE_EQUAL("[3,4]", output["data"].dump());
+
+  res = cli->Post("/AllNearestNeighbours", input.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL("[1,0,4,4,3]", output["data"].dump());
+}
+
+/**
+ * @brief Совпадающие точки находятся на нулевом расстоянии.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void DuplicateTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 2,
+    "type": "double",
+    "size": 4,
+    "data": [ [0.0, 5.0, 1.0, 5.0], [0.0, 5.0, 1.0, 5.0] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/ClosestPair", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL("[1,3]", output["data"].dump());
+
+  res = cli->Post("/AllNearestNeighbours", input.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL("[2,3,0,1]", output["data"].dump());
+}
+
+/**
+ * @brief Сравнение с полным перебором на случайных данных.
+ *
+ * Координаты берутся из небольшого диапазона целых чисел, поэтому
+ * в наборах много совпадающих расстояний и совпадающих точек.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void RandomTest(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<size_t> count(2, 3000);
+  std::uniform_int_distribution<int> range(1, 10000);
+
+  for (size_t i = 0; i < NUM_TRIES_FOR_RANDOM_TEST; i++) {
+    size_t size = count(gen);
+    std::uniform_int_distribution<int> coordinate(0, range(gen));
+    std::vector<int> xs(size), ys(size);
+
+    for (size_t j = 0; j < size; j++) {
+      xs[j] = coordinate(gen);
+      ys[j] = coordinate(gen);
+    }
+
+    auto distance = [&xs, &ys](size_t a, size_t b) {
+      double dx = static_cast<double>(xs[a]) - xs[b];
+      double dy = static_cast<double>(ys[a]) - ys[b];
+
+      return dx * dx + dy * dy;
+    };
+
+    double best = std::numeric_limits<double>::infinity();
+    std::vector<double> nearest(size, best);
+
+    for (size_t a = 0; a < size; a++) {
+      for (size_t b = a + 1; b < size; b++) {
+        double d = distance(a, b);
+
+        best = std::min(best, d);
+        nearest[a] = std::min(nearest[a], d);
+        nearest[b] = std::min(nearest[b], d);
+      }
+    }
+
+    nlohmann::json input;
+
+    input["id"] = i;
+    input["type"] = "int";
+    input["threads"] = 4;
+    input["size"] = size;
+    input["data"] = { xs, ys };
+
+    httplib::Result res = cli->Post("/ClosestPair", input.dump(),
+                                    "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+    size_t first = output["data"][0], second = output["data"][1];
+
+    REQUIRE(first < second && second < size);
+    REQUIRE_EQUAL(best, distance(first, second));
+
+    res = cli->Post("/AllNearestNeighbours", input.dump(),
+                    "application/json");
+    output = nlohmann::json::parse(res->body);
+
+    REQUIRE_EQUAL(size, output["data"].size());
+
+    for (size_t j = 0; j < size; j++) {
+      size_t neighbour = output["data"][j];
+
+      REQUIRE(neighbour != j && neighbour < size);
+      REQUIRE_EQUAL(nearest[j], distance(j, neighbour));
+    }
+  }
+}
+
+/**
+ * @brief Набор из одной точки.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void InvalidInputTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 3,
+    "type": "float",
+    "size": 1,
+    "data": [ [0], [0] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/ClosestPair", input.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+
+  res = cli->Post("/AllNearestNeighbours", input.dump(), "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
@@ -9,8 +9,11 @@
 #include <httplib.h>
 #include <cmath>
 #include <limits>
+#include <random>
+#include <string>
 #include <contour_rectangles.hpp>
 #include <nlohmann/json.hpp>
+#include <wire_format.hpp>
 #include "test.hpp"
 #include "test_core.hpp"
 
@@ -19,6 +22,10 @@
 static void IntSimpleTest(httplib::Client *cli);
 static void FloatSimpleTest(httplib::Client *cli);
 static void RandomTest(httplib::Client *cli);
+static void FixedPointTest(httplib::Client *cli);
+static void BinaryTest(httplib::Client *cli);
+static void TextTest(httplib::Client *cli);
+static void SerializationTest(httplib::Client *cli);
 
 template <typename T>
 static void RandomIntegerHelperTest(httplib::Client *cli, std::string type);
@@ -33,6 +40,10 @@ void TestContourRectangles(httplib::Client *cli) {
   RUN_TEST_REMOTE(suite, cli, IntSimpleTest);
   RUN_TEST_REMOTE(suite, cli, FloatSimpleTest);
   RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, FixedPointTest);
+  RUN_TEST_REMOTE(suite, cli, BinaryTest);
+  RUN_TEST_REMOTE(suite, cli, TextTest);
+  RUN_TEST_REMOTE(suite, cli, SerializationTest);
 }
 
 /** 
@@ -112,6 +123,58 @@ static void FloatSimpleTest(httplib::Client *cli) {
   }
 }
 
+/**
+ * @brief Тест режима фиксированной точки.
+ *
+ * @param cli Указатель на HTTP клиент.
+ *
+ * Данные из теста IntSimpleTest, уменьшенные в 1000 раз. С масштабом 1000
+ * контур должен совпасть с целочисленным.
+ */
+static void FixedPointTest(httplib::Client *cli) {
+  nlohmann::json input = R"(
+  {
+  "id"  : 3,
+  "type": "double",
+  "scale": 1000,
+  "size": 3,
+  "data": [ [[0,0],[0.005,0.005]], [[-0.001,0.001],[0.003,0.004]],
+            [[0.002,0.002],[0.006,0.003]] ]
+}
+)"_json;
+
+  httplib::Result res =
+      cli->Post("/ContourRectangles", input.dump(), "application/json");
+
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(3, output["id"]);
+  REQUIRE_EQUAL(12, output["size"]);
+  REQUIRE_EQUAL("double", output["type"]);
+
+  const int expected[12][4] = {
+    {-1, 1, -1, 4}, {0, 0, 0, 1}, {-1, 1, 0, 1}, {-1, 4, 0, 4},
+    {0, 4, 0, 5}, {0, 0, 5, 0}, {0, 5, 5, 5}, {5, 0, 5, 2},
+    {5, 3, 5, 5}, {5, 2, 6, 2}, {5, 3, 6, 3}, {6, 2, 6, 3}
+  };
+
+  for (size_t i = 0; i < 12; i++) {
+    double values[4] = {
+      output["data"][i][0][0], output["data"][i][0][1],
+      output["data"][i][1][0], output["data"][i][1][1]
+    };
+
+    for (size_t j = 0; j < 4; j++)
+      REQUIRE_EQUAL(std::lround(values[j] * 1000), expected[i][j]);
+  }
+
+  input["scale"] = -1;
+
+  res = cli->Post("/ContourRectangles", input.dump(), "application/json");
+
+  REQUIRE_EQUAL(res->status, 400);
+}
+
 /** 
  * @brief Простейший случайный тест.
  *
@@ -297,3 +360,190 @@ static void RandomFloatingPointHelperTest(httplib::Client *cli,
     }
   }
 }
+
+/**
+ * @brief Запросы в двоичном формате.
+ *
+ * Контур, построенный по двоичному запросу, должен совпадать с контуром,
+ * построенным по тем же прямоугольникам в JSON формате.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void BinaryTest(httplib::Client *cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<int> coordinate(0, 100);
+  std::uniform_int_distribution<int> length(1, 20);
+
+  for (size_t it = 0; it < NUM_TRIES_FOR_RANDOM_TEST / 10; it++) {
+    const size_t size = 50;
+    nlohmann::json input;
+    geometry::WireEncoder<int> encoder(it, size, 4);
+
+    input["id"] = it;
+    input["type"] = "int";
+    input["size"] = size;
+
+    for (size_t i = 0; i < size; i++) {
+      int x = coordinate(gen), y = coordinate(gen);
+      int w = length(gen), h = length(gen);
+
+      input["data"][i] = { { x, y }, { x + w, y + h } };
+      encoder.Set(0, i, x);
+      encoder.Set(1, i, y);
+      encoder.Set(2, i, x + w);
+      encoder.Set(3, i, y + h);
+    }
+
+    httplib::Result res =
+        cli->Post("/ContourRectangles", input.dump(), "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    res = cli->Post("/ContourRectangles", encoder.Release(),
+                    "application/octet-stream");
+
+    geometry::WireDecoder decoder;
+
+    REQUIRE_EQUAL(200, res->status);
+    REQUIRE(decoder.Parse(res->body, 4));
+    REQUIRE_EQUAL(it, decoder.Id());
+    REQUIRE_EQUAL(output["size"], decoder.Count());
+
+    for (size_t i = 0; i < decoder.Count(); i++) {
+      REQUIRE(output["data"][i][0][0] == decoder.Get<int>(0, i));
+      REQUIRE(output["data"][i][0][1] == decoder.Get<int>(1, i));
+      REQUIRE(output["data"][i][1][0] == decoder.Get<int>(2, i));
+      REQUIRE(output["data"][i][1][1] == decoder.Get<int>(3, i));
+    }
+  }
+
+  // Двоичный формат не поддерживает long double.
+  std::string message = geometry::WireEncoder<int>(1, 0, 4).Release();
+
+  message[4] = 4;
+
+  httplib::Result res = cli->Post("/ContourRectangles", message,
+                                  "application/octet-stream");
+
+  REQUIRE_EQUAL(400, res->status);
+
+  // Двоичный формат, в отличие от JSON, передаёт NaN и бесконечности.
+  // Такие прямоугольники, как и вывернутые (ne левее или ниже sw),
+  // отклоняются.
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  const double inf = std::numeric_limits<double>::infinity();
+  const double invalid[][4] = {
+    { 0, 0, nan, 1 },
+    { 0, -inf, 1, 1 },
+    { 2, 0, 1, 1 },
+    { 0, 2, 1, 1 }
+  };
+
+  for (const auto &corners : invalid) {
+    geometry::WireEncoder<double> encoder(2, 2, 4);
+
+    for (size_t k = 0; k < 4; k++) {
+      encoder.Set(k, 0, k < 2 ? 0.0 : 1.0);
+      encoder.Set(k, 1, corners[k]);
+    }
+
+    res = cli->Post("/ContourRectangles", encoder.Release(),
+                    "application/octet-stream");
+
+    REQUIRE_EQUAL(400, res->status);
+  }
+}
+
+static void TextTest(httplib::Client *cli) {
+  nlohmann::json input = {
+    {"id", 5},
+    {"size", 2},
+    {"type", "int"},
+    {"data", { { { 0, 0 }, { 2, 2 } }, { { 1, 1 }, { 3, 3 } } } }
+  };
+  httplib::Result res = cli->Post("/ContourRectangles", input.dump(),
+                                  "application/json");
+  nlohmann::json expected = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(8, expected["size"]);
+
+  // Поля в другом порядке, пробелы и вложенные поля, не относящиеся
+  // к методу. Лишняя координата угла игнорируется, как и при разборе
+  // запроса в дерево.
+  std::string texts[] = {
+    "{\"type\": \"int\", \"data\": [[[0, 0], [2, 2]],\n"
+    "  [[1, 1], [3, 3]]], \"size\": 2, \"id\": 5}",
+    "{\"id\": 5, \"size\": 2, \"data\": [[[0, 0], [2, 2]],"
+    " [[1, 1], [3, 3]]], \"type\": \"int\", \"extra\": {\"a\": [1]}}",
+    "{\"id\": 5, \"size\": 2, \"type\": \"int\","
+    " \"data\": [[[0, 0, 7], [2, 2]], [[1, 1], [3, 3]]]}"
+  };
+
+  for (const std::string &text : texts) {
+    res = cli->Post("/ContourRectangles", text, "application/json");
+
+    REQUIRE_EQUAL(200, res->status);
+    REQUIRE(expected == nlohmann::json::parse(res->body));
+  }
+
+  // Прямоугольников меньше, чем указано в поле "size".
+  res = cli->Post("/ContourRectangles",
+                  "{\"id\": 1, \"size\": 2, \"type\": \"int\","
+                  " \"data\": [[[0, 0], [2, 2]]]}",
+                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
+
+static void SerializationTest(httplib::Client *cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<int> coordinate(-100, 100);
+  std::uniform_int_distribution<int> length(1, 30);
+  nlohmann::json input;
+
+  input["id"] = "request";
+  input["type"] = "int";
+  input["size"] = 30;
+  input["components"] = true;
+
+  for (size_t i = 0; i < 30; i++) {
+    int x = coordinate(gen), y = coordinate(gen);
+
+    input["data"][i] = { { x, y }, { x + length(gen), y + length(gen) } };
+  }
+
+  httplib::Result res = cli->Post("/ContourRectangles", input.dump(),
+                                  "application/json");
+
+  // Для целых координат ответ совпадает с сериализацией nlohmann::json.
+  REQUIRE_EQUAL(200, res->status);
+  REQUIRE_EQUAL(nlohmann::json::parse(res->body).dump(), res->body);
+
+  // Координаты типа float записываются кратчайшим образом для float,
+  // а не для double.
+  input = {
+    {"id", 1},
+    {"type", "float"},
+    {"size", 1},
+    {"data", { { { 0.1, 0.2 }, { 1.5, 2.5 } } } }
+  };
+
+  res = cli->Post("/ContourRectangles", input.dump(), "application/json");
+
+  REQUIRE_EQUAL(200, res->status);
+  REQUIRE(res->body.find("[0.1,0.2]") != std::string::npos);
+
+  // Фиксированное число знаков после запятой.
+  input["type"] = "double";
+  input["precision"] = 3;
+  res = cli->Post("/ContourRectangles", input.dump(), "application/json");
+
+  REQUIRE_EQUAL(200, res->status);
+  REQUIRE(res->body.find("[0.100,0.200]") != std::string::npos);
+
+  input["precision"] = 100;
+  res = cli->Post("/ContourRectangles", input.dump(), "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
@@ -0,0 +1,232 @@
+/**
+ * @file tests/convex_intersection_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для пересечения выпуклых многоугольников.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+#define NUM_TRIES_FOR_RANDOM_TEST 10
+
+static void SimpleTest(httplib::Client* cli);
+static void DegenerateTest(httplib::Client* cli);
+static void RandomTest(httplib::Client* cli);
+static void NonConvexTest(httplib::Client* cli);
+
+static double Area(const nlohmann::json& polygon);
+
+void TestConvexIntersection(httplib::Client* cli) {
+  TestSuite suite("TestConvexIntersection");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, DegenerateTest);
+  RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, NonConvexTest);
+}
+
+/**
+ * @brief Простейший статический тест.
+ *
+ * Пары: пересекающиеся квадраты (второй задан по часовой стрелке),
+ * квадрат внутри квадрата и непересекающиеся треугольники.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "type": "int",
+    "size": 3,
+    "data": [
+      [ [ [0, 4, 4, 0], [0, 0, 4, 4] ], [ [2, 2, 6, 6], [2, 6, 6, 2] ] ],
+      [ [ [0, 9, 9, 0], [0, 0, 9, 9] ], [ [1, 2, 2, 1], [1, 1, 2, 2] ] ],
+      [ [ [0, 2, 0], [0, 0, 2] ], [ [3, 5, 5], [3, 1, 3] ] ]
+    ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/ConvexIntersection", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL(3, output["size"]);
+  REQUIRE_EQUAL(4.0, Area(output["data"][0]));
+  REQUIRE_EQUAL("[[1,2,2,1],[1,1,2,2]]", output["data"][1].dump());
+  REQUIRE_EQUAL("[[],[]]", output["data"][2].dump());
+
+  input["mode"] = "test";
+
+  res = cli->Post("/ConvexIntersection", input.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL("[true,true,false]", output["data"].dump());
+}
+
+/**
+ * @brief Многоугольники с общими сторонами и вершинами.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void DegenerateTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 2,
+    "type": "double",
+    "size": 3,
+    "data": [
+      [ [ [0, 2, 2, 0], [0, 0, 2, 2] ], [ [0, 2, 2, 0], [0, 0, 2, 2] ] ],
+      [ [ [0, 2, 2, 0], [0, 0, 2, 2] ], [ [0, 2, 2, 0], [0, 0, 1, 1] ] ],
+      [ [ [0, 2, 2, 0], [0, 0, 2, 2] ], [ [2, 4, 4, 2], [2, 2, 4, 4] ] ]
+    ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/ConvexIntersection", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(4.0, Area(output["data"][0]));
+  REQUIRE_EQUAL(2.0, Area(output["data"][1]));
+  REQUIRE_EQUAL(0.0, Area(output["data"][2]));
+
+  input["mode"] = "test";
+
+  res = cli->Post("/ConvexIntersection", input.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  // Касание в вершине считается пересечением.
+  REQUIRE_EQUAL("[true,true,true]", output["data"].dump());
+}
+
+/**
+ * @brief Сравнение с отсечением методом Сазерленда-Ходжмана.
+ *
+ * Вершины случайных выпуклых многоугольников лежат на окружностях
+ * со случайными центрами. Площади пересечений должны совпадать
+ * с результатами /ClipPolygons, а режим "test" должен возвращать true
+ * ровно для пар с непустым пересечением.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void RandomTest(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_real_distribution<double> coordinate(-100.0, 100.0);
+  std::uniform_real_distribution<double> radius(10.0, 100.0);
+  std::uniform_real_distribution<double> angle(0.0, 2 * std::acos(-1.0));
+  std::uniform_int_distribution<size_t> vertices(3, 50);
+
+  auto randomPolygon = [&]() {
+    std::vector<double> angles(vertices(gen));
+    double x = coordinate(gen), y = coordinate(gen), r = radius(gen);
+    nlohmann::json polygon;
+
+    for (double& value : angles)
+      value = angle(gen);
+
+    std::sort(angles.begin(), angles.end());
+
+    for (size_t j = 0; j < angles.size(); j++) {
+      polygon[0][j] = x + r * std::cos(angles[j]);
+      polygon[1][j] = y + r * std::sin(angles[j]);
+    }
+
+    return polygon;
+  };
+
+  for (size_t i = 0; i < NUM_TRIES_FOR_RANDOM_TEST; i++) {
+    const size_t size = 50;
+    nlohmann::json input;
+
+    input["id"] = i;
+    input["type"] = "double";
+    input["threads"] = 4;
+    input["size"] = size;
+
+    for (size_t j = 0; j < size; j++)
+      input["data"][j] = { randomPolygon(), randomPolygon() };
+
+    httplib::Result res = cli->Post("/ConvexIntersection", input.dump(),
+                                    "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    input["mode"] = "test";
+
+    res = cli->Post("/ConvexIntersection", input.dump(), "application/json");
+
+    nlohmann::json test = nlohmann::json::parse(res->body);
+
+    for (size_t j = 0; j < size; j++) {
+      nlohmann::json clip;
+
+      clip["id"] = j;
+      clip["type"] = "double";
+      clip["window"] = input["data"][j][1];
+      clip["size"] = 1;
+      clip["data"][0] = input["data"][j][0];
+
+      res = cli->Post("/ClipPolygons", clip.dump(), "application/json");
+
+      nlohmann::json expected = nlohmann::json::parse(res->body)["data"][0];
+      double area = expected.empty() ? 0 : std::fabs(Area(expected[0]));
+
+      REQUIRE_CLOSE(area, std::fabs(Area(output["data"][j])), 1e-6);
+      REQUIRE_EQUAL(area > 0, test["data"][j].get<bool>());
+    }
+  }
+}
+
+/**
+ * @brief Невыпуклый многоугольник.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void NonConvexTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 3,
+    "type": "float",
+    "size": 1,
+    "data": [
+      [ [ [0, 2, 1, 2, 0], [0, 0, 1, 2, 2] ], [ [0, 1, 0], [0, 0, 1] ] ]
+    ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/ConvexIntersection", input.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
+
+/**
+ * @brief Вычислить площадь многоугольника.
+ *
+ * @param polygon Координаты вершин в формате [[x1, ...], [y1, ...]].
+ * @return Площадь (положительна для обхода против часовой стрелки).
+ */
+static double Area(const nlohmann::json& polygon) {
+  double area = 0;
+  size_t size = polygon[0].size();
+
+  for (size_t i = 0; i < size; i++) {
+    size_t j = (i + 1) % size;
+    double xi = polygon[0][i], yi = polygon[1][i];
+    double xj = polygon[0][j], yj = polygon[1][j];
+
+    area += xi * yj - xj * yi;
+  }
+
+  return area / 2;
+}
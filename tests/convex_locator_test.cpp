@@ -0,0 +1,168 @@
+/**
+ * @file tests/convex_locator_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для запросов положения точки относительно
+ * выпуклой оболочки.
+ */
+
+#include <httplib.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+#define NUM_TRIES_FOR_RANDOM_TEST 10
+
+static void SimpleTest(httplib::Client* cli);
+static void DegenerateTest(httplib::Client* cli);
+static void RandomTest(httplib::Client* cli);
+
+void TestConvexLocator(httplib::Client* cli) {
+  TestSuite suite("TestConvexLocator");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, DegenerateTest);
+  RUN_TEST_REMOTE(suite, cli, RandomTest);
+}
+
+/**
+ * @brief Простейший статический тест.
+ *
+ * Оболочкой точек является квадрат, точки запроса лежат внутри,
+ * в вершинах, на сторонах и снаружи.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "type": "int",
+    "points": [ [0, 4, 4, 0, 2, 2], [0, 0, 4, 4, 2, 0] ],
+    "size": 7,
+    "queries": [ [2, 4, 0, 5, 2, -1, 2], [2, 2, 0, 5, 0, 2, 4] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/ConvexLocate", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL(7, output["size"]);
+  REQUIRE_EQUAL(4U, output["hull"][0].size());
+  REQUIRE_EQUAL("[1,0,0,-1,0,-1,0]", output["data"].dump());
+}
+
+/**
+ * @brief Вырожденные оболочки: отрезок и точка.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void DegenerateTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 2,
+    "type": "double",
+    "points": [ [0, 2, 4, 1], [0, 2, 4, 1] ],
+    "size": 5,
+    "queries": [ [3, 5, 1, 0, -1], [3, 5, 0, 0, -1] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/ConvexLocate", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL("[0,-1,-1,0,-1]", output["data"].dump());
+
+  input["points"] = { { 3 }, { 3 } };
+  input["size"] = 2;
+  input["queries"] = { { 3, 3 }, { 3, 4 } };
+
+  res = cli->Post("/ConvexLocate", input.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL("[0,-1]", output["data"].dump());
+
+  input["points"] = { nlohmann::json::array(), nlohmann::json::array() };
+
+  res = cli->Post("/ConvexLocate", input.dump(), "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
+
+/**
+ * @brief Сравнение с проверкой всех сторон оболочки.
+ *
+ * Точки и запросы выбираются на небольшой целочисленной сетке, чтобы
+ * запросы часто попадали на вершины и стороны оболочки.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void RandomTest(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<int> coordinate(-20, 20);
+
+  for (size_t i = 0; i < NUM_TRIES_FOR_RANDOM_TEST; i++) {
+    const size_t count = 50;
+    const size_t size = 2000;
+    nlohmann::json input;
+
+    input["id"] = i;
+    input["type"] = "int";
+    input["threads"] = 4;
+    input["size"] = size;
+
+    for (size_t j = 0; j < count; j++) {
+      input["points"][0][j] = coordinate(gen);
+      input["points"][1][j] = coordinate(gen);
+    }
+
+    for (size_t j = 0; j < size; j++) {
+      input["queries"][0][j] = coordinate(gen);
+      input["queries"][1][j] = coordinate(gen);
+    }
+
+    httplib::Result res = cli->Post("/ConvexLocate", input.dump(),
+                                    "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+    const nlohmann::json& hull = output["hull"];
+    size_t vertices = hull[0].size();
+
+    REQUIRE(vertices >= 3);
+    REQUIRE_EQUAL(size, output["data"].size());
+
+    for (size_t j = 0; j < size; j++) {
+      std::int64_t x = input["queries"][0][j], y = input["queries"][1][j];
+      int expected = 1;
+
+      // Оболочка ориентирована против часовой стрелки. Совпадающие
+      // точки входа могут дать повторяющиеся вершины, такие стороны
+      // пропускаются.
+      for (size_t k = 0, l = vertices - 1; k < vertices; l = k++) {
+        std::int64_t ax = hull[0][l], ay = hull[1][l];
+        std::int64_t bx = hull[0][k], by = hull[1][k];
+
+        if (ax == bx && ay == by)
+          continue;
+
+        std::int64_t cross = (bx - ax) * (y - ay) - (by - ay) * (x - ax);
+
+        if (cross < 0) {
+          expected = -1;
+          break;
+        }
+
+        if (cross == 0)
+          expected = 0;
+      }
+
+      REQUIRE_EQUAL(expected, output["data"][j].get<int>());
+    }
+  }
+}
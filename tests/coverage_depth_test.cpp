@@ -0,0 +1,229 @@
+/**
+ * @file tests/coverage_depth_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для поиска максимальной глубины покрытия
+ * прямоугольниками.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+#define NUM_TRIES_FOR_RANDOM_TEST 10
+
+static void SimpleTest(httplib::Client* cli);
+static void TouchingTest(httplib::Client* cli);
+static void RandomTest(httplib::Client* cli);
+static void InvalidTest(httplib::Client* cli);
+
+void TestCoverageDepth(httplib::Client* cli) {
+  TestSuite suite("TestCoverageDepth");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, TouchingTest);
+  RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, InvalidTest);
+}
+
+/**
+ * @brief Простейший статический тест.
+ *
+ * Первые три прямоугольника одновременно покрывают квадрат
+ * [3, 4] x [2, 3], четвёртый ни с кем не пересекается.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "type": "int",
+    "size": 4,
+    "histogram": true,
+    "data": [
+      [ [0, 0], [4, 4] ],
+      [ [2, 2], [6, 6] ],
+      [ [3, 0], [5, 3] ],
+      [ [10, 10], [12, 12] ]
+    ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/CoverageDepth", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL(3, output["depth"]);
+  REQUIRE_EQUAL(3, output["witness"][0]);
+  REQUIRE_EQUAL(2, output["witness"][1]);
+  REQUIRE_EQUAL(4U, output["histogram"].size());
+  REQUIRE_CLOSE(110.0, output["histogram"][0].get<double>(), 1e-9);
+  REQUIRE_CLOSE(27.0, output["histogram"][1].get<double>(), 1e-9);
+  REQUIRE_CLOSE(6.0, output["histogram"][2].get<double>(), 1e-9);
+  REQUIRE_CLOSE(1.0, output["histogram"][3].get<double>(), 1e-9);
+
+  input.erase("histogram");
+
+  res = cli->Post("/CoverageDepth", input.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(3, output["depth"]);
+  REQUIRE(!output.contains("histogram"));
+}
+
+/**
+ * @brief Касающиеся и вырожденные прямоугольники.
+ *
+ * Прямоугольники замкнуты, поэтому общий угол покрыт дважды, а отрезок,
+ * проходящий через него, добавляет третий слой без площади.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void TouchingTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 2,
+    "type": "double",
+    "size": 3,
+    "histogram": true,
+    "data": [
+      [ [0, 0], [1, 1] ],
+      [ [1, 1], [2, 2] ],
+      [ [0, 1], [2, 1] ]
+    ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/CoverageDepth", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(3, output["depth"]);
+  REQUIRE_CLOSE(1.0, output["witness"][0].get<double>(), 1e-9);
+  REQUIRE_CLOSE(1.0, output["witness"][1].get<double>(), 1e-9);
+  REQUIRE_EQUAL(2U, output["histogram"].size());
+  REQUIRE_CLOSE(2.0, output["histogram"][0].get<double>(), 1e-9);
+  REQUIRE_CLOSE(2.0, output["histogram"][1].get<double>(), 1e-9);
+
+  input["size"] = 0;
+  input["data"] = nlohmann::json::array();
+
+  res = cli->Post("/CoverageDepth", input.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(0, output["depth"]);
+  REQUIRE(!output.contains("witness"));
+}
+
+/**
+ * @brief Сравнение с перебором по сетке.
+ *
+ * Глубина в каждой точке с целыми координатами вычисляется перебором
+ * прямоугольников, площадь каждого единичного квадрата относится
+ * к глубине его центра.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void RandomTest(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<int> coordinate(0, 50);
+  std::uniform_int_distribution<int> length(0, 15);
+
+  for (size_t i = 0; i < NUM_TRIES_FOR_RANDOM_TEST; i++) {
+    const size_t size = 100;
+    nlohmann::json input;
+    std::vector<std::vector<int>> rectangles;
+    int minX = 100, minY = 100, maxX = 0, maxY = 0;
+
+    input["id"] = i;
+    input["type"] = i % 2 ? "int" : "double";
+    input["size"] = size;
+    input["histogram"] = true;
+
+    for (size_t j = 0; j < size; j++) {
+      int x = coordinate(gen), y = coordinate(gen);
+      int w = length(gen), h = length(gen);
+
+      rectangles.push_back({ x, y, x + w, y + h });
+      input["data"][j] = { { x, y }, { x + w, y + h } };
+      minX = std::min(minX, x);
+      minY = std::min(minY, y);
+      maxX = std::max(maxX, x + w);
+      maxY = std::max(maxY, y + h);
+    }
+
+    // Глубина точки (x, y), координаты заданы в половинах.
+    auto depth = [&](int x, int y) {
+      size_t result = 0;
+
+      for (const std::vector<int>& r : rectangles) {
+        if (2 * r[0] <= x && x <= 2 * r[2] && 2 * r[1] <= y && y <= 2 * r[3])
+          result++;
+      }
+
+      return result;
+    };
+
+    size_t expected = 0;
+    std::vector<double> histogram;
+
+    for (int x = minX; x <= maxX; x++) {
+      for (int y = minY; y <= maxY; y++) {
+        expected = std::max(expected, depth(2 * x, 2 * y));
+
+        if (x == maxX || y == maxY)
+          continue;
+
+        size_t cell = depth(2 * x + 1, 2 * y + 1);
+
+        if (histogram.size() <= cell)
+          histogram.resize(cell + 1, 0.0);
+
+        histogram[cell] += 1.0;
+      }
+    }
+
+    while (histogram.size() > 1 && histogram.back() == 0.0)
+      histogram.pop_back();
+
+    httplib::Result res = cli->Post("/CoverageDepth", input.dump(),
+                                    "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+    int x = output["witness"][0], y = output["witness"][1];
+
+    REQUIRE_EQUAL(expected, output["depth"]);
+    REQUIRE_EQUAL(expected, depth(2 * x, 2 * y));
+    REQUIRE_EQUAL(histogram.size(), output["histogram"].size());
+
+    for (size_t j = 0; j < histogram.size(); j++)
+      REQUIRE_CLOSE(histogram[j], output["histogram"][j].get<double>(), 1e-6);
+  }
+}
+
+/**
+ * @brief Некорректные входные данные.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void InvalidTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 3,
+    "type": "float",
+    "size": 1,
+    "data": [ [ [0, 4], [4, 0] ] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/CoverageDepth", input.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
@@ -0,0 +1,310 @@
+/**
+ * @file tests/delaunay_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для триангуляции Делоне.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <point.hpp>
+#include <robust_predicates.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+#define NUM_TRIES_FOR_RANDOM_TEST 10
+
+using geometry::Point;
+using geometry::RobustInCircle;
+using geometry::RobustOrientation;
+
+static void PredicatesTest();
+static void SimpleTest(httplib::Client* cli);
+static void VoronoiTest(httplib::Client* cli);
+static void DegenerateTest(httplib::Client* cli);
+static void RandomTest(httplib::Client* cli);
+
+template<typename T, typename Distribution>
+static void RandomHelperTest(httplib::Client* cli, std::string type,
+                             Distribution coordinate);
+
+void TestDelaunay(httplib::Client* cli) {
+  TestSuite suite("TestDelaunay");
+
+  RUN_TEST(suite, PredicatesTest);
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, VoronoiTest);
+  RUN_TEST_REMOTE(suite, cli, DegenerateTest);
+  RUN_TEST_REMOTE(suite, cli, RandomTest);
+}
+
+/**
+ * @brief Проверка устойчивых предикатов на почти вырожденных данных.
+ *
+ * Точки отличаются от вырожденного положения на несколько единиц
+ * последнего разряда, поэтому наивное вычисление в double ошибается.
+ */
+static void PredicatesTest() {
+  Point<double> b(12, 12), c(24, 24);
+  double x = 0.5;
+
+  REQUIRE_EQUAL(0, RobustOrientation(b, c, Point<double>(x, x)));
+
+  for (int i = 0; i < 64; i++) {
+    x = std::nextafter(x, 1.0);
+
+    REQUIRE_EQUAL(-1, RobustOrientation(b, c, Point<double>(x, 0.5)));
+    REQUIRE_EQUAL(1, RobustOrientation(b, c, Point<double>(0.5, x)));
+  }
+
+  Point<double> p(5, 0), q(0, 5), r(-5, 0);
+
+  REQUIRE_EQUAL(0, RobustInCircle(p, q, r, Point<double>(3, 4)));
+  REQUIRE_EQUAL(-1, RobustInCircle(p, q, r,
+                                   Point<double>(3, std::nextafter(4.0, 5.0))));
+  REQUIRE_EQUAL(1, RobustInCircle(p, q, r,
+                                  Point<double>(3, std::nextafter(4.0, 0.0))));
+  REQUIRE_EQUAL(0, RobustInCircle(Point<int>(5, 0), Point<int>(0, 5),
+                                  Point<int>(-5, 0), Point<int>(-3, -4)));
+}
+
+/**
+ * @brief Простейший статический тест.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "type": "int",
+    "size": 5,
+    "data": [ [0, 10, 10, 0, 5], [0, 0, 10, 10, 5] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/Delaunay", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL(4, output["size"]);
+  REQUIRE_EQUAL(4U, output["data"].size());
+  REQUIRE(output.find("voronoi") == output.end());
+
+  // Каждый треугольник содержит центр квадрата и одну из его сторон.
+  for (const nlohmann::json& triangle : output["data"]) {
+    std::vector<size_t> corners = triangle;
+
+    std::sort(corners.begin(), corners.end());
+
+    REQUIRE_EQUAL(4U, corners[2]);
+    REQUIRE((corners[1] - corners[0]) % 2 == 1);
+  }
+}
+
+/**
+ * @brief Диаграмма Вороного треугольника и квадрата.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void VoronoiTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 2,
+    "type": "double",
+    "size": 3,
+    "voronoi": true,
+    "data": [ [0, 4, 0], [0, 0, 4] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/Delaunay", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(1, output["size"]);
+  REQUIRE_CLOSE(2.0, output["voronoi"]["vertices"][0][0].get<double>(),
+                1e-12);
+  REQUIRE_CLOSE(2.0, output["voronoi"]["vertices"][1][0].get<double>(),
+                1e-12);
+  REQUIRE_EQUAL(0U, output["voronoi"]["edges"].size());
+  REQUIRE_EQUAL(3U, output["voronoi"]["rays"].size());
+
+  // Лучи направлены наружу: по внешним нормалям сторон.
+  for (const nlohmann::json& ray : output["voronoi"]["rays"]) {
+    double dx = ray[1], dy = ray[2];
+
+    REQUIRE(dx * dx + dy * dy > 0);
+    REQUIRE(dx < 0 || dy < 0 || (dx > 0 && dy > 0));
+  }
+
+  input["size"] = 5;
+  input["data"] = R"([ [0, 10, 10, 0, 5], [0, 0, 10, 10, 5] ])"_json;
+
+  res = cli->Post("/Delaunay", input.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(4U, output["voronoi"]["vertices"][0].size());
+  REQUIRE_EQUAL(4U, output["voronoi"]["edges"].size());
+  REQUIRE_EQUAL(4U, output["voronoi"]["rays"].size());
+}
+
+/**
+ * @brief Совпадающие и коллинеарные точки.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void DegenerateTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 3,
+    "type": "long double",
+    "size": 4,
+    "data": [ [0, 1, 2, 3], [0, 2, 4, 6] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/Delaunay", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(200, res->status);
+  REQUIRE_EQUAL(0, output["size"]);
+
+  input["size"] = 6;
+  input["data"] = R"([ [0, 1, 0, 1, 0, 1], [0, 0, 1, 1, 0, 1] ])"_json;
+
+  res = cli->Post("/Delaunay", input.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(2, output["size"]);
+
+  // Из совпадающих точек в триангуляцию попадает ровно одна.
+  for (const nlohmann::json& triangle : output["data"]) {
+    std::vector<std::pair<int, int>> corners;
+
+    for (size_t corner : triangle) {
+      corners.emplace_back(input["data"][0][corner].get<int>(),
+                           input["data"][1][corner].get<int>());
+    }
+
+    std::sort(corners.begin(), corners.end());
+
+    REQUIRE(std::unique(corners.begin(), corners.end()) == corners.end());
+  }
+}
+
+/**
+ * @brief Проверка свойства пустой окружности на случайных данных.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void RandomTest(httplib::Client* cli) {
+  RandomHelperTest<int>(cli, "int",
+                        std::uniform_int_distribution<int>(-10, 10));
+  RandomHelperTest<int>(cli, "int",
+                        std::uniform_int_distribution<int>(-1000000,
+                                                           1000000));
+  RandomHelperTest<double>(cli, "double",
+                           std::uniform_real_distribution<double>(-1.0, 1.0));
+}
+
+/**
+ * @brief Проверка свойства пустой окружности для заданного типа координат.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Distribution Тип распределения координат.
+ *
+ * @param cli Указатель на HTTP клиент.
+ * @param type Строковое представление типа данных координат.
+ * @param coordinate Распределение координат.
+ *
+ * Треугольники должны быть ориентированы против часовой стрелки,
+ * их описанные окружности не должны содержать точек набора, а суммарная
+ * площадь должна совпадать с площадью выпуклой оболочки.
+ */
+template<typename T, typename Distribution>
+static void RandomHelperTest(httplib::Client* cli, std::string type,
+                             Distribution coordinate) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<size_t> count(3, 300);
+
+  for (size_t i = 0; i < NUM_TRIES_FOR_RANDOM_TEST; i++) {
+    size_t size = count(gen);
+    std::vector<T> xs(size), ys(size);
+    std::vector<Point<T>> points;
+
+    for (size_t j = 0; j < size; j++) {
+      xs[j] = coordinate(gen);
+      ys[j] = coordinate(gen);
+      points.push_back(Point<T>(xs[j], ys[j]));
+    }
+
+    nlohmann::json input;
+
+    input["id"] = i;
+    input["type"] = type;
+    input["size"] = size;
+    input["data"] = { xs, ys };
+
+    httplib::Result res = cli->Post("/Delaunay", input.dump(),
+                                    "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    REQUIRE_EQUAL(output["size"].get<size_t>(), output["data"].size());
+
+    long double area = 0;
+
+    for (const nlohmann::json& triangle : output["data"]) {
+      const Point<T>& a = points[triangle[0]];
+      const Point<T>& b = points[triangle[1]];
+      const Point<T>& c = points[triangle[2]];
+
+      REQUIRE_EQUAL(1, RobustOrientation(a, b, c));
+
+      area += (static_cast<long double>(b.X()) - a.X()) * (c.Y() - a.Y()) -
+              (static_cast<long double>(b.Y()) - a.Y()) * (c.X() - a.X());
+
+      for (const Point<T>& point : points)
+        REQUIRE(RobustInCircle(a, b, c, point) <= 0);
+    }
+
+    // Площадь выпуклой оболочки (алгоритм Эндрю).
+    std::sort(points.begin(), points.end());
+
+    std::vector<Point<T>> hull(2 * points.size());
+    size_t k = 0;
+
+    for (size_t j = 0; j < points.size(); j++) {
+      while (k >= 2 && RobustOrientation(hull[k - 2], hull[k - 1],
+                                         points[j]) <= 0)
+        k--;
+      hull[k++] = points[j];
+    }
+
+    for (size_t j = points.size() - 1, lower = k + 1; j > 0; j--) {
+      while (k >= lower && RobustOrientation(hull[k - 2], hull[k - 1],
+                                             points[j - 1]) <= 0)
+        k--;
+      hull[k++] = points[j - 1];
+    }
+
+    long double hullArea = 0;
+
+    for (size_t j = 0; j + 1 < k; j++) {
+      hullArea += static_cast<long double>(hull[j].X()) * hull[j + 1].Y() -
+                  static_cast<long double>(hull[j + 1].X()) * hull[j].Y();
+    }
+
+    REQUIRE_CLOSE(static_cast<double>(hullArea), static_cast<double>(area),
+                  1e-9);
+  }
+}
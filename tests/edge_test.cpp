@@ -5,6 +5,7 @@
  * Тесты для класса Edge.
  */
 
+#include <cstdint>
 #include <limits>
 #include <edge.hpp>
 #include "test_core.hpp"
@@ -18,6 +19,9 @@ using geometry::Intersection;
 template<typename T>
 static void BuildTest();
 
+template<typename T>
+static void IntegerTest();
+
 /**
  * @brief Набор тестов для класса geometry::Edge.
  */
@@ -27,6 +31,8 @@ void TestEdge() {
   RUN_TEST(suite, BuildTest<float>);
   RUN_TEST(suite, BuildTest<double>);
   RUN_TEST(suite, BuildTest<long double>);
+  RUN_TEST(suite, IntegerTest<int>);
+  RUN_TEST(suite, IntegerTest<std::int64_t>);
 }
 
 /**
@@ -132,3 +138,74 @@ static void BuildTest() {
     REQUIRE_CLOSE(e.Y(x, eps), T(1.5), eps);
   }
 }
+
+/**
+ * @brief Тест целочисленной специализации класса ребра.
+ *
+ * @tparam T Целочисленный тип данных, используемый для арифметики.
+ */
+template<typename T>
+static void IntegerTest() {
+  {
+    constexpr Edge<T> edge(Point<T>(T(0), T(0)), Point<T>(T(2), T(4)));
+    constexpr Point<T> value = edge.Value(T(2));
+    constexpr Edge<T> flipped = Edge<T>(edge).Flip();
+
+    static_assert(value.X() == T(4) && value.Y() == T(8));
+    static_assert(flipped.Origin().X() == T(2));
+    static_assert(flipped.Destination().Y() == T(0));
+  }
+
+  {
+    Edge<T> vertical(Point<T>(T(3), T(-1)), Point<T>(T(3), T(7)));
+    Edge<T> other(Point<T>(T(4), T(-1)), Point<T>(T(5), T(7)));
+
+    REQUIRE(vertical.IsVertical(T(0)));
+    REQUIRE(!other.IsVertical(T(0)));
+    REQUIRE_EQUAL(other.Slope(T(0)), T(8));
+    REQUIRE_EQUAL(vertical.Slope(T(0)), std::numeric_limits<T>::max());
+  }
+
+  {
+    Edge<T> e1(Point<T>(T(0), T(0)), Point<T>(T(4), T(4)));
+    Edge<T> e2(Point<T>(T(0), T(4)), Point<T>(T(4), T(0)));
+    Edge<T> e3(Point<T>(T(5), T(0)), Point<T>(T(9), T(-4)));
+    Edge<T> e4(Point<T>(T(1), T(0)), Point<T>(T(5), T(4)));
+    Edge<T> e5(Point<T>(T(5), T(5)), Point<T>(T(7), T(7)));
+    T t = T();
+
+    REQUIRE(e1.Cross(e2, &t, T(0)) == Intersection::SkewCross);
+    REQUIRE(e1.Cross(e3, &t, T(0)) == Intersection::SkewNoCross);
+    REQUIRE(e1.Cross(e4, &t, T(0)) == Intersection::Parallel);
+    REQUIRE(e1.Cross(e5, &t, T(0)) == Intersection::Collinear);
+    // Касание концом ребра тоже считается пересечением.
+    REQUIRE(e2.Cross(Edge<T>(Point<T>(T(4), T(0)), Point<T>(T(8), T(3))),
+                     &t, T(0)) == Intersection::SkewCross);
+  }
+
+  // Разность начал рёбер не помещается в T. Для 64-битного типа
+  // координаты ограничены условием CrossProductSign().
+  if constexpr (sizeof(T) < sizeof(std::int64_t)) {
+    const T m = std::numeric_limits<T>::max() - 1;
+    Edge<T> horizontal(Point<T>(T(-m), T(0)), Point<T>(m, T(0)));
+    Edge<T> vertical(Point<T>(m, T(-1)), Point<T>(m, T(1)));
+    T t = T();
+
+    REQUIRE(horizontal.Intersect(vertical, &t, T(0)) == Intersection::Skew);
+    REQUIRE_EQUAL(T(1), t);
+  }
+
+  // Второе ребро проходит через конец первого, то есть точное значение
+  // параметра равно 1. Числитель и знаменатель не помещаются в мантиссу
+  // long double, и частное, вычисленное в нём, округлялось к 0.
+  if constexpr (sizeof(T) == sizeof(std::int64_t)) {
+    Edge<T> e1(Point<T>(T(-484463521653), T(933520734837)),
+               Point<T>(T(-477325537161), T(-439753384453)));
+    Edge<T> e2(Point<T>(T(-775524310709), T(-125484606105)),
+               Point<T>(T(-179126763613), T(-754022162801)));
+    T t = T();
+
+    REQUIRE(e1.Intersect(e2, &t, T(0)) == Intersection::Skew);
+    REQUIRE_EQUAL(T(1), t);
+  }
+}
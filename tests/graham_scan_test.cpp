@@ -6,9 +6,15 @@
  */
 
 #include <httplib.h>
+#include <cmath>
+#include <cstdint>
+#include <list>
 #include <ostream>
+#include <random>
+#include <string>
 #include <nlohmann/json.hpp>
 #include <graham_scan.hpp>
+#include <wire_format.hpp>
 #include "test_core.hpp"
 #include "test.hpp"
 
@@ -19,6 +25,13 @@ static void SimpleTestGrahamScan1(httplib::Client* cli);
 static void SimpleTestGrahamScan2(httplib::Client* cli);
 static void SimpleTestGrahamScan3(httplib::Client* cli);
 static void RandomTestGrahamScan(httplib::Client* cli);
+static void FixedPointTestGrahamScan(httplib::Client* cli);
+static void BinaryTestGrahamScan(httplib::Client* cli);
+static void SerializationTestGrahamScan(httplib::Client* cli);
+static void RepeatTestGrahamScan(httplib::Client* cli);
+
+template<typename T>
+static void BinaryHelperTest(httplib::Client* cli, std::string type);
 
 // template<typename T>
 // static void RandomIntegerHelperTest(httplib::Client* cli, std::string type);
@@ -36,6 +49,10 @@ void TestGrahamScan(httplib::Client* cli) {
   RUN_TEST_REMOTE(suite, cli, SimpleTestGrahamScan2);
   RUN_TEST_REMOTE(suite, cli, SimpleTestGrahamScan3);
   RUN_TEST_REMOTE(suite, cli, RandomTestGrahamScan);
+  RUN_TEST_REMOTE(suite, cli, FixedPointTestGrahamScan);
+  RUN_TEST_REMOTE(suite, cli, BinaryTestGrahamScan);
+  RUN_TEST_REMOTE(suite, cli, SerializationTestGrahamScan);
+  RUN_TEST_REMOTE(suite, cli, RepeatTestGrahamScan);
   // std::cout<<"Test has been started"<<std::endl;
 }
 
@@ -257,6 +274,97 @@ static void SimpleTestGrahamScan2(httplib::Client* cli) {
   }
 }
 
+/**
+ * @brief Тест режима фиксированной точки.
+ *
+ * @param cli Указатель на HTTP клиент.
+ *
+ * Координаты задаются в миллиметрах с точностью до микрометра
+ * и переводятся на целочисленную сетку с масштабом 1000. Полученная
+ * оболочка проверяется точным целочисленным сравнением углов.
+ */
+static void FixedPointTestGrahamScan(httplib::Client* cli) {
+  {
+    nlohmann::json input;
+
+    input["id"] = 4;
+    input["type"] = "double";
+    input["scale"] = 1000;
+    input["size"] = 5;
+    input["data"] = { {-0.030, 0.010, 0.0, 0.020, 0.050},
+                      {0.0, 0.020, 0.030, 0.010, 0.050} };
+
+    httplib::Result res = cli->Post("/GrahamScan", input.dump(),
+        "application/json");
+
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    REQUIRE_EQUAL(res->status, 200);
+    REQUIRE_EQUAL(4, output["size"]);
+    REQUIRE_EQUAL(4, output["id"]);
+    REQUIRE_EQUAL("double", output["type"]);
+
+    const int expected[2][4] = { {-30, 20, 50, 0}, {0, 10, 50, 30} };
+
+    for (size_t i = 0; i < 4; i++) {
+      double x = output["data"][0][i];
+      double y = output["data"][1][i];
+
+      REQUIRE_EQUAL(std::lround(x * 1000), expected[0][i]);
+      REQUIRE_EQUAL(std::lround(y * 1000), expected[1][i]);
+    }
+  }
+
+  // Используется для инициализации генератора случайных чисел.
+  std::random_device rd;
+  // Генератор случайных чисел.
+  std::mt19937 gen(rd());
+  // Распределение для количества точек.
+  std::uniform_int_distribution<size_t> arraySize(10, 50);
+  // Распределение для координат точек.
+  std::uniform_real_distribution<double> elem(-10.0, 10.0);
+
+  for (int it = 0; it < 100; it++) {
+    size_t size = arraySize(gen);
+
+    nlohmann::json input;
+
+    input["id"] = it;
+    input["type"] = "double";
+    input["scale"] = 100;
+    input["size"] = size;
+
+    for (size_t i = 0; i < size; i++) {
+      input["data"][0][i] = elem(gen);
+      input["data"][1][i] = elem(gen);
+    }
+
+    httplib::Result res = cli->Post("/GrahamScan", input.dump(),
+        "application/json");
+
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    size = output.at("size");
+
+    std::list<geometry::Point<std::int64_t>> data;
+    for (size_t i = 0; i < size; i++) {
+      double x = output.at("data").at(0).at(i);
+      double y = output.at("data").at(1).at(i);
+
+      data.push_back(geometry::Point<std::int64_t>(std::llround(x * 100),
+                                                   std::llround(y * 100)));
+    }
+    data.push_back(*data.begin());
+
+    auto it1 = data.begin();
+    auto it2 = std::next(it1);
+    auto it3 = std::next(it2);
+    for (; it3 != data.end(); it1++, it2++, it3++) {
+      REQUIRE(geometry::polarCmp<std::int64_t>(*it2 - *it1, *it3 - *it2));
+    }
+  }
+}
+
 /** 
  * @brief Простейший случайный тест.
  *
@@ -410,3 +518,174 @@ static void RandomFloatingPointHelperTest(httplib::Client* cli,
     }
   }
 }
+
+/**
+ * @brief Запросы в двоичном формате.
+ *
+ * Оболочка, построенная по двоичному запросу, должна совпадать
+ * с оболочкой, построенной по тем же точкам в JSON формате.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void BinaryTestGrahamScan(httplib::Client* cli) {
+  BinaryHelperTest<int>(cli, "int");
+  BinaryHelperTest<float>(cli, "float");
+  BinaryHelperTest<double>(cli, "double");
+
+  // Повреждённое сообщение: размер не соответствует заголовку.
+  std::string message = geometry::WireEncoder<double>(1, 3, 2).Release();
+
+  message.pop_back();
+
+  httplib::Result res = cli->Post("/GrahamScan", message,
+                                  "application/octet-stream");
+
+  REQUIRE_EQUAL(400, res->status);
+}
+
+/**
+ * @brief Сравнение двоичного и JSON форматов для заданного типа.
+ *
+ * @tparam T Тип данных координат.
+ *
+ * @param cli Указатель на HTTP клиент.
+ * @param type Строковое представление типа данных координат.
+ */
+template<typename T>
+static void BinaryHelperTest(httplib::Client* cli, std::string type) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<size_t> arraySize(10, 500);
+  std::uniform_int_distribution<int> elem(-1000, 1000);
+
+  for (int it = 0; it < 10; it++) {
+    size_t size = arraySize(gen);
+    nlohmann::json input;
+    geometry::WireEncoder<T> encoder(it, size, 2);
+
+    input["id"] = it;
+    input["type"] = type;
+    input["size"] = size;
+
+    for (size_t i = 0; i < size; i++) {
+      T x = static_cast<T>(elem(gen)), y = static_cast<T>(elem(gen));
+
+      input["data"][0][i] = x;
+      input["data"][1][i] = y;
+      encoder.Set(0, i, x);
+      encoder.Set(1, i, y);
+    }
+
+    httplib::Result res = cli->Post("/GrahamScan", input.dump(),
+        "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    res = cli->Post("/GrahamScan", encoder.Release(),
+                    "application/octet-stream");
+
+    geometry::WireDecoder decoder;
+
+    REQUIRE_EQUAL(200, res->status);
+    REQUIRE(decoder.Parse(res->body, 2));
+    REQUIRE(decoder.Type() == geometry::WireTypeOf<T>());
+    REQUIRE_EQUAL(static_cast<uint64_t>(it), decoder.Id());
+    REQUIRE_EQUAL(output["size"], decoder.Count());
+
+    for (size_t i = 0; i < decoder.Count(); i++) {
+      REQUIRE(output["data"][0][i] == decoder.Get<T>(0, i));
+      REQUIRE(output["data"][1][i] == decoder.Get<T>(1, i));
+    }
+  }
+}
+
+static void SerializationTestGrahamScan(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<int> coordinate(-1000, 1000);
+  nlohmann::json input;
+
+  input["id"] = 7;
+  input["type"] = "int";
+  input["size"] = 100;
+
+  for (size_t i = 0; i < 100; i++) {
+    input["data"][0][i] = coordinate(gen);
+    input["data"][1][i] = coordinate(gen);
+  }
+
+  httplib::Result res = cli->Post("/GrahamScan", input.dump(),
+                                  "application/json");
+
+  // Для целых координат ответ совпадает с сериализацией nlohmann::json.
+  REQUIRE_EQUAL(200, res->status);
+  REQUIRE_EQUAL(nlohmann::json::parse(res->body).dump(), res->body);
+
+  // Вещественные координаты с фиксированным числом знаков.
+  input = {
+    {"id", 8},
+    {"type", "double"},
+    {"size", 3},
+    {"precision", 2},
+    {"data", { { 0.0, 1.0, 0.0 }, { 0.0, 0.0, 0.5 } } }
+  };
+
+  res = cli->Post("/GrahamScan", input.dump(), "application/json");
+
+  REQUIRE_EQUAL(200, res->status);
+  REQUIRE(res->body.find("0.50") != std::string::npos);
+  REQUIRE(res->body.find("1.00") != std::string::npos);
+  REQUIRE_EQUAL(3, nlohmann::json::parse(res->body)["size"]);
+
+  input["precision"] = -1;
+  res = cli->Post("/GrahamScan", input.dump(), "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
+
+/**
+ * @brief Повторные запросы (сервер отвечает на них из кэша результатов).
+ */
+static void RepeatTestGrahamScan(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_real_distribution<double> coordinate(-1000.0, 1000.0);
+  nlohmann::json input;
+
+  input["id"] = 1;
+  input["type"] = "double";
+  input["size"] = 1000;
+
+  for (size_t i = 0; i < 1000; i++) {
+    input["data"][0][i] = coordinate(gen);
+    input["data"][1][i] = coordinate(gen);
+  }
+
+  std::string body = input.dump();
+  httplib::Result first = cli->Post("/GrahamScan", body, "application/json");
+  httplib::Result second = cli->Post("/GrahamScan", body, "application/json");
+
+  REQUIRE_EQUAL(200, first->status);
+  REQUIRE_EQUAL(200, second->status);
+  REQUIRE_EQUAL(first->body, second->body);
+
+  // Запрос, отличающийся только идентификатором, получает свой ответ.
+  input["id"] = 2;
+
+  httplib::Result other = cli->Post("/GrahamScan", input.dump(),
+                                    "application/json");
+  nlohmann::json output = nlohmann::json::parse(other->body);
+  nlohmann::json expected = nlohmann::json::parse(first->body);
+
+  REQUIRE_EQUAL(200, other->status);
+  REQUIRE_EQUAL(2, output.at("id"));
+  REQUIRE(output.at("data") == expected.at("data"));
+
+  // Ошибочные запросы не кэшируются и повторно возвращают ошибку.
+  input["size"] = 1001;
+  body = input.dump();
+
+  REQUIRE_EQUAL(400, cli->Post("/GrahamScan", body,
+                               "application/json")->status);
+  REQUIRE_EQUAL(400, cli->Post("/GrahamScan", body,
+                               "application/json")->status);
+}
@@ -0,0 +1,193 @@
+/**
+ * @file tests/jobs_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для фоновых задач.
+ */
+
+#include <httplib.h>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+static void SimpleTest(httplib::Client* cli);
+static void CancelTest(httplib::Client* cli);
+static void InvalidTest(httplib::Client* cli);
+
+void TestJobs(httplib::Client* cli) {
+  TestSuite suite("TestJobs");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, CancelTest);
+  RUN_TEST_REMOTE(suite, cli, InvalidTest);
+}
+
+/**
+ * @brief Отправить запрос {"job": id}.
+ *
+ * @param cli Указатель на HTTP клиент.
+ * @param path Адрес запроса.
+ * @param id Идентификатор задачи.
+ */
+static httplib::Result JobRequest(httplib::Client* cli, const char* path,
+                                  uint64_t id) {
+  nlohmann::json input;
+
+  input["job"] = id;
+
+  return cli->Post(path, input.dump(), "application/json");
+}
+
+/**
+ * @brief Дождаться завершения задачи.
+ *
+ * @param cli Указатель на HTTP клиент.
+ * @param id Идентификатор задачи.
+ * @return Последнее полученное состояние задачи.
+ */
+static nlohmann::json WaitJob(httplib::Client* cli, uint64_t id) {
+  nlohmann::json status;
+
+  for (size_t attempt = 0; attempt < 1000; attempt++) {
+    httplib::Result res = JobRequest(cli, "/Jobs/Status", id);
+
+    REQUIRE_EQUAL(200, res->status);
+
+    status = nlohmann::json::parse(res->body);
+
+    if (status["state"] != "queued" && status["state"] != "running")
+      break;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  return status;
+}
+
+/**
+ * @brief Результат фоновой задачи совпадает с ответом синхронного метода.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<int> coordinate(-1000, 1000);
+  nlohmann::json input;
+
+  input["id"] = 5;
+  input["type"] = "int";
+  input["size"] = 1000;
+
+  for (size_t i = 0; i < 1000; i++) {
+    input["data"][0][i] = coordinate(gen);
+    input["data"][1][i] = coordinate(gen);
+  }
+
+  httplib::Result res = cli->Post("/Jobs/GrahamScan", input.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(200, res->status);
+
+  uint64_t id = nlohmann::json::parse(res->body).at("job");
+  nlohmann::json status = WaitJob(cli, id);
+
+  REQUIRE_EQUAL(id, status["job"]);
+  REQUIRE_EQUAL("done", status["state"]);
+  REQUIRE_CLOSE(1.0, status["progress"].get<double>(), 1e-9);
+
+  httplib::Result result = JobRequest(cli, "/Jobs/Result", id);
+  httplib::Result expected = cli->Post("/GrahamScan", input.dump(),
+                                       "application/json");
+
+  REQUIRE_EQUAL(200, result->status);
+  REQUIRE_EQUAL(expected->body, result->body);
+
+  // Результат можно получить повторно.
+  result = JobRequest(cli, "/Jobs/Result", id);
+
+  REQUIRE_EQUAL(200, result->status);
+  REQUIRE_EQUAL(expected->body, result->body);
+}
+
+/**
+ * @brief Отмена задачи.
+ *
+ * Задача может успеть завершиться до отмены, тогда отмена её не меняет.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void CancelTest(httplib::Client* cli) {
+  nlohmann::json input;
+
+  input["id"] = 6;
+  input["type"] = "int";
+  input["size"] = 1;
+  input["data"] = { { { 0, 0 }, { 1, 1 } } };
+
+  httplib::Result res = cli->Post("/Jobs/ContourRectangles", input.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(200, res->status);
+
+  uint64_t id = nlohmann::json::parse(res->body).at("job");
+
+  res = JobRequest(cli, "/Jobs/Cancel", id);
+
+  REQUIRE_EQUAL(200, res->status);
+
+  std::string state = nlohmann::json::parse(res->body).at("state");
+
+  REQUIRE(state == "cancelled" || state == "done");
+
+  state = WaitJob(cli, id).at("state");
+  res = JobRequest(cli, "/Jobs/Result", id);
+
+  if (state == "cancelled") {
+    REQUIRE_EQUAL(410, res->status);
+  } else {
+    REQUIRE_EQUAL("done", state);
+    REQUIRE_EQUAL(200, res->status);
+    REQUIRE_EQUAL(4, nlohmann::json::parse(res->body).at("size"));
+  }
+}
+
+/**
+ * @brief Некорректные запросы и задачи с ошибкой во входных данных.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void InvalidTest(httplib::Client* cli) {
+  nlohmann::json input;
+
+  input["id"] = 7;
+  input["type"] = "int";
+  input["size"] = 3;
+  input["data"] = { { 0, 1 }, { 0, 1 } };
+
+  httplib::Result res = cli->Post("/Jobs/GrahamScan", input.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(200, res->status);
+
+  uint64_t id = nlohmann::json::parse(res->body).at("job");
+
+  REQUIRE_EQUAL("failed", WaitJob(cli, id).at("state"));
+  REQUIRE_EQUAL(400, JobRequest(cli, "/Jobs/Result", id)->status);
+
+  // Неизвестная задача.
+  REQUIRE_EQUAL(404, JobRequest(cli, "/Jobs/Status", 0)->status);
+  REQUIRE_EQUAL(404, JobRequest(cli, "/Jobs/Result", 0)->status);
+  REQUIRE_EQUAL(404, JobRequest(cli, "/Jobs/Cancel", 0)->status);
+
+  // Идентификатор задачи не задан.
+  REQUIRE_EQUAL(400, cli->Post("/Jobs/Status", "{}",
+                               "application/json")->status);
+  REQUIRE_EQUAL(400, cli->Post("/Jobs/Result", "[1]",
+                               "application/json")->status);
+}
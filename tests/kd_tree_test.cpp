@@ -0,0 +1,286 @@
+/**
+ * @file tests/kd_tree_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для k-d дерева.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+#define NUM_TRIES_FOR_RANDOM_TEST 10
+
+static void SimpleTest(httplib::Client* cli);
+static void RandomTest(httplib::Client* cli);
+static void InvalidQueryTest(httplib::Client* cli);
+static void DropTest(httplib::Client* cli);
+
+void TestKdTree(httplib::Client* cli) {
+  TestSuite suite("TestKdTree");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, InvalidQueryTest);
+  RUN_TEST_REMOTE(suite, cli, DropTest);
+}
+
+/**
+ * @brief Простейший статический тест.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  nlohmann::json build = R"(
+  {
+    "id": 1,
+    "type": "int",
+    "name": "simple",
+    "size": 5,
+    "data": [ [0, 10, 0, 10, 5], [0, 0, 10, 10, 5] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/KdTreeBuild", build.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL(5, output["size"]);
+
+  nlohmann::json query = R"(
+  {
+    "id": 2,
+    "type": "int",
+    "name": "simple",
+    "k": 2,
+    "size": 2,
+    "queries": [ [1, 1], [9, 8] ]
+  }
+)"_json;
+
+  res = cli->Post("/KdTreeQuery", query.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(2, output["id"]);
+  REQUIRE_EQUAL("[[2,4],[2,4]]", output["data"].dump());
+
+  query["mode"] = "radius";
+  query["radius"] = 5;
+
+  res = cli->Post("/KdTreeQuery", query.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  std::vector<size_t> second = output["data"][1];
+
+  std::sort(second.begin(), second.end());
+
+  REQUIRE_EQUAL("[2]", output["data"][0].dump());
+  REQUIRE(second == std::vector<size_t>({ 2, 4 }));
+
+  // Число соседей больше числа точек ограничивается размером дерева.
+  query["mode"] = "nearest";
+  query["k"] = 2147483647;
+
+  res = cli->Post("/KdTreeQuery", query.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(200, res->status);
+  REQUIRE_EQUAL(5U, output["data"][0].size());
+  REQUIRE_EQUAL(5U, output["data"][1].size());
+}
+
+/**
+ * @brief Сравнение с полным перебором на случайных данных.
+ *
+ * Проверяются точный поиск, приближённый поиск с погрешностью
+ * (1 + epsilon) и поиск в круге.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void RandomTest(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_real_distribution<double> coordinate(-1000.0, 1000.0);
+  std::uniform_int_distribution<size_t> count(1, 5000);
+  const double epsilon = 0.5;
+
+  for (size_t i = 0; i < NUM_TRIES_FOR_RANDOM_TEST; i++) {
+    size_t size = count(gen);
+    std::vector<double> xs(size), ys(size);
+
+    for (size_t j = 0; j < size; j++) {
+      xs[j] = coordinate(gen);
+      ys[j] = coordinate(gen);
+    }
+
+    nlohmann::json build;
+
+    build["id"] = i;
+    build["type"] = "double";
+    build["name"] = "random";
+    build["threads"] = 4;
+    build["size"] = size;
+    build["data"] = { xs, ys };
+
+    httplib::Result res = cli->Post("/KdTreeBuild", build.dump(),
+                                    "application/json");
+
+    REQUIRE_EQUAL(200, res->status);
+
+    const size_t queries = 100;
+    const size_t k = 5;
+    std::vector<double> qx(queries), qy(queries);
+
+    for (size_t j = 0; j < queries; j++) {
+      qx[j] = coordinate(gen);
+      qy[j] = coordinate(gen);
+    }
+
+    nlohmann::json query;
+
+    query["id"] = i;
+    query["type"] = "double";
+    query["name"] = "random";
+    query["k"] = k;
+    query["size"] = queries;
+    query["queries"] = { qx, qy };
+
+    res = cli->Post("/KdTreeQuery", query.dump(), "application/json");
+
+    nlohmann::json exact = nlohmann::json::parse(res->body);
+
+    query["epsilon"] = epsilon;
+    res = cli->Post("/KdTreeQuery", query.dump(), "application/json");
+
+    nlohmann::json approximate = nlohmann::json::parse(res->body);
+
+    query["mode"] = "radius";
+    query["radius"] = 50.0;
+    res = cli->Post("/KdTreeQuery", query.dump(), "application/json");
+
+    nlohmann::json radius = nlohmann::json::parse(res->body);
+
+    for (size_t j = 0; j < queries; j++) {
+      std::vector<double> distances(size);
+      std::vector<size_t> expected;
+
+      for (size_t p = 0; p < size; p++) {
+        distances[p] = std::hypot(xs[p] - qx[j], ys[p] - qy[j]);
+
+        if (distances[p] <= 50.0)
+          expected.push_back(p);
+      }
+
+      std::vector<double> sorted = distances;
+
+      std::sort(sorted.begin(), sorted.end());
+
+      REQUIRE_EQUAL(std::min(size, k), exact["data"][j].size());
+      REQUIRE_EQUAL(std::min(size, k), approximate["data"][j].size());
+
+      for (size_t p = 0; p < exact["data"][j].size(); p++) {
+        size_t e = exact["data"][j][p];
+        size_t a = approximate["data"][j][p];
+
+        REQUIRE_CLOSE(sorted[p], distances[e], 1e-9);
+        REQUIRE(distances[a] <= (1 + epsilon) * sorted[p] + 1e-9);
+      }
+
+      std::vector<size_t> found = radius["data"][j];
+
+      std::sort(found.begin(), found.end());
+
+      REQUIRE(found == expected);
+    }
+  }
+}
+
+/**
+ * @brief Некорректные запросы.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void InvalidQueryTest(httplib::Client* cli) {
+  nlohmann::json query = R"(
+  {
+    "id": 3,
+    "type": "float",
+    "name": "missing",
+    "size": 1,
+    "queries": [ [0], [0] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/KdTreeQuery", query.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+
+  query["type"] = "int";
+  query["name"] = "simple";
+  query["mode"] = "radius";
+  query["radius"] = -1;
+
+  res = cli->Post("/KdTreeQuery", query.dump(), "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
+
+/**
+ * @brief Удаление дерева.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void DropTest(httplib::Client* cli) {
+  nlohmann::json build = R"(
+  {
+    "id": 4,
+    "type": "double",
+    "name": "drop",
+    "size": 2,
+    "data": [ [0, 1], [0, 1] ]
+  }
+)"_json;
+  nlohmann::json query = R"(
+  {
+    "id": 5,
+    "type": "double",
+    "name": "drop",
+    "size": 1,
+    "queries": [ [0], [0] ]
+  }
+)"_json;
+  nlohmann::json drop = R"(
+  {
+    "id": 6,
+    "type": "double",
+    "name": "drop"
+  }
+)"_json;
+
+  REQUIRE_EQUAL(200, cli->Post("/KdTreeBuild", build.dump(),
+                               "application/json")->status);
+  REQUIRE_EQUAL(200, cli->Post("/KdTreeQuery", query.dump(),
+                               "application/json")->status);
+
+  httplib::Result res = cli->Post("/KdTreeDrop", drop.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(6, output["id"]);
+  REQUIRE_EQUAL(true, output["dropped"]);
+  REQUIRE_EQUAL(400, cli->Post("/KdTreeQuery", query.dump(),
+                               "application/json")->status);
+
+  res = cli->Post("/KdTreeDrop", drop.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(false, output["dropped"]);
+}
@@ -42,6 +42,23 @@ int main(int argc, char* argv[]) {
 
   TestContourRectangles(&cli);
   TestGrahamScan(&cli);
+  TestClipPolygons(&cli);
+  TestRTree(&cli);
+  TestPointIndex(&cli);
+  TestKdTree(&cli);
+  TestDelaunay(&cli);
+  TestTriangulatePolygon(&cli);
+  TestClosestPair(&cli);
+  TestMinkowskiSum(&cli);
+  TestConvexIntersection(&cli);
+  TestConvexLocator(&cli);
+  TestSimplifyPolyline(&cli);
+  TestRectangleIntersections(&cli);
+  TestCoverageDepth(&cli);
+  TestRectangleComponents(&cli);
+  TestBatch(&cli);
+  TestJobs(&cli);
+  TestMetrics(&cli);
 
   /* Конец вставки. */
 
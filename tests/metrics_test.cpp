@@ -0,0 +1,165 @@
+/**
+ * @file tests/metrics_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для счётчиков запросов /metrics.
+ */
+
+#include <httplib.h>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+static void SimpleTest(httplib::Client* cli);
+static void ErrorTest(httplib::Client* cli);
+static void FormatTest(httplib::Client* cli);
+
+void TestMetrics(httplib::Client* cli) {
+  TestSuite suite("TestMetrics");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, ErrorTest);
+  RUN_TEST_REMOTE(suite, cli, FormatTest);
+}
+
+/**
+ * @brief Прочитать значение счётчика из ответа /metrics.
+ *
+ * @param cli Указатель на HTTP клиент.
+ * @param series Название счётчика вместе с метками.
+ * @return Значение счётчика или 0, если счётчика ещё нет.
+ */
+static uint64_t ReadCounter(httplib::Client* cli, const std::string& series) {
+  httplib::Result res = cli->Get("/metrics");
+
+  REQUIRE_EQUAL(200, res->status);
+
+  std::istringstream stream(res->body);
+  std::string line;
+
+  while (std::getline(stream, line)) {
+    if (line.compare(0, series.size() + 1, series + " ") == 0)
+      return std::stoull(line.substr(series.size() + 1));
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Каждый запрос увеличивает счётчик своего метода и типа.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  const std::string labels = "{method=\"/GrahamScan\",type=\"int\"}";
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "type": "int",
+    "size": 4,
+    "data": [ [0, 3, 3, 0], [0, 0, 3, 3] ]
+  }
+)"_json;
+
+  uint64_t before = ReadCounter(cli, "geometry_requests_total" + labels);
+
+  // Разные "id" нужны, чтобы ответы не брались из кэша.
+  for (int i = 0; i < 3; i++) {
+    input["id"] = 100 + i;
+
+    REQUIRE_EQUAL(200, cli->Post("/GrahamScan", input.dump(),
+                                 "application/json")->status);
+  }
+
+  REQUIRE_EQUAL(before + 3,
+                ReadCounter(cli, "geometry_requests_total" + labels));
+
+  // Каждый запрос прошёл все три этапа.
+  for (const char* phase : { "parse", "compute", "serialize" }) {
+    std::string series = "geometry_request_phase_seconds_count"
+                         "{method=\"/GrahamScan\",type=\"int\",phase=\"" +
+                         std::string(phase) + "\"}";
+
+    REQUIRE(ReadCounter(cli, series) >= 3);
+  }
+}
+
+/**
+ * @brief Ошибки во входных данных учитываются отдельно.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void ErrorTest(httplib::Client* cli) {
+  const std::string labels = "{method=\"/ContourRectangles\",type=\"int\"}";
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "type": "int",
+    "size": 2,
+    "data": [ [ [0, 0], [1, 1] ] ]
+  }
+)"_json;
+
+  uint64_t before = ReadCounter(cli,
+                                "geometry_request_errors_total" + labels);
+
+  REQUIRE_EQUAL(400, cli->Post("/ContourRectangles", input.dump(),
+                               "application/json")->status);
+  REQUIRE_EQUAL(before + 1,
+                ReadCounter(cli, "geometry_request_errors_total" + labels));
+
+  // Тип, которого нет в списке известных, не создаёт новый ряд счётчиков.
+  input["type"] = "complex";
+
+  REQUIRE_EQUAL(400, cli->Post("/ContourRectangles", input.dump(),
+                               "application/json")->status);
+
+  std::string body = cli->Get("/metrics")->body;
+
+  REQUIRE(body.find("type=\"complex\"") == std::string::npos);
+  REQUIRE(body.find("method=\"/ContourRectangles\",type=\"unknown\"") !=
+          std::string::npos);
+}
+
+/**
+ * @brief Корзины гистограмм накопленные и заканчиваются корзиной +Inf,
+ * равной числу значений. Границы корзин записаны точно.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void FormatTest(httplib::Client* cli) {
+  const std::string labels = "method=\"/GrahamScan\",type=\"int\"";
+  std::string body = cli->Get("/metrics")->body;
+  std::istringstream stream(body);
+  std::string line, prefix = "geometry_request_bytes_bucket{" + labels;
+  uint64_t previous = 0, last = 0;
+  size_t buckets = 0;
+
+  REQUIRE(body.find("# TYPE geometry_request_bytes histogram") !=
+          std::string::npos);
+
+  while (std::getline(stream, line)) {
+    if (line.compare(0, prefix.size(), prefix) != 0)
+      continue;
+
+    last = std::stoull(line.substr(line.rfind(' ') + 1));
+
+    REQUIRE(last >= previous);
+
+    previous = last;
+    buckets++;
+  }
+
+  REQUIRE(buckets > 1);
+  REQUIRE(body.find(prefix + ",le=\"+Inf\"} ") != std::string::npos);
+
+  // Границы и суммы записываются без потери точности.
+  REQUIRE(body.find(prefix + ",le=\"1048576\"} ") != std::string::npos);
+  REQUIRE(body.find(prefix + ",le=\"1073741824\"} ") != std::string::npos);
+  REQUIRE(body.find("e+") == std::string::npos);
+  REQUIRE_EQUAL(last, ReadCounter(cli, "geometry_request_bytes_count{" +
+                                       labels + "}"));
+}
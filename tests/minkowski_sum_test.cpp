@@ -0,0 +1,225 @@
+/**
+ * @file tests/minkowski_sum_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для суммы Минковского выпуклых многоугольников.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+#define NUM_TRIES_FOR_RANDOM_TEST 10
+
+//! Вершина многоугольника с целыми координатами.
+using Vertex = std::pair<int64_t, int64_t>;
+
+static void SimpleTest(httplib::Client* cli);
+static void RandomTest(httplib::Client* cli);
+static void NonConvexTest(httplib::Client* cli);
+
+static std::vector<Vertex> ConvexHull(std::vector<Vertex> points);
+
+void TestMinkowskiSum(httplib::Client* cli) {
+  TestSuite suite("TestMinkowskiSum");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, NonConvexTest);
+}
+
+/**
+ * @brief Простейший статический тест.
+ *
+ * Квадрат складывается с треугольником и с самим собой. Параллельные
+ * стороны квадратов сливаются в одно ребро.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "type": "int",
+    "polygon": [ [0, 1, 1, 0], [0, 0, 1, 1] ],
+    "size": 2,
+    "data": [
+      [ [0, 2, 0], [0, 0, 2] ],
+      [ [1, 1, 0, 0], [1, 0, 0, 1] ]
+    ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/MinkowskiSum", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL(2, output["size"]);
+  REQUIRE_EQUAL("[[0,3,3,1,0],[0,0,1,3,3]]", output["data"][0].dump());
+  REQUIRE_EQUAL("[[0,2,2,0],[0,0,2,2]]", output["data"][1].dump());
+}
+
+/**
+ * @brief Сравнение с выпуклой оболочкой всех попарных сумм вершин.
+ *
+ * Многоугольники задаются по часовой стрелке и начинаются с
+ * произвольной вершины.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void RandomTest(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<int> coordinate(-1000, 1000);
+  std::uniform_int_distribution<size_t> count(3, 200);
+
+  auto randomPolygon = [&]() {
+    std::vector<Vertex> hull;
+
+    while (hull.size() < 3) {
+      std::vector<Vertex> points(count(gen));
+
+      for (Vertex& point : points)
+        point = Vertex(coordinate(gen), coordinate(gen));
+
+      hull = ConvexHull(points);
+    }
+
+    std::reverse(hull.begin(), hull.end());
+    std::rotate(hull.begin(), hull.begin() + gen() % hull.size(), hull.end());
+
+    return hull;
+  };
+
+  auto toJson = [](const std::vector<Vertex>& polygon) {
+    nlohmann::json result = { nlohmann::json::array(),
+                              nlohmann::json::array() };
+
+    for (const Vertex& vertex : polygon) {
+      result[0].push_back(vertex.first);
+      result[1].push_back(vertex.second);
+    }
+
+    return result;
+  };
+
+  for (size_t i = 0; i < NUM_TRIES_FOR_RANDOM_TEST; i++) {
+    const size_t size = 20;
+    std::vector<Vertex> polygon = randomPolygon();
+    nlohmann::json input;
+
+    input["id"] = i;
+    input["type"] = "int";
+    input["threads"] = 4;
+    input["polygon"] = toJson(polygon);
+    input["size"] = size;
+
+    std::vector<std::vector<Vertex>> others(size);
+
+    for (size_t j = 0; j < size; j++) {
+      others[j] = randomPolygon();
+      input["data"].push_back(toJson(others[j]));
+    }
+
+    httplib::Result res = cli->Post("/MinkowskiSum", input.dump(),
+                                    "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    REQUIRE_EQUAL(size, output["data"].size());
+
+    for (size_t j = 0; j < size; j++) {
+      std::vector<Vertex> sums;
+
+      for (const Vertex& a : polygon) {
+        for (const Vertex& b : others[j])
+          sums.emplace_back(a.first + b.first, a.second + b.second);
+      }
+
+      std::vector<Vertex> expected = ConvexHull(sums);
+      std::vector<Vertex> actual;
+      const nlohmann::json& data = output["data"][j];
+
+      for (size_t k = 0; k < data[0].size(); k++)
+        actual.emplace_back(data[0][k], data[1][k]);
+
+      // Ответ ориентирован по часовой стрелке, как исходный многоугольник.
+      std::reverse(actual.begin(), actual.end());
+      std::rotate(actual.begin(),
+                  std::min_element(actual.begin(), actual.end()),
+                  actual.end());
+
+      REQUIRE(actual == expected);
+    }
+  }
+}
+
+/**
+ * @brief Невыпуклое слагаемое.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void NonConvexTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 3,
+    "type": "double",
+    "polygon": [ [0, 2, 1, 2, 0], [0, 0, 1, 2, 2] ],
+    "size": 1,
+    "data": [ [ [0, 1, 0], [0, 0, 1] ] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/MinkowskiSum", input.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
+
+/**
+ * @brief Построить выпуклую оболочку алгоритмом Эндрю.
+ *
+ * @param points Набор точек.
+ * @return Вершины оболочки против часовой стрелки без точек на сторонах,
+ * начиная с наименьшей в лексикографическом порядке.
+ */
+static std::vector<Vertex> ConvexHull(std::vector<Vertex> points) {
+  auto cross = [](const Vertex& o, const Vertex& a, const Vertex& b) {
+    return (a.first - o.first) * (b.second - o.second) -
+           (a.second - o.second) * (b.first - o.first);
+  };
+
+  std::sort(points.begin(), points.end());
+  points.erase(std::unique(points.begin(), points.end()), points.end());
+
+  if (points.size() < 3)
+    return points;
+
+  std::vector<Vertex> hull(2 * points.size());
+  size_t k = 0;
+
+  for (size_t i = 0; i < points.size(); i++) {
+    while (k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0)
+      k--;
+
+    hull[k++] = points[i];
+  }
+
+  for (size_t i = points.size() - 1, lower = k + 1; i > 0; i--) {
+    while (k >= lower && cross(hull[k - 2], hull[k - 1], points[i - 1]) <= 0)
+      k--;
+
+    hull[k++] = points[i - 1];
+  }
+
+  hull.resize(k - 1);
+
+  return hull;
+}
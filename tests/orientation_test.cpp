@@ -5,6 +5,7 @@
  * Тесты для функции geometry::Orientation().
  */
 
+#include <cstdint>
 #include <limits>
 #include <point.hpp>
 #include <orientation.hpp>
@@ -18,6 +19,9 @@ using geometry::Orientation;
 template<typename T>
 static void BuildTest();
 
+template<typename T>
+static void IntegerTest();
+
 /**
  * @brief Набор тестов для функции geometry::Orientation().
  */
@@ -27,6 +31,8 @@ void TestOrientation() {
   RUN_TEST(suite, BuildTest<float>);
   RUN_TEST(suite, BuildTest<double>);
   RUN_TEST(suite, BuildTest<long double>);
+  RUN_TEST(suite, IntegerTest<int>);
+  RUN_TEST(suite, IntegerTest<std::int64_t>);
 }
 
 /**
@@ -45,3 +51,47 @@ static void BuildTest() {
     REQUIRE_EQUAL(Orientation(p0, p1, p2, eps), 1);
   }
 }
+
+/**
+ * @brief Тесты целочисленной специализации функции geometry::Orientation().
+ *
+ * @tparam T Целочисленный тип данных, используемый для арифметики.
+ */
+template<typename T>
+static void IntegerTest() {
+  {
+    constexpr Point<T> p0(T(0), T(0));
+    constexpr Point<T> p1(T(1), T(0));
+    constexpr Point<T> p2(T(0), T(1));
+
+    static_assert(Orientation(p0, p1, p2, T(0)) == 1);
+    static_assert(Orientation(p0, p2, p1, T(0)) == -1);
+    static_assert(Orientation(p0, p1, Point<T>(T(7), T(0)), T(0)) == 0);
+  }
+
+  {
+    // Векторное произведение порядка 2^64 для int и 2^124 для std::int64_t.
+    const T big = std::numeric_limits<T>::max() / 4;
+
+    REQUIRE_EQUAL(Orientation(Point<T>(-big, -big), Point<T>(big, big),
+                              Point<T>(big - 1, big), T(0)), 1);
+    REQUIRE_EQUAL(Orientation(Point<T>(-big, -big), Point<T>(big, big),
+                              Point<T>(big, big - 1), T(0)), -1);
+    REQUIRE_EQUAL(Orientation(Point<T>(-big, -big), Point<T>(big, big),
+                              Point<T>(T(3), T(3)), T(0)), 0);
+  }
+
+  {
+    // Переносимая реализация без 128-битного типа.
+    const std::int64_t big = std::numeric_limits<std::int64_t>::max() / 2;
+
+    REQUIRE_EQUAL(geometry::detail::PortableProductDifferenceSign(
+        big, big, big - 1, big + 1), 1);
+    REQUIRE_EQUAL(geometry::detail::PortableProductDifferenceSign(
+        -big, big, big, -big), 0);
+    REQUIRE_EQUAL(geometry::detail::PortableProductDifferenceSign(
+        -big, big, -big + 1, big), -1);
+    REQUIRE_EQUAL(geometry::detail::PortableProductDifferenceSign(
+        0, big, -1, 1), 1);
+  }
+}
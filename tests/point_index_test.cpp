@@ -0,0 +1,274 @@
+/**
+ * @file tests/point_index_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для индекса точек.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+#define NUM_TRIES_FOR_RANDOM_TEST 10
+
+static void SimpleTest(httplib::Client* cli);
+static void RandomTest(httplib::Client* cli);
+static void MissingDatasetTest(httplib::Client* cli);
+static void DropTest(httplib::Client* cli);
+
+template<typename T, typename Distribution>
+static void RandomHelperTest(httplib::Client* cli, std::string type,
+                             std::string kind, Distribution coordinate);
+
+void TestPointIndex(httplib::Client* cli) {
+  TestSuite suite("TestPointIndex");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, MissingDatasetTest);
+  RUN_TEST_REMOTE(suite, cli, DropTest);
+}
+
+/**
+ * @brief Простейший статический тест.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  for (std::string kind : { "quadtree", "grid" }) {
+    nlohmann::json build = R"(
+    {
+      "id": 1,
+      "type": "int",
+      "name": "simple",
+      "bucket": 1,
+      "size": 5,
+      "data": [ [0, 1, 2, 3, 4], [0, 3, 1, 4, 2] ]
+    }
+)"_json;
+
+    build["kind"] = kind;
+
+    httplib::Result res = cli->Post("/PointIndexBuild", build.dump(),
+                                    "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    REQUIRE_EQUAL(1, output["id"]);
+    REQUIRE_EQUAL(5, output["size"]);
+    REQUIRE_EQUAL(kind, output["kind"]);
+
+    nlohmann::json query = R"(
+    {
+      "id": 2,
+      "type": "int",
+      "name": "simple",
+      "size": 3,
+      "queries": [ [[1, 1], [3, 3]], [[0, 0], [4, 4]], [[5, 5], [6, 6]] ]
+    }
+)"_json;
+
+    res = cli->Post("/PointIndexQuery", query.dump(), "application/json");
+    output = nlohmann::json::parse(res->body);
+
+    std::vector<size_t> first = output["data"][0];
+    std::vector<size_t> second = output["data"][1];
+
+    std::sort(first.begin(), first.end());
+    std::sort(second.begin(), second.end());
+
+    REQUIRE(first == std::vector<size_t>({ 1, 2 }));
+    REQUIRE(second == std::vector<size_t>({ 0, 1, 2, 3, 4 }));
+    REQUIRE_EQUAL(0U, output["data"][2].size());
+
+    query["mode"] = "count";
+
+    res = cli->Post("/PointIndexQuery", query.dump(), "application/json");
+    output = nlohmann::json::parse(res->body);
+
+    REQUIRE_EQUAL("[2,5,0]", output["data"].dump());
+  }
+}
+
+/**
+ * @brief Сравнение с полным перебором на случайных данных.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void RandomTest(httplib::Client* cli) {
+  for (std::string kind : { "quadtree", "grid" }) {
+    RandomHelperTest<int>(cli, "int", kind,
+                          std::uniform_int_distribution<int>(-50, 50));
+    RandomHelperTest<double>(cli, "double", kind,
+                             std::uniform_real_distribution<double>(-1e3,
+                                                                    1e3));
+  }
+}
+
+/**
+ * @brief Сравнение с полным перебором для заданного типа координат.
+ *
+ * @tparam T Тип данных координат.
+ * @tparam Distribution Тип распределения координат.
+ *
+ * @param cli Указатель на HTTP клиент.
+ * @param type Строковое представление типа данных координат.
+ * @param kind Вид индекса.
+ * @param coordinate Распределение координат.
+ *
+ * Целочисленные координаты берутся из маленького диапазона, поэтому
+ * в наборе много совпадающих точек и точек на границах запросов.
+ */
+template<typename T, typename Distribution>
+static void RandomHelperTest(httplib::Client* cli, std::string type,
+                             std::string kind, Distribution coordinate) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<size_t> count(0, 3000);
+
+  for (size_t i = 0; i < NUM_TRIES_FOR_RANDOM_TEST; i++) {
+    size_t size = count(gen);
+    std::vector<T> xs(size), ys(size);
+
+    for (size_t j = 0; j < size; j++) {
+      xs[j] = coordinate(gen);
+      ys[j] = coordinate(gen);
+    }
+
+    nlohmann::json build;
+
+    build["id"] = i;
+    build["type"] = type;
+    build["name"] = "random";
+    build["kind"] = kind;
+    build["size"] = size;
+    build["data"] = { xs, ys };
+
+    httplib::Result res = cli->Post("/PointIndexBuild", build.dump(),
+                                    "application/json");
+
+    REQUIRE_EQUAL(200, res->status);
+
+    const size_t queries = 100;
+    nlohmann::json query;
+
+    query["id"] = i;
+    query["type"] = type;
+    query["name"] = "random";
+    query["size"] = queries;
+    query["threads"] = 4;
+
+    for (size_t j = 0; j < queries; j++) {
+      T x1 = coordinate(gen), x2 = coordinate(gen);
+      T y1 = coordinate(gen), y2 = coordinate(gen);
+
+      query["queries"][j] = { { x1, y1 }, { x2, y2 } };
+    }
+
+    res = cli->Post("/PointIndexQuery", query.dump(), "application/json");
+
+    nlohmann::json reports = nlohmann::json::parse(res->body);
+
+    query["mode"] = "count";
+    res = cli->Post("/PointIndexQuery", query.dump(), "application/json");
+
+    nlohmann::json counts = nlohmann::json::parse(res->body);
+
+    for (size_t j = 0; j < queries; j++) {
+      T x1 = query["queries"][j][0][0], y1 = query["queries"][j][0][1];
+      T x2 = query["queries"][j][1][0], y2 = query["queries"][j][1][1];
+      std::vector<size_t> expected;
+
+      for (size_t k = 0; k < size; k++) {
+        if (std::min(x1, x2) <= xs[k] && xs[k] <= std::max(x1, x2) &&
+            std::min(y1, y2) <= ys[k] && ys[k] <= std::max(y1, y2))
+          expected.push_back(k);
+      }
+
+      std::vector<size_t> report = reports["data"][j];
+
+      std::sort(report.begin(), report.end());
+
+      REQUIRE(report == expected);
+      REQUIRE_EQUAL(expected.size(), counts["data"][j].get<size_t>());
+    }
+  }
+}
+
+/**
+ * @brief Запрос к несуществующему индексу.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void MissingDatasetTest(httplib::Client* cli) {
+  nlohmann::json query = R"(
+  {
+    "id": 3,
+    "type": "long double",
+    "name": "missing",
+    "size": 1,
+    "queries": [ [[0, 0], [1, 1]] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/PointIndexQuery", query.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
+
+/**
+ * @brief Удаление индекса.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void DropTest(httplib::Client* cli) {
+  nlohmann::json build = R"(
+  {
+    "id": 4,
+    "type": "double",
+    "name": "drop",
+    "size": 2,
+    "data": [ [0, 1], [0, 1] ]
+  }
+)"_json;
+  nlohmann::json query = R"(
+  {
+    "id": 5,
+    "type": "double",
+    "name": "drop",
+    "size": 1,
+    "queries": [ [[0, 0], [1, 1]] ]
+  }
+)"_json;
+  nlohmann::json drop = R"(
+  {
+    "id": 6,
+    "type": "double",
+    "name": "drop"
+  }
+)"_json;
+
+  REQUIRE_EQUAL(200, cli->Post("/PointIndexBuild", build.dump(),
+                               "application/json")->status);
+  REQUIRE_EQUAL(200, cli->Post("/PointIndexQuery", query.dump(),
+                               "application/json")->status);
+
+  httplib::Result res = cli->Post("/PointIndexDrop", drop.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(6, output["id"]);
+  REQUIRE_EQUAL(true, output["dropped"]);
+  REQUIRE_EQUAL(400, cli->Post("/PointIndexQuery", query.dump(),
+                               "application/json")->status);
+
+  res = cli->Post("/PointIndexDrop", drop.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(false, output["dropped"]);
+}
@@ -5,6 +5,7 @@
  * Тесты для класса Point.
  */
 
+#include <cstdint>
 #include <limits>
 #include <point.hpp>
 #include <edge.hpp>
@@ -19,6 +20,9 @@ using geometry::Position;
 template<typename T>
 static void BuildTest();
 
+template<typename T>
+static void IntegerTest();
+
 /**
  * @brief Набор тестов для класса geometry::Point.
  */
@@ -28,6 +32,8 @@ void TestPoint() {
   RUN_TEST(suite, BuildTest<float>);
   RUN_TEST(suite, BuildTest<double>);
   RUN_TEST(suite, BuildTest<long double>);
+  RUN_TEST(suite, IntegerTest<int>);
+  RUN_TEST(suite, IntegerTest<std::int64_t>);
 }
 
 /**
@@ -150,3 +156,68 @@ static void BuildTest() {
     REQUIRE_CLOSE(result.Y(), T(12.0), eps);
   }
 }
+
+/**
+ * @brief Тест целочисленной специализации класса точки.
+ *
+ * @tparam T Целочисленный тип данных, используемый для арифметики.
+ */
+template<typename T>
+static void IntegerTest() {
+  {
+    constexpr Point<T> p1(T(1), T(2));
+    constexpr Point<T> p2(T(3), T(5));
+    constexpr Point<T> sum = p1 + p2;
+    constexpr Point<T> difference = p2 - p1;
+
+    static_assert(sum.X() == T(4) && sum.Y() == T(7));
+    static_assert(difference.X() == T(2) && difference.Y() == T(3));
+    static_assert(p1 * p2 == T(13));
+    static_assert((T(2) * p1).Y() == T(4));
+    static_assert(p1 < p2 && p2 > p1);
+    static_assert(Point<T>::IsEqual(p1, Point<T>(T(1), T(2)), T(0)));
+    static_assert(!Point<T>::IsEqual(p1, p2, T(0)));
+  }
+
+  {
+    constexpr Point<T> p0(T(1), T(1));
+    constexpr Point<T> p1(T(5), T(5));
+
+    static_assert(Point<T>(T(3), T(3)).Classify(p0, p1, T(0)) ==
+                  Position::Between);
+    static_assert(Point<T>(T(0), T(5)).Classify(p0, p1, T(0)) ==
+                  Position::Left);
+    static_assert(Point<T>(T(5), T(0)).Classify(p0, p1, T(0)) ==
+                  Position::Right);
+    static_assert(Point<T>(T(7), T(7)).Classify(p0, p1, T(0)) ==
+                  Position::Beyond);
+    static_assert(Point<T>(T(-1), T(-1)).Classify(p0, p1, T(0)) ==
+                  Position::Behind);
+    static_assert(Point<T>(T(1), T(1)).Classify(p0, p1, T(0)) ==
+                  Position::Origin);
+    static_assert(Point<T>(T(5), T(5)).Classify(p0, p1, T(0)) ==
+                  Position::Destination);
+  }
+
+  {
+    // Произведения координат не помещаются в 64 бита, но классификация
+    // должна оставаться точной.
+    const T big = std::numeric_limits<T>::max() / 4;
+    Point<T> p0(-big, -big);
+    Point<T> p1(big, big - 1);
+    Point<T> p2(big - 1, big);
+
+    REQUIRE(p2.Classify(p0, p1, T(0)) == Position::Left);
+    REQUIRE(p1.Classify(p0, p2, T(0)) == Position::Right);
+    REQUIRE(Point<T>(T(0), T(0)).Classify(Point<T>(-big, -big),
+                                          Point<T>(big, big), T(0)) ==
+            Position::Between);
+  }
+
+  {
+    Point<T> p(T(0), T(3));
+
+    REQUIRE_EQUAL(p.PolarAngle(T(0)), T(90));
+    REQUIRE_EQUAL(Point<T>().PolarAngle(T(0)), T(-1));
+  }
+}
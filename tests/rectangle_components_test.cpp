@@ -0,0 +1,245 @@
+/**
+ * @file tests/rectangle_components_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для поиска компонент связности объединения
+ * прямоугольников.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+#define NUM_TRIES_FOR_RANDOM_TEST 10
+
+static void SimpleTest(httplib::Client* cli);
+static void ContourTest(httplib::Client* cli);
+static void RandomTest(httplib::Client* cli);
+static void InvalidTest(httplib::Client* cli);
+
+void TestRectangleComponents(httplib::Client* cli) {
+  TestSuite suite("TestRectangleComponents");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, ContourTest);
+  RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, InvalidTest);
+}
+
+/**
+ * @brief Кольцо из четырёх прямоугольников с островом внутри и два
+ * прямоугольника, касающиеся углом.
+ */
+static const char* kSimpleInput = R"(
+  {
+    "id": 1,
+    "type": "int",
+    "size": 7,
+    "data": [
+      [ [0, 0], [6, 1] ],
+      [ [0, 5], [6, 6] ],
+      [ [0, 0], [1, 6] ],
+      [ [5, 0], [6, 6] ],
+      [ [2, 2], [4, 4] ],
+      [ [10, 10], [11, 11] ],
+      [ [11, 11], [12, 12] ]
+    ]
+  }
+)";
+
+/**
+ * @brief Простейший статический тест.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  nlohmann::json input = nlohmann::json::parse(kSimpleInput);
+
+  httplib::Result res = cli->Post("/RectangleComponents", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL(3, output["size"]);
+  REQUIRE(output["components"] ==
+          nlohmann::json({ 0, 0, 0, 0, 4, 5, 5 }));
+  REQUIRE(output["holes"] ==
+          nlohmann::json({ { 0, 1 }, { 4, 0 }, { 5, 0 } }));
+}
+
+/**
+ * @brief Компоненты, вычисленные за один проход с контуром.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void ContourTest(httplib::Client* cli) {
+  nlohmann::json input = nlohmann::json::parse(kSimpleInput);
+
+  httplib::Result res = cli->Post("/ContourRectangles", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE(!output.contains("components"));
+
+  input["components"] = true;
+
+  res = cli->Post("/ContourRectangles", input.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE(output["components"] ==
+          nlohmann::json({ 0, 0, 0, 0, 4, 5, 5 }));
+  REQUIRE(output["holes"] ==
+          nlohmann::json({ { 0, 1 }, { 4, 0 }, { 5, 0 } }));
+
+  input["scale"] = 1;
+
+  res = cli->Post("/ContourRectangles", input.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE(output["components"] ==
+          nlohmann::json({ 0, 0, 0, 0, 4, 5, 5 }));
+  REQUIRE(output["holes"] ==
+          nlohmann::json({ { 0, 1 }, { 4, 0 }, { 5, 0 } }));
+}
+
+/**
+ * @brief Сравнение с поиском в ширину по сетке.
+ *
+ * Координаты удваиваются, чтобы между соседними целыми точками
+ * появились точки сетки. Тогда замкнутые прямоугольники связаны тогда
+ * и только тогда, когда покрытые узлы сетки связаны по сторонам,
+ * а дыры компоненты --- это ограниченные связные по сторонам области
+ * узлов, не покрытых этой компонентой.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void RandomTest(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<int> coordinate(0, 30);
+  std::uniform_int_distribution<int> length(0, 6);
+  const int side = 2 * 36 + 3;
+
+  // Пометить связную по сторонам область, содержащую start.
+  auto fill = [&](const std::vector<int>& cells, int value, int start,
+                  std::vector<int>* mark) {
+    std::queue<int> queue;
+
+    queue.push(start);
+    (*mark)[start] = value;
+
+    while (!queue.empty()) {
+      int x = queue.front() / side, y = queue.front() % side;
+      const int shifts[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+
+      queue.pop();
+
+      for (const int* shift : shifts) {
+        int nx = x + shift[0], ny = y + shift[1];
+
+        if (nx < 0 || ny < 0 || nx >= side || ny >= side)
+          continue;
+
+        int next = nx * side + ny;
+
+        if ((*mark)[next] < 0 && cells[next] == cells[start]) {
+          (*mark)[next] = value;
+          queue.push(next);
+        }
+      }
+    }
+  };
+
+  for (size_t i = 0; i < NUM_TRIES_FOR_RANDOM_TEST; i++) {
+    const size_t size = 60;
+    nlohmann::json input;
+    std::vector<std::vector<int>> rectangles;
+    std::vector<int> owner(side * side, -1);
+
+    input["id"] = i;
+    input["type"] = i % 2 ? "int" : "double";
+    input["size"] = size;
+
+    for (size_t j = 0; j < size; j++) {
+      int x = coordinate(gen), y = coordinate(gen);
+      int w = length(gen), h = length(gen);
+
+      rectangles.push_back({ x, y, x + w, y + h });
+      input["data"][j] = { { x, y }, { x + w, y + h } };
+
+      for (int cx = 2 * x; cx <= 2 * (x + w); cx++)
+        for (int cy = 2 * y; cy <= 2 * (y + h); cy++)
+          owner[(cx + 1) * side + cy + 1] = 0;
+    }
+
+    std::vector<int> label(side * side, -1);
+    std::vector<int> expected(size);
+
+    for (size_t j = 0; j < size; j++) {
+      int start = (2 * rectangles[j][0] + 1) * side + 2 * rectangles[j][1] + 1;
+
+      if (label[start] < 0)
+        fill(owner, static_cast<int>(j), start, &label);
+
+      expected[j] = label[start];
+    }
+
+    std::vector<std::pair<int, int>> holes;
+
+    for (size_t j = 0; j < size; j++) {
+      if (expected[j] != static_cast<int>(j))
+        continue;
+
+      std::vector<int> cells(side * side, 0);
+      std::vector<int> region(side * side, -1);
+      int count = 0;
+
+      for (int cell = 0; cell < side * side; cell++)
+        cells[cell] = label[cell] == expected[j] ? 1 : 0;
+
+      fill(cells, 0, 0, &region);
+
+      for (int cell = 0; cell < side * side; cell++) {
+        if (cells[cell] == 0 && region[cell] < 0)
+          fill(cells, ++count, cell, &region);
+      }
+
+      holes.emplace_back(static_cast<int>(j), count);
+    }
+
+    httplib::Result res = cli->Post("/RectangleComponents", input.dump(),
+                                    "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    REQUIRE_EQUAL(holes.size(), output["size"]);
+    REQUIRE(output["components"] == nlohmann::json(expected));
+    REQUIRE(output["holes"] == nlohmann::json(holes));
+  }
+}
+
+/**
+ * @brief Некорректные входные данные.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void InvalidTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 2,
+    "type": "float",
+    "size": 1,
+    "data": [ [ [4, 4], [0, 0] ] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/RectangleComponents", input.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
@@ -0,0 +1,172 @@
+/**
+ * @file tests/rectangle_intersections_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для поиска пар пересекающихся прямоугольников.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+#define NUM_TRIES_FOR_RANDOM_TEST 10
+
+static void SimpleTest(httplib::Client* cli);
+static void RandomTest(httplib::Client* cli);
+static void InvalidTest(httplib::Client* cli);
+
+void TestRectangleIntersections(httplib::Client* cli) {
+  TestSuite suite("TestRectangleIntersections");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, InvalidTest);
+}
+
+/**
+ * @brief Простейший статический тест.
+ *
+ * Прямоугольники 0 и 1 пересекаются, 1 и 2 касаются углом,
+ * 3 лежит внутри 0, а 4 ни с кем не пересекается.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "type": "int",
+    "size": 5,
+    "data": [
+      [ [0, 0], [4, 4] ],
+      [ [2, 2], [6, 6] ],
+      [ [6, 6], [8, 8] ],
+      [ [1, 1], [2, 2] ],
+      [ [10, 0], [12, 2] ]
+    ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/RectangleIntersections", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+  std::vector<std::pair<int, int>> pairs;
+
+  for (const nlohmann::json& pair : output["data"])
+    pairs.emplace_back(pair[0], pair[1]);
+
+  std::sort(pairs.begin(), pairs.end());
+
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL(4, output["size"]);
+  REQUIRE(pairs == (std::vector<std::pair<int, int>>{
+      { 0, 1 }, { 0, 3 }, { 1, 2 }, { 1, 3 } }));
+
+  input["mode"] = "count";
+
+  res = cli->Post("/RectangleIntersections", input.dump(),
+                  "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(4, output["size"]);
+  REQUIRE(!output.contains("data"));
+}
+
+/**
+ * @brief Сравнение с перебором всех пар.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void RandomTest(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<int> coordinate(0, 100);
+  std::uniform_int_distribution<int> length(0, 20);
+
+  for (size_t i = 0; i < NUM_TRIES_FOR_RANDOM_TEST; i++) {
+    const size_t size = 300;
+    nlohmann::json input;
+    std::vector<std::vector<int>> rectangles;
+
+    input["id"] = i;
+    input["type"] = i % 2 ? "int" : "double";
+    input["size"] = size;
+
+    for (size_t j = 0; j < size; j++) {
+      int x = coordinate(gen), y = coordinate(gen);
+      int w = length(gen), h = length(gen);
+
+      rectangles.push_back({ x, y, x + w, y + h });
+      input["data"][j] = { { x, y }, { x + w, y + h } };
+    }
+
+    std::vector<std::pair<int, int>> expected;
+
+    for (size_t j = 0; j < size; j++) {
+      for (size_t k = j + 1; k < size; k++) {
+        const std::vector<int>& a = rectangles[j];
+        const std::vector<int>& b = rectangles[k];
+
+        if (a[0] <= b[2] && b[0] <= a[2] && a[1] <= b[3] && b[1] <= a[3])
+          expected.emplace_back(j, k);
+      }
+    }
+
+    httplib::Result res = cli->Post("/RectangleIntersections", input.dump(),
+                                    "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+    std::vector<std::pair<int, int>> pairs;
+
+    for (const nlohmann::json& pair : output["data"]) {
+      REQUIRE(pair[0] < pair[1]);
+      pairs.emplace_back(pair[0], pair[1]);
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+
+    REQUIRE_EQUAL(expected.size(), output["size"]);
+    REQUIRE(pairs == expected);
+
+    input["mode"] = "count";
+
+    res = cli->Post("/RectangleIntersections", input.dump(),
+                    "application/json");
+    output = nlohmann::json::parse(res->body);
+
+    REQUIRE_EQUAL(expected.size(), output["size"]);
+  }
+}
+
+/**
+ * @brief Некорректные входные данные.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void InvalidTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 2,
+    "type": "float",
+    "size": 1,
+    "data": [ [ [4, 0], [0, 4] ] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/RectangleIntersections", input.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+
+  input["data"] = R"([ [ [0, 0], [4, 4] ] ])"_json;
+  input["mode"] = "unknown";
+
+  res = cli->Post("/RectangleIntersections", input.dump(),
+                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
@@ -0,0 +1,359 @@
+/**
+ * @file tests/rtree_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для R-дерева.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+#define NUM_TRIES_FOR_RANDOM_TEST 20
+
+static void SimpleTest(httplib::Client* cli);
+static void RandomTest(httplib::Client* cli);
+static void MissingDatasetTest(httplib::Client* cli);
+static void DropTest(httplib::Client* cli);
+static void EvictionTest(httplib::Client* cli);
+
+static double Distance(const nlohmann::json& rectangle, double x, double y);
+
+void TestRTree(httplib::Client* cli) {
+  TestSuite suite("TestRTree");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, MissingDatasetTest);
+  RUN_TEST_REMOTE(suite, cli, DropTest);
+  RUN_TEST_REMOTE(suite, cli, EvictionTest);
+}
+
+/**
+ * @brief Простейший статический тест.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  nlohmann::json build = R"(
+  {
+    "id": 1,
+    "type": "int",
+    "name": "simple",
+    "size": 4,
+    "data": [ [[0, 0], [2, 2]], [[1, 1], [4, 3]],
+              [[5, 5], [6, 6]], [[-3, 4], [-1, 7]] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/RTreeBuild", build.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL(4, output["size"]);
+  REQUIRE_EQUAL("simple", output["name"]);
+
+  nlohmann::json query = R"(
+  {
+    "id": 2,
+    "type": "int",
+    "name": "simple",
+    "size": 4,
+    "queries": [
+      { "kind": "window", "window": [[1, 0], [3, 1]] },
+      { "kind": "stab", "point": [5, 6] },
+      { "kind": "nearest", "point": [7, 7], "k": 2 },
+      { "kind": "window", "window": [[10, 10], [11, 11]] }
+    ]
+  }
+)"_json;
+
+  res = cli->Post("/RTreeQuery", query.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(2, output["id"]);
+  REQUIRE_EQUAL(4, output["size"]);
+
+  std::vector<size_t> window = output["data"][0];
+
+  std::sort(window.begin(), window.end());
+
+  REQUIRE_EQUAL(2U, window.size());
+  REQUIRE_EQUAL(0U, window[0]);
+  REQUIRE_EQUAL(1U, window[1]);
+
+  REQUIRE_EQUAL("[2]", output["data"][1].dump());
+  REQUIRE_EQUAL("[2,1]", output["data"][2].dump());
+  REQUIRE_EQUAL("[]", output["data"][3].dump());
+}
+
+/**
+ * @brief Сравнение с полным перебором на случайных данных.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void RandomTest(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_real_distribution<double> coordinate(-1000.0, 1000.0);
+  std::uniform_real_distribution<double> extent(0.0, 50.0);
+  std::uniform_int_distribution<size_t> count(0, 2000);
+
+  for (size_t i = 0; i < NUM_TRIES_FOR_RANDOM_TEST; i++) {
+    size_t size = count(gen);
+    nlohmann::json build;
+
+    build["id"] = i;
+    build["type"] = "double";
+    build["name"] = "random";
+    build["size"] = size;
+    build["data"] = nlohmann::json::array();
+
+    for (size_t j = 0; j < size; j++) {
+      double x = coordinate(gen), y = coordinate(gen);
+
+      build["data"][j] = { { x, y }, { x + extent(gen), y + extent(gen) } };
+    }
+
+    httplib::Result res = cli->Post("/RTreeBuild", build.dump(),
+                                    "application/json");
+
+    REQUIRE_EQUAL(200, res->status);
+
+    const size_t queries = 50;
+    nlohmann::json query;
+
+    query["id"] = i;
+    query["type"] = "double";
+    query["name"] = "random";
+    query["size"] = 3 * queries;
+
+    for (size_t j = 0; j < queries; j++) {
+      double x = coordinate(gen), y = coordinate(gen);
+
+      query["queries"][3 * j] = {
+        { "kind", "window" },
+        { "window", { { x, y }, { x + 200, y + 100 } } }
+      };
+      query["queries"][3 * j + 1] = {
+        { "kind", "stab" },
+        { "point", { x, y } }
+      };
+      query["queries"][3 * j + 2] = {
+        { "kind", "nearest" },
+        { "point", { x, y } },
+        { "k", 5 }
+      };
+    }
+
+    res = cli->Post("/RTreeQuery", query.dump(), "application/json");
+
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    for (size_t j = 0; j < queries; j++) {
+      double x = query["queries"][3 * j + 1]["point"][0];
+      double y = query["queries"][3 * j + 1]["point"][1];
+      std::vector<size_t> window, stab, expectedWindow, expectedStab;
+      std::vector<double> distances;
+
+      for (size_t k = 0; k < size; k++) {
+        const nlohmann::json& r = build["data"][k];
+
+        if (r[0][0] <= x + 200 && x <= r[1][0] &&
+            r[0][1] <= y + 100 && y <= r[1][1])
+          expectedWindow.push_back(k);
+
+        if (Distance(r, x, y) == 0)
+          expectedStab.push_back(k);
+
+        distances.push_back(Distance(r, x, y));
+      }
+
+      window = output["data"][3 * j].get<std::vector<size_t>>();
+      stab = output["data"][3 * j + 1].get<std::vector<size_t>>();
+
+      std::sort(window.begin(), window.end());
+      std::sort(stab.begin(), stab.end());
+      std::sort(distances.begin(), distances.end());
+
+      REQUIRE(window == expectedWindow);
+      REQUIRE(stab == expectedStab);
+
+      const nlohmann::json& nearest = output["data"][3 * j + 2];
+
+      REQUIRE_EQUAL(std::min(size, size_t(5)), nearest.size());
+
+      for (size_t k = 0; k < nearest.size(); k++) {
+        REQUIRE_CLOSE(distances[k],
+                      Distance(build["data"][nearest[k].get<size_t>()], x, y),
+                      1e-9);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Запрос к несуществующему дереву.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void MissingDatasetTest(httplib::Client* cli) {
+  nlohmann::json query = R"(
+  {
+    "id": 3,
+    "type": "float",
+    "name": "missing",
+    "size": 1,
+    "queries": [ { "kind": "stab", "point": [0, 0] } ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/RTreeQuery", query.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
+
+/**
+ * @brief Удаление дерева.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void DropTest(httplib::Client* cli) {
+  nlohmann::json build = R"(
+  {
+    "id": 4,
+    "type": "double",
+    "name": "drop",
+    "size": 1,
+    "data": [ [[0, 0], [1, 1]] ]
+  }
+)"_json;
+  nlohmann::json query = R"(
+  {
+    "id": 5,
+    "type": "double",
+    "name": "drop",
+    "size": 1,
+    "queries": [ { "kind": "stab", "point": [0, 0] } ]
+  }
+)"_json;
+  nlohmann::json drop = R"(
+  {
+    "id": 6,
+    "type": "double",
+    "name": "drop"
+  }
+)"_json;
+
+  REQUIRE_EQUAL(200, cli->Post("/RTreeBuild", build.dump(),
+                               "application/json")->status);
+  REQUIRE_EQUAL(200, cli->Post("/RTreeQuery", query.dump(),
+                               "application/json")->status);
+
+  httplib::Result res = cli->Post("/RTreeDrop", drop.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(6, output["id"]);
+  REQUIRE_EQUAL("drop", output["name"]);
+  REQUIRE_EQUAL(true, output["dropped"]);
+
+  REQUIRE_EQUAL(400, cli->Post("/RTreeQuery", query.dump(),
+                               "application/json")->status);
+
+  res = cli->Post("/RTreeDrop", drop.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(false, output["dropped"]);
+
+  drop["type"] = "complex";
+
+  REQUIRE_EQUAL(400, cli->Post("/RTreeDrop", drop.dump(),
+                               "application/json")->status);
+}
+
+/**
+ * @brief Вытеснение дольше всего не использованных деревьев.
+ *
+ * Сервер по умолчанию хранит не больше 64 деревьев каждого типа
+ * координат. После построения 66 новых деревьев вытесняется первое
+ * из них, а дерево, к которому недавно обращались, остаётся.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void EvictionTest(httplib::Client* cli) {
+  const size_t capacity = 64;
+  nlohmann::json build = R"(
+  {
+    "id": 7,
+    "type": "long double",
+    "size": 1,
+    "data": [ [[0, 0], [1, 1]] ]
+  }
+)"_json;
+  nlohmann::json query = R"(
+  {
+    "id": 8,
+    "type": "long double",
+    "size": 1,
+    "queries": [ { "kind": "stab", "point": [0, 0] } ]
+  }
+)"_json;
+
+  for (size_t i = 0; i <= capacity; i++) {
+    build["name"] = "evict-" + std::to_string(i);
+
+    REQUIRE_EQUAL(200, cli->Post("/RTreeBuild", build.dump(),
+                                 "application/json")->status);
+
+    // Обращение к дереву evict-1 защищает его от вытеснения.
+    if (i > 1) {
+      query["name"] = "evict-1";
+
+      REQUIRE_EQUAL(200, cli->Post("/RTreeQuery", query.dump(),
+                                   "application/json")->status);
+    }
+  }
+
+  build["name"] = "evict-extra";
+
+  REQUIRE_EQUAL(200, cli->Post("/RTreeBuild", build.dump(),
+                               "application/json")->status);
+
+  query["name"] = "evict-0";
+  REQUIRE_EQUAL(400, cli->Post("/RTreeQuery", query.dump(),
+                               "application/json")->status);
+
+  query["name"] = "evict-1";
+  REQUIRE_EQUAL(200, cli->Post("/RTreeQuery", query.dump(),
+                               "application/json")->status);
+
+  query["name"] = "evict-extra";
+  REQUIRE_EQUAL(200, cli->Post("/RTreeQuery", query.dump(),
+                               "application/json")->status);
+}
+
+/**
+ * @brief Вычислить расстояние от точки до прямоугольника.
+ *
+ * @param rectangle Прямоугольник в формате [[x1, y1], [x2, y2]].
+ * @param x Абсцисса точки.
+ * @param y Ордината точки.
+ * @return Расстояние.
+ */
+static double Distance(const nlohmann::json& rectangle, double x, double y) {
+  double x1 = rectangle[0][0], y1 = rectangle[0][1];
+  double x2 = rectangle[1][0], y2 = rectangle[1][1];
+  double dx = std::max({ x1 - x, 0.0, x - x2 });
+  double dy = std::max({ y1 - y, 0.0, y - y2 });
+
+  return std::sqrt(dx * dx + dy * dy);
+}
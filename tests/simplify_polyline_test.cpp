@@ -0,0 +1,218 @@
+/**
+ * @file tests/simplify_polyline_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для упрощения ломаных.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+#define NUM_TRIES_FOR_RANDOM_TEST 10
+
+static void SimpleTest(httplib::Client* cli);
+static void ClosedTest(httplib::Client* cli);
+static void StreamingTest(httplib::Client* cli);
+static void InvalidTest(httplib::Client* cli);
+
+static double Distance(const nlohmann::json& polyline, double x, double y);
+
+void TestSimplifyPolyline(httplib::Client* cli) {
+  TestSuite suite("TestSimplifyPolyline");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, ClosedTest);
+  RUN_TEST_REMOTE(suite, cli, StreamingTest);
+  RUN_TEST_REMOTE(suite, cli, InvalidTest);
+}
+
+/**
+ * @brief Простейший статический тест для обоих алгоритмов.
+ *
+ * Почти прямая ломаная сводится к отрезку, а у ломаной в форме буквы L
+ * сохраняется только угол.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  for (std::string method : { "douglas-peucker", "visvalingam" }) {
+    nlohmann::json input = R"(
+    {
+      "id": 1,
+      "type": "double",
+      "tolerance": 0.5,
+      "size": 5,
+      "data": [ [0, 1, 2, 3, 4], [0, 0.1, 0, -0.1, 0] ]
+    }
+)"_json;
+
+    input["method"] = method;
+
+    httplib::Result res = cli->Post("/SimplifyPolyline", input.dump(),
+                                    "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    REQUIRE_EQUAL(1, output["id"]);
+    REQUIRE_EQUAL(2, output["size"]);
+    REQUIRE_EQUAL("[[0.0,4.0],[0.0,0.0]]", output["data"].dump());
+
+    input["type"] = "int";
+    input["data"] = { { 0, 1, 2, 2, 2 }, { 0, 0, 0, 1, 2 } };
+
+    res = cli->Post("/SimplifyPolyline", input.dump(), "application/json");
+    output = nlohmann::json::parse(res->body);
+
+    REQUIRE_EQUAL("[[0,2,2],[0,0,2]]", output["data"].dump());
+  }
+}
+
+/**
+ * @brief Замкнутая ломаная.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void ClosedTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 2,
+    "type": "int",
+    "tolerance": 0.5,
+    "closed": true,
+    "size": 6,
+    "data": [ [0, 1, 2, 2, 0, 0], [0, 0, 0, 2, 2, 1] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/SimplifyPolyline", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL("[[0,2,2,0],[0,0,2,2]]", output["data"].dump());
+}
+
+/**
+ * @brief Потоковый режим на случайных блужданиях.
+ *
+ * Концы ломаной должны сохраняться, каждая вершина исходной ломаной
+ * должна лежать не дальше допуска от результата Дугласа-Пекера,
+ * а окно, вмещающее всю ломаную, должно давать тот же результат,
+ * что и обработка целиком.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void StreamingTest(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::normal_distribution<double> step(0.0, 1.0);
+
+  for (size_t i = 0; i < NUM_TRIES_FOR_RANDOM_TEST; i++) {
+    const size_t size = 2000;
+    const double tolerance = 2.0;
+    double x = 0, y = 0;
+    nlohmann::json input;
+
+    input["id"] = i;
+    input["type"] = "double";
+    input["tolerance"] = tolerance;
+    input["size"] = size;
+
+    for (size_t j = 0; j < size; j++) {
+      input["data"][0][j] = x += step(gen);
+      input["data"][1][j] = y += step(gen);
+    }
+
+    httplib::Result res = cli->Post("/SimplifyPolyline", input.dump(),
+                                    "application/json");
+    nlohmann::json whole = nlohmann::json::parse(res->body);
+
+    input["window"] = size;
+    res = cli->Post("/SimplifyPolyline", input.dump(), "application/json");
+
+    REQUIRE_EQUAL(whole["data"].dump(),
+                  nlohmann::json::parse(res->body)["data"].dump());
+
+    input["window"] = 100;
+    res = cli->Post("/SimplifyPolyline", input.dump(), "application/json");
+
+    nlohmann::json output = nlohmann::json::parse(res->body);
+    size_t count = output["size"];
+
+    REQUIRE(count >= 2);
+    REQUIRE(count < size);
+    REQUIRE_EQUAL(input["data"][0][0], output["data"][0][0]);
+    REQUIRE_EQUAL(input["data"][0][size - 1], output["data"][0][count - 1]);
+
+    for (size_t j = 0; j < size; j++) {
+      REQUIRE(Distance(output["data"], input["data"][0][j],
+                       input["data"][1][j]) <= tolerance * (1 + 1e-9));
+    }
+
+    input["method"] = "visvalingam";
+    res = cli->Post("/SimplifyPolyline", input.dump(), "application/json");
+    output = nlohmann::json::parse(res->body);
+
+    REQUIRE(output["size"] >= 2);
+    REQUIRE(output["size"] < size);
+  }
+}
+
+/**
+ * @brief Некорректные параметры.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void InvalidTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 3,
+    "type": "float",
+    "tolerance": -1,
+    "size": 3,
+    "data": [ [0, 1, 2], [0, 1, 0] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/SimplifyPolyline", input.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+
+  input["tolerance"] = 1;
+  input["method"] = "unknown";
+
+  res = cli->Post("/SimplifyPolyline", input.dump(), "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
+
+/**
+ * @brief Вычислить расстояние от точки до ломаной.
+ *
+ * @param polyline Вершины ломаной в формате [[x1, ...], [y1, ...]].
+ * @param x \f$ X \f$ координата точки.
+ * @param y \f$ Y \f$ координата точки.
+ * @return Расстояние.
+ */
+static double Distance(const nlohmann::json& polyline, double x, double y) {
+  double result = 1e300;
+
+  for (size_t i = 0; i + 1 < polyline[0].size(); i++) {
+    double ax = polyline[0][i], ay = polyline[1][i];
+    double dx = double(polyline[0][i + 1]) - ax;
+    double dy = double(polyline[1][i + 1]) - ay;
+    double length = dx * dx + dy * dy;
+    double t = length > 0 ? ((x - ax) * dx + (y - ay) * dy) / length : 0;
+
+    t = std::min(1.0, std::max(0.0, t));
+
+    result = std::min(result, std::hypot(x - ax - t * dx, y - ay - t * dy));
+  }
+
+  return result;
+}
@@ -34,6 +34,23 @@ void TestOrientation();
 
 void TestContourRectangles(httplib::Client* cli);
 void TestGrahamScan(httplib::Client* cli);
+void TestClipPolygons(httplib::Client* cli);
+void TestRTree(httplib::Client* cli);
+void TestPointIndex(httplib::Client* cli);
+void TestKdTree(httplib::Client* cli);
+void TestDelaunay(httplib::Client* cli);
+void TestTriangulatePolygon(httplib::Client* cli);
+void TestClosestPair(httplib::Client* cli);
+void TestMinkowskiSum(httplib::Client* cli);
+void TestConvexIntersection(httplib::Client* cli);
+void TestConvexLocator(httplib::Client* cli);
+void TestSimplifyPolyline(httplib::Client* cli);
+void TestRectangleIntersections(httplib::Client* cli);
+void TestCoverageDepth(httplib::Client* cli);
+void TestRectangleComponents(httplib::Client* cli);
+void TestBatch(httplib::Client* cli);
+void TestJobs(httplib::Client* cli);
+void TestMetrics(httplib::Client* cli);
 
 /* Конец вставки. */
 
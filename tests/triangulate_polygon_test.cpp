@@ -0,0 +1,206 @@
+/**
+ * @file tests/triangulate_polygon_test.cpp
+ * @author Mikhail Lozhnikov
+ *
+ * Реализация набора тестов для триангуляции многоугольника.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "test.hpp"
+#include "test_core.hpp"
+
+#define NUM_TRIES_FOR_RANDOM_TEST 20
+
+static void SimpleTest(httplib::Client* cli);
+static void CombTest(httplib::Client* cli);
+static void RandomTest(httplib::Client* cli);
+static void InvalidInputTest(httplib::Client* cli);
+
+static void CheckTriangulation(const std::vector<double>& xs,
+                               const std::vector<double>& ys,
+                               const nlohmann::json& output);
+
+void TestTriangulatePolygon(httplib::Client* cli) {
+  TestSuite suite("TestTriangulatePolygon");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, CombTest);
+  RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, InvalidInputTest);
+}
+
+/**
+ * @brief Простейший статический тест.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "type": "int",
+    "size": 4,
+    "data": [ [0, 0, 2, 2], [0, 2, 2, 0] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/TriangulatePolygon", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL(2, output["size"]);
+
+  CheckTriangulation({ 0, 0, 2, 2 }, { 0, 2, 2, 0 }, output);
+}
+
+/**
+ * @brief Гребёнка: много вершин разбиения и слияния и горизонтальных
+ * рёбер.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void CombTest(httplib::Client* cli) {
+  const int teeth = 50;
+  std::vector<double> xs, ys;
+
+  // Зубья вверх по верхней стороне и вниз по нижней, все на одной высоте.
+  for (int i = 0; i < teeth; i++) {
+    xs.insert(xs.end(), { 3.0 * i, 3.0 * i + 1, 3.0 * i + 2 });
+    ys.insert(ys.end(), { 0, 5, 0 });
+  }
+
+  for (int i = teeth - 1; i >= 0; i--) {
+    xs.insert(xs.end(), { 3.0 * i + 2, 3.0 * i + 1, 3.0 * i });
+    ys.insert(ys.end(), { -10, -5, -10 });
+  }
+
+  nlohmann::json input;
+
+  input["id"] = 2;
+  input["type"] = "double";
+  input["size"] = xs.size();
+  input["data"] = { xs, ys };
+
+  httplib::Result res = cli->Post("/TriangulatePolygon", input.dump(),
+                                  "application/json");
+
+  CheckTriangulation(xs, ys, nlohmann::json::parse(res->body));
+}
+
+/**
+ * @brief Случайные звёздные многоугольники.
+ *
+ * @param cli Указатель на HTTP клиент.
+ *
+ * Вершины берутся с возрастающими полярными углами и случайными
+ * расстояниями от центра, поэтому многоугольник простой, но содержит
+ * много невыпуклых вершин.
+ */
+static void RandomTest(httplib::Client* cli) {
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::uniform_int_distribution<size_t> count(3, 2000);
+  std::uniform_real_distribution<double> jitter(0.0, 0.9);
+  std::uniform_real_distribution<double> radius(0.1, 1.0);
+  const double pi = std::acos(-1.0);
+
+  for (size_t i = 0; i < NUM_TRIES_FOR_RANDOM_TEST; i++) {
+    size_t size = count(gen);
+    std::vector<double> xs(size), ys(size);
+
+    for (size_t j = 0; j < size; j++) {
+      double angle = 2 * pi * (j + jitter(gen)) / size;
+      double r = radius(gen);
+
+      xs[j] = r * std::cos(angle);
+      ys[j] = r * std::sin(angle);
+    }
+
+    // Половина многоугольников обходится по часовой стрелке.
+    if (i % 2 == 1) {
+      std::reverse(xs.begin(), xs.end());
+      std::reverse(ys.begin(), ys.end());
+    }
+
+    nlohmann::json input;
+
+    input["id"] = i;
+    input["type"] = "double";
+    input["size"] = size;
+    input["data"] = { xs, ys };
+
+    httplib::Result res = cli->Post("/TriangulatePolygon", input.dump(),
+                                    "application/json");
+
+    CheckTriangulation(xs, ys, nlohmann::json::parse(res->body));
+  }
+}
+
+/**
+ * @brief Многоугольник из двух вершин.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void InvalidInputTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 3,
+    "type": "float",
+    "size": 2,
+    "data": [ [0, 1], [0, 1] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/TriangulatePolygon", input.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
+
+/**
+ * @brief Проверить триангуляцию многоугольника.
+ *
+ * @param xs Абсциссы вершин.
+ * @param ys Ординаты вершин.
+ * @param output Ответ сервера.
+ *
+ * Треугольников должно быть на два меньше, чем вершин, все они должны
+ * обходиться в том же направлении, что и многоугольник, а их суммарная
+ * площадь должна совпадать с площадью многоугольника.
+ */
+static void CheckTriangulation(const std::vector<double>& xs,
+                               const std::vector<double>& ys,
+                               const nlohmann::json& output) {
+  size_t size = xs.size();
+  double area = 0, sum = 0;
+
+  for (size_t i = 0; i < size; i++) {
+    size_t next = (i + 1) % size;
+
+    area += xs[i] * ys[next] - xs[next] * ys[i];
+  }
+
+  REQUIRE_EQUAL(size - 2, output["data"].size());
+
+  for (const nlohmann::json& triangle : output["data"]) {
+    size_t a = triangle[0], b = triangle[1], c = triangle[2];
+
+    REQUIRE(a < size && b < size && c < size);
+
+    double doubled = (xs[b] - xs[a]) * (ys[c] - ys[a]) -
+                     (ys[b] - ys[a]) * (xs[c] - xs[a]);
+
+    REQUIRE(doubled * area > 0);
+
+    sum += doubled;
+  }
+
+  REQUIRE_CLOSE(area, sum, 1e-9);
+}